@@ -0,0 +1,70 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+/*
+ * NOTE: this file is compiled in the native_sim runner (host) context and linked with the host C library,
+ * that is why it can use fopen()/fgets(). it must not include any zephyr header.
+ * documentation can be found at: https://docs.zephyrproject.org/latest/boards/native/native_sim/doc/index.html
+ */
+#include <stdio.h>
+
+#include "bmi323_emul_replay_native.h"
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Longest CSV line, 8 numbers and their separators. */
+#define LINE_MAX_LEN            (128)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+static FILE *replay_file;
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int bmi323_emul_replay_native_open(const char *path)
+{
+    replay_file = fopen(path, "r");
+
+    return (replay_file != NULL) ? 0 : -1;
+}
+
+int bmi323_emul_replay_native_next(int16_t *axes)
+{
+    char line[LINE_MAX_LEN];
+    unsigned int seq, sensor_time;
+    int values[6];
+    int rewinds = 0;
+    int i;
+
+    if (replay_file == NULL)
+    {
+        return -1;
+    }
+
+    /* Stop after a second pass without a single sample, the file holds none. */
+    while (rewinds < 2)
+    {
+        if (fgets(line, sizeof(line), replay_file) == NULL)
+        {
+            rewind(replay_file);
+            rewinds++;
+            continue;
+        }
+
+        if (sscanf(line, "%u,%u,%d,%d,%d,%d,%d,%d", &seq, &sensor_time, &values[0], &values[1], &values[2],
+                   &values[3], &values[4], &values[5]) == 8)
+        {
+            for (i = 0; i < 6; i++)
+            {
+                axes[i] = (int16_t)values[i];
+            }
+
+            return 0;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,103 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   host side of the BMI323 emulator replay                                                                     |
+ * |    @file           :   bmi323_emul_replay_native.h                                                                                 |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the recorded motion of the BMI323 emulator from a CSV file of the host (native_sim)      |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef BMI323_EMUL_REPLAY_NATIVE_H_
+#define BMI323_EMUL_REPLAY_NATIVE_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'int16_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int bmi323_emul_replay_native_open(const char *path);
+ *  \b Description                              :       open a recording in the CSV format of 'tools/telemetry_decode.py'
+ *                                                      (seq,sensor_time,acc_x,acc_y,acc_z,gyr_x,gyr_y,gyr_z).
+ *  @param  path [IN]                           :       path of the file, relative to the working directory of 'zephyr.exe'.
+ *  @note                                       :       only available on native_sim, this runs in the host (runner) context.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -1 if the file could not be opened.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_emul_replay_native_open(const char *path);
+
+
+/**
+ *  \b function                                 :       int bmi323_emul_replay_native_next(int16_t *axes);
+ *  \b Description                              :       read the raw axes of the next recorded sample, the recording starts over at its end.
+ *  @param  axes [OUT]                          :       acc x/y/z then gyr x/y/z, 6 values.
+ *  @note                                       :       lines that are not samples (the CSV header) are skipped.
+ *  \b PRE-CONDITION                            :       bmi323_emul_replay_native_open() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -1 if the recording holds no sample at all.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_emul_replay_native_next(int16_t *axes);
+
+
+/*** End of File **************************************************************/
+
+#endif /*BMI323_EMUL_REPLAY_NATIVE_H_*/
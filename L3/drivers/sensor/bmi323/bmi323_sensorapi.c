@@ -0,0 +1,1006 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#define DT_DRV_COMPAT bosch_bmi323_sensorapi
+
+#include <zephyr/kernel.h>
+
+#include <string.h>
+
+// include the device model and the devicetree macros
+#include <zephyr/device.h>
+
+// include the I2C, SPI and GPIO drivers
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/gpio.h>
+
+// include the sensor driver API
+#include <zephyr/drivers/sensor.h>
+
+// include the real-time I/O types of the read and stream requests
+#include <zephyr/rtio/rtio.h>
+
+// include the sys_get_le16() helpers
+#include <zephyr/sys/byteorder.h>
+
+// include bmi323 API function haeders
+#include <bmi323.h>
+
+#include "bmi323_sensorapi.h"
+#include "bmi323_sensorapi_decoder.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * DEVICE_DT_INST_DEFINE()          |   https://docs.zephyrproject.org/latest/kernel/drivers/index.html
+ * i2c_write_read_dt()              |   https://docs.zephyrproject.org/latest/doxygen/html/group__i2c__interface.html
+ * spi_transceive_dt()              |   https://docs.zephyrproject.org/latest/hardware/peripherals/spi.html
+ * rtio_sqe_rx_buf()                |   https://docs.zephyrproject.org/latest/services/rtio/index.html
+ * rtio_iodev_sqe_ok()              |   https://docs.zephyrproject.org/latest/services/rtio/index.html
+ * k_work_submit()                  |   https://docs.zephyrproject.org/latest/kernel/services/threads/workqueue.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Largest read of the vendor API in one bus transfer. */
+#define BUS_READ_WRITE_LEN      (64U)
+
+#if defined(CONFIG_BMI323_SENSORAPI_WARM_BOOT)
+/*! CHIP_ID is one word, the id of the sensor is its lower byte. */
+#define CHIP_ID_BYTES           (2U)
+#endif
+
+/*! ACC_CONF and GYR_CONF, both ranges are read back in one transfer. */
+#define CONF_BYTES              (4U)
+#define CONF_RANGE_POS          (4U)
+#define CONF_RANGE_MASK         (0x07U)
+
+/*! ACC_DATA_X up to SENSOR_TIME_1: accel x/y/z, gyro x/y/z, temperature, sensor time (2). */
+#define DATA_BURST_WORDS        (9U)
+#define BURST_TEMP              (6U)
+#define BURST_TIME_0            (7U)
+
+#if defined(CONFIG_BMI323_SENSORAPI_STREAM)
+/*! FIFO frames with accel, gyro and the sensor time, refer to BMI323_SENSORAPI_FRAME_SIZE. */
+#define FIFO_SENSORS            (BMI3_FIFO_ACC_EN | BMI3_FIFO_GYR_EN | BMI3_FIFO_TIME_EN)
+
+/*! The fill level counts words in its lower 11 bits. */
+#define FIFO_FILL_LEVEL_MASK    (0x07FFU)
+
+#define FIFO_CTRL_FLUSH         (0x01U)
+
+/*! Frames per FIFO read, the nRF52832 TWIM and SPIM move at most 255 bytes per transfer, dummy bytes included. */
+#define FIFO_CHUNK_FRAMES       (18U)
+#endif
+
+/******************************************************************************/
+/*!         Typedefs                                                          */
+
+/*! Bus of one instance, the parent of its devicetree node. */
+union bmi323_sensorapi_bus {
+#if DT_ANY_INST_ON_BUS_STATUS_OKAY(i2c)
+    struct i2c_dt_spec i2c;
+#endif
+#if DT_ANY_INST_ON_BUS_STATUS_OKAY(spi)
+    struct spi_dt_spec spi;
+#endif
+};
+
+/*! Bus functions of one bus type, they plug into the SensorAPI in place of 'bmi3_interface_init()'. */
+struct bmi323_sensorapi_bus_io {
+    bool (*is_ready)(const union bmi323_sensorapi_bus *bus);
+    bmi3_read_fptr_t read;
+    bmi3_write_fptr_t write;
+    enum bmi3_intf intf;
+};
+
+/*! Devicetree configuration of one instance. */
+struct bmi323_sensorapi_config {
+    union bmi323_sensorapi_bus bus;
+    const struct bmi323_sensorapi_bus_io *bus_io;
+#if defined(CONFIG_BMI323_SENSORAPI_STREAM)
+    struct gpio_dt_spec int1;
+#endif
+};
+
+/*! Run time data of one instance. */
+struct bmi323_sensorapi_data {
+    /* Bosch SensorAPI instance, its interface pointer is the config of the instance. */
+    struct bmi3_dev bmi;
+
+    /* Serialises the bus between the readers and the stream work. */
+    struct k_mutex lock;
+
+    /* Raw values of the last sample_fetch(), in ACC_DATA_X order. */
+    int16_t fetched[DATA_BURST_WORDS - 2U];
+    uint8_t fetched_acc_range;
+    uint8_t fetched_gyr_range;
+
+#if defined(CONFIG_BMI323_SENSORAPI_STREAM)
+    const struct device *dev;
+    struct gpio_callback int1_cb;
+    struct k_work fifo_work;
+
+    /* Pending stream request, completed by the next watermark interrupt. */
+    struct rtio_iodev_sqe *stream_sqe;
+    bool stream_configured;
+    uint8_t stream_acc_range;
+    uint8_t stream_gyr_range;
+#endif
+};
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+#if DT_ANY_INST_ON_BUS_STATUS_OKAY(i2c)
+/*!
+ *  @brief This internal function checks the I2C bus of an instance.
+ */
+static bool i2c_bus_is_ready(const union bmi323_sensorapi_bus *bus);
+
+/*!
+ *  @brief I2C read function of the SensorAPI, 'intf_ptr' is the config of the instance.
+ */
+static int8_t i2c_bus_read(uint8_t reg_addr, uint8_t *reg_data, uint32_t len, void *intf_ptr);
+
+/*!
+ *  @brief I2C write function of the SensorAPI, 'intf_ptr' is the config of the instance.
+ */
+static int8_t i2c_bus_write(uint8_t reg_addr, const uint8_t *reg_data, uint32_t len, void *intf_ptr);
+#endif
+
+#if DT_ANY_INST_ON_BUS_STATUS_OKAY(spi)
+/*!
+ *  @brief This internal function checks the SPI bus of an instance.
+ */
+static bool spi_bus_is_ready(const union bmi323_sensorapi_bus *bus);
+
+/*!
+ *  @brief SPI read function of the SensorAPI, 'intf_ptr' is the config of the instance.
+ */
+static int8_t spi_bus_read(uint8_t reg_addr, uint8_t *reg_data, uint32_t len, void *intf_ptr);
+
+/*!
+ *  @brief SPI write function of the SensorAPI, 'intf_ptr' is the config of the instance.
+ */
+static int8_t spi_bus_write(uint8_t reg_addr, const uint8_t *reg_data, uint32_t len, void *intf_ptr);
+#endif
+
+/*!
+ *  @brief Delay function of the SensorAPI.
+ */
+static void bus_delay_us(uint32_t period, void *intf_ptr);
+
+/*!
+ *  @brief This internal function reads the current accel and gyro ranges back from the sensor.
+ */
+static int read_ranges(struct bmi323_sensorapi_data *data, uint8_t *acc_range, uint8_t *gyr_range);
+
+/*!
+ *  @brief This internal function reads one accel + gyro + sensor time sample as a single frame.
+ */
+static int read_frame(struct bmi323_sensorapi_data *data, uint8_t *frame, int16_t *temp);
+
+#if defined(CONFIG_SENSOR_ASYNC_API)
+/*!
+ *  @brief This internal function completes a one-shot sensor_read() request.
+ */
+static void submit_one_shot(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe);
+#endif
+
+#if defined(CONFIG_BMI323_SENSORAPI_STREAM)
+/*!
+ *  @brief This internal function stores a stream request until the next FIFO watermark.
+ */
+static void submit_stream(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe);
+
+/*!
+ *  @brief This internal function configures the FIFO and its watermark interrupt for streaming.
+ */
+static int stream_configure(const struct device *dev);
+
+/*!
+ *  @brief GPIOTE callback of the INT1 line, runs in interrupt context.
+ */
+static void int1_triggered(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins);
+
+/*!
+ *  @brief Work handler that drains the FIFO into the pending stream request.
+ */
+static void fifo_work_handler(struct k_work *work);
+#endif
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+struct bmi3_dev *bmi323_sensorapi_get_bmi3_dev(const struct device *dev)
+{
+    struct bmi323_sensorapi_data *data = dev->data;
+
+    return &data->bmi;
+}
+
+/*!
+ * @brief 'sample_fetch' entry of the driver API, reads accel, gyro and temperature in one burst.
+ */
+static int bmi323_sensorapi_sample_fetch(const struct device *dev, enum sensor_channel chan)
+{
+    struct bmi323_sensorapi_data *data = dev->data;
+    uint8_t frame[BMI323_SENSORAPI_FRAME_SIZE];
+    int16_t temp;
+    uint8_t i;
+    int ret;
+
+    if ((chan != SENSOR_CHAN_ALL) && (chan != SENSOR_CHAN_ACCEL_XYZ) && (chan != SENSOR_CHAN_GYRO_XYZ) &&
+        (chan != SENSOR_CHAN_DIE_TEMP))
+    {
+        return -ENOTSUP;
+    }
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+
+    ret = read_ranges(data, &data->fetched_acc_range, &data->fetched_gyr_range);
+
+    if (ret == 0)
+    {
+        ret = read_frame(data, frame, &temp);
+    }
+
+    k_mutex_unlock(&data->lock);
+
+    if (ret == 0)
+    {
+        for (i = 0; i < 6U; i++)
+        {
+            data->fetched[i] = (int16_t)sys_get_le16(&frame[i * 2U]);
+        }
+
+        data->fetched[BURST_TEMP] = temp;
+    }
+
+    return ret;
+}
+
+/*!
+ * @brief 'channel_get' entry of the driver API.
+ *
+ * @details
+ *      goes through the same q31_t conversion as the decoder, then to 'struct sensor_value'.
+ *      the die temperature is 23 degC + raw / 512.
+ */
+static int bmi323_sensorapi_channel_get(const struct device *dev, enum sensor_channel chan, struct sensor_value *val)
+{
+    struct bmi323_sensorapi_data *data = dev->data;
+    const struct sensor_decoder_api *decoder;
+    struct sensor_chan_spec spec = { .chan_type = (uint16_t)chan, .chan_idx = 0 };
+    struct sensor_three_axis_data out;
+    struct {
+        struct bmi323_sensorapi_encoded_header header;
+        uint8_t frame[BMI323_SENSORAPI_FRAME_SIZE];
+    } encoded = { 0 };
+    uint32_t fit = 0;
+    uint8_t i;
+    int64_t micro;
+
+    if (chan == SENSOR_CHAN_DIE_TEMP)
+    {
+        micro = 23000000LL + (((int64_t)data->fetched[BURST_TEMP] * 1000000LL) / 512);
+        val->val1 = (int32_t)(micro / 1000000LL);
+        val->val2 = (int32_t)(micro % 1000000LL);
+        return 0;
+    }
+
+    if ((chan != SENSOR_CHAN_ACCEL_XYZ) && (chan != SENSOR_CHAN_GYRO_XYZ))
+    {
+        return -ENOTSUP;
+    }
+
+    encoded.header.frame_count = 1;
+    encoded.header.acc_range = data->fetched_acc_range;
+    encoded.header.gyr_range = data->fetched_gyr_range;
+
+    for (i = 0; i < 6U; i++)
+    {
+        sys_put_le16((uint16_t)data->fetched[i], &encoded.frame[i * 2U]);
+    }
+
+    bmi323_sensorapi_get_decoder(dev, &decoder);
+
+    if (decoder->decode((const uint8_t *)&encoded, spec, &fit, 1, &out) != 1)
+    {
+        return -EIO;
+    }
+
+    for (i = 0; i < 3U; i++)
+    {
+        micro = ((int64_t)out.readings[0].values[i] * 1000000LL * (1LL << out.shift)) >> 31;
+        val[i].val1 = (int32_t)(micro / 1000000LL);
+        val[i].val2 = (int32_t)(micro % 1000000LL);
+    }
+
+    return 0;
+}
+
+#if defined(CONFIG_SENSOR_ASYNC_API)
+/*!
+ * @brief 'submit' entry of the driver API, serves sensor_read() and sensor_stream().
+ */
+static void bmi323_sensorapi_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+    const struct sensor_read_config *cfg = iodev_sqe->sqe.iodev->data;
+
+    if (!cfg->is_streaming)
+    {
+        submit_one_shot(dev, iodev_sqe);
+    }
+#if defined(CONFIG_BMI323_SENSORAPI_STREAM)
+    else
+    {
+        submit_stream(dev, iodev_sqe);
+    }
+#else
+    else
+    {
+        rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+    }
+#endif
+}
+#endif
+
+static const struct sensor_driver_api bmi323_sensorapi_api = {
+    .sample_fetch = bmi323_sensorapi_sample_fetch,
+    .channel_get = bmi323_sensorapi_channel_get,
+#if defined(CONFIG_SENSOR_ASYNC_API)
+    .submit = bmi323_sensorapi_submit,
+    .get_decoder = bmi323_sensorapi_get_decoder,
+#endif
+};
+
+int bmi323_sensorapi_reset(const struct device *dev)
+{
+    struct bmi323_sensorapi_data *data = dev->data;
+    int8_t rslt;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+
+    rslt = bmi323_init(&data->bmi);
+
+    k_mutex_unlock(&data->lock);
+
+    return (rslt == BMI323_OK) ? 0 : -EIO;
+}
+
+#if defined(CONFIG_BMI323_SENSORAPI_WARM_BOOT)
+/*!
+ * @brief This internal function takes over a sensor that may still be configured, without resetting it.
+ *
+ * @details
+ *      sets the same fields of the SensorAPI instance as bmi323_init() does (dummy bytes, chip id, the
+ *      accel offset width of the silicon revision and the resolution), minus the soft reset and the
+ *      start of the feature engine (both survive an MCU-only reset). on SPI the first read is a dummy
+ *      read, a sensor that was powered up with the MCU still listens on I2C until CSB rises once.
+ */
+static int8_t attach_without_reset(struct bmi3_dev *bmi)
+{
+    uint8_t chip_id[CHIP_ID_BYTES];
+    int8_t rslt;
+
+    /* Same rule as bmi3_init(): 1 dummy byte on SPI, 2 on I2C. */
+    bmi->dummy_byte = (bmi->intf == BMI3_SPI_INTF) ? 1U : 2U;
+
+    if (bmi->intf == BMI3_SPI_INTF)
+    {
+        (void)bmi323_get_regs(BMI3_REG_CHIP_ID, chip_id, sizeof(chip_id), bmi);
+    }
+
+    rslt = bmi323_get_regs(BMI3_REG_CHIP_ID, chip_id, sizeof(chip_id), bmi);
+
+    if (rslt != BMI323_OK)
+    {
+        return rslt;
+    }
+
+    bmi->chip_id = chip_id[0];
+
+    /* Same as bmi3_init(): the revision in the upper nibble of the second byte widens the accel offsets to 14 bits. */
+    bmi->accel_bit_width = BMI3_ACC_DP_OFF_XYZ_13_BIT_MASK;
+
+    if (((chip_id[1] & BMI3_REV_ID_MASK) >> BMI3_REV_ID_POS) == BMI3_ENABLE)
+    {
+        bmi->accel_bit_width = BMI3_ACC_DP_OFF_XYZ_14_BIT_MASK;
+    }
+
+    if (bmi->chip_id != BMI323_CHIP_ID)
+    {
+        return BMI323_E_DEV_NOT_FOUND;
+    }
+
+    bmi->resolution = BMI323_16_BIT_RESOLUTION;
+
+    return BMI323_OK;
+}
+#endif
+
+/*!
+ * @brief Init function of an instance, runs once when the kernel starts.
+ *
+ * @details
+ *      this replaces 'bmi3_interface_init()' of the vendor examples: the SensorAPI gets the bus
+ *      functions of this instance, then bmi323_init() checks the chip id and soft-resets the sensor.
+ *      with CONFIG_BMI323_SENSORAPI_WARM_BOOT only the chip id is checked, the application decides
+ *      whether the configuration the sensor kept can be used or bmi323_sensorapi_reset() is needed.
+ */
+static int bmi323_sensorapi_init(const struct device *dev)
+{
+    const struct bmi323_sensorapi_config *config = dev->config;
+    struct bmi323_sensorapi_data *data = dev->data;
+
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    if (!config->bus_io->is_ready(&config->bus))
+    {
+        return -ENODEV;
+    }
+
+    k_mutex_init(&data->lock);
+
+    /* On SPI bmi323_init() starts with a dummy read, the rising edge of CSB switches the sensor from I2C to SPI. */
+    data->bmi.intf = config->bus_io->intf;
+    data->bmi.intf_ptr = (void *)config;
+    data->bmi.read = config->bus_io->read;
+    data->bmi.write = config->bus_io->write;
+    data->bmi.delay_us = bus_delay_us;
+    data->bmi.read_write_len = BUS_READ_WRITE_LEN;
+
+#if defined(CONFIG_BMI323_SENSORAPI_WARM_BOOT)
+    rslt = attach_without_reset(&data->bmi);
+#else
+    rslt = bmi323_init(&data->bmi);
+#endif
+
+    if (rslt != BMI323_OK)
+    {
+        return -EIO;
+    }
+
+#if defined(CONFIG_BMI323_SENSORAPI_STREAM)
+    data->dev = dev;
+    k_work_init(&data->fifo_work, fifo_work_handler);
+#endif
+
+    return 0;
+}
+
+#if DT_ANY_INST_ON_BUS_STATUS_OKAY(i2c)
+/*!
+ * @brief This internal function checks the I2C bus of an instance.
+ */
+static bool i2c_bus_is_ready(const union bmi323_sensorapi_bus *bus)
+{
+    return i2c_is_ready_dt(&bus->i2c);
+}
+
+/*!
+ * @brief I2C read function of the SensorAPI, the API itself strips the 2 dummy bytes.
+ */
+static int8_t i2c_bus_read(uint8_t reg_addr, uint8_t *reg_data, uint32_t len, void *intf_ptr)
+{
+    const struct bmi323_sensorapi_config *config = intf_ptr;
+
+    return (i2c_write_read_dt(&config->bus.i2c, &reg_addr, 1, reg_data, len) == 0) ? BMI3_OK : BMI3_E_COM_FAIL;
+}
+
+/*!
+ * @brief I2C write function of the SensorAPI.
+ */
+static int8_t i2c_bus_write(uint8_t reg_addr, const uint8_t *reg_data, uint32_t len, void *intf_ptr)
+{
+    const struct bmi323_sensorapi_config *config = intf_ptr;
+
+    return (i2c_burst_write_dt(&config->bus.i2c, reg_addr, reg_data, len) == 0) ? BMI3_OK : BMI3_E_COM_FAIL;
+}
+
+static const struct bmi323_sensorapi_bus_io i2c_bus_io = {
+    .is_ready = i2c_bus_is_ready,
+    .read = i2c_bus_read,
+    .write = i2c_bus_write,
+    .intf = BMI3_I2C_INTF,
+};
+#endif
+
+#if DT_ANY_INST_ON_BUS_STATUS_OKAY(spi)
+/*!
+ * @brief This internal function checks the SPI bus of an instance.
+ */
+static bool spi_bus_is_ready(const union bmi323_sensorapi_bus *bus)
+{
+    return spi_is_ready_dt(&bus->spi);
+}
+
+/*!
+ * @brief SPI read function of the SensorAPI.
+ *
+ * @details
+ *      the SensorAPI already set the read bit of 'reg_addr' and asks for one dummy byte more than it
+ *      needs. the byte clocked in while the address goes out carries nothing and is skipped (NULL rx
+ *      buffer), the dummy byte lands in 'reg_data' and is stripped by the API, as on I2C. both buffers
+ *      go out as one EasyDMA transfer of the SPIM with CSB held low.
+ */
+static int8_t spi_bus_read(uint8_t reg_addr, uint8_t *reg_data, uint32_t len, void *intf_ptr)
+{
+    const struct bmi323_sensorapi_config *config = intf_ptr;
+    const struct spi_buf tx_buf = { .buf = &reg_addr, .len = 1 };
+    const struct spi_buf_set tx = { .buffers = &tx_buf, .count = 1 };
+    const struct spi_buf rx_bufs[2] = {
+        { .buf = NULL, .len = 1 },
+        { .buf = reg_data, .len = len },
+    };
+    const struct spi_buf_set rx = { .buffers = rx_bufs, .count = 2 };
+
+    return (spi_transceive_dt(&config->bus.spi, &tx, &rx) == 0) ? BMI3_OK : BMI3_E_COM_FAIL;
+}
+
+/*!
+ * @brief SPI write function of the SensorAPI, the address (read bit cleared by the API) and the data in one transfer.
+ */
+static int8_t spi_bus_write(uint8_t reg_addr, const uint8_t *reg_data, uint32_t len, void *intf_ptr)
+{
+    const struct bmi323_sensorapi_config *config = intf_ptr;
+    const struct spi_buf tx_bufs[2] = {
+        { .buf = &reg_addr, .len = 1 },
+        { .buf = (uint8_t *)reg_data, .len = len },
+    };
+    const struct spi_buf_set tx = { .buffers = tx_bufs, .count = 2 };
+
+    return (spi_write_dt(&config->bus.spi, &tx) == 0) ? BMI3_OK : BMI3_E_COM_FAIL;
+}
+
+static const struct bmi323_sensorapi_bus_io spi_bus_io = {
+    .is_ready = spi_bus_is_ready,
+    .read = spi_bus_read,
+    .write = spi_bus_write,
+    .intf = BMI3_SPI_INTF,
+};
+#endif
+
+/*!
+ * @brief Delay function of the SensorAPI.
+ */
+static void bus_delay_us(uint32_t period, void *intf_ptr)
+{
+    ARG_UNUSED(intf_ptr);
+
+    k_busy_wait(period);
+}
+
+/*!
+ * @brief This internal function reads the current accel and gyro ranges back from the sensor.
+ */
+static int read_ranges(struct bmi323_sensorapi_data *data, uint8_t *acc_range, uint8_t *gyr_range)
+{
+    uint8_t conf[CONF_BYTES];
+
+    if (bmi323_get_regs(BMI3_REG_ACC_CONF, conf, sizeof(conf), &data->bmi) != BMI323_OK)
+    {
+        return -EIO;
+    }
+
+    *acc_range = (uint8_t)((sys_get_le16(&conf[0]) >> CONF_RANGE_POS) & CONF_RANGE_MASK);
+    *gyr_range = (uint8_t)((sys_get_le16(&conf[2]) >> CONF_RANGE_POS) & CONF_RANGE_MASK);
+
+    return 0;
+}
+
+/*!
+ * @brief This internal function reads one sample as a single frame.
+ *
+ * @details
+ *      accel, gyro, temperature and the sensor time are read in one burst, then stored in the
+ *      FIFO frame layout (the temperature is not part of it).
+ */
+static int read_frame(struct bmi323_sensorapi_data *data, uint8_t *frame, int16_t *temp)
+{
+    uint8_t burst[DATA_BURST_WORDS * 2U];
+
+    if (bmi323_get_regs(BMI3_REG_ACC_DATA_X, burst, sizeof(burst), &data->bmi) != BMI323_OK)
+    {
+        return -EIO;
+    }
+
+    memcpy(frame, burst, BMI323_SENSORAPI_FRAME_TIME * 2U);
+    memcpy(&frame[BMI323_SENSORAPI_FRAME_TIME * 2U], &burst[BURST_TIME_0 * 2U], 2U);
+
+    if (temp != NULL)
+    {
+        *temp = (int16_t)sys_get_le16(&burst[BURST_TEMP * 2U]);
+    }
+
+    return 0;
+}
+
+#if defined(CONFIG_SENSOR_ASYNC_API)
+/*!
+ * @brief This internal function completes a one-shot sensor_read() request.
+ *
+ * @details
+ *      every channel of the request is served by the same single frame, the decoder picks the
+ *      values out of it when (and if) the consumer asks for them.
+ */
+static void submit_one_shot(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+    const struct sensor_read_config *cfg = iodev_sqe->sqe.iodev->data;
+    struct bmi323_sensorapi_data *data = dev->data;
+    struct bmi323_sensorapi_encoded_data *edata;
+    const uint32_t min_len = sizeof(struct bmi323_sensorapi_encoded_header) + BMI323_SENSORAPI_FRAME_SIZE;
+    uint8_t *buf;
+    uint32_t buf_len;
+    size_t i;
+    int ret;
+
+    for (i = 0; i < cfg->count; i++)
+    {
+        if ((cfg->channels[i].chan_type != SENSOR_CHAN_ACCEL_XYZ) &&
+            (cfg->channels[i].chan_type != SENSOR_CHAN_GYRO_XYZ) &&
+            (cfg->channels[i].chan_type != SENSOR_CHAN_ALL))
+        {
+            rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+            return;
+        }
+    }
+
+    ret = rtio_sqe_rx_buf(iodev_sqe, min_len, min_len, &buf, &buf_len);
+
+    if (ret != 0)
+    {
+        rtio_iodev_sqe_err(iodev_sqe, ret);
+        return;
+    }
+
+    edata = (struct bmi323_sensorapi_encoded_data *)buf;
+    edata->header.frame_count = 1;
+    edata->header.fifo_watermark = 0;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+
+    ret = read_ranges(data, &edata->header.acc_range, &edata->header.gyr_range);
+
+    if (ret == 0)
+    {
+        ret = read_frame(data, edata->frames, NULL);
+    }
+
+    k_mutex_unlock(&data->lock);
+
+    edata->header.timestamp_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+
+    if (ret != 0)
+    {
+        rtio_iodev_sqe_err(iodev_sqe, ret);
+        return;
+    }
+
+    rtio_iodev_sqe_ok(iodev_sqe, 0);
+}
+#endif
+
+#if defined(CONFIG_BMI323_SENSORAPI_STREAM)
+/*!
+ * @brief This internal function stores a stream request until the next FIFO watermark.
+ *
+ * @details
+ *      a stream request is multishot: once completed, RTIO submits it again and it lands here
+ *      again. only the FIFO watermark trigger is supported. the watermark interrupt is a level
+ *      that stays high while the FIFO is above the watermark, so if it is already high when
+ *      the request arrives (no request was pending at the edge), the FIFO is drained right away.
+ */
+static void submit_stream(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+    const struct sensor_read_config *cfg = iodev_sqe->sqe.iodev->data;
+    const struct bmi323_sensorapi_config *config = dev->config;
+    struct bmi323_sensorapi_data *data = dev->data;
+    size_t i;
+    int ret;
+
+    for (i = 0; i < cfg->count; i++)
+    {
+        if (cfg->triggers[i].trigger != SENSOR_TRIG_FIFO_WATERMARK)
+        {
+            rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+            return;
+        }
+    }
+
+    if (!data->stream_configured)
+    {
+        ret = stream_configure(dev);
+
+        if (ret != 0)
+        {
+            rtio_iodev_sqe_err(iodev_sqe, ret);
+            return;
+        }
+
+        data->stream_configured = true;
+    }
+
+    /* The work item takes the request under the same lock, it may be completing the previous one right now. */
+    k_mutex_lock(&data->lock, K_FOREVER);
+    data->stream_sqe = iodev_sqe;
+    k_mutex_unlock(&data->lock);
+
+    if (gpio_pin_get_dt(&config->int1) > 0)
+    {
+        k_work_submit(&data->fifo_work);
+    }
+}
+
+/*!
+ * @brief This internal function configures the FIFO and its watermark interrupt for streaming.
+ *
+ * @details
+ *      the ranges are read back once here, they cannot change without stopping the stream.
+ */
+static int stream_configure(const struct device *dev)
+{
+    const struct bmi323_sensorapi_config *config = dev->config;
+    struct bmi323_sensorapi_data *data = dev->data;
+
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    struct bmi3_int_pin_config int_cfg;
+    struct bmi3_map_int map_int = { 0 };
+    uint8_t flush[2] = { FIFO_CTRL_FLUSH, 0 };
+    int ret;
+
+    if (!gpio_is_ready_dt(&config->int1))
+    {
+        return -ENODEV;
+    }
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+
+    ret = read_ranges(data, &data->stream_acc_range, &data->stream_gyr_range);
+
+    rslt = (ret == 0) ? bmi323_set_fifo_config(BMI3_FIFO_ALL_EN, BMI3_DISABLE, &data->bmi) : BMI3_E_COM_FAIL;
+
+    if (rslt == BMI323_OK)
+    {
+        rslt = bmi323_set_fifo_config(FIFO_SENSORS, BMI3_ENABLE, &data->bmi);
+    }
+
+    /* The watermark register counts 16-bit words, not frames. */
+    if (rslt == BMI323_OK)
+    {
+        rslt = bmi323_set_fifo_wm((uint16_t)(CONFIG_BMI323_SENSORAPI_FIFO_WATERMARK_FRAMES *
+                                             (BMI323_SENSORAPI_FRAME_SIZE / 2U)), &data->bmi);
+    }
+
+    if (rslt == BMI323_OK)
+    {
+        rslt = bmi323_get_int_pin_config(&int_cfg, &data->bmi);
+    }
+
+    if (rslt == BMI323_OK)
+    {
+        int_cfg.pin_type = BMI3_INT1;
+        int_cfg.int_latch = BMI3_INT_LATCH_DIS;
+        int_cfg.pin_cfg[0].output_en = BMI3_INT_OUTPUT_ENABLE;
+        int_cfg.pin_cfg[0].od = BMI3_INT_PUSH_PULL;
+        int_cfg.pin_cfg[0].lvl = BMI3_INT_ACTIVE_HIGH;
+
+        rslt = bmi323_set_int_pin_config(&int_cfg, &data->bmi);
+    }
+
+    if (rslt == BMI323_OK)
+    {
+        map_int.fifo_watermark_int = BMI3_INT1;
+        rslt = bmi323_map_interrupt(map_int, &data->bmi);
+    }
+
+    if (rslt == BMI323_OK)
+    {
+        rslt = bmi323_set_regs(BMI3_REG_FIFO_CTRL, flush, sizeof(flush), &data->bmi);
+    }
+
+    k_mutex_unlock(&data->lock);
+
+    if (rslt != BMI323_OK)
+    {
+        return -EIO;
+    }
+
+    if (gpio_pin_configure_dt(&config->int1, GPIO_INPUT) < 0)
+    {
+        return -EIO;
+    }
+
+    gpio_init_callback(&data->int1_cb, int1_triggered, BIT(config->int1.pin));
+
+    if (gpio_add_callback_dt(&config->int1, &data->int1_cb) < 0)
+    {
+        return -EIO;
+    }
+
+    if (gpio_pin_interrupt_configure_dt(&config->int1, GPIO_INT_EDGE_TO_ACTIVE) < 0)
+    {
+        return -EIO;
+    }
+
+    return 0;
+}
+
+/*!
+ * @brief GPIOTE callback of the INT1 line, the FIFO cannot be read from an interrupt.
+ */
+static void int1_triggered(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins)
+{
+    struct bmi323_sensorapi_data *data = CONTAINER_OF(cb, struct bmi323_sensorapi_data, int1_cb);
+
+    k_work_submit(&data->fifo_work);
+}
+
+/*!
+ * @brief Work handler that drains the FIFO into the pending stream request.
+ *
+ * @details
+ *      only whole frames are read, in chunks that fit a single EasyDMA transfer. the frames are
+ *      copied as they are into the request buffer behind the header, nothing is decoded here.
+ */
+static void fifo_work_handler(struct k_work *work)
+{
+    struct bmi323_sensorapi_data *data = CONTAINER_OF(work, struct bmi323_sensorapi_data, fifo_work);
+    const struct bmi323_sensorapi_config *config = data->dev->config;
+    struct rtio_iodev_sqe *iodev_sqe;
+    const struct sensor_read_config *cfg;
+    struct bmi323_sensorapi_encoded_data *edata;
+    enum sensor_stream_data_opt opt = SENSOR_STREAM_DATA_NOP;
+    uint8_t chunk[BMI323_SENSORAPI_FRAME_SIZE * FIFO_CHUNK_FRAMES + 2U];
+    uint8_t fill[2];
+    uint8_t reg = BMI3_REG_FIFO_DATA;
+    uint8_t flush[2] = { FIFO_CTRL_FLUSH, 0 };
+    uint8_t *buf;
+    uint32_t buf_len;
+    uint16_t frames, done, n;
+    size_t i;
+    int ret;
+
+    /* Take the request and clear it in one step, a resubmit from the caller's thread must not be lost or completed twice. */
+    k_mutex_lock(&data->lock, K_FOREVER);
+    iodev_sqe = data->stream_sqe;
+    data->stream_sqe = NULL;
+    k_mutex_unlock(&data->lock);
+
+    if (iodev_sqe == NULL)
+    {
+        /* No consumer is waiting, the FIFO keeps the data until the next request arrives. */
+        return;
+    }
+
+    /* INCLUDE wins over DROP, which wins over NOP. */
+    cfg = iodev_sqe->sqe.iodev->data;
+    for (i = 0; i < cfg->count; i++)
+    {
+        if (cfg->triggers[i].opt == SENSOR_STREAM_DATA_INCLUDE)
+        {
+            opt = SENSOR_STREAM_DATA_INCLUDE;
+        }
+        else if ((cfg->triggers[i].opt == SENSOR_STREAM_DATA_DROP) && (opt == SENSOR_STREAM_DATA_NOP))
+        {
+            opt = SENSOR_STREAM_DATA_DROP;
+        }
+    }
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+
+    if (bmi323_get_regs(BMI3_REG_FIFO_FILL_LVL, fill, sizeof(fill), &data->bmi) != BMI323_OK)
+    {
+        k_mutex_unlock(&data->lock);
+        rtio_iodev_sqe_err(iodev_sqe, -EIO);
+        return;
+    }
+
+    frames = (uint16_t)(((sys_get_le16(fill) & FIFO_FILL_LEVEL_MASK) * 2U) / BMI323_SENSORAPI_FRAME_SIZE);
+
+    if (opt != SENSOR_STREAM_DATA_INCLUDE)
+    {
+        /* DROP empties the FIFO, NOP leaves it untouched. either way only the trigger is reported. */
+        if (opt == SENSOR_STREAM_DATA_DROP)
+        {
+            bmi323_set_regs(BMI3_REG_FIFO_CTRL, flush, sizeof(flush), &data->bmi);
+        }
+
+        frames = 0;
+    }
+
+    ret = rtio_sqe_rx_buf(iodev_sqe, sizeof(struct bmi323_sensorapi_encoded_header),
+                          sizeof(struct bmi323_sensorapi_encoded_header) + (frames * BMI323_SENSORAPI_FRAME_SIZE),
+                          &buf, &buf_len);
+
+    if (ret != 0)
+    {
+        k_mutex_unlock(&data->lock);
+        rtio_iodev_sqe_err(iodev_sqe, ret);
+        return;
+    }
+
+    edata = (struct bmi323_sensorapi_encoded_data *)buf;
+    frames = MIN(frames, (buf_len - sizeof(struct bmi323_sensorapi_encoded_header)) / BMI323_SENSORAPI_FRAME_SIZE);
+
+    /* The chunks bypass bmi323_get_regs(), the read bit of SPI is set here like the SensorAPI does. */
+    if (data->bmi.intf == BMI3_SPI_INTF)
+    {
+        reg |= BMI3_SPI_RD_MASK;
+    }
+
+    for (done = 0; done < frames; done += n)
+    {
+        n = MIN((uint16_t)(frames - done), FIFO_CHUNK_FRAMES);
+
+        if (config->bus_io->read(reg, chunk, (n * BMI323_SENSORAPI_FRAME_SIZE) + data->bmi.dummy_byte,
+                                 (void *)config) != BMI3_OK)
+        {
+            ret = -EIO;
+            break;
+        }
+
+        memcpy(&edata->frames[done * BMI323_SENSORAPI_FRAME_SIZE], &chunk[data->bmi.dummy_byte],
+               n * BMI323_SENSORAPI_FRAME_SIZE);
+    }
+
+    k_mutex_unlock(&data->lock);
+
+    edata->header.timestamp_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+    edata->header.frame_count = done;
+    edata->header.acc_range = data->stream_acc_range;
+    edata->header.gyr_range = data->stream_gyr_range;
+    edata->header.fifo_watermark = 1;
+
+    if (ret != 0)
+    {
+        rtio_iodev_sqe_err(iodev_sqe, -EIO);
+        return;
+    }
+
+    rtio_iodev_sqe_ok(iodev_sqe, 0);
+}
+#endif
+
+#if defined(CONFIG_BMI323_SENSORAPI_STREAM)
+#define BMI323_SENSORAPI_INT1(inst)     .int1 = GPIO_DT_SPEC_INST_GET(inst, int1_gpios),
+#else
+#define BMI323_SENSORAPI_INT1(inst)
+#endif
+
+/* Mode 0, MSB first, the BMI323 takes up to 10 MHz (the SPIM of the nRF52832 up to 8 MHz). */
+#define BMI323_SENSORAPI_SPI_OPERATION  (SPI_OP_MODE_MASTER | SPI_WORD_SET(8) | SPI_TRANSFER_MSB)
+
+/* The bus spec and the bus functions of an instance, from the bus its node sits on. */
+#define BMI323_SENSORAPI_BUS(inst)                                                          \
+    COND_CODE_1(DT_INST_ON_BUS(inst, spi),                                                  \
+                (.bus.spi = SPI_DT_SPEC_INST_GET(inst, BMI323_SENSORAPI_SPI_OPERATION, 0),  \
+                 .bus_io = &spi_bus_io,),                                                   \
+                (.bus.i2c = I2C_DT_SPEC_INST_GET(inst),                                     \
+                 .bus_io = &i2c_bus_io,))
+
+/* One config, one data and one device per 'bosch,bmi323-sensorapi' node of the devicetree. */
+#define BMI323_SENSORAPI_DEFINE(inst)                                                       \
+    static const struct bmi323_sensorapi_config bmi323_sensorapi_config_##inst = {         \
+        BMI323_SENSORAPI_BUS(inst)                                                          \
+        BMI323_SENSORAPI_INT1(inst)                                                         \
+    };                                                                                      \
+                                                                                            \
+    static struct bmi323_sensorapi_data bmi323_sensorapi_data_##inst;                      \
+                                                                                            \
+    SENSOR_DEVICE_DT_INST_DEFINE(inst, bmi323_sensorapi_init, NULL,                         \
+                                 &bmi323_sensorapi_data_##inst,                             \
+                                 &bmi323_sensorapi_config_##inst,                           \
+                                 POST_KERNEL, CONFIG_SENSOR_INIT_PRIORITY,                  \
+                                 &bmi323_sensorapi_api);
+
+DT_INST_FOREACH_STATUS_OKAY(BMI323_SENSORAPI_DEFINE)
@@ -0,0 +1,113 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   BMI323 sensor driver                                                                                        |
+ * |    @file           :   bmi323_sensorapi.h                                                                                          |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the Zephyr sensor driver of the BMI323 built on top of the Bosch SensorAPI               |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef BMI323_SENSORAPI_H_
+#define BMI323_SENSORAPI_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the 'struct device' type
+ */
+#include <zephyr/device.h>
+
+/**
+ * @reason: provide 'struct bmi3_dev'
+ */
+#include <bmi323.h>
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       struct bmi3_dev *bmi323_sensorapi_get_bmi3_dev(const struct device *dev);
+ *  \b Description                              :       get the Bosch SensorAPI instance of the sensor, the bus functions are already set up
+ *                                                      and bmi323_init() already succeeded when the kernel started (only the chip id
+ *                                                      was checked with CONFIG_BMI323_SENSORAPI_WARM_BOOT).
+ *  @param  dev [IN]                            :       the BMI323 device, e.g. DEVICE_DT_GET(DT_NODELABEL(bmi323)).
+ *  @note                                       :       the accel and gyro configuration can still be changed through the SensorAPI, the driver
+ *                                                      reads the ranges back from the sensor every time it starts a read or a stream.
+ *  \b PRE-CONDITION                            :       device_is_ready(dev) is true.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       the SensorAPI instance, it stays valid for the whole run time.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+struct bmi3_dev *bmi323_sensorapi_get_bmi3_dev(const struct device *dev);
+
+
+/**
+ *  \b function                                 :       int bmi323_sensorapi_reset(const struct device *dev);
+ *  \b Description                              :       soft-reset the sensor and start its feature engine again (bmi323_init()), every
+ *                                                      configuration is back at its default then.
+ *  @param  dev [IN]                            :       the BMI323 device.
+ *  @note                                       :       with CONFIG_BMI323_SENSORAPI_WARM_BOOT the driver does not reset the sensor when the
+ *                                                      kernel starts, the application calls this when the sensor did not keep the
+ *                                                      configuration it wants.
+ *  \b PRE-CONDITION                            :       device_is_ready(dev) is true, no read or stream is pending.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -EIO if the sensor did not come back.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_sensorapi_reset(const struct device *dev);
+
+
+/*** End of File **************************************************************/
+
+#endif /*BMI323_SENSORAPI_H_*/
@@ -0,0 +1,292 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#define DT_DRV_COMPAT bosch_bmi323_sensorapi
+
+#include <zephyr/kernel.h>
+
+// include the sensor driver API and the decoder types
+#include <zephyr/drivers/sensor.h>
+
+// include the sys_get_le16() helpers
+#include <zephyr/sys/byteorder.h>
+
+// include the BMI3_ACC_RANGE_x / BMI3_GYR_RANGE_x definitions
+#include <bmi323.h>
+
+#include "bmi323_sensorapi_decoder.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * SENSOR_DECODER_API_DT_DEFINE()   |   https://docs.zephyrproject.org/latest/hardware/peripherals/sensor/index.html
+ * struct sensor_decoder_api        |   https://docs.zephyrproject.org/latest/hardware/peripherals/sensor/index.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Micro units per unit, the ranges below are in um/s^2 and urad/s. */
+#define MICRO                   (1000000LL)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! Accel ranges in um/s^2, indexed by BMI3_ACC_RANGE_x (2, 4, 8 and 16 g). */
+static const uint32_t acc_range_micro[] = {
+    [BMI3_ACC_RANGE_2G] = 19613300UL,
+    [BMI3_ACC_RANGE_4G] = 39226600UL,
+    [BMI3_ACC_RANGE_8G] = 78453200UL,
+    [BMI3_ACC_RANGE_16G] = 156906400UL,
+};
+
+/*! Gyro ranges in urad/s, indexed by BMI3_GYR_RANGE_x (125, 250, 500, 1000 and 2000 dps). */
+static const uint32_t gyr_range_micro[] = {
+    [BMI3_GYR_RANGE_125DPS] = 2181662UL,
+    [BMI3_GYR_RANGE_250DPS] = 4363323UL,
+    [BMI3_GYR_RANGE_500DPS] = 8726646UL,
+    [BMI3_GYR_RANGE_1000DPS] = 17453293UL,
+    [BMI3_GYR_RANGE_2000DPS] = 34906585UL,
+};
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function gives the smallest shift whose q31 range covers 'range_micro'.
+ */
+static int8_t range_shift(uint32_t range_micro);
+
+/*!
+ *  @brief This internal function converts a sensor time difference into nanoseconds.
+ */
+static uint32_t ticks_to_ns(uint16_t ticks);
+
+/*!
+ *  @brief This internal function reads one 16-bit word of a frame.
+ */
+static uint16_t frame_word(const struct bmi323_sensorapi_encoded_data *edata, uint16_t frame, uint8_t word);
+
+/*!
+ *  @brief This internal function tells a dummy frame of the FIFO, it holds no reading.
+ */
+static bool frame_is_dummy(const struct bmi323_sensorapi_encoded_data *edata, uint16_t frame);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+/*!
+ * @brief 'get_frame_count' entry of the decoder, every frame holds one accel and one gyro reading.
+ */
+static int decoder_get_frame_count(const uint8_t *buffer, struct sensor_chan_spec chan_spec, uint16_t *frame_count)
+{
+    const struct bmi323_sensorapi_encoded_data *edata = (const struct bmi323_sensorapi_encoded_data *)buffer;
+
+    if (chan_spec.chan_idx != 0)
+    {
+        return -ENOTSUP;
+    }
+
+    switch (chan_spec.chan_type)
+    {
+        case SENSOR_CHAN_ACCEL_XYZ:
+        case SENSOR_CHAN_GYRO_XYZ:
+            *frame_count = edata->header.frame_count;
+            return 0;
+        default:
+            return -ENOTSUP;
+    }
+}
+
+/*!
+ * @brief 'get_size_info' entry of the decoder.
+ */
+static int decoder_get_size_info(struct sensor_chan_spec chan_spec, size_t *base_size, size_t *frame_size)
+{
+    switch (chan_spec.chan_type)
+    {
+        case SENSOR_CHAN_ACCEL_XYZ:
+        case SENSOR_CHAN_GYRO_XYZ:
+            *base_size = sizeof(struct sensor_three_axis_data);
+            *frame_size = sizeof(struct sensor_three_axis_sample_data);
+            return 0;
+        default:
+            return -ENOTSUP;
+    }
+}
+
+/*!
+ * @brief 'decode' entry of the decoder.
+ *
+ * @details
+ *      the raw value is a Q15 fraction of the range, so with the range in micro units:
+ *          value_q31 = raw * range * 2^(31 - shift) / (2^15 * 10^6) = raw * range * 2^(16 - shift) / 10^6
+ *      for every range the product stays below 2^51, far from the int64_t limit.
+ *      the timestamps come from the sensor time of every frame, relative to the last frame which was
+ *      read at 'timestamp_ns', so they do not carry the jitter of the interrupt and the bus. dummy
+ *      frames are skipped in both channels like bmi3_extract_accel() / bmi3_extract_gyro() do, so
+ *      accel and gyro still hand out the same frames.
+ */
+static int decoder_decode(const uint8_t *buffer, struct sensor_chan_spec chan_spec, uint32_t *fit,
+                          uint16_t max_count, void *data_out)
+{
+    const struct bmi323_sensorapi_encoded_data *edata = (const struct bmi323_sensorapi_encoded_data *)buffer;
+    struct sensor_three_axis_data *out = (struct sensor_three_axis_data *)data_out;
+    uint16_t frame_count = edata->header.frame_count;
+    uint16_t last;
+    uint32_t range_micro;
+    uint16_t first_time, last_time, time;
+    uint8_t word;
+    uint8_t axis;
+    uint16_t count = 0;
+
+    if ((chan_spec.chan_idx != 0) || (*fit >= frame_count))
+    {
+        return 0;
+    }
+
+    switch (chan_spec.chan_type)
+    {
+        case SENSOR_CHAN_ACCEL_XYZ:
+            if (edata->header.acc_range >= ARRAY_SIZE(acc_range_micro))
+            {
+                return -EINVAL;
+            }
+            range_micro = acc_range_micro[edata->header.acc_range];
+            word = BMI323_SENSORAPI_FRAME_ACC_X;
+            break;
+        case SENSOR_CHAN_GYRO_XYZ:
+            if (edata->header.gyr_range >= ARRAY_SIZE(gyr_range_micro))
+            {
+                return -EINVAL;
+            }
+            range_micro = gyr_range_micro[edata->header.gyr_range];
+            word = BMI323_SENSORAPI_FRAME_GYR_X;
+            break;
+        default:
+            return -ENOTSUP;
+    }
+
+    out->shift = range_shift(range_micro);
+
+    while ((*fit < frame_count) && frame_is_dummy(edata, (uint16_t)*fit))
+    {
+        (*fit)++;
+    }
+
+    if (*fit >= frame_count)
+    {
+        return 0;
+    }
+
+    /* The frame at '*fit' is a reading, the search stops there at the latest. */
+    last = frame_count - 1U;
+    while (frame_is_dummy(edata, last))
+    {
+        last--;
+    }
+
+    first_time = frame_word(edata, (uint16_t)*fit, BMI323_SENSORAPI_FRAME_TIME);
+    last_time = frame_word(edata, last, BMI323_SENSORAPI_FRAME_TIME);
+
+    out->header.base_timestamp_ns = edata->header.timestamp_ns - ticks_to_ns((uint16_t)(last_time - first_time));
+
+    while ((count < max_count) && (*fit < frame_count))
+    {
+        if (frame_is_dummy(edata, (uint16_t)*fit))
+        {
+            (*fit)++;
+            continue;
+        }
+
+        time = frame_word(edata, (uint16_t)*fit, BMI323_SENSORAPI_FRAME_TIME);
+        out->readings[count].timestamp_delta = ticks_to_ns((uint16_t)(time - first_time));
+
+        for (axis = 0; axis < 3U; axis++)
+        {
+            int16_t raw = (int16_t)frame_word(edata, (uint16_t)*fit, word + axis);
+
+            out->readings[count].values[axis] =
+                (q31_t)(((int64_t)raw * range_micro * (1LL << (16 - out->shift))) / MICRO);
+        }
+
+        count++;
+        (*fit)++;
+    }
+
+    out->header.reading_count = count;
+
+    return count;
+}
+
+/*!
+ * @brief 'has_trigger' entry of the decoder.
+ */
+static bool decoder_has_trigger(const uint8_t *buffer, enum sensor_trigger_type trigger)
+{
+    const struct bmi323_sensorapi_encoded_data *edata = (const struct bmi323_sensorapi_encoded_data *)buffer;
+
+    return (trigger == SENSOR_TRIG_FIFO_WATERMARK) && (edata->header.fifo_watermark != 0);
+}
+
+SENSOR_DECODER_API_DT_DEFINE() = {
+    .get_frame_count = decoder_get_frame_count,
+    .get_size_info = decoder_get_size_info,
+    .decode = decoder_decode,
+    .has_trigger = decoder_has_trigger,
+};
+
+int bmi323_sensorapi_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder)
+{
+    ARG_UNUSED(dev);
+
+    *decoder = &SENSOR_DECODER_NAME();
+
+    return 0;
+}
+
+/*!
+ * @brief This internal function gives the smallest shift whose q31 range covers 'range_micro'.
+ */
+static int8_t range_shift(uint32_t range_micro)
+{
+    int8_t shift = 0;
+
+    while ((MICRO << shift) <= (int64_t)range_micro)
+    {
+        shift++;
+    }
+
+    return shift;
+}
+
+/*!
+ * @brief This internal function converts a sensor time difference into nanoseconds.
+ *
+ * @details
+ *      a stream buffer never spans more than the 2.56 s the 16-bit sensor time needs to wrap,
+ *      so the result always fits in 32 bits.
+ */
+static uint32_t ticks_to_ns(uint16_t ticks)
+{
+    return (uint32_t)(((uint64_t)ticks * BMI323_SENSORAPI_TIME_TICK_NS_NUM) / BMI323_SENSORAPI_TIME_TICK_NS_DEN);
+}
+
+/*!
+ * @brief This internal function reads one 16-bit word of a frame.
+ */
+static uint16_t frame_word(const struct bmi323_sensorapi_encoded_data *edata, uint16_t frame, uint8_t word)
+{
+    return sys_get_le16(&edata->frames[(frame * BMI323_SENSORAPI_FRAME_SIZE) + (word * 2U)]);
+}
+
+/*!
+ * @brief This internal function tells a dummy frame of the FIFO.
+ */
+static bool frame_is_dummy(const struct bmi323_sensorapi_encoded_data *edata, uint16_t frame)
+{
+    return (frame_word(edata, frame, BMI323_SENSORAPI_FRAME_ACC_X) == BMI323_SENSORAPI_FRAME_ACC_DUMMY) ||
+           (frame_word(edata, frame, BMI323_SENSORAPI_FRAME_GYR_X) == BMI323_SENSORAPI_FRAME_GYR_DUMMY);
+}
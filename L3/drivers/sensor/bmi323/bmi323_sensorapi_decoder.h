@@ -0,0 +1,151 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   BMI323 sensor driver decoder                                                                                |
+ * |    @file           :   bmi323_sensorapi_decoder.h                                                                                  |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the encoded buffer format of the BMI323 driver and its q31_t decoder                     |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef BMI323_SENSORAPI_DECODER_H_
+#define BMI323_SENSORAPI_DECODER_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the sensor decoder API types
+ */
+#include <zephyr/drivers/sensor.h>
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * a frame is the raw content of one FIFO frame with accel, gyro and sensor time enabled, little-endian:
+ *
+ *      | acc x | acc y | acc z | gyr x | gyr y | gyr z | sensor time [15:0] |      (7 x 16 bits)
+ *
+ * a one-shot read is stored in the same layout, so the decoder has a single path.
+ */
+#define BMI323_SENSORAPI_FRAME_SIZE         (14U)
+
+/**
+ * word offsets inside a frame
+ */
+#define BMI323_SENSORAPI_FRAME_ACC_X        (0U)
+#define BMI323_SENSORAPI_FRAME_GYR_X        (3U)
+#define BMI323_SENSORAPI_FRAME_TIME         (6U)
+
+/**
+ * first word of the accel / gyro part of a frame the FIFO returns in place of data it does not have (dummy frame),
+ * refer to the 'FIFO' section in the datasheet
+ */
+#define BMI323_SENSORAPI_FRAME_ACC_DUMMY    (0x7F01U)
+#define BMI323_SENSORAPI_FRAME_GYR_DUMMY    (0x7F02U)
+
+/**
+ * the sensor time counts in steps of 39.0625 us, 78125 / 2 ns
+ */
+#define BMI323_SENSORAPI_TIME_TICK_NS_NUM   (78125U)
+#define BMI323_SENSORAPI_TIME_TICK_NS_DEN   (2U)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: bmi323_sensorapi_encoded_header
+ * @brief: header in front of the raw frames of every read or stream buffer, the frames stay raw until a consumer
+ *         decodes them, so no conversion is paid for samples that are never looked at
+ */
+struct bmi323_sensorapi_encoded_header {
+    uint64_t timestamp_ns;      /**< system time the last frame was read at */
+    uint16_t frame_count;       /**< number of frames following the header */
+    uint8_t acc_range;          /**< BMI3_ACC_RANGE_x the frames were sampled with */
+    uint8_t gyr_range;          /**< BMI3_GYR_RANGE_x the frames were sampled with */
+    uint8_t fifo_watermark;     /**< 1 if the buffer was produced by a FIFO watermark interrupt */
+    uint8_t reserved[3];
+};
+
+/**
+ * @struct: bmi323_sensorapi_encoded_data
+ * @brief: a read or stream buffer, 'frames' holds frame_count * BMI323_SENSORAPI_FRAME_SIZE bytes
+ */
+struct bmi323_sensorapi_encoded_data {
+    struct bmi323_sensorapi_encoded_header header;
+    uint8_t frames[];
+};
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int bmi323_sensorapi_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder);
+ *  \b Description                              :       'get_decoder' entry of the driver API, the decoder turns the raw frames into q31_t
+ *                                                      values (m/s^2 for accel, rad/s for gyro).
+ *  @param  dev [IN]                            :       the BMI323 device.
+ *  @param  decoder [OUT]                       :       receives the decoder.
+ *  @note                                       :       the frame iterator ('fit') of the decoder is the index of the next frame to decode.
+ *                                                      only SENSOR_CHAN_ACCEL_XYZ and SENSOR_CHAN_GYRO_XYZ can be decoded.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_sensorapi_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder);
+
+
+/*** End of File **************************************************************/
+
+#endif /*BMI323_SENSORAPI_DECODER_H_*/
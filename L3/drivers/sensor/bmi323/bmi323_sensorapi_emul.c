@@ -0,0 +1,850 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#define DT_DRV_COMPAT bosch_bmi323_sensorapi
+
+#include <zephyr/kernel.h>
+
+#include <string.h>
+
+// include the emulator framework and the I2C emulated bus
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+
+// include the emulated GPIO, the INT1 line is driven through it
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+
+#if defined(CONFIG_BMI323_SENSORAPI_EMUL_REPLAY)
+// the recording is read by the host side of native_sim, refer to 'bmi323_emul_replay_native.c'
+#include "bmi323_emul_replay_native.h"
+#endif
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * EMUL_DT_INST_DEFINE()            |   https://docs.zephyrproject.org/latest/hardware/emulator/index.html
+ * struct i2c_emul_api              |   https://docs.zephyrproject.org/latest/hardware/emulator/index.html
+ * gpio_emul_input_set()            |   https://docs.zephyrproject.org/latest/doxygen/html/group__gpio__emul.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Registers of the BMI323 that are emulated, every register is 16 bits wide. */
+#define REG_CHIP_ID             (0x00U)
+#define REG_STATUS              (0x02U)
+#define REG_ACC_DATA_X          (0x03U)
+#define REG_GYR_DATA_X          (0x06U)
+#define REG_TEMP_DATA           (0x09U)
+#define REG_SENSOR_TIME_0       (0x0AU)
+#define REG_SENSOR_TIME_1       (0x0BU)
+#define REG_INT_STATUS_INT1     (0x0DU)
+#define REG_FEATURE_IO1         (0x11U)
+#define REG_FIFO_FILL_LEVEL     (0x15U)
+#define REG_FIFO_DATA           (0x16U)
+#define REG_ACC_CONF            (0x20U)
+#define REG_GYR_CONF            (0x21U)
+#define REG_FIFO_WATERMARK      (0x35U)
+#define REG_FIFO_CONF           (0x36U)
+#define REG_FIFO_CTRL           (0x37U)
+#define REG_IO_INT_CTRL         (0x38U)
+#define REG_INT_CONF            (0x39U)
+#define REG_INT_MAP2            (0x3BU)
+#define REG_FEATURE_CTRL        (0x40U)
+#define REG_CMD                 (0x7EU)
+#define REG_COUNT               (0x80U)
+
+#define CHIP_ID                 (0x0043U)
+#define CMD_SOFT_RESET          (0xDEAFU)
+
+/*! Reset values that are not 0. */
+#define ACC_CONF_RESET          (0x0028U)
+#define GYR_CONF_RESET          (0x0048U)
+#define FIFO_CONF_RESET         (0x0001U)
+
+/*! STATUS and INT_STATUS_INT1 bits. */
+#define STATUS_DRDY_ACC         (0x0080U)
+#define STATUS_DRDY_GYR         (0x0040U)
+#define STATUS_DRDY_TEMP        (0x0020U)
+#define INT_STATUS_FFULL        (0x8000U)
+#define INT_STATUS_FWM          (0x4000U)
+#define INT_STATUS_ACC_DRDY     (0x2000U)
+#define INT_STATUS_GYR_DRDY     (0x1000U)
+#define INT_STATUS_TEMP_DRDY    (0x0800U)
+
+/*! Fields of ACC_CONF / GYR_CONF, FIFO_CONF and INT_MAP2. */
+#define CONF_ODR_MASK           (0x000FU)
+#define CONF_RANGE_POS          (4U)
+#define CONF_RANGE_MASK         (0x07U)
+#define CONF_MODE_POS           (12U)
+#define CONF_MODE_MASK          (0x07U)
+#define FIFO_CONF_STOP_ON_FULL  (0x0001U)
+#define FIFO_CONF_TIME_EN       (0x0100U)
+#define FIFO_CONF_ACC_EN        (0x0200U)
+#define FIFO_CONF_GYR_EN        (0x0400U)
+#define FIFO_CONF_TEMP_EN       (0x0800U)
+#define FIFO_CTRL_FLUSH         (0x0001U)
+#define INT_MAP2_GYR_DRDY_POS   (8U)
+#define INT_MAP2_ACC_DRDY_POS   (10U)
+#define INT_MAP2_FWM_POS        (12U)
+#define INT_MAP2_FFULL_POS      (14U)
+#define INT_MAP_INT1            (0x01U)
+#define IO_INT_CTRL_INT1_LVL    (0x0001U)
+#define IO_INT_CTRL_INT1_OE     (0x0004U)
+
+/*! The FIFO holds 2 KB, it returns this word when it is read empty. */
+#define FIFO_WORDS              (1024U)
+#define FIFO_EMPTY_WORD         (0x8000U)
+
+/*! Over I2C every read starts with 2 dummy bytes. */
+#define DUMMY_BYTES             (2U)
+
+/*! The sensor time counts in steps of 39.0625 us (25600 Hz). */
+#define SENSOR_TIME_HZ          (25600U)
+
+/*! ODR code 8 is 100 Hz, every step doubles or halves it. */
+#define ODR_CODE_100HZ          (8U)
+
+/*! Synthetic motion: one turn per second, +/-0.25 g of tilt on x/y, 1 g on z, 90 dps around z. */
+#define MOTION_STEPS            (64U)
+#define MOTION_TILT_MG          (250)
+#define MOTION_RATE_DPS         (90)
+
+/******************************************************************************/
+/*!         Typedefs                                                          */
+
+/*! Devicetree configuration of one emulated sensor. */
+struct bmi323_emul_cfg {
+    struct gpio_dt_spec int1;
+};
+
+/*! State of one emulated sensor. */
+struct bmi323_emul_data {
+    const struct emul *emul;
+    struct k_spinlock lock;
+    struct k_timer sample_timer;
+
+    uint16_t regs[REG_COUNT];
+
+    /* Register selected by the last write, a read in a transfer of its own (stop, then start) continues there. */
+    uint8_t reg_ptr;
+
+    uint16_t fifo[FIFO_WORDS];
+    uint16_t fifo_head;
+    uint16_t fifo_count;
+
+    /* Sensor time and its increment per expiry of the sample timer, which runs at the faster ODR. */
+    uint32_t sensor_time;
+    uint32_t period_ticks;
+
+    /* Accel and gyro produce a sample every 'div' expiries (0 while suspended), 'tick' counts the expiries. */
+    uint16_t acc_div;
+    uint16_t gyr_div;
+    uint32_t tick;
+
+    /* A sample is waiting in the data registers, cleared when ACC_DATA_X / GYR_DATA_X is read. */
+    bool acc_drdy_pending;
+    bool gyr_drdy_pending;
+
+    /* Level of the INT1 line, and the time it last became active. */
+    bool int1_active;
+    uint32_t int1_active_cycles;
+    bool latency_armed;
+
+    /* Statistics, printed every CONFIG_BMI323_SENSORAPI_EMUL_STATS_PERIOD_MS. */
+    uint32_t generated;
+    uint32_t unread;
+    uint32_t fifo_overflows;
+    uint32_t latency_count;
+    uint64_t latency_sum_cycles;
+    uint32_t latency_max_cycles;
+};
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! One period of a sine, Q15. */
+static const int16_t sine_q15[MOTION_STEPS] = {
+         0,   3212,   6393,   9512,  12539,  15446,  18204,  20787,
+     23170,  25329,  27245,  28898,  30273,  31356,  32137,  32609,
+     32767,  32609,  32137,  31356,  30273,  28898,  27245,  25329,
+     23170,  20787,  18204,  15446,  12539,   9512,   6393,   3212,
+         0,  -3212,  -6393,  -9512, -12539, -15446, -18204, -20787,
+    -23170, -25329, -27245, -28898, -30273, -31356, -32137, -32609,
+    -32767, -32609, -32137, -31356, -30273, -28898, -27245, -25329,
+    -23170, -20787, -18204, -15446, -12539,  -9512,  -6393,  -3212,
+};
+
+/*! Accel ranges in g and gyro ranges in dps, indexed by the range field of ACC_CONF / GYR_CONF. */
+static const uint16_t acc_range_g[] = { 2, 4, 8, 16 };
+static const uint16_t gyr_range_dps[] = { 125, 250, 500, 1000, 2000 };
+
+#if (CONFIG_BMI323_SENSORAPI_EMUL_STATS_PERIOD_MS > 0)
+static void stats_timer_expired(struct k_timer *timer);
+K_TIMER_DEFINE(stats_timer, stats_timer_expired, NULL);
+static struct bmi323_emul_data *stats_data;
+#endif
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function puts every register back to its reset value.
+ */
+static void reset_regs(struct bmi323_emul_data *data);
+
+/*!
+ *  @brief This internal function returns a register for a read and applies its read side effects.
+ */
+static uint16_t reg_read(struct bmi323_emul_data *data, uint8_t reg);
+
+/*!
+ *  @brief This internal function writes a register and applies its write side effects.
+ */
+static void reg_write(struct bmi323_emul_data *data, uint8_t reg, uint16_t value);
+
+/*!
+ *  @brief This internal function (re)starts the sample timer at the faster ODR of ACC_CONF and GYR_CONF, or stops it.
+ */
+static void update_odr(struct bmi323_emul_data *data);
+
+/*!
+ *  @brief This internal function computes the raw accel and gyro values of the current sample.
+ */
+static void next_motion(struct bmi323_emul_data *data, int16_t *axes);
+
+/*!
+ *  @brief This internal function appends the enabled words of the current sample to the FIFO.
+ */
+static void fifo_push_frame(struct bmi323_emul_data *data);
+
+/*!
+ *  @brief This internal function computes the level of INT1 from the interrupt sources mapped to it.
+ */
+static bool int1_level(struct bmi323_emul_data *data);
+
+/*!
+ *  @brief This internal function drives the emulated GPIO of INT1, called without the lock held.
+ */
+static void drive_int1(const struct emul *target, bool active);
+
+/*!
+ *  @brief Expiry function of the sample timer, produces one sample at the ODR.
+ */
+static void sample_timer_expired(struct k_timer *timer);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+/*!
+ * @brief 'transfer' entry of the I2C emulator API.
+ *
+ * @details
+ *      the first byte written in a transfer selects the register, the next written bytes are
+ *      16-bit little-endian register values. a read returns the 2 dummy bytes of the I2C
+ *      interface first, then the registers from the selected one on. FIFO_DATA is not
+ *      incremented, every word read from it pops the FIFO. the register pointer outlives the
+ *      transfer, as on the sensor, so the address and the data may also come with a stop between.
+ */
+static int bmi323_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs, int addr)
+{
+    struct bmi323_emul_data *data = target->data;
+    k_spinlock_key_t key;
+    bool reg_selected = false;
+    uint8_t reg;
+    uint16_t word = 0;
+    uint32_t byte_idx = 0;
+    uint32_t i;
+    bool active;
+    int m;
+
+    ARG_UNUSED(addr);
+
+    key = k_spin_lock(&data->lock);
+
+    reg = data->reg_ptr;
+
+    for (m = 0; m < num_msgs; m++)
+    {
+        if ((msgs[m].flags & I2C_MSG_RW_MASK) == I2C_MSG_WRITE)
+        {
+            for (i = 0; i < msgs[m].len; i++)
+            {
+                if (!reg_selected)
+                {
+                    reg = msgs[m].buf[i] & (REG_COUNT - 1U);
+                    reg_selected = true;
+                    byte_idx = 0;
+                    continue;
+                }
+
+                if ((byte_idx & 1U) == 0U)
+                {
+                    word = msgs[m].buf[i];
+                }
+                else
+                {
+                    word |= (uint16_t)msgs[m].buf[i] << 8;
+                    reg_write(data, reg, word);
+                    reg = (reg + 1U) & (REG_COUNT - 1U);
+                }
+
+                byte_idx++;
+            }
+        }
+        else
+        {
+            for (i = 0; i < msgs[m].len; i++)
+            {
+                if (i < DUMMY_BYTES)
+                {
+                    msgs[m].buf[i] = 0;
+                    continue;
+                }
+
+                if (((i - DUMMY_BYTES) & 1U) == 0U)
+                {
+                    word = reg_read(data, reg);
+                    msgs[m].buf[i] = (uint8_t)word;
+                }
+                else
+                {
+                    msgs[m].buf[i] = (uint8_t)(word >> 8);
+
+                    if (reg != REG_FIFO_DATA)
+                    {
+                        reg = (reg + 1U) & (REG_COUNT - 1U);
+                    }
+                }
+            }
+        }
+    }
+
+    data->reg_ptr = reg;
+
+    active = int1_level(data);
+
+    k_spin_unlock(&data->lock, key);
+
+    drive_int1(target, active);
+
+    return 0;
+}
+
+static const struct i2c_emul_api bmi323_emul_api_i2c = {
+    .transfer = bmi323_emul_transfer,
+};
+
+/*!
+ * @brief Init function of the emulator, the sensor starts as after a power-on reset.
+ */
+static int bmi323_emul_init(const struct emul *target, const struct device *parent)
+{
+    struct bmi323_emul_data *data = target->data;
+
+    ARG_UNUSED(parent);
+
+    data->emul = target;
+    k_timer_init(&data->sample_timer, sample_timer_expired, NULL);
+    reset_regs(data);
+
+#if defined(CONFIG_BMI323_SENSORAPI_EMUL_REPLAY)
+    if (bmi323_emul_replay_native_open(CONFIG_BMI323_SENSORAPI_EMUL_REPLAY_FILE) != 0)
+    {
+        printk("bmi323 emul: cannot open %s, using synthetic motion\n\r", CONFIG_BMI323_SENSORAPI_EMUL_REPLAY_FILE);
+    }
+#endif
+
+#if (CONFIG_BMI323_SENSORAPI_EMUL_STATS_PERIOD_MS > 0)
+    stats_data = data;
+    k_timer_start(&stats_timer, K_MSEC(CONFIG_BMI323_SENSORAPI_EMUL_STATS_PERIOD_MS),
+                  K_MSEC(CONFIG_BMI323_SENSORAPI_EMUL_STATS_PERIOD_MS));
+#endif
+
+    return 0;
+}
+
+/*!
+ * @brief This internal function puts every register back to its reset value.
+ */
+static void reset_regs(struct bmi323_emul_data *data)
+{
+    memset(data->regs, 0, sizeof(data->regs));
+
+    data->regs[REG_CHIP_ID] = CHIP_ID;
+    data->regs[REG_ACC_CONF] = ACC_CONF_RESET;
+    data->regs[REG_GYR_CONF] = GYR_CONF_RESET;
+    data->regs[REG_FIFO_CONF] = FIFO_CONF_RESET;
+
+    data->fifo_head = 0;
+    data->fifo_count = 0;
+    data->acc_drdy_pending = false;
+    data->gyr_drdy_pending = false;
+    data->acc_div = 0;
+    data->gyr_div = 0;
+    data->latency_armed = false;
+
+    k_timer_stop(&data->sample_timer);
+}
+
+/*!
+ * @brief This internal function returns a register for a read and applies its read side effects.
+ *
+ * @details
+ *      STATUS and INT_STATUS_INT1 are cleared on read. reading ACC_DATA_X or GYR_DATA_X releases the
+ *      non-latched data-ready interrupt of that sensor, and closes the latency measurement started when
+ *      INT1 became active.
+ */
+static uint16_t reg_read(struct bmi323_emul_data *data, uint8_t reg)
+{
+    uint16_t value;
+    uint32_t latency;
+
+    switch (reg)
+    {
+        case REG_STATUS:
+        case REG_INT_STATUS_INT1:
+            value = data->regs[reg];
+            data->regs[reg] = 0;
+            return value;
+
+        case REG_FIFO_FILL_LEVEL:
+            return data->fifo_count;
+
+        case REG_FIFO_DATA:
+            if (data->fifo_count == 0)
+            {
+                value = FIFO_EMPTY_WORD;
+            }
+            else
+            {
+                value = data->fifo[data->fifo_head];
+                data->fifo_head = (data->fifo_head + 1U) % FIFO_WORDS;
+                data->fifo_count--;
+            }
+            break;
+
+        case REG_ACC_DATA_X:
+            data->acc_drdy_pending = false;
+            value = data->regs[reg];
+            break;
+
+        case REG_GYR_DATA_X:
+            data->gyr_drdy_pending = false;
+            value = data->regs[reg];
+            break;
+
+        default:
+            return data->regs[reg];
+    }
+
+    if (data->latency_armed)
+    {
+        latency = k_cycle_get_32() - data->int1_active_cycles;
+
+        data->latency_count++;
+        data->latency_sum_cycles += latency;
+        data->latency_max_cycles = MAX(data->latency_max_cycles, latency);
+        data->latency_armed = false;
+    }
+
+    return value;
+}
+
+/*!
+ * @brief This internal function writes a register and applies its write side effects.
+ *
+ * @details
+ *      the feature engine of the real sensor is not emulated, enabling it only reports it as
+ *      active in FEATURE_IO1, which is what bmi323_init() waits for.
+ */
+static void reg_write(struct bmi323_emul_data *data, uint8_t reg, uint16_t value)
+{
+    switch (reg)
+    {
+        case REG_CHIP_ID:
+        case REG_STATUS:
+        case REG_INT_STATUS_INT1:
+        case REG_FIFO_FILL_LEVEL:
+        case REG_FIFO_DATA:
+            /* Read only. */
+            break;
+
+        case REG_CMD:
+            if (value == CMD_SOFT_RESET)
+            {
+                reset_regs(data);
+            }
+            break;
+
+        case REG_FEATURE_CTRL:
+            data->regs[reg] = value;
+            data->regs[REG_FEATURE_IO1] = (value & 0x0001U) ? 0x0001U : 0x0000U;
+            break;
+
+        case REG_FIFO_CTRL:
+            if (value & FIFO_CTRL_FLUSH)
+            {
+                data->fifo_head = 0;
+                data->fifo_count = 0;
+            }
+            break;
+
+        case REG_ACC_CONF:
+        case REG_GYR_CONF:
+            data->regs[reg] = value;
+            update_odr(data);
+            break;
+
+        default:
+            data->regs[reg] = value;
+            break;
+    }
+}
+
+/*!
+ * @brief This internal function (re)starts the sample timer at the faster ODR of ACC_CONF and GYR_CONF, or stops it.
+ *
+ * @details
+ *      ODR code 8 is 100 Hz and every code up or down doubles or halves it, so the slower sensor
+ *      produces a sample every 2^(difference of the codes) expiries. a suspended sensor (mode 0)
+ *      produces none.
+ */
+static void update_odr(struct bmi323_emul_data *data)
+{
+    uint16_t acc_conf = data->regs[REG_ACC_CONF];
+    uint16_t gyr_conf = data->regs[REG_GYR_CONF];
+    uint8_t acc_odr = (((acc_conf >> CONF_MODE_POS) & CONF_MODE_MASK) != 0U) ? (acc_conf & CONF_ODR_MASK) : 0U;
+    uint8_t gyr_odr = (((gyr_conf >> CONF_MODE_POS) & CONF_MODE_MASK) != 0U) ? (gyr_conf & CONF_ODR_MASK) : 0U;
+    uint8_t odr = MAX(acc_odr, gyr_odr);
+    uint64_t period_us;
+
+    if (odr == 0U)
+    {
+        k_timer_stop(&data->sample_timer);
+        return;
+    }
+
+    data->acc_div = (acc_odr != 0U) ? (uint16_t)BIT(odr - acc_odr) : 0U;
+    data->gyr_div = (gyr_odr != 0U) ? (uint16_t)BIT(odr - gyr_odr) : 0U;
+    data->tick = 0;
+
+    if (odr >= ODR_CODE_100HZ)
+    {
+        period_us = 10000ULL >> (odr - ODR_CODE_100HZ);
+    }
+    else
+    {
+        period_us = 10000ULL << (ODR_CODE_100HZ - odr);
+    }
+
+    data->period_ticks = (uint32_t)((period_us * SENSOR_TIME_HZ) / 1000000ULL);
+
+    k_timer_start(&data->sample_timer, K_USEC(period_us), K_USEC(period_us));
+}
+
+/*!
+ * @brief This internal function computes the raw accel and gyro values of the current sample.
+ *
+ * @details
+ *      the synthetic motion only depends on the sensor time, so it looks the same at every ODR
+ *      and range. a replayed recording is used as it is, it has to be recorded with the same ranges.
+ */
+static void next_motion(struct bmi323_emul_data *data, int16_t *axes)
+{
+    uint8_t acc_range = (data->regs[REG_ACC_CONF] >> CONF_RANGE_POS) & CONF_RANGE_MASK;
+    uint8_t gyr_range = (data->regs[REG_GYR_CONF] >> CONF_RANGE_POS) & CONF_RANGE_MASK;
+    int32_t lsb_per_g = 32768 / acc_range_g[MIN(acc_range, ARRAY_SIZE(acc_range_g) - 1U)];
+    int32_t lsb_per_dps = 32768 / gyr_range_dps[MIN(gyr_range, ARRAY_SIZE(gyr_range_dps) - 1U)];
+    uint32_t step = (uint32_t)(((uint64_t)data->sensor_time * MOTION_STEPS) / SENSOR_TIME_HZ) % MOTION_STEPS;
+    int32_t sin_q15 = sine_q15[step];
+    int32_t cos_q15 = sine_q15[(step + (MOTION_STEPS / 4U)) % MOTION_STEPS];
+
+#if defined(CONFIG_BMI323_SENSORAPI_EMUL_REPLAY)
+    if (bmi323_emul_replay_native_next(axes) == 0)
+    {
+        return;
+    }
+#endif
+
+    axes[0] = (int16_t)(((int64_t)sin_q15 * MOTION_TILT_MG * lsb_per_g) / (32768LL * 1000LL));
+    axes[1] = (int16_t)(((int64_t)cos_q15 * MOTION_TILT_MG * lsb_per_g) / (32768LL * 1000LL));
+    axes[2] = (int16_t)lsb_per_g;
+    axes[3] = 0;
+    axes[4] = 0;
+    axes[5] = (int16_t)(MOTION_RATE_DPS * lsb_per_dps);
+}
+
+/*!
+ * @brief This internal function appends the enabled words of the current sample to the FIFO.
+ *
+ * @details
+ *      the frame holds accel, gyro, temperature and the lower 16 bits of the sensor time, in
+ *      this order, each only if enabled in FIFO_CONF. with stop-on-full, a frame that does not
+ *      fit is dropped, otherwise the oldest words are overwritten.
+ */
+static void fifo_push_frame(struct bmi323_emul_data *data)
+{
+    uint16_t conf = data->regs[REG_FIFO_CONF];
+    uint16_t frame[8];
+    uint16_t words = 0;
+    uint16_t i;
+
+    if (conf & FIFO_CONF_ACC_EN)
+    {
+        frame[words++] = data->regs[REG_ACC_DATA_X + 0U];
+        frame[words++] = data->regs[REG_ACC_DATA_X + 1U];
+        frame[words++] = data->regs[REG_ACC_DATA_X + 2U];
+    }
+
+    if (conf & FIFO_CONF_GYR_EN)
+    {
+        frame[words++] = data->regs[REG_GYR_DATA_X + 0U];
+        frame[words++] = data->regs[REG_GYR_DATA_X + 1U];
+        frame[words++] = data->regs[REG_GYR_DATA_X + 2U];
+    }
+
+    if (conf & FIFO_CONF_TEMP_EN)
+    {
+        frame[words++] = data->regs[REG_TEMP_DATA];
+    }
+
+    if (conf & FIFO_CONF_TIME_EN)
+    {
+        frame[words++] = (uint16_t)data->sensor_time;
+    }
+
+    if (words == 0)
+    {
+        return;
+    }
+
+    if ((data->fifo_count + words) > FIFO_WORDS)
+    {
+        data->fifo_overflows++;
+        data->regs[REG_INT_STATUS_INT1] |= INT_STATUS_FFULL;
+
+        if (conf & FIFO_CONF_STOP_ON_FULL)
+        {
+            return;
+        }
+
+        data->fifo_head = (data->fifo_head + words) % FIFO_WORDS;
+        data->fifo_count -= words;
+    }
+
+    for (i = 0; i < words; i++)
+    {
+        data->fifo[(data->fifo_head + data->fifo_count) % FIFO_WORDS] = frame[i];
+        data->fifo_count++;
+    }
+}
+
+/*!
+ * @brief This internal function computes the level of INT1 from the interrupt sources mapped to it.
+ *
+ * @details
+ *      a data-ready source is active while a sample of its sensor is waiting in the data registers,
+ *      the watermark and full sources while the FIFO is at or above the watermark or full.
+ */
+static bool int1_level(struct bmi323_emul_data *data)
+{
+    uint16_t map = data->regs[REG_INT_MAP2];
+    uint16_t watermark = data->regs[REG_FIFO_WATERMARK];
+    bool active = false;
+
+    if ((data->regs[REG_IO_INT_CTRL] & IO_INT_CTRL_INT1_OE) == 0U)
+    {
+        return false;
+    }
+
+    if ((((map >> INT_MAP2_ACC_DRDY_POS) & 0x03U) == INT_MAP_INT1) && data->acc_drdy_pending)
+    {
+        active = true;
+    }
+
+    if ((((map >> INT_MAP2_GYR_DRDY_POS) & 0x03U) == INT_MAP_INT1) && data->gyr_drdy_pending)
+    {
+        active = true;
+    }
+
+    if ((((map >> INT_MAP2_FWM_POS) & 0x03U) == INT_MAP_INT1) && (watermark != 0U) &&
+        (data->fifo_count >= watermark))
+    {
+        active = true;
+    }
+
+    if ((((map >> INT_MAP2_FFULL_POS) & 0x03U) == INT_MAP_INT1) && (data->fifo_count >= FIFO_WORDS))
+    {
+        active = true;
+    }
+
+    if (active && !data->int1_active)
+    {
+        data->int1_active_cycles = k_cycle_get_32();
+        data->latency_armed = true;
+    }
+
+    data->int1_active = active;
+
+    return active;
+}
+
+/*!
+ * @brief This internal function drives the emulated GPIO of INT1.
+ *
+ * @details
+ *      the callbacks of the GPIO run from here, so the lock of the emulator must not be held.
+ */
+static void drive_int1(const struct emul *target, bool active)
+{
+    const struct bmi323_emul_cfg *cfg = target->cfg;
+    struct bmi323_emul_data *data = target->data;
+    bool high = (data->regs[REG_IO_INT_CTRL] & IO_INT_CTRL_INT1_LVL) ? active : !active;
+
+    if (cfg->int1.port == NULL)
+    {
+        return;
+    }
+
+    /* The emulated pin takes the physical level, the GPIO flags of the devicetree invert it if needed. */
+    gpio_emul_input_set(cfg->int1.port, cfg->int1.pin, high ? 1 : 0);
+}
+
+/*!
+ * @brief Expiry function of the sample timer.
+ *
+ * @details
+ *      the sensors whose ODR is due at this expiry produce a sample: their data registers are
+ *      updated and their data-ready flags raised, the FIFO gets a frame and INT1 follows its
+ *      sources. a sample whose predecessor was never read is counted as unread.
+ */
+static void sample_timer_expired(struct k_timer *timer)
+{
+    struct bmi323_emul_data *data = CONTAINER_OF(timer, struct bmi323_emul_data, sample_timer);
+    int16_t axes[6];
+    k_spinlock_key_t key;
+    bool acc_due;
+    bool gyr_due;
+    bool active;
+    uint8_t i;
+
+    key = k_spin_lock(&data->lock);
+
+    data->sensor_time += data->period_ticks;
+    data->tick++;
+
+    acc_due = (data->acc_div != 0U) && ((data->tick % data->acc_div) == 0U);
+    gyr_due = (data->gyr_div != 0U) && ((data->tick % data->gyr_div) == 0U);
+
+    next_motion(data, axes);
+
+    if (acc_due)
+    {
+        for (i = 0; i < 3U; i++)
+        {
+            data->regs[REG_ACC_DATA_X + i] = (uint16_t)axes[i];
+        }
+
+        if (data->acc_drdy_pending)
+        {
+            data->unread++;
+        }
+
+        data->acc_drdy_pending = true;
+        data->regs[REG_STATUS] |= STATUS_DRDY_ACC;
+        data->regs[REG_INT_STATUS_INT1] |= INT_STATUS_ACC_DRDY;
+    }
+
+    if (gyr_due)
+    {
+        for (i = 0; i < 3U; i++)
+        {
+            data->regs[REG_GYR_DATA_X + i] = (uint16_t)axes[3U + i];
+        }
+
+        if (data->gyr_drdy_pending)
+        {
+            data->unread++;
+        }
+
+        data->gyr_drdy_pending = true;
+        data->regs[REG_STATUS] |= STATUS_DRDY_GYR;
+        data->regs[REG_INT_STATUS_INT1] |= INT_STATUS_GYR_DRDY;
+    }
+
+    data->regs[REG_TEMP_DATA] = 0;
+    data->regs[REG_SENSOR_TIME_0] = (uint16_t)data->sensor_time;
+    data->regs[REG_SENSOR_TIME_1] = (uint16_t)(data->sensor_time >> 16);
+    data->regs[REG_STATUS] |= STATUS_DRDY_TEMP;
+    data->regs[REG_INT_STATUS_INT1] |= INT_STATUS_TEMP_DRDY;
+
+    fifo_push_frame(data);
+
+    if ((data->regs[REG_FIFO_WATERMARK] != 0U) && (data->fifo_count >= data->regs[REG_FIFO_WATERMARK]))
+    {
+        data->regs[REG_INT_STATUS_INT1] |= INT_STATUS_FWM;
+    }
+
+    data->generated++;
+
+    active = int1_level(data);
+
+    k_spin_unlock(&data->lock, key);
+
+    drive_int1(data->emul, active);
+}
+
+#if (CONFIG_BMI323_SENSORAPI_EMUL_STATS_PERIOD_MS > 0)
+/*!
+ * @brief Expiry function of the statistics timer.
+ *
+ * @details
+ *      prints the samples produced, the samples overwritten before they were read, the FIFO
+ *      overflows and the latency from INT1 becoming active to the first data read, then
+ *      starts the latency measurement over.
+ */
+static void stats_timer_expired(struct k_timer *timer)
+{
+    struct bmi323_emul_data *data = stats_data;
+    k_spinlock_key_t key;
+    uint32_t avg_us = 0;
+    uint32_t max_us;
+
+    ARG_UNUSED(timer);
+
+    key = k_spin_lock(&data->lock);
+
+    if (data->latency_count > 0)
+    {
+        avg_us = k_cyc_to_us_floor32((uint32_t)(data->latency_sum_cycles / data->latency_count));
+    }
+    max_us = k_cyc_to_us_floor32(data->latency_max_cycles);
+
+    printk("bmi323 emul: %u samples, %u unread, %u fifo overflows, int1 to read %u us avg %u us max\n\r",
+           data->generated, data->unread, data->fifo_overflows, avg_us, max_us);
+
+    data->latency_count = 0;
+    data->latency_sum_cycles = 0;
+    data->latency_max_cycles = 0;
+
+    k_spin_unlock(&data->lock, key);
+}
+#endif
+
+/* One emulator per 'bosch,bmi323-sensorapi' node on an emulated I2C bus. */
+#define BMI323_EMUL_DEFINE(inst)                                                            \
+    static const struct bmi323_emul_cfg bmi323_emul_cfg_##inst = {                          \
+        .int1 = GPIO_DT_SPEC_INST_GET_OR(inst, int1_gpios, { 0 }),                          \
+    };                                                                                      \
+                                                                                            \
+    static struct bmi323_emul_data bmi323_emul_data_##inst;                                 \
+                                                                                            \
+    EMUL_DT_INST_DEFINE(inst, bmi323_emul_init, &bmi323_emul_data_##inst,                   \
+                        &bmi323_emul_cfg_##inst, &bmi323_emul_api_i2c, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(BMI323_EMUL_DEFINE)
@@ -0,0 +1,171 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+// include the I2C drivers, they provide the RTIO I2C iodev
+#include <zephyr/drivers/i2c.h>
+
+// include the real-time I/O submission and completion queues
+#include <zephyr/rtio/rtio.h>
+
+#include "bmi323_async.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * I2C_DT_IODEV_DEFINE()            |   https://docs.zephyrproject.org/latest/doxygen/html/group__i2c__interface.html
+ * RTIO_DEFINE()                    |   https://docs.zephyrproject.org/latest/services/rtio/index.html
+ * rtio_sqe_acquire()               |   https://docs.zephyrproject.org/latest/services/rtio/index.html
+ * rtio_sqe_prep_tiny_write()       |   https://docs.zephyrproject.org/latest/services/rtio/index.html
+ * rtio_sqe_prep_read()             |   https://docs.zephyrproject.org/latest/services/rtio/index.html
+ * rtio_submit()                    |   https://docs.zephyrproject.org/latest/services/rtio/index.html
+ * rtio_cqe_consume_block()         |   https://docs.zephyrproject.org/latest/services/rtio/index.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Every read is a register address write and a data read, each one is a submission and gives one completion. */
+#define ENTRIES_PER_READ        (2U)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+// the I2C bus and address are read from the 'bmi323' node of the '.overlay' file
+I2C_DT_IODEV_DEFINE(bmi323_iodev, DT_NODELABEL(bmi323));
+
+/*! Submission and completion queues, the nrfx TWIM driver executes the submissions with EasyDMA. */
+RTIO_DEFINE(bmi323_rtio, CONFIG_L3_BUS_ASYNC_QUEUE_DEPTH, CONFIG_L3_BUS_ASYNC_QUEUE_DEPTH);
+
+/*! Keeps the entries of one chain together when an interrupt and a thread submit at the same time. */
+static struct k_spinlock submit_lock;
+
+K_THREAD_STACK_DEFINE(completion_stack, CONFIG_L3_BUS_ASYNC_THREAD_STACK_SIZE);
+static struct k_thread completion_thread;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief Entry of the completion thread, it hands the finished requests to their callbacks.
+ */
+static void completion_thread_entry(void *p1, void *p2, void *p3);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int bmi323_async_init(void)
+{
+    if (!i2c_is_ready_iodev(&bmi323_iodev))
+    {
+        return -ENODEV;
+    }
+
+    k_thread_create(&completion_thread, completion_stack, K_THREAD_STACK_SIZEOF(completion_stack),
+                    completion_thread_entry, NULL, NULL, NULL,
+                    CONFIG_L3_BUS_ASYNC_THREAD_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&completion_thread, "bmi323_async");
+
+    return 0;
+}
+
+int bmi323_async_submit(bmi323_async_req_t *req, const bmi323_async_read_t *reads, uint8_t count)
+{
+    k_spinlock_key_t key;
+    struct rtio_sqe *write_sqe;
+    struct rtio_sqe *read_sqe = NULL;
+    uint8_t i;
+
+    if (count == 0)
+    {
+        return -EINVAL;
+    }
+
+    if (!atomic_cas(&req->pending, 0, (atomic_val_t)(count * ENTRIES_PER_READ)))
+    {
+        return -EBUSY;
+    }
+
+    req->result = 0;
+
+    key = k_spin_lock(&submit_lock);
+
+    for (i = 0; i < count; i++)
+    {
+        write_sqe = rtio_sqe_acquire(&bmi323_rtio);
+        read_sqe = rtio_sqe_acquire(&bmi323_rtio);
+
+        if ((write_sqe == NULL) || (read_sqe == NULL))
+        {
+            /* Nothing of this chain was submitted yet, give all its entries back. */
+            rtio_sqe_drop_all(&bmi323_rtio);
+            k_spin_unlock(&submit_lock, key);
+            atomic_clear(&req->pending);
+
+            return -ENOMEM;
+        }
+
+        /* Register address and data read form one I2C transfer with a repeated start in between. */
+        rtio_sqe_prep_tiny_write(write_sqe, &bmi323_iodev, RTIO_PRIO_NORM, &reads[i].reg, 1, req);
+        write_sqe->flags |= RTIO_SQE_TRANSACTION;
+
+        rtio_sqe_prep_read(read_sqe, &bmi323_iodev, RTIO_PRIO_NORM, reads[i].buf,
+                           BMI323_ASYNC_BUF_SIZE(reads[i].len), req);
+        read_sqe->iodev_flags |= RTIO_IODEV_I2C_RESTART | RTIO_IODEV_I2C_STOP;
+
+        /* The next read only starts once this one succeeded. */
+        read_sqe->flags |= RTIO_SQE_CHAINED;
+    }
+
+    /* The last read ends the chain. */
+    read_sqe->flags &= ~RTIO_SQE_CHAINED;
+
+    rtio_submit(&bmi323_rtio, 0);
+
+    k_spin_unlock(&submit_lock, key);
+
+    return 0;
+}
+
+/*!
+ * @brief Entry of the completion thread.
+ *
+ * @details
+ *      every submission of a chain gives one completion, also the ones cancelled after an error, so the
+ *      request is done once all of them are consumed. the callback is called before the request is
+ *      marked idle, so a new submission of the same request can never overwrite the buffers it reads.
+ */
+static void completion_thread_entry(void *p1, void *p2, void *p3)
+{
+    struct rtio_cqe *cqe;
+    bmi323_async_req_t *req;
+    int result;
+
+    while (1)
+    {
+        cqe = rtio_cqe_consume_block(&bmi323_rtio);
+
+        req = (bmi323_async_req_t *)cqe->userdata;
+        result = cqe->result;
+
+        rtio_cqe_release(&bmi323_rtio, cqe);
+
+        if ((result < 0) && (req->result == 0))
+        {
+            req->result = result;
+        }
+
+        if (atomic_get(&req->pending) == 1)
+        {
+            req->callback(req->result, req->user_data);
+            atomic_clear(&req->pending);
+        }
+        else
+        {
+            atomic_dec(&req->pending);
+        }
+    }
+}
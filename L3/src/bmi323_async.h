@@ -0,0 +1,161 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   asynchronous I2C register reads of the BMI323                                                               |
+ * |    @file           :   bmi323_async.h                                                                                              |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides queued, chained and non-blocking register reads of the BMI323 on top of Zephyr RTIO      |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef BMI323_ASYNC_H_
+#define BMI323_ASYNC_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the 'atomic_t' type
+ */
+#include <zephyr/kernel.h>
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * over I2C the BMI323 sends 2 dummy bytes before the content of the first register, every read buffer has
+ * to be this much bigger than the data it receives and the data starts at this offset
+ */
+#define BMI323_ASYNC_DUMMY_BYTES        (2U)
+
+/**
+ * size of the buffer needed to receive 'len' bytes of register data
+ */
+#define BMI323_ASYNC_BUF_SIZE(len)      ((len) + BMI323_ASYNC_DUMMY_BYTES)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: called once all the reads of a request are done, from the completion thread
+ * @param  result       : 0 if every read succeeded, otherwise the error of the first failing read.
+ * @param  user_data    : the pointer given in the request.
+ */
+typedef void (*bmi323_async_cb_t)(int result, void *user_data);
+
+/**
+ * @struct: bmi323_async_read_t
+ * @brief: one register burst read, a repeated start is used between the register address and the data
+ */
+typedef struct {
+    uint8_t reg;                /**< first register of the burst */
+    uint8_t *buf;               /**< receive buffer of BMI323_ASYNC_BUF_SIZE(len) bytes */
+    uint16_t len;               /**< number of data bytes, without the dummy bytes */
+} bmi323_async_read_t;
+
+/**
+ * @struct: bmi323_async_req_t
+ * @brief: a chain of reads submitted as one sequence, owned by the caller and reused for every submission
+ */
+typedef struct {
+    bmi323_async_cb_t callback; /**< completion callback, set by the caller */
+    void *user_data;            /**< handed to the callback, set by the caller */
+    atomic_t pending;           /**< completions still expected, 0 when the request is idle (private) */
+    int result;                 /**< first error of the sequence (private) */
+} bmi323_async_req_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int bmi323_async_init(void);
+ *  \b Description                              :       check the I2C bus of the BMI323 and start the thread that dispatches the completions.
+ *  @note                                       :       the bus and the address come from the 'bmi323' node of the '.overlay' file.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       bmi323_async_submit() can be used.
+ *  @return                                     :       0 on success, -ENODEV if the I2C bus is not ready.
+ *  @see                                        :       int bmi323_async_submit(bmi323_async_req_t *req, const bmi323_async_read_t *reads, uint8_t count);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_async_init(void);
+
+
+/**
+ *  \b function                                 :       int bmi323_async_submit(bmi323_async_req_t *req, const bmi323_async_read_t *reads, uint8_t count);
+ *  \b Description                              :       queue 'count' register reads as one chained sequence and return immediately, the TWIM
+ *                                                      moves the bytes with EasyDMA and 'req->callback' is called once the last read is done.
+ *  @param  req [IN]                            :       the request, it has to stay valid until its callback was called.
+ *  @param  reads [IN]                          :       the reads, executed back-to-back in this order, the array and the buffers have to stay
+ *                                                      valid until the callback was called.
+ *  @param  count [IN]                          :       number of reads, at least 1.
+ *  @note                                       :       can be called from an interrupt. a read of the chain is only started once the previous
+ *                                                      one succeeded, after an error the rest of the chain is cancelled.
+ *  \b PRE-CONDITION                            :       bmi323_async_init() succeeded.
+ *  \b POST-CONDITION                           :       the callback of the request is called exactly once.
+ *  @return                                     :       0 on success, -EINVAL if 'count' is 0, -EBUSY if the request is still in flight,
+ *                                                      -ENOMEM if the submission queue has no room for the chain.
+ *  @see                                        :       int bmi323_async_init(void);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_async_submit(bmi323_async_req_t *req, const bmi323_async_read_t *reads, uint8_t count);
+
+
+/*** End of File **************************************************************/
+
+#endif /*BMI323_ASYNC_H_*/
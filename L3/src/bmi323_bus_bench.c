@@ -0,0 +1,280 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+// include the printk function file header
+#include <zephyr/sys/printk.h>
+
+// include the cycle accurate timing functions (DWT CYCCNT on the nRF52832, the host counter on native_sim)
+#include <zephyr/timing/timing.h>
+
+#if defined(CONFIG_L3_BUS_BENCH_I2C)
+// include the I2C driver, the sweep drives the bus of the sensor directly
+#include <zephyr/drivers/i2c.h>
+#endif
+
+#include "bmi323_bus_bench.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                 |   Documentation Link
+ * =========================|=====================
+ * timing_counter_get()     |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * timing_cycles_get()      |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * timing_cycles_to_ns()    |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * i2c_configure()          |   https://docs.zephyrproject.org/latest/hardware/peripherals/i2c.html
+ * i2c_write_read_dt()      |   https://docs.zephyrproject.org/latest/hardware/peripherals/i2c.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Accel, gyro and sensor time: 7 words per FIFO frame. */
+#define BENCH_FRAME_SIZE    (14U)
+
+/*! Largest drain, 16 frames and the dummy bytes still fit one 255 byte EasyDMA transfer. */
+#define BENCH_MAX_FRAMES    (16U)
+
+/*! Every drain size is repeated to average out the interrupt noise. */
+#define BENCH_ROUNDS        (32U)
+
+#if defined(CONFIG_L3_BUS_BENCH_I2C)
+/*! Largest read of the sweep, the 2 dummy bytes of I2C come on top. */
+#define SWEEP_MAX_BYTES     (224U)
+
+/*! Bytes on the wire around the data: address + W, register, address + R and the 2 dummy bytes. */
+#define SWEEP_FRAME_BYTES   (5U)
+
+/*! Every byte takes 9 clocks (8 bits and the acknowledge). */
+#define SWEEP_BYTE_CLOCKS   (9U)
+
+/*! Bus speed of the devicetree, restored after the sweep. */
+#define SWEEP_DT_SPEED      i2c_map_dt_bitrate(DT_PROP(DT_BUS(DT_NODELABEL(bmi323)), clock_frequency))
+#endif
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! Frames per drain, from a sample at a time to a small watermark. */
+static const uint8_t bench_frames[] = { 1U, 4U, 8U, 16U };
+
+static uint8_t bench_buf[(BENCH_MAX_FRAMES * BENCH_FRAME_SIZE) + 2U];
+
+#if defined(CONFIG_L3_BUS_BENCH_I2C)
+/*! The bus and the address of the 'bmi323' node of the '.overlay' file. */
+static const struct i2c_dt_spec sweep_i2c = I2C_DT_SPEC_GET(DT_NODELABEL(bmi323));
+
+/*! Bus speeds of the sweep, standard (100 kHz) and fast (400 kHz) mode. */
+static const uint32_t sweep_speeds[] = { I2C_SPEED_STANDARD, I2C_SPEED_FAST };
+static const uint32_t sweep_bitrates[] = { I2C_BITRATE_STANDARD, I2C_BITRATE_FAST };
+
+/*! Data bytes per read: a register, an accel sample, accel + gyro, a FIFO frame, and FIFO drains. */
+static const uint8_t sweep_sizes[] = { 2U, 6U, 12U, 14U, 28U, 64U, 128U, SWEEP_MAX_BYTES };
+
+static uint8_t sweep_buf[SWEEP_MAX_BYTES + 2U];
+#endif
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+#if defined(CONFIG_L3_BUS_BENCH_I2C)
+/*!
+ *  @brief This internal function sweeps the I2C bus speeds, read sizes and transaction types.
+ *
+ *  @param[in] dev       : Structure instance of bmi3_dev, for the vendor API overhead.
+ */
+static void run_i2c_sweep(struct bmi3_dev *dev);
+
+/*!
+ *  @brief This internal function times BENCH_ROUNDS reads of FIFO_DATA.
+ *
+ *  @param[in] size           : Data bytes per read, the dummy bytes come on top.
+ *  @param[in] repeated_start : true for one write-read transfer, false for a write and a read with a stop between.
+ *
+ *  @return Average ns per read, 0 if a transfer failed.
+ */
+static uint32_t time_i2c_read(uint8_t size, bool repeated_start);
+#endif
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+/*!
+ * @brief time FIFO drains of several sizes over the bus of the sensor.
+ *
+ * @details
+ *      the bus function of the SensorAPI is called directly, as bmi323_read_fifo_data() would, with the
+ *      read bit of SPI and the dummy bytes of the bus. the fixed cost of a transfer (address phase, the
+ *      driver and its interrupt) is what makes small drains slow, the frame rate of a bus is the one of
+ *      its largest drain.
+ */
+void bmi323_bus_bench_run(struct bmi3_dev *dev)
+{
+    const uint8_t reg = (dev->intf == BMI3_SPI_INTF) ? (BMI3_REG_FIFO_DATA | BMI3_SPI_RD_MASK) : BMI3_REG_FIFO_DATA;
+    timing_t start, end;
+    uint64_t ns;
+    uint32_t len, per_read_ns, bytes_per_s, frames_per_s;
+    uint32_t round;
+    uint8_t i;
+    int8_t rslt = BMI3_OK;
+
+    timing_init();
+    timing_start();
+
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("bus benchmark (%s), %u rounds per drain, frames of %u bytes\n\r",
+           (dev->intf == BMI3_SPI_INTF) ? "SPI" : "I2C", BENCH_ROUNDS, BENCH_FRAME_SIZE);
+    printk("----------------------------------------------------------------------------------\n\r");
+
+    for (i = 0; (i < ARRAY_SIZE(bench_frames)) && (rslt == BMI3_OK); i++)
+    {
+        len = (bench_frames[i] * BENCH_FRAME_SIZE) + dev->dummy_byte;
+
+        start = timing_counter_get();
+        for (round = 0; (round < BENCH_ROUNDS) && (rslt == BMI3_OK); round++)
+        {
+            rslt = dev->read(reg, bench_buf, len, dev->intf_ptr);
+        }
+        end = timing_counter_get();
+
+        ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+        per_read_ns = (uint32_t)(ns / BENCH_ROUNDS);
+        bytes_per_s = (uint32_t)(((uint64_t)bench_frames[i] * BENCH_FRAME_SIZE * BENCH_ROUNDS * 1000000000ULL) / ns);
+        frames_per_s = bytes_per_s / BENCH_FRAME_SIZE;
+
+        printk("%2u frames (%3u bytes): %6u us/read, %6u bytes/s, %5u frames/s\n\r",
+               bench_frames[i], len, per_read_ns / 1000U, bytes_per_s, frames_per_s);
+    }
+
+    if (rslt != BMI3_OK)
+    {
+        printk("bus benchmark: read failed (%d)\n\r", rslt);
+    }
+
+#if defined(CONFIG_L3_BUS_BENCH_I2C)
+    run_i2c_sweep(dev);
+#endif
+
+    timing_stop();
+}
+
+#if defined(CONFIG_L3_BUS_BENCH_I2C)
+/*!
+ * @brief This internal function sweeps the I2C bus.
+ *
+ * @details
+ *      every size is read at every speed once with a repeated start between the register address
+ *      and the data (one i2c_write_read_dt()) and once as two transfers with a stop in between. the
+ *      overhead is the measured time minus the clocks of the bytes on the wire: the start and stop
+ *      conditions, the driver, its interrupts and the EasyDMA setup. on native_sim the emulator
+ *      answers at once, the whole time is the software path. last, the vendor API (bmi323_get_regs())
+ *      is compared with the bare transfer of the same 12 bytes at the speed of the devicetree.
+ */
+static void run_i2c_sweep(struct bmi3_dev *dev)
+{
+    static const char *const mode_names[] = { "stop-start", "repeated-start" };
+    timing_t start, end;
+    uint32_t ns, api_ns, wire_ns, bytes_per_s;
+    uint32_t round;
+    uint8_t speed, size, mode;
+    int8_t rslt = BMI3_OK;
+
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("i2c sweep: kHz, transaction, bytes, us/read, bytes/s, overhead us\n\r");
+
+    for (speed = 0; speed < ARRAY_SIZE(sweep_speeds); speed++)
+    {
+        if (i2c_configure(sweep_i2c.bus, I2C_MODE_CONTROLLER | I2C_SPEED_SET(sweep_speeds[speed])) != 0)
+        {
+            printk("i2c sweep: %u kHz not supported\n\r", sweep_bitrates[speed] / 1000U);
+            continue;
+        }
+
+        for (mode = 0; mode < ARRAY_SIZE(mode_names); mode++)
+        {
+            for (size = 0; size < ARRAY_SIZE(sweep_sizes); size++)
+            {
+                ns = time_i2c_read(sweep_sizes[size], mode != 0);
+
+                if (ns == 0)
+                {
+                    printk("i2c sweep: read failed\n\r");
+                    continue;
+                }
+
+                wire_ns = (uint32_t)(((uint64_t)(sweep_sizes[size] + SWEEP_FRAME_BYTES) * SWEEP_BYTE_CLOCKS *
+                                      1000000000ULL) / sweep_bitrates[speed]);
+                bytes_per_s = (uint32_t)(((uint64_t)sweep_sizes[size] * 1000000000ULL) / ns);
+
+                printk("%u, %s, %u, %u, %u, %d\n\r",
+                       sweep_bitrates[speed] / 1000U, mode_names[mode], sweep_sizes[size], ns / 1000U,
+                       bytes_per_s, ((int32_t)ns - (int32_t)wire_ns) / 1000);
+            }
+        }
+    }
+
+    i2c_configure(sweep_i2c.bus, I2C_MODE_CONTROLLER | I2C_SPEED_SET(SWEEP_DT_SPEED));
+
+    /* The same 12 bytes through the SensorAPI: its checks and the copy that strips the dummy bytes. */
+    start = timing_counter_get();
+    for (round = 0; (round < BENCH_ROUNDS) && (rslt == BMI3_OK); round++)
+    {
+        rslt = bmi323_get_regs(BMI3_REG_FIFO_DATA, sweep_buf, 12U, dev);
+    }
+    end = timing_counter_get();
+
+    api_ns = (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &end)) / BENCH_ROUNDS);
+    ns = time_i2c_read(12U, true);
+
+    if ((rslt == BMI3_OK) && (ns != 0))
+    {
+        printk("i2c sweep: 12 bytes, bmi323_get_regs() %u us, i2c_write_read_dt() %u us, vendor API %d us\n\r",
+               api_ns / 1000U, ns / 1000U, ((int32_t)api_ns - (int32_t)ns) / 1000);
+    }
+}
+
+/*!
+ * @brief This internal function times the reads of FIFO_DATA.
+ *
+ * @details
+ *      FIFO_DATA does not increment the address, any size can be read from it. the FIFO is not enabled
+ *      yet, the sensor returns dummy frames at the same bus timing.
+ */
+static uint32_t time_i2c_read(uint8_t size, bool repeated_start)
+{
+    const uint8_t reg = BMI3_REG_FIFO_DATA;
+    timing_t start, end;
+    uint32_t round;
+    int ret = 0;
+
+    start = timing_counter_get();
+    for (round = 0; (round < BENCH_ROUNDS) && (ret == 0); round++)
+    {
+        if (repeated_start)
+        {
+            ret = i2c_write_read_dt(&sweep_i2c, &reg, 1, sweep_buf, size + 2U);
+        }
+        else
+        {
+            ret = i2c_write_dt(&sweep_i2c, &reg, 1);
+
+            if (ret == 0)
+            {
+                ret = i2c_read_dt(&sweep_i2c, sweep_buf, size + 2U);
+            }
+        }
+    }
+    end = timing_counter_get();
+
+    if (ret != 0)
+    {
+        return 0;
+    }
+
+    return (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &end)) / BENCH_ROUNDS);
+}
+#endif
@@ -0,0 +1,88 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   BMI323 bus throughput benchmark                                                                             |
+ * |    @file           :   bmi323_bus_bench.h                                                                                          |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides a startup benchmark of the FIFO drains over the I2C or the SPI bus of the BMI323         |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef BMI323_BUS_BENCH_H_
+#define BMI323_BUS_BENCH_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide 'struct bmi3_dev', its bus functions are timed
+ */
+#include <bmi323.h>
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       void bmi323_bus_bench_run(struct bmi3_dev *dev);
+ *  \b Description                              :       time FIFO drains of 1, 4, 8 and 16 frames (14 bytes: accel, gyro and sensor time) over
+ *                                                      the bus the sensor sits on and print the time per read, the payload throughput and
+ *                                                      the frame rate the bus could sustain with drains of that size.
+ *  @param  dev [IN]                            :       structure instance of bmi3_dev.
+ *  @note                                       :       build once with the I2C and once with the SPI overlay ('spi.overlay') to compare the
+ *                                                      buses. the FIFO is not enabled yet, the sensor answers with dummy frames and the bus
+ *                                                      timing is the same. with CONFIG_L3_BUS_BENCH_I2C the I2C bus is then swept over its
+ *                                                      speeds, read sizes and transaction types, which blocks for a few seconds.
+ *  \b PRE-CONDITION                            :       bmi323_init() succeeded, the FIFO is not in use.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void bmi323_bus_bench_run(struct bmi3_dev *dev);
+
+
+/*** End of File **************************************************************/
+
+#endif /*BMI323_BUS_BENCH_H_*/
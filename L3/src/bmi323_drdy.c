@@ -0,0 +1,402 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+// include GPIO drivers
+#include <zephyr/drivers/gpio.h>
+
+// include the sys_get_le16() helpers
+#include <zephyr/sys/byteorder.h>
+
+// include the common header file that will be used in conjunction with BMI323 drivers
+#include <common.h>
+
+#if defined(CONFIG_L3_BUS_ASYNC)
+// include the queued asynchronous register reads
+#include "bmi323_async.h"
+#endif
+
+#if defined(CONFIG_L3_PROC_THREAD)
+// include the processing thread, its ring replaces the sample queue
+#include "imu_proc.h"
+#endif
+
+#if defined(CONFIG_L3_TIMING)
+// include the timing statistics, they are fed from the reading context
+#include "imu_timing.h"
+#endif
+
+#include "bmi323_drdy.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * gpio_pin_interrupt_configure_dt()|   https://docs.zephyrproject.org/latest/doxygen/html/group__gpio__interface.html
+ * k_sem_give() / k_sem_take()      |   https://docs.zephyrproject.org/latest/kernel/services/synchronization/semaphores.html
+ * k_msgq_put() / k_msgq_get()      |   https://docs.zephyrproject.org/latest/kernel/services/data_passing/message_queues.html
+ * k_thread_create()                |   https://docs.zephyrproject.org/latest/kernel/services/threads/index.html
+ * bmi323_async_submit()            |   refer to 'bmi323_async.h'
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Number of 16-bit registers from ACC_DATA_X up to SENSOR_TIME_1: accel x/y/z, gyro x/y/z, temperature, sensor time (2). */
+#define DATA_BURST_WORDS        (9U)
+
+/*! Word offsets inside the burst. */
+#define BURST_ACC_X             (0U)
+#define BURST_GYR_X             (3U)
+#define BURST_TIME_0            (7U)
+
+/*! Size of the STATUS register. */
+#define STATUS_BYTES            (2U)
+
+#if !defined(CONFIG_L3_BUS_ASYNC)
+/*! Longest wait for an edge, 4 ODR periods: the acquisition thread then looks at STATUS on its own. */
+#define DRDY_TIMEOUT_US         ((4U * 1000000U) / CONFIG_L3_IMU_ODR_HZ)
+#endif
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+// read the gpio configurations of the INT1 line from the 'bmi323' node of the '.overlay' file
+static const struct gpio_dt_spec int1 = GPIO_DT_SPEC_GET(DT_NODELABEL(bmi323), int1_gpios);
+static struct gpio_callback int1_cb_data;
+
+#if !defined(CONFIG_L3_PROC_THREAD)
+/*! Samples handed from the acquisition thread to the consumer. */
+K_MSGQ_DEFINE(drdy_msgq, sizeof(imu_sample_t), CONFIG_L3_DRDY_QUEUE_DEPTH, 4);
+#endif
+
+#if defined(CONFIG_L3_BUS_ASYNC)
+static uint8_t status_buf[BMI323_ASYNC_BUF_SIZE(STATUS_BYTES)];
+static uint8_t burst_buf[BMI323_ASYNC_BUF_SIZE(DATA_BURST_WORDS * 2U)];
+
+/*! STATUS and the data burst, chained into one sequence submitted straight from the INT1 interrupt. */
+static const bmi323_async_read_t drdy_reads[] = {
+    { .reg = BMI3_REG_STATUS, .buf = status_buf, .len = STATUS_BYTES },
+    { .reg = BMI3_REG_ACC_DATA_X, .buf = burst_buf, .len = DATA_BURST_WORDS * 2U },
+};
+
+static bmi323_async_req_t drdy_req;
+#else
+/*! Given from the GPIOTE interrupt, taken by the acquisition thread. Limit 1: a second edge before the read is an overrun. */
+K_SEM_DEFINE(drdy_sem, 0, 1);
+
+K_THREAD_STACK_DEFINE(drdy_stack, CONFIG_L3_DRDY_THREAD_STACK_SIZE);
+static struct k_thread drdy_thread;
+#endif
+
+/*! Lost samples, see bmi323_drdy_overruns(). */
+static atomic_t overruns;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal API configures the INT1 pin of the BMI323 and maps the accel data-ready interrupt to it.
+ *
+ *  @param[in] dev       : Structure instance of bmi3_dev.
+ *
+ *  @return Status of execution.
+ */
+static int8_t set_int1_config(struct bmi3_dev *dev);
+
+/*!
+ *  @brief GPIOTE callback of the INT1 line, runs in interrupt context.
+ */
+static void int1_triggered(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins);
+
+/*!
+ *  @brief This internal function decodes a data burst (accel, gyro, temperature, sensor time) into a sample.
+ */
+static void parse_burst(const uint8_t *burst, imu_sample_t *sample);
+
+/*!
+ *  @brief This internal function hands a sample to the consumer, a full queue counts as an overrun.
+ */
+static void queue_sample(const imu_sample_t *sample);
+
+#if defined(CONFIG_L3_BUS_ASYNC)
+/*!
+ *  @brief Completion callback of the chained STATUS + data read, runs in the completion thread of 'bmi323_async.c'.
+ */
+static void drdy_read_done(int result, void *user_data);
+#else
+/*!
+ *  @brief Entry of the acquisition thread, p1 is the bmi3_dev instance.
+ */
+static void drdy_thread_entry(void *p1, void *p2, void *p3);
+#endif
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int bmi323_drdy_start(struct bmi3_dev *dev)
+{
+    int8_t rslt;
+
+    if (!gpio_is_ready_dt(&int1))
+    {
+        return -ENODEV;
+    }
+
+    if (gpio_pin_configure_dt(&int1, GPIO_INPUT) < 0)
+    {
+        return -EIO;
+    }
+
+#if defined(CONFIG_L3_BUS_ASYNC)
+    if (bmi323_async_init() < 0)
+    {
+        return -ENODEV;
+    }
+
+    drdy_req.callback = drdy_read_done;
+    drdy_req.user_data = NULL;
+#endif
+
+    rslt = set_int1_config(dev);
+    bmi3_error_codes_print_result("set_int1_config", rslt);
+
+    if (rslt != BMI323_OK)
+    {
+        return -EIO;
+    }
+
+    gpio_init_callback(&int1_cb_data, int1_triggered, BIT(int1.pin));
+
+    if (gpio_add_callback_dt(&int1, &int1_cb_data) < 0)
+    {
+        return -EIO;
+    }
+
+    if (gpio_pin_interrupt_configure_dt(&int1, GPIO_INT_EDGE_TO_ACTIVE) < 0)
+    {
+        return -EIO;
+    }
+
+#if defined(CONFIG_L3_BUS_ASYNC)
+    /* A sample may already be waiting, its edge happened before the interrupt was enabled. */
+    bmi323_async_submit(&drdy_req, drdy_reads, ARRAY_SIZE(drdy_reads));
+#else
+    k_thread_create(&drdy_thread, drdy_stack, K_THREAD_STACK_SIZEOF(drdy_stack),
+                    drdy_thread_entry, dev, NULL, NULL,
+                    CONFIG_L3_DRDY_THREAD_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&drdy_thread, "bmi323_drdy");
+
+    /* A sample may already be waiting, its edge happened before the interrupt was enabled. */
+    k_sem_give(&drdy_sem);
+#endif
+
+    return 0;
+}
+
+int bmi323_drdy_get(imu_sample_t *sample, k_timeout_t timeout)
+{
+#if defined(CONFIG_L3_PROC_THREAD)
+    return -ENOTSUP;
+#else
+    return k_msgq_get(&drdy_msgq, sample, timeout);
+#endif
+}
+
+uint32_t bmi323_drdy_overruns(void)
+{
+    return (uint32_t)atomic_get(&overruns);
+}
+
+/*!
+ * @brief This internal API configures the INT1 pin of the BMI323.
+ *
+ * @details
+ *      the pin is push-pull, active high and non-latched: it rises when a new accel sample is ready
+ *      and falls again once the data registers are read, which gives us exactly one edge per sample.
+ */
+static int8_t set_int1_config(struct bmi3_dev *dev)
+{
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    struct bmi3_int_pin_config int_cfg;
+    struct bmi3_map_int map_int = { 0 };
+
+    rslt = bmi323_get_int_pin_config(&int_cfg, dev);
+
+    if (rslt == BMI323_OK)
+    {
+        int_cfg.pin_type = BMI3_INT1;
+        int_cfg.int_latch = BMI3_INT_LATCH_DIS;
+        int_cfg.pin_cfg[0].output_en = BMI3_INT_OUTPUT_ENABLE;
+        int_cfg.pin_cfg[0].od = BMI3_INT_PUSH_PULL;
+        int_cfg.pin_cfg[0].lvl = BMI3_INT_ACTIVE_HIGH;
+
+        rslt = bmi323_set_int_pin_config(&int_cfg, dev);
+    }
+
+    if (rslt == BMI323_OK)
+    {
+        map_int.acc_drdy_int = BMI3_INT1;
+        rslt = bmi323_map_interrupt(map_int, dev);
+    }
+
+    return rslt;
+}
+
+#if defined(CONFIG_L3_BUS_ASYNC)
+/*!
+ * @brief GPIOTE callback of the INT1 line.
+ *
+ * @details
+ *      the chained STATUS + data read is queued directly from the interrupt, no thread has to wake up
+ *      before the transfer starts and the CPU is free while the TWIM moves the bytes. if the previous
+ *      read of the same buffers is still in flight, this sample is lost.
+ */
+static void int1_triggered(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins)
+{
+    if (bmi323_async_submit(&drdy_req, drdy_reads, ARRAY_SIZE(drdy_reads)) != 0)
+    {
+        atomic_inc(&overruns);
+    }
+}
+
+/*!
+ * @brief Completion callback of the chained STATUS + data read.
+ *
+ * @details
+ *      reading STATUS clears its data-ready flags, a burst read without the accel flag set did not
+ *      follow a real data-ready edge (e.g. the start-up read) and is not queued.
+ */
+static void drdy_read_done(int result, void *user_data)
+{
+    imu_sample_t sample;
+    uint16_t status;
+
+    if (result < 0)
+    {
+        atomic_inc(&overruns);
+        return;
+    }
+
+    status = sys_get_le16(&status_buf[BMI323_ASYNC_DUMMY_BYTES]);
+
+    if (!(status & BMI3_STATUS_DRDY_ACC))
+    {
+        return;
+    }
+
+    parse_burst(&burst_buf[BMI323_ASYNC_DUMMY_BYTES], &sample);
+    sample.read_cycles = k_cycle_get_32();
+
+    queue_sample(&sample);
+}
+#else
+/*!
+ * @brief GPIOTE callback of the INT1 line.
+ *
+ * @details
+ *      nothing is read here (the I2C driver cannot be used from an interrupt), we only wake the
+ *      acquisition thread. if the semaphore is still given, the thread did not pick up the
+ *      previous sample yet and one sample is lost.
+ */
+static void int1_triggered(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins)
+{
+    if (k_sem_count_get(&drdy_sem) != 0)
+    {
+        atomic_inc(&overruns);
+    }
+
+    k_sem_give(&drdy_sem);
+}
+
+/*!
+ * @brief Entry of the acquisition thread.
+ *
+ * @details
+ *      the thread sleeps on the semaphore until the sensor reports a new sample, then reads accel,
+ *      gyro and the sensor time in a single burst (one I2C transaction instead of three). INT1 is edge
+ *      triggered and not latched: a data-ready that arrives during the burst can keep the line high
+ *      with no new edge. the wait therefore ends after DRDY_TIMEOUT_US and STATUS is read instead,
+ *      a sample that is waiting is read like after an edge and the line is released again.
+ */
+static void drdy_thread_entry(void *p1, void *p2, void *p3)
+{
+    struct bmi3_dev *dev = (struct bmi3_dev *)p1;
+
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    uint8_t burst[DATA_BURST_WORDS * 2U];
+    uint8_t status[STATUS_BYTES];
+    imu_sample_t sample;
+
+    while (1)
+    {
+        if (k_sem_take(&drdy_sem, K_USEC(DRDY_TIMEOUT_US)) != 0)
+        {
+            /* No edge for 4 ODR periods, only read the data if the sensor has a sample ready. */
+            rslt = bmi323_get_regs(BMI3_REG_STATUS, status, sizeof(status), dev);
+
+            if ((rslt != BMI323_OK) || !(sys_get_le16(status) & BMI3_STATUS_DRDY_ACC))
+            {
+                continue;
+            }
+        }
+
+        rslt = bmi323_get_regs(BMI3_REG_ACC_DATA_X, burst, sizeof(burst), dev);
+        sample.read_cycles = k_cycle_get_32();
+
+        if (rslt != BMI323_OK)
+        {
+            bmi3_error_codes_print_result("bmi323_get_regs", rslt);
+            continue;
+        }
+
+        parse_burst(burst, &sample);
+
+        queue_sample(&sample);
+    }
+}
+#endif
+
+/*!
+ * @brief This internal function decodes a data burst into a sample, all the registers are little-endian.
+ */
+static void parse_burst(const uint8_t *burst, imu_sample_t *sample)
+{
+    sample->acc_x = (int16_t)sys_get_le16(&burst[(BURST_ACC_X + 0U) * 2U]);
+    sample->acc_y = (int16_t)sys_get_le16(&burst[(BURST_ACC_X + 1U) * 2U]);
+    sample->acc_z = (int16_t)sys_get_le16(&burst[(BURST_ACC_X + 2U) * 2U]);
+    sample->gyr_x = (int16_t)sys_get_le16(&burst[(BURST_GYR_X + 0U) * 2U]);
+    sample->gyr_y = (int16_t)sys_get_le16(&burst[(BURST_GYR_X + 1U) * 2U]);
+    sample->gyr_z = (int16_t)sys_get_le16(&burst[(BURST_GYR_X + 2U) * 2U]);
+    sample->sensor_time = sys_get_le32(&burst[BURST_TIME_0 * 2U]);
+}
+
+/*!
+ * @brief This internal function hands a sample to the consumer.
+ *
+ * @details
+ *      with CONFIG_L3_PROC_THREAD the sample goes straight into the ring of the processing thread, this
+ *      context is then its only producer. otherwise it is queued for bmi323_drdy_get(). the timing
+ *      statistics see every sample that was read, also the ones a full queue then loses.
+ */
+static void queue_sample(const imu_sample_t *sample)
+{
+#if defined(CONFIG_L3_TIMING)
+    imu_timing_update(sample);
+#endif
+
+#if defined(CONFIG_L3_PROC_THREAD)
+    if (imu_proc_put(sample) != 0)
+#else
+    if (k_msgq_put(&drdy_msgq, sample, K_NO_WAIT) != 0)
+#endif
+    {
+        atomic_inc(&overruns);
+    }
+}
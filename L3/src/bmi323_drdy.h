@@ -0,0 +1,140 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   BMI323 interrupt driven sampling                                                                            |
+ * |    @file           :   bmi323_drdy.h                                                                                               |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the INT1 data-ready triggered acquisition thread of the BMI323                           |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef BMI323_DRDY_H_
+#define BMI323_DRDY_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the 'k_timeout_t' type
+ */
+#include <zephyr/kernel.h>
+
+/**
+ * @reason: provide 'struct bmi3_dev' and the BMI323 interrupt API
+ */
+#include <bmi323.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type the acquisition thread produces
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int bmi323_drdy_start(struct bmi3_dev *dev);
+ *  \b Description                              :       route the accel data-ready interrupt of the BMI323 to its INT1 pin, enable a GPIOTE
+ *                                                      edge interrupt on the MCU side and start the acquisition thread.
+ *  @param  dev [IN]                            :       structure instance of bmi3_dev, it has to stay valid while the thread runs.
+ *  @note                                       :       accel and gyro run at the same ODR, so the accel data-ready signals both.
+ *                                                      with CONFIG_L3_BUS_ASYNC the interrupt queues the read itself (refer to 'bmi323_async.h')
+ *                                                      and no acquisition thread is started.
+ *                                                      with CONFIG_L3_PROC_THREAD the samples are put into the ring of 'imu_proc.h' instead.
+ *  \b PRE-CONDITION                            :       bmi323_init() succeeded and both accel and gyro are configured.
+ *  \b POST-CONDITION                           :       every new sample is read by the acquisition thread and queued for bmi323_drdy_get().
+ *  @return                                     :       0 on success, -ENODEV if the INT1 gpio is not ready, -EIO if the sensor could not be
+ *                                                      configured or the negative error code of the failing gpio call.
+ *  @see                                        :       int bmi323_drdy_get(imu_sample_t *sample, k_timeout_t timeout);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_drdy_start(struct bmi3_dev *dev);
+
+
+/**
+ *  \b function                                 :       int bmi323_drdy_get(imu_sample_t *sample, k_timeout_t timeout);
+ *  \b Description                              :       take the oldest sample read by the acquisition thread.
+ *  @param  sample [OUT]                        :       receives the sample.
+ *  @param  timeout [IN]                        :       how long to wait for a sample, K_FOREVER to sleep until one is ready.
+ *  @note                                       :       not available with CONFIG_L3_PROC_THREAD, the processing thread gets the samples.
+ *  \b PRE-CONDITION                            :       bmi323_drdy_start() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -EAGAIN if no sample arrived before 'timeout', -ENOTSUP with
+ *                                                      CONFIG_L3_PROC_THREAD.
+ *  @see                                        :       int bmi323_drdy_start(struct bmi3_dev *dev);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_drdy_get(imu_sample_t *sample, k_timeout_t timeout);
+
+
+/**
+ *  \b function                                 :       uint32_t bmi323_drdy_overruns(void);
+ *  \b Description                              :       number of samples lost so far, either because a new data-ready edge arrived before
+ *                                                      the previous sample was read or because the sample queue (or ring) was full.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       the overrun counter.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+uint32_t bmi323_drdy_overruns(void);
+
+
+/*** End of File **************************************************************/
+
+#endif /*BMI323_DRDY_H_*/
@@ -0,0 +1,420 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+// include k_cycle_get_32() and the conversion of the cycles
+#include <zephyr/kernel.h>
+
+// include the MIN() macro
+#include <zephyr/sys/util.h>
+
+#include <string.h>
+
+// include sys_get_le16() for the sensor time registers
+#include <zephyr/sys/byteorder.h>
+
+// include the FIFO context and the chunked read of one sensor
+#include "bmi323_fifo.h"
+
+#include "bmi323_dual.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * k_cycle_get_32()                 |   https://docs.zephyrproject.org/latest/kernel/services/timing/clocks.html
+ * sys_clock_hw_cycles_per_sec()    |   https://docs.zephyrproject.org/latest/kernel/services/timing/clocks.html
+ * sys_get_le16()                   |   https://docs.zephyrproject.org/latest/doxygen/html/group__byteorder.html
+ * bmi323_fifo_init() / _drain()    |   refer to 'bmi323_fifo.h'
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Sensor time of the BMI323, 39.0625 us per tick: 25600 ticks per second. */
+#define SENSOR_TICKS_PER_SEC    (25600U)
+
+/*! SENSOR_TIME_0 and SENSOR_TIME_1, the lower and the upper word of the sensor time. */
+#define SENSOR_TIME_BYTES       (4U)
+
+/*! Frames kept per sensor: a full FIFO plus the frames that wait for a partner. */
+#define PENDING_FRAMES          (BMI323_FIFO_MAX_FRAMES + 16U)
+
+/*! Weight of the interpolation, Q15. */
+#define WEIGHT_ONE              (1L << 15)
+
+/******************************************************************************/
+/*!         Typedefs                                                          */
+
+/*! One of the two sensors and the frames it delivered that are not fused yet. */
+typedef struct {
+    struct bmi3_dev *dev;
+    bmi323_fifo_t fifo;
+    imu_sample_t pending[PENDING_FRAMES];
+    bool used[PENDING_FRAMES];  /**< the frame is part of a fused sample */
+    uint16_t count;
+    uint32_t frames;
+    uint32_t unpaired;
+} dual_sensor_t;
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+static dual_sensor_t sensors[BMI323_DUAL_SENSORS];
+
+/*! Time between two frames in sensor ticks. */
+static int32_t period_ticks;
+
+/*! Sensor time of the second sensor and its offset to the first one at the last two syncs, oldest first. */
+static uint32_t sync_time_b[2];
+static int32_t sync_offset[2];
+static uint32_t syncs;
+
+static uint32_t fused;
+static uint32_t drains;
+
+/*! Cycles the drain sequences took, and the cycles since bmi323_dual_init(). */
+static uint64_t bus_cycles;
+static uint64_t elapsed_cycles;
+static uint32_t last_cycles;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function reads the sensor time of both sensors back to back and keeps their offset.
+ *
+ *  @return Status of execution.
+ */
+static int8_t sync_sensor_time(void);
+
+/*!
+ *  @brief This internal function converts a sensor time of the second sensor to the sensor time of the first one.
+ *
+ *  @param[in] time_b    : Sensor time of the second sensor.
+ *
+ *  @return Sensor time of the first sensor at the same instant.
+ */
+static uint32_t to_time_a(uint32_t time_b);
+
+/*!
+ *  @brief This internal function removes the oldest frames of a sensor, the ones that were never fused are counted.
+ *
+ *  @param[in] sensor    : The sensor.
+ *  @param[in] n         : Number of frames to remove.
+ */
+static void drop_oldest(dual_sensor_t *sensor, uint16_t n);
+
+/*!
+ *  @brief This internal function averages one axis of the first sensor with the second one interpolated to its time.
+ *
+ *  @param[in] a         : Axis of the first sensor.
+ *  @param[in] b0        : Axis of the second sensor, frame before.
+ *  @param[in] b1        : Axis of the second sensor, frame after.
+ *  @param[in] weight    : Position of the first sensor's frame between both, Q15.
+ *
+ *  @return The fused axis.
+ */
+static inline int16_t fuse_axis(int16_t a, int16_t b0, int16_t b1, int32_t weight);
+
+/*!
+ *  @brief This internal function fuses the pending frames of both sensors.
+ *
+ *  @param[out] samples      : Array that receives the fused samples.
+ *  @param[in]  max_samples  : Capacity of 'samples'.
+ *
+ *  @return Number of fused samples.
+ */
+static uint16_t fuse(imu_sample_t *samples, uint16_t max_samples);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int8_t bmi323_dual_init(struct bmi3_dev *dev_a, struct bmi3_dev *dev_b, uint16_t wm_frames, uint16_t odr_hz)
+{
+    /* Status of API are returned to this variable. */
+    int8_t rslt = BMI323_OK;
+
+    if (odr_hz == 0)
+    {
+        return BMI3_E_INVALID_INPUT;
+    }
+
+    memset(sensors, 0, sizeof(sensors));
+    sensors[0].dev = dev_a;
+    sensors[1].dev = dev_b;
+
+    for (uint8_t s = 0; (s < BMI323_DUAL_SENSORS) && (rslt == BMI323_OK); s++)
+    {
+        rslt = bmi323_fifo_init(&sensors[s].fifo, wm_frames, sensors[s].dev);
+    }
+
+    period_ticks = (int32_t)(SENSOR_TICKS_PER_SEC / odr_hz);
+    syncs = 0;
+    fused = 0;
+    drains = 0;
+    bus_cycles = 0;
+    elapsed_cycles = 0;
+    last_cycles = k_cycle_get_32();
+
+    if (rslt == BMI323_OK)
+    {
+        rslt = sync_sensor_time();
+    }
+
+    return rslt;
+}
+
+/*!
+ * @brief read both FIFOs in one sequence and fuse what they delivered.
+ *
+ * @details
+ *      the sequence is all the bus sees of this mode: two sensor time reads, then a fill level read and
+ *      the chunked burst reads (refer to bmi323_fifo_drain()) of each sensor, per watermark period.
+ *      there is no INT status to poll, the caller knows when a watermark worth of frames is there. the
+ *      sensor times are taken first, the frames of the bursts are older than them, the offset is
+ *      interpolated backwards between the syncs. main.c checks at build time that the sequence fits
+ *      one watermark period on the bus.
+ */
+int8_t bmi323_dual_drain(imu_sample_t *samples, uint16_t max_samples, uint16_t *count)
+{
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    uint32_t start = k_cycle_get_32();
+    uint16_t n;
+
+    *count = 0;
+
+    rslt = sync_sensor_time();
+
+    for (uint8_t s = 0; (s < BMI323_DUAL_SENSORS) && (rslt == BMI323_OK); s++)
+    {
+        dual_sensor_t *sensor = &sensors[s];
+
+        /* A burst reads every complete frame of the FIFO, room for a full one has to be there. */
+        if ((PENDING_FRAMES - sensor->count) < BMI323_FIFO_MAX_FRAMES)
+        {
+            drop_oldest(sensor, (uint16_t)(BMI323_FIFO_MAX_FRAMES - (PENDING_FRAMES - sensor->count)));
+        }
+
+        rslt = bmi323_fifo_drain(&sensor->fifo, &sensor->pending[sensor->count], (uint16_t)(PENDING_FRAMES - sensor->count),
+                                 &n, sensor->dev);
+
+        sensor->count += n;
+        sensor->frames += n;
+    }
+
+    bus_cycles += k_cycle_get_32() - start;
+    elapsed_cycles += start - last_cycles;
+    last_cycles = start;
+    drains++;
+
+    if (rslt == BMI323_OK)
+    {
+        *count = fuse(samples, max_samples);
+    }
+
+    return rslt;
+}
+
+void bmi323_dual_get_stats(bmi323_dual_stats_t *stats)
+{
+    for (uint8_t s = 0; s < BMI323_DUAL_SENSORS; s++)
+    {
+        stats->sensor[s].frames = sensors[s].frames;
+        stats->sensor[s].overruns = sensors[s].fifo.overruns;
+        stats->sensor[s].unpaired = sensors[s].unpaired;
+    }
+
+    stats->fused = fused;
+    stats->offset_ticks = sync_offset[1];
+    stats->drift_ppm = 0;
+
+    if ((syncs > 1) && (sync_time_b[1] != sync_time_b[0]))
+    {
+        stats->drift_ppm = (int32_t)(((int64_t)(sync_offset[1] - sync_offset[0]) * 1000000LL) /
+                                     (int32_t)(sync_time_b[1] - sync_time_b[0]));
+    }
+
+    stats->drains = drains;
+    stats->bus_us_per_drain = (drains > 0) ? (uint32_t)(k_cyc_to_us_floor64(bus_cycles) / drains) : 0;
+    stats->bus_permille = (elapsed_cycles > 0) ? (uint32_t)((bus_cycles * 1000ULL) / elapsed_cycles) : 0;
+}
+
+/*!
+ * @brief This internal function reads the sensor time of both sensors back to back.
+ *
+ * @details
+ *      each value is latched somewhere during its read, it is taken as the middle of it: the second
+ *      sensor time was latched half the time of both reads after the first one. the error is a fraction
+ *      of one read (tens of us on I2C), small against the time between two frames up to 1600 Hz.
+ */
+static int8_t sync_sensor_time(void)
+{
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    uint8_t time_a[SENSOR_TIME_BYTES], time_b[SENSOR_TIME_BYTES];
+    uint32_t cycles_0, cycles_2;
+    uint32_t a, b, between;
+
+    cycles_0 = k_cycle_get_32();
+    rslt = bmi323_get_regs(BMI3_REG_SENSOR_TIME_0, time_a, sizeof(time_a), sensors[0].dev);
+
+    if (rslt == BMI323_OK)
+    {
+        rslt = bmi323_get_regs(BMI3_REG_SENSOR_TIME_0, time_b, sizeof(time_b), sensors[1].dev);
+    }
+
+    cycles_2 = k_cycle_get_32();
+
+    if (rslt != BMI323_OK)
+    {
+        return rslt;
+    }
+
+    a = sys_get_le16(&time_a[0]) | ((uint32_t)sys_get_le16(&time_a[2]) << 16);
+    b = sys_get_le16(&time_b[0]) | ((uint32_t)sys_get_le16(&time_b[2]) << 16);
+    between = (uint32_t)(((uint64_t)((cycles_2 - cycles_0) / 2U) * SENSOR_TICKS_PER_SEC) / sys_clock_hw_cycles_per_sec());
+
+    sync_time_b[0] = sync_time_b[1];
+    sync_offset[0] = sync_offset[1];
+    sync_time_b[1] = b;
+    sync_offset[1] = (int32_t)(a + between - b);
+    syncs++;
+
+    return BMI323_OK;
+}
+
+/*!
+ * @brief This internal function converts a sensor time of the second sensor to the first one.
+ *
+ * @details
+ *      both oscillators drift against each other, the offset is a straight line through the last two
+ *      syncs. a frame read right after a sync is up to one watermark period older than it.
+ */
+static uint32_t to_time_a(uint32_t time_b)
+{
+    int32_t offset = sync_offset[1];
+
+    if ((syncs > 1) && (sync_time_b[1] != sync_time_b[0]))
+    {
+        offset += (int32_t)(((int64_t)(sync_offset[1] - sync_offset[0]) * (int32_t)(time_b - sync_time_b[1])) /
+                            (int32_t)(sync_time_b[1] - sync_time_b[0]));
+    }
+
+    return time_b + (uint32_t)offset;
+}
+
+/*!
+ * @brief This internal function removes the oldest frames of a sensor.
+ */
+static void drop_oldest(dual_sensor_t *sensor, uint16_t n)
+{
+    n = MIN(n, sensor->count);
+
+    for (uint16_t k = 0; k < n; k++)
+    {
+        if (!sensor->used[k])
+        {
+            sensor->unpaired++;
+        }
+    }
+
+    sensor->count -= n;
+    memmove(&sensor->pending[0], &sensor->pending[n], sensor->count * sizeof(sensor->pending[0]));
+    memmove(&sensor->used[0], &sensor->used[n], sensor->count * sizeof(sensor->used[0]));
+    memset(&sensor->used[sensor->count], 0, n * sizeof(sensor->used[0]));
+}
+
+/*!
+ * @brief This internal function averages one axis with the interpolated second sensor.
+ */
+static inline int16_t fuse_axis(int16_t a, int16_t b0, int16_t b1, int32_t weight)
+{
+    int32_t b = b0 + ((((int32_t)b1 - b0) * weight) >> 15);
+
+    return (int16_t)((a + b) / 2);
+}
+
+/*!
+ * @brief This internal function fuses the pending frames of both sensors.
+ *
+ * @details
+ *      both sensors sample at the same rate but not at the same instants, the second sensor is
+ *      interpolated linearly between its two frames around the frame of the first one and both are
+ *      averaged. a frame of the first sensor is dropped if the second one has no frame within one
+ *      period on both sides of it (before its first frame or around its lost frames), and it waits if
+ *      the second sensor has no later frame yet. the frames of the second sensor are kept while they
+ *      may still be the earlier one of a pair.
+ */
+static uint16_t fuse(imu_sample_t *samples, uint16_t max_samples)
+{
+    dual_sensor_t *a = &sensors[0];
+    dual_sensor_t *b = &sensors[1];
+    const imu_sample_t *b0, *b1;
+    uint16_t i = 0, j = 0, n = 0;
+    uint32_t time;
+    int32_t left, right, weight;
+
+    while ((i < a->count) && (n < max_samples) && (b->count > 0))
+    {
+        time = a->pending[i].sensor_time;
+
+        /* The latest frame of the second sensor that is not later than the frame of the first one. */
+        while (((j + 1U) < b->count) && ((int32_t)(to_time_a(b->pending[j + 1U].sensor_time) - time) <= 0))
+        {
+            j++;
+        }
+
+        left = (int32_t)(time - to_time_a(b->pending[j].sensor_time));
+
+        if (left < 0)
+        {
+            i++;
+            continue;
+        }
+
+        if ((j + 1U) >= b->count)
+        {
+            break;
+        }
+
+        right = (int32_t)(to_time_a(b->pending[j + 1U].sensor_time) - time);
+
+        if ((left > period_ticks) || (right > period_ticks))
+        {
+            i++;
+            continue;
+        }
+
+        b0 = &b->pending[j];
+        b1 = &b->pending[j + 1U];
+        weight = (int32_t)((left * WEIGHT_ONE) / (left + right));
+
+        samples[n].acc_x = fuse_axis(a->pending[i].acc_x, b0->acc_x, b1->acc_x, weight);
+        samples[n].acc_y = fuse_axis(a->pending[i].acc_y, b0->acc_y, b1->acc_y, weight);
+        samples[n].acc_z = fuse_axis(a->pending[i].acc_z, b0->acc_z, b1->acc_z, weight);
+        samples[n].gyr_x = fuse_axis(a->pending[i].gyr_x, b0->gyr_x, b1->gyr_x, weight);
+        samples[n].gyr_y = fuse_axis(a->pending[i].gyr_y, b0->gyr_y, b1->gyr_y, weight);
+        samples[n].gyr_z = fuse_axis(a->pending[i].gyr_z, b0->gyr_z, b1->gyr_z, weight);
+
+        samples[n].sensor_time = time;
+        samples[n].read_cycles = a->pending[i].read_cycles;
+
+        a->used[i] = true;
+        b->used[j] = true;
+        b->used[j + 1U] = true;
+        n++;
+        i++;
+    }
+
+    /* The frames of the first sensor that were passed are done, fused or not. */
+    drop_oldest(a, i);
+    drop_oldest(b, j);
+
+    fused += n;
+
+    return n;
+}
@@ -0,0 +1,180 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   two BMI323 on one bus                                                                                       |
+ * |    @file           :   bmi323_dual.h                                                                                               |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file drains the FIFOs of two BMI323 on one bus and fuses their frames aligned by sensor time           |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef BMI323_DUAL_H_
+#define BMI323_DUAL_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide 'struct bmi3_dev'
+ */
+#include <bmi323.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type of the fused samples
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * number of sensors on the bus, the first one is the reference of the sensor time
+ */
+#define BMI323_DUAL_SENSORS             (2U)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: bmi323_dual_sensor_stats_t
+ * @brief: counters of one of the two sensors since bmi323_dual_init()
+ */
+typedef struct {
+    uint32_t frames;            /**< frames read out of its FIFO */
+    uint32_t overruns;          /**< drains that found its FIFO full, frames were lost before they were read */
+    uint32_t unpaired;          /**< frames dropped without being part of a fused sample */
+} bmi323_dual_sensor_stats_t;
+
+/**
+ * @struct: bmi323_dual_stats_t
+ * @brief: alignment of the two sensors and occupancy of the bus they share
+ */
+typedef struct {
+    bmi323_dual_sensor_stats_t sensor[BMI323_DUAL_SENSORS];
+    uint32_t fused;             /**< samples handed out */
+    int32_t offset_ticks;       /**< added to a sensor time of the second sensor gives the one of the first, last sync */
+    int32_t drift_ppm;          /**< change of 'offset_ticks' between the last two syncs, per million ticks */
+    uint32_t drains;            /**< calls of bmi323_dual_drain() */
+    uint32_t bus_us_per_drain;  /**< average time of one drain sequence on the bus */
+    uint32_t bus_permille;      /**< share of the time the drain sequences took the bus */
+} bmi323_dual_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int8_t bmi323_dual_init(struct bmi3_dev *dev_a, struct bmi3_dev *dev_b, uint16_t wm_frames, uint16_t odr_hz);
+ *  \b Description                              :       set up the FIFO of both sensors and relate their sensor times.
+ *  @param  dev_a [IN]                          :       the first sensor, its sensor time is the one of the fused samples.
+ *  @param  dev_b [IN]                          :       the second sensor, on the same bus.
+ *  @param  wm_frames [IN]                      :       watermark of both FIFOs in frames, refer to bmi323_fifo_init().
+ *  @param  odr_hz [IN]                         :       output data rate both sensors run at.
+ *  @note                                       :       both sensors need the same accel and gyro configuration.
+ *  \b PRE-CONDITION                            :       both sensors are initialized and configured.
+ *  \b POST-CONDITION                           :       the statistics are cleared.
+ *  @return                                     :       BMI323_OK on success, otherwise the error code of the failing BMI323 call.
+ *  @see                                        :       int8_t bmi323_dual_drain(imu_sample_t *samples, uint16_t max_samples, uint16_t *count);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int8_t bmi323_dual_init(struct bmi3_dev *dev_a, struct bmi3_dev *dev_b, uint16_t wm_frames, uint16_t odr_hz);
+
+
+/**
+ *  \b function                                 :       int8_t bmi323_dual_drain(imu_sample_t *samples, uint16_t max_samples, uint16_t *count);
+ *  \b Description                              :       read both FIFOs in one sequence on the bus and fuse the frames taken at the same
+ *                                                      instant into samples.
+ *  @param  samples [OUT]                       :       array that receives the fused samples, oldest first.
+ *  @param  max_samples [IN]                    :       capacity of 'samples', the frames beyond it are fused by the next call.
+ *  @param  count [OUT]                         :       number of samples written into 'samples'.
+ *  @note                                       :       the sequence is: both sensor times back to back, then the fill level and the chunked
+ *                                                      bursts of complete frames of each FIFO, no interrupt status is read. every frame of the
+ *                                                      first sensor is averaged with the second sensor interpolated to its sensor time,
+ *                                                      the last frames wait for the next call until the second sensor has a frame after
+ *                                                      them. call it at least once per watermark period, a FIFO that runs full is an
+ *                                                      overrun.
+ *  \b PRE-CONDITION                            :       bmi323_dual_init() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       BMI323_OK on success, otherwise the error code of the failing BMI323 call.
+ *  @see                                        :       void bmi323_dual_get_stats(bmi323_dual_stats_t *stats);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int8_t bmi323_dual_drain(imu_sample_t *samples, uint16_t max_samples, uint16_t *count);
+
+
+/**
+ *  \b function                                 :       void bmi323_dual_get_stats(bmi323_dual_stats_t *stats);
+ *  \b Description                              :       read the counters of both sensors, their alignment and the occupancy of the bus.
+ *  @param  stats [OUT]                         :       receives the statistics.
+ *  \b PRE-CONDITION                            :       bmi323_dual_init() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void bmi323_dual_get_stats(bmi323_dual_stats_t *stats);
+
+
+/*** End of File **************************************************************/
+
+#endif /*BMI323_DUAL_H_*/
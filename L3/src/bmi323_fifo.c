@@ -0,0 +1,250 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+// include k_cycle_get_32()
+#include <zephyr/kernel.h>
+
+// include the MIN() macro
+#include <zephyr/sys/util.h>
+
+// include sys_get_le16() for the sensor time register
+#include <zephyr/sys/byteorder.h>
+
+#include <string.h>
+
+// include the bmi323 FIFO API function headers
+#include <bmi323.h>
+
+#include "bmi323_fifo.h"
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Frames stored in the FIFO for every sample: accel, gyro and the sensor time. */
+#define FIFO_SENSORS            (BMI3_FIFO_ACC_EN | BMI3_FIFO_GYR_EN | BMI3_FIFO_TIME_EN)
+
+/*! Dummy bytes the BMI323 sends ahead of every read (2 on I2C, 1 on SPI), reserve the larger. */
+#define FIFO_MAX_DUMMY_BYTES    (2U)
+
+/*! Largest EasyDMA transfer of the nRF52832 TWIM and SPIM (MAXCNT), dummy bytes included. */
+#define BUS_MAX_TRANSFER_BYTES  (255U)
+
+BUILD_ASSERT(((BMI323_FIFO_CHUNK_FRAMES * BMI323_FIFO_FRAME_SIZE_BYTES) + FIFO_MAX_DUMMY_BYTES) <= BUS_MAX_TRANSFER_BYTES,
+             "a chunk of the FIFO has to fit one bus transfer");
+
+/*! Bit of the FIFO_CTRL register that clears the FIFO content. */
+#define FIFO_CTRL_FLUSH         (0x01U)
+
+/*! SENSOR_TIME_0 and SENSOR_TIME_1, the lower and the upper word of the sensor time. */
+#define SENSOR_TIME_BYTES       (4U)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! Raw bytes of one chunk, shared by every sensor: the drains run one after the other. */
+static uint8_t fifo_raw[(BMI323_FIFO_CHUNK_FRAMES * BMI323_FIFO_FRAME_SIZE_BYTES) + FIFO_MAX_DUMMY_BYTES];
+
+/*! Accel and gyro frames extracted from 'fifo_raw' by the vendor parser. */
+static struct bmi3_fifo_sens_axes_data acc_frames[BMI323_FIFO_CHUNK_FRAMES];
+static struct bmi3_fifo_sens_axes_data gyr_frames[BMI323_FIFO_CHUNK_FRAMES];
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function extends the 16-bit FIFO sensor time to 32-bit by counting wrap-arounds.
+ *
+ *  @param[in] fifo      : Context of the sensor the frame comes from.
+ *  @param[in] time_lo   : Sensor time field of the FIFO frame.
+ *
+ *  @return Monotonic 32-bit sensor time.
+ */
+static uint32_t extend_sensor_time(bmi323_fifo_t *fifo, uint16_t time_lo);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+/*!
+ * @brief configure the FIFO of one sensor and start its context.
+ *
+ * @details
+ *      the sensor time is read right before the FIFO is flushed: every frame that survives the flush is
+ *      younger than it, so the first one drained never looks like a wrap. read after the flush, a frame
+ *      written in between would be older than the seed and shift the sensor by 65536 ticks. its upper
+ *      word seeds the extension of the 16-bit FIFO time, so the samples carry the same 32-bit sensor
+ *      time as the data registers, and two sensors on one bus can be compared.
+ */
+int8_t bmi323_fifo_init(bmi323_fifo_t *fifo, uint16_t wm_frames, struct bmi3_dev *dev)
+{
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    /* Interrupt mapping, only the watermark is routed to INT1. */
+    struct bmi3_map_int map_int = { 0 };
+
+    uint8_t flush[2] = { FIFO_CTRL_FLUSH, 0 };
+
+    uint8_t time[SENSOR_TIME_BYTES] = { 0 };
+
+    if ((wm_frames == 0) || (wm_frames > BMI323_FIFO_MAX_FRAMES))
+    {
+        return BMI3_E_INVALID_INPUT;
+    }
+
+    /* Start from a clean FIFO configuration, then enable only the frames this module parses. */
+    rslt = bmi323_set_fifo_config(BMI3_FIFO_ALL_EN, BMI3_DISABLE, dev);
+
+    if (rslt == BMI323_OK)
+    {
+        rslt = bmi323_set_fifo_config(FIFO_SENSORS, BMI3_ENABLE, dev);
+    }
+
+    /* The watermark register counts 16-bit words, not frames. */
+    if (rslt == BMI323_OK)
+    {
+        rslt = bmi323_set_fifo_wm((uint16_t)(wm_frames * (BMI323_FIFO_FRAME_SIZE_BYTES / 2U)), dev);
+    }
+
+    if (rslt == BMI323_OK)
+    {
+        map_int.fifo_watermark_int = BMI3_INT1;
+        rslt = bmi323_map_interrupt(map_int, dev);
+    }
+
+    if (rslt == BMI323_OK)
+    {
+        rslt = bmi323_get_regs(BMI3_REG_SENSOR_TIME_0, time, sizeof(time), dev);
+    }
+
+    /* Drop whatever was collected while the sensor was being configured. */
+    if (rslt == BMI323_OK)
+    {
+        rslt = bmi323_set_regs(BMI3_REG_FIFO_CTRL, flush, sizeof(flush), dev);
+    }
+
+    fifo->sensor_time_hi = (uint32_t)sys_get_le16(&time[2]) << 16;
+    fifo->sensor_time_last = sys_get_le16(&time[0]);
+    fifo->overruns = 0;
+
+    return rslt;
+}
+
+/*!
+ * @brief read the complete frames of the FIFO in chunks and parse them.
+ *
+ * @details
+ *      the TWIM and SPIM of the nRF52832 move at most 255 bytes per EasyDMA transfer, a bigger read is
+ *      refused by the bus driver. the frames are read in chunks of BMI323_FIFO_CHUNK_FRAMES like the
+ *      stream path of the driver does, every chunk is one read of the FIFO_DATA register and is parsed
+ *      on its own. only as many frames as 'samples' holds are read, the others stay in the FIFO for the
+ *      next drain instead of being read and thrown away.
+ */
+int8_t bmi323_fifo_drain(bmi323_fifo_t *fifo, imu_sample_t *samples, uint16_t max_samples, uint16_t *count, struct bmi3_dev *dev)
+{
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    /* FIFO fill level in words. */
+    uint16_t fifo_words = 0;
+
+    /* Complete frames in the FIFO, then the ones to read. */
+    uint16_t frames;
+
+    /* Frames read so far and frames of the current chunk. */
+    uint16_t done;
+    uint16_t n;
+
+    uint16_t parsed;
+    uint16_t i;
+
+    /* MCU cycle counter right after a chunk, shared by every sample of it. */
+    uint32_t read_cycles;
+
+    struct bmi3_fifo_frame fifoframe;
+
+    *count = 0;
+
+    rslt = bmi323_get_fifo_length(&fifo_words, dev);
+    if ((rslt != BMI323_OK) || (fifo_words == 0))
+    {
+        return rslt;
+    }
+
+    /* No room left for the next frame: the FIFO overwrites its oldest frames until it is read. */
+    if ((uint32_t)fifo_words * 2U > (BMI323_FIFO_SIZE_BYTES - BMI323_FIFO_FRAME_SIZE_BYTES))
+    {
+        fifo->overruns++;
+    }
+
+    /* Only read complete frames, a frame that is being written stays in the FIFO for the next drain. */
+    frames = (uint16_t)(MIN((uint32_t)fifo_words * 2U, BMI323_FIFO_SIZE_BYTES) / BMI323_FIFO_FRAME_SIZE_BYTES);
+    frames = MIN(frames, max_samples);
+
+    for (done = 0; (done < frames) && (rslt == BMI323_OK); done += n)
+    {
+        n = MIN((uint16_t)(frames - done), BMI323_FIFO_CHUNK_FRAMES);
+
+        memset(&fifoframe, 0, sizeof(fifoframe));
+        fifoframe.data = fifo_raw;
+        fifoframe.length = (uint16_t)((n * BMI323_FIFO_FRAME_SIZE_BYTES) + dev->dummy_byte);
+        fifoframe.available_fifo_sens = FIFO_SENSORS;
+
+        rslt = bmi323_read_fifo_data(&fifoframe, dev);
+        read_cycles = k_cycle_get_32();
+
+        if (rslt == BMI323_OK)
+        {
+            rslt = bmi323_extract_accel(acc_frames, &fifoframe, dev);
+        }
+
+        if (rslt == BMI323_OK)
+        {
+            rslt = bmi323_extract_gyro(gyr_frames, &fifoframe, dev);
+        }
+
+        if (rslt != BMI323_OK)
+        {
+            break;
+        }
+
+        /* Accel and gyro share every frame, so both counts match unless a dummy frame was returned. */
+        parsed = MIN(fifoframe.avail_fifo_accel_frames, fifoframe.avail_fifo_gyro_frames);
+        parsed = MIN(parsed, n);
+
+        for (i = 0; i < parsed; i++)
+        {
+            samples[*count].acc_x = acc_frames[i].x;
+            samples[*count].acc_y = acc_frames[i].y;
+            samples[*count].acc_z = acc_frames[i].z;
+            samples[*count].gyr_x = gyr_frames[i].x;
+            samples[*count].gyr_y = gyr_frames[i].y;
+            samples[*count].gyr_z = gyr_frames[i].z;
+            samples[*count].sensor_time = extend_sensor_time(fifo, acc_frames[i].sensor_time);
+            samples[*count].read_cycles = read_cycles;
+            (*count)++;
+        }
+    }
+
+    return rslt;
+}
+
+/*!
+ * @brief This internal function extends the 16-bit FIFO sensor time to 32-bit.
+ *
+ * @details
+ *      the FIFO only stores the lower 16 bits of the sensor time which wrap every ~2.56 s,
+ *      as long as the FIFO is drained more often than that, a smaller value than the previous
+ *      one can only mean that the counter wrapped. main.c checks at build time that a watermark
+ *      period is shorter than one wrap.
+ */
+static uint32_t extend_sensor_time(bmi323_fifo_t *fifo, uint16_t time_lo)
+{
+    if (time_lo < fifo->sensor_time_last)
+    {
+        fifo->sensor_time_hi += 0x10000UL;
+    }
+
+    fifo->sensor_time_last = time_lo;
+
+    return fifo->sensor_time_hi | time_lo;
+}
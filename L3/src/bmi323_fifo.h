@@ -0,0 +1,162 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   BMI323 FIFO-batched acquisition                                                                             |
+ * |    @file           :   bmi323_fifo.h                                                                                               |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the watermark based FIFO drain of the BMI323 (chunked reads per watermark)               |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef BMI323_FIFO_H_
+#define BMI323_FIFO_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide 'struct bmi3_dev' and the BMI323 FIFO API
+ */
+#include <bmi323.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type the FIFO frames are parsed into
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * size of the on-chip FIFO of the BMI323 in bytes (1024 words), refer to the 'FIFO' section in the datasheet
+ */
+#define BMI323_FIFO_SIZE_BYTES          (2048U)
+
+/**
+ * size of one FIFO frame in bytes when accel (3 words), gyro (3 words) and sensor-time (1 word) are enabled
+ */
+#define BMI323_FIFO_FRAME_SIZE_BYTES    (14U)
+
+/**
+ * the maximum number of complete frames the FIFO can hold with the above frame layout
+ */
+#define BMI323_FIFO_MAX_FRAMES          (BMI323_FIFO_SIZE_BYTES / BMI323_FIFO_FRAME_SIZE_BYTES)
+
+/**
+ * frames per read of the FIFO, the nRF52832 TWIM and SPIM move at most 255 bytes per transfer, dummy bytes included
+ */
+#define BMI323_FIFO_CHUNK_FRAMES        (18U)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: bmi323_fifo_t
+ * @brief: what is kept of one sensor between two drains, one instance per BMI323
+ */
+typedef struct {
+    uint32_t sensor_time_hi;    /**< upper 16 bits of the extended sensor time */
+    uint16_t sensor_time_last;  /**< last 16-bit sensor time seen in the FIFO */
+    uint32_t overruns;          /**< drains that found the FIFO full, its oldest frames were overwritten */
+} bmi323_fifo_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int8_t bmi323_fifo_init(bmi323_fifo_t *fifo, uint16_t wm_frames, struct bmi3_dev *dev);
+ *  \b Description                              :       enable the accel, gyro and sensor-time frames of the BMI323 FIFO, set the watermark
+ *                                                      and map the watermark interrupt to INT1.
+ *  @param  fifo [OUT]                          :       context of the sensor, started with its current sensor time.
+ *  @param  wm_frames [IN]                      :       watermark in frames, possible values are 1 to @BMI323_FIFO_MAX_FRAMES.
+ *  @param  dev [IN]                            :       structure instance of bmi3_dev.
+ *  @note                                       :       the FIFO is flushed as part of the initialization.
+ *  \b PRE-CONDITION                            :       bmi323_init() succeeded and both accel and gyro are configured.
+ *  \b POST-CONDITION                           :       the FIFO watermark bit of the INT1 status is set every 'wm_frames' frames.
+ *  @return                                     :       BMI323_OK on success, otherwise the error code of the failing BMI323 call.
+ *  @see                                        :       int8_t bmi323_fifo_drain(bmi323_fifo_t *fifo, imu_sample_t *samples, uint16_t max_samples, uint16_t *count, struct bmi3_dev *dev);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int8_t bmi323_fifo_init(bmi323_fifo_t *fifo, uint16_t wm_frames, struct bmi3_dev *dev);
+
+
+/**
+ *  \b function                                 :       int8_t bmi323_fifo_drain(bmi323_fifo_t *fifo, imu_sample_t *samples, uint16_t max_samples, uint16_t *count, struct bmi3_dev *dev);
+ *  \b Description                              :       read the complete frames of the FIFO in chunks of @BMI323_FIFO_CHUNK_FRAMES and parse the
+ *                                                      accel, gyro and sensor-time frames into an array of samples.
+ *  @param  fifo [IN,OUT]                       :       context of the sensor given to bmi323_fifo_init().
+ *  @param  samples [OUT]                       :       array that receives the parsed samples.
+ *  @param  max_samples [IN]                    :       capacity of 'samples', frames beyond that stay in the FIFO for the next call.
+ *  @param  count [OUT]                         :       number of samples written into 'samples'.
+ *  @param  dev [IN]                            :       structure instance of bmi3_dev.
+ *  @note                                       :       the 16-bit sensor-time of the FIFO frames is extended to 32-bit across calls. a
+ *                                                      full FIFO counts one overrun in 'fifo'. drains of several sensors share one read
+ *                                                      buffer and must not run at the same time.
+ *  \b PRE-CONDITION                            :       bmi323_fifo_init() succeeded.
+ *  \b POST-CONDITION                           :       the FIFO is empty (except for frames written while the chunks were read, or that did not fit 'samples').
+ *  @return                                     :       BMI323_OK on success, otherwise the error code of the failing BMI323 call.
+ *  @see                                        :       int8_t bmi323_fifo_init(bmi323_fifo_t *fifo, uint16_t wm_frames, struct bmi3_dev *dev);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int8_t bmi323_fifo_drain(bmi323_fifo_t *fifo, imu_sample_t *samples, uint16_t max_samples, uint16_t *count, struct bmi3_dev *dev);
+
+
+/*** End of File **************************************************************/
+
+#endif /*BMI323_FIFO_H_*/
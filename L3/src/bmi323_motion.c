@@ -0,0 +1,360 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+// include GPIO drivers
+#include <zephyr/drivers/gpio.h>
+
+// include the common header file that will be used in conjunction with BMI323 drivers
+#include <common.h>
+
+#include "bmi323_motion.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * gpio_pin_interrupt_configure_dt()|   https://docs.zephyrproject.org/latest/doxygen/html/group__gpio__interface.html
+ * k_sem_give() / k_sem_take()      |   https://docs.zephyrproject.org/latest/kernel/services/synchronization/semaphores.html
+ * bmi323_set_sensor_config()       |   refer to '<BMI323_SensorAPI/bmi323.h>' and the datasheet section 'Feature engine'
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+#if defined(CONFIG_L3_MOTION_ANY_NO_MOTION)
+/*! Slope threshold of any/no-motion: 1 LSB = 1/512 g. */
+#define MOTION_SLOPE_THRES      ((CONFIG_L3_MOTION_THRESHOLD_MG * 512U) / 1000U)
+
+/*! Durations of any/no-motion: 1 LSB = one 50 Hz sample of the feature engine (20 ms). */
+#define MOTION_ANY_DURATION     (CONFIG_L3_MOTION_ANY_DURATION_MS / 20U)
+#define MOTION_NO_DURATION      (CONFIG_L3_MOTION_NO_DURATION_MS / 20U)
+#endif
+
+/*! The tap detector needs the accel at 200 Hz, the motion detectors are happy with 50 Hz. */
+#if defined(CONFIG_L3_MOTION_TAP)
+#define MOTION_ACC_ODR          BMI3_ACC_ODR_200HZ
+#else
+#define MOTION_ACC_ODR          BMI3_ACC_ODR_50HZ
+#endif
+
+/*! Interrupt status bits of the enabled features. */
+#define MOTION_EVENTS           (BMI3_INT_STATUS_ANY_MOTION | BMI3_INT_STATUS_NO_MOTION | \
+                                 BMI3_INT_STATUS_TAP | BMI3_INT_STATUS_STEP_COUNTER)
+
+/*! Accel, gyro, any-motion, no-motion, tap and step-counter. */
+#define MOTION_CONFIG_COUNT     (6U)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+// read the gpio configurations of the INT1 line from the 'bmi323' node of the '.overlay' file
+static const struct gpio_dt_spec int1 = GPIO_DT_SPEC_GET(DT_NODELABEL(bmi323), int1_gpios);
+static struct gpio_callback int1_cb_data;
+
+/*! Given from the GPIOTE interrupt, taken by bmi323_motion_wait(). */
+K_SEM_DEFINE(motion_sem, 0, 1);
+
+/*! Set by bmi323_motion_start(). */
+static struct bmi3_dev *motion_dev;
+static int64_t start_ms;
+
+/*! Counters, only written by bmi323_motion_wait(). */
+static bmi323_motion_stats_t motion_stats;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal API configures the accel, the gyro and the features of the feature engine.
+ *
+ *  @param[in] dev       : Structure instance of bmi3_dev.
+ *
+ *  @return Status of execution.
+ */
+static int8_t set_feature_config(struct bmi3_dev *dev);
+
+/*!
+ *  @brief This internal API configures the INT1 pin of the BMI323 (latched) and maps the feature interrupts to it.
+ *
+ *  @param[in] dev       : Structure instance of bmi3_dev.
+ *
+ *  @return Status of execution.
+ */
+static int8_t set_int1_config(struct bmi3_dev *dev);
+
+/*!
+ *  @brief GPIOTE callback of the INT1 line, runs in interrupt context.
+ */
+static void int1_triggered(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int bmi323_motion_start(struct bmi3_dev *dev)
+{
+    int8_t rslt;
+
+    if (!gpio_is_ready_dt(&int1))
+    {
+        return -ENODEV;
+    }
+
+    if (gpio_pin_configure_dt(&int1, GPIO_INPUT) < 0)
+    {
+        return -EIO;
+    }
+
+    rslt = set_feature_config(dev);
+    bmi3_error_codes_print_result("set_feature_config", rslt);
+
+    if (rslt == BMI323_OK)
+    {
+        rslt = set_int1_config(dev);
+        bmi3_error_codes_print_result("set_int1_config", rslt);
+    }
+
+    if (rslt != BMI323_OK)
+    {
+        return -EIO;
+    }
+
+    motion_dev = dev;
+    start_ms = k_uptime_get();
+
+    gpio_init_callback(&int1_cb_data, int1_triggered, BIT(int1.pin));
+
+    if (gpio_add_callback_dt(&int1, &int1_cb_data) < 0)
+    {
+        return -EIO;
+    }
+
+    if (gpio_pin_interrupt_configure_dt(&int1, GPIO_INT_EDGE_TO_ACTIVE) < 0)
+    {
+        return -EIO;
+    }
+
+    /* An event may already be latched, its edge happened before the interrupt was enabled. */
+    k_sem_give(&motion_sem);
+
+    return 0;
+}
+
+/*!
+ * @brief sleep until the sensor reports an event.
+ *
+ * @details
+ *      the interrupt is latched in the sensor, reading INT_STATUS_INT1 clears it and releases the line, so
+ *      the next event gives a new edge. the step count is only read when the step-counter reports, every
+ *      other event costs exactly one register read.
+ */
+int bmi323_motion_wait(uint16_t *events, k_timeout_t timeout)
+{
+    int8_t rslt;
+    uint16_t int_status = 0;
+    struct bmi3_sensor_data step_data = { 0 };
+
+    if (k_sem_take(&motion_sem, timeout) != 0)
+    {
+        return -EAGAIN;
+    }
+
+    motion_stats.wakeups++;
+
+    rslt = bmi323_get_int1_status(&int_status, motion_dev);
+
+    if (rslt != BMI323_OK)
+    {
+        bmi3_error_codes_print_result("bmi323_get_int1_status", rslt);
+        return -EIO;
+    }
+
+    if (int_status & BMI3_INT_STATUS_ANY_MOTION)
+    {
+        motion_stats.any_motion++;
+    }
+
+    if (int_status & BMI3_INT_STATUS_NO_MOTION)
+    {
+        motion_stats.no_motion++;
+    }
+
+    if (int_status & BMI3_INT_STATUS_TAP)
+    {
+        motion_stats.taps++;
+    }
+
+    if (int_status & BMI3_INT_STATUS_STEP_COUNTER)
+    {
+        step_data.type = BMI323_STEP_COUNTER;
+
+        if (bmi323_get_sensor_data(&step_data, 1, motion_dev) == BMI323_OK)
+        {
+            motion_stats.steps = step_data.sens_data.step_counter_output;
+        }
+    }
+
+    if ((int_status & MOTION_EVENTS) == 0U)
+    {
+        motion_stats.spurious++;
+    }
+
+    *events = int_status & MOTION_EVENTS;
+
+    return 0;
+}
+
+void bmi323_motion_get_stats(bmi323_motion_stats_t *stats)
+{
+    *stats = motion_stats;
+    stats->uptime_ms = k_uptime_get() - start_ms;
+}
+
+/*!
+ * @brief This internal API configures the accel, the gyro and the features of the feature engine.
+ *
+ * @details
+ *      the gyro is suspended (it takes most of the current of the sensor) and the accel runs in low
+ *      power mode with 2 samples averaged, which is all the feature engine needs. any-motion and
+ *      no-motion share the slope threshold, each has its own duration. the tap detector keeps the
+ *      timing defaults of the sensor and only looks at the z-axis (device lying flat).
+ */
+static int8_t set_feature_config(struct bmi3_dev *dev)
+{
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    struct bmi3_sens_config config[MOTION_CONFIG_COUNT];
+    struct bmi3_feature_enable feature = { 0 };
+
+    config[0].type = BMI323_ACCEL;
+    config[1].type = BMI323_GYRO;
+    config[2].type = BMI323_ANY_MOTION;
+    config[3].type = BMI323_NO_MOTION;
+    config[4].type = BMI323_TAP;
+    config[5].type = BMI323_STEP_COUNTER;
+
+    /* Get default configurations for the type of feature selected. */
+    rslt = bmi323_get_sensor_config(config, MOTION_CONFIG_COUNT, dev);
+
+    if (rslt != BMI323_OK)
+    {
+        return rslt;
+    }
+
+    config[0].cfg.acc.odr = MOTION_ACC_ODR;
+    config[0].cfg.acc.range = BMI3_ACC_RANGE_4G;
+    config[0].cfg.acc.bwp = BMI3_ACC_BW_ODR_HALF;
+    config[0].cfg.acc.avg_num = BMI3_ACC_AVG2;
+    config[0].cfg.acc.acc_mode = BMI3_ACC_MODE_LOW_PWR;
+
+    config[1].cfg.gyr.gyr_mode = BMI3_GYR_MODE_DISABLE;
+
+#if defined(CONFIG_L3_MOTION_ANY_NO_MOTION)
+    config[2].cfg.any_motion.slope_thres = MOTION_SLOPE_THRES;
+    config[2].cfg.any_motion.hysteresis = MOTION_SLOPE_THRES / 4U;
+    config[2].cfg.any_motion.duration = MOTION_ANY_DURATION;
+    config[2].cfg.any_motion.acc_ref_up = 1;
+    config[2].cfg.any_motion.wait_time = 1;
+
+    config[3].cfg.no_motion.slope_thres = MOTION_SLOPE_THRES;
+    config[3].cfg.no_motion.hysteresis = MOTION_SLOPE_THRES / 4U;
+    config[3].cfg.no_motion.duration = MOTION_NO_DURATION;
+    config[3].cfg.no_motion.acc_ref_up = 1;
+    config[3].cfg.no_motion.wait_time = 1;
+#endif
+
+    /* 2 = z-axis, 1 = normal mode (between sensitive and robust). */
+    config[4].cfg.tap.axis_sel = 2;
+    config[4].cfg.tap.mode = 1;
+
+    /* One interrupt every 20 steps. */
+    config[5].cfg.step_counter.watermark_level = 1;
+
+    rslt = bmi323_set_sensor_config(config, MOTION_CONFIG_COUNT, dev);
+
+    if (rslt != BMI323_OK)
+    {
+        return rslt;
+    }
+
+#if defined(CONFIG_L3_MOTION_ANY_NO_MOTION)
+    feature.any_motion_x_en = BMI3_ENABLE;
+    feature.any_motion_y_en = BMI3_ENABLE;
+    feature.any_motion_z_en = BMI3_ENABLE;
+    feature.no_motion_x_en = BMI3_ENABLE;
+    feature.no_motion_y_en = BMI3_ENABLE;
+    feature.no_motion_z_en = BMI3_ENABLE;
+#endif
+
+#if defined(CONFIG_L3_MOTION_TAP)
+    feature.tap_detector_s_tap_en = BMI3_ENABLE;
+    feature.tap_detector_d_tap_en = BMI3_ENABLE;
+#endif
+
+#if defined(CONFIG_L3_MOTION_STEP_COUNTER)
+    feature.step_counter_en = BMI3_ENABLE;
+#endif
+
+    return bmi323_select_sensor(&feature, dev);
+}
+
+/*!
+ * @brief This internal API configures the INT1 pin of the BMI323.
+ *
+ * @details
+ *      the pin is push-pull, active high and latched: an event keeps the line high until the interrupt
+ *      status is read, so even a short event can not be missed by the GPIOTE edge detection.
+ */
+static int8_t set_int1_config(struct bmi3_dev *dev)
+{
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    struct bmi3_int_pin_config int_cfg;
+    struct bmi3_map_int map_int = { 0 };
+
+    rslt = bmi323_get_int_pin_config(&int_cfg, dev);
+
+    if (rslt == BMI323_OK)
+    {
+        int_cfg.pin_type = BMI3_INT1;
+        int_cfg.int_latch = BMI3_INT_LATCH_EN;
+        int_cfg.pin_cfg[0].output_en = BMI3_INT_OUTPUT_ENABLE;
+        int_cfg.pin_cfg[0].od = BMI3_INT_PUSH_PULL;
+        int_cfg.pin_cfg[0].lvl = BMI3_INT_ACTIVE_HIGH;
+
+        rslt = bmi323_set_int_pin_config(&int_cfg, dev);
+    }
+
+    if (rslt == BMI323_OK)
+    {
+#if defined(CONFIG_L3_MOTION_ANY_NO_MOTION)
+        map_int.any_motion_out = BMI3_INT1;
+        map_int.no_motion_out = BMI3_INT1;
+#endif
+#if defined(CONFIG_L3_MOTION_TAP)
+        map_int.tap_out = BMI3_INT1;
+#endif
+#if defined(CONFIG_L3_MOTION_STEP_COUNTER)
+        map_int.step_counter_out = BMI3_INT1;
+#endif
+        rslt = bmi323_map_interrupt(map_int, dev);
+    }
+
+    return rslt;
+}
+
+/*!
+ * @brief GPIOTE callback of the INT1 line.
+ *
+ * @details
+ *      nothing is read here (the I2C driver cannot be used from an interrupt), we only wake the thread
+ *      waiting in bmi323_motion_wait().
+ */
+static void int1_triggered(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins)
+{
+    k_sem_give(&motion_sem);
+}
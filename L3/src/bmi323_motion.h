@@ -0,0 +1,154 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   BMI323 feature engine motion events                                                                         |
+ * |    @file           :   bmi323_motion.h                                                                                             |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the event driven mode: motion, tap and steps detected on the sensor, the MCU idles       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef BMI323_MOTION_H_
+#define BMI323_MOTION_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the 'k_timeout_t' type
+ */
+#include <zephyr/kernel.h>
+
+/**
+ * @reason: provide 'struct bmi3_dev', the feature configurations and the BMI3_INT_STATUS_* bits
+ */
+#include <bmi323.h>
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: bmi323_motion_stats_t
+ * @brief: counters of the motion mode, they show how rarely the MCU is woken up by the sensor
+ */
+typedef struct {
+    uint32_t wakeups;           /**< INT1 edges served, every one is a wake-up of the MCU */
+    uint32_t any_motion;        /**< any-motion events */
+    uint32_t no_motion;         /**< no-motion events */
+    uint32_t taps;              /**< tap events */
+    uint32_t steps;             /**< step count of the sensor, updated at every step-counter event */
+    uint32_t spurious;          /**< wake-ups without any of the enabled events in the interrupt status */
+    int64_t uptime_ms;          /**< time since bmi323_motion_start() */
+} bmi323_motion_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int bmi323_motion_start(struct bmi3_dev *dev);
+ *  \b Description                              :       move the detection to the feature engine of the BMI323: suspend the gyro, run the accel
+ *                                                      in low power mode, configure the any-motion, no-motion, tap and step-counter features
+ *                                                      (refer to 'CONFIG_L3_MOTION_*') and route their interrupts to the INT1 pin.
+ *  @param  dev [IN]                            :       structure instance of bmi3_dev, it has to stay valid while the mode runs.
+ *  @note                                       :       overrides the accel and gyro configuration done before, the sensor produces no data
+ *                                                      samples in this mode, only events.
+ *  \b PRE-CONDITION                            :       bmi323_init() succeeded (it enables the feature engine).
+ *  \b POST-CONDITION                           :       every event of the sensor makes bmi323_motion_wait() return.
+ *  @return                                     :       0 on success, -ENODEV if the INT1 gpio is not ready, -EIO if the sensor or the gpio
+ *                                                      could not be configured.
+ *  @see                                        :       int bmi323_motion_wait(uint16_t *events, k_timeout_t timeout);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_motion_start(struct bmi3_dev *dev);
+
+
+/**
+ *  \b function                                 :       int bmi323_motion_wait(uint16_t *events, k_timeout_t timeout);
+ *  \b Description                              :       sleep until the sensor reports an event, then read (and clear) its interrupt status and
+ *                                                      update the counters.
+ *  @param  events [OUT]                        :       the BMI3_INT_STATUS_* bits of the events that woke us up.
+ *  @param  timeout [IN]                        :       how long to wait, K_FOREVER to let the MCU idle until the next event.
+ *  @note                                       :       the interrupt status is only read after an INT1 edge, an idle device costs no bus
+ *                                                      transfer and no wake-up at all.
+ *  \b PRE-CONDITION                            :       bmi323_motion_start() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -EAGAIN if no event arrived before 'timeout', -EIO if the status could
+ *                                                      not be read.
+ *  @see                                        :       void bmi323_motion_get_stats(bmi323_motion_stats_t *stats);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_motion_wait(uint16_t *events, k_timeout_t timeout);
+
+
+/**
+ *  \b function                                 :       void bmi323_motion_get_stats(bmi323_motion_stats_t *stats);
+ *  \b Description                              :       read the event and wake-up counters.
+ *  @param  stats [OUT]                         :       receives the counters.
+ *  @note                                       :       the counters are updated by bmi323_motion_wait(), read them from the same thread.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void bmi323_motion_get_stats(bmi323_motion_stats_t *stats);
+
+
+/*** End of File **************************************************************/
+
+#endif /*BMI323_MOTION_H_*/
@@ -0,0 +1,287 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+// include GPIO drivers
+#include <zephyr/drivers/gpio.h>
+
+// include the sys_get_le16() helpers
+#include <zephyr/sys/byteorder.h>
+
+// include the common header file that will be used in conjunction with BMI323 drivers
+#include <common.h>
+
+#include "bmi323_split.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * gpio_pin_interrupt_configure_dt()|   https://docs.zephyrproject.org/latest/doxygen/html/group__gpio__interface.html
+ * k_sem_give() / k_sem_take()      |   https://docs.zephyrproject.org/latest/kernel/services/synchronization/semaphores.html
+ * k_msgq_put() / k_msgq_get()      |   https://docs.zephyrproject.org/latest/kernel/services/data_passing/message_queues.html
+ * k_poll_event_init()              |   https://docs.zephyrproject.org/latest/kernel/services/polling.html
+ * k_thread_create()                |   https://docs.zephyrproject.org/latest/kernel/services/threads/index.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Number of 16-bit registers from STATUS up to SENSOR_TIME_1: status, accel x/y/z, gyro x/y/z, temperature, sensor time (2). */
+#define SPLIT_BURST_WORDS       (10U)
+
+/*! Word offsets inside the burst. */
+#define BURST_STATUS            (0U)
+#define BURST_ACC_X             (1U)
+#define BURST_GYR_X             (4U)
+#define BURST_TIME_0            (8U)
+
+/*! Longest wait for an edge, 4 periods of the slower sensor: the burst then reads STATUS anyway. */
+#define SPLIT_TIMEOUT_US        ((4U * 1000000U) / MIN(CONFIG_L3_IMU_ODR_HZ, CONFIG_L3_GYR_ODR_HZ))
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+// read the gpio configurations of the INT1 line from the 'bmi323' node of the '.overlay' file
+static const struct gpio_dt_spec int1 = GPIO_DT_SPEC_GET(DT_NODELABEL(bmi323), int1_gpios);
+static struct gpio_callback int1_cb_data;
+
+/*! One queue per stream, each one is sized for the ODR of its sensor. */
+K_MSGQ_DEFINE(acc_msgq, sizeof(imu_axis_sample_t), CONFIG_L3_SPLIT_ACC_QUEUE_DEPTH, 4);
+K_MSGQ_DEFINE(gyr_msgq, sizeof(imu_axis_sample_t), CONFIG_L3_SPLIT_GYR_QUEUE_DEPTH, 4);
+
+/*! Queues and overrun counters, indexed by bmi323_split_stream_t. */
+static struct k_msgq *const split_msgq[BMI323_SPLIT_COUNT] = { &acc_msgq, &gyr_msgq };
+static atomic_t overruns[BMI323_SPLIT_COUNT];
+
+/*! Given from the GPIOTE interrupt, taken by the acquisition thread. */
+K_SEM_DEFINE(split_sem, 0, 1);
+
+K_THREAD_STACK_DEFINE(split_stack, CONFIG_L3_DRDY_THREAD_STACK_SIZE);
+static struct k_thread split_thread;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal API configures the INT1 pin of the BMI323 and maps both data-ready interrupts to it.
+ *
+ *  @param[in] dev       : Structure instance of bmi3_dev.
+ *
+ *  @return Status of execution.
+ */
+static int8_t set_int1_config(struct bmi3_dev *dev);
+
+/*!
+ *  @brief GPIOTE callback of the INT1 line, runs in interrupt context.
+ */
+static void int1_triggered(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins);
+
+/*!
+ *  @brief This internal function decodes three axes and the sensor time of a burst into a sample and queues it.
+ */
+static void queue_axes(bmi323_split_stream_t stream, const uint8_t *burst, uint8_t axis_word);
+
+/*!
+ *  @brief Entry of the acquisition thread, p1 is the bmi3_dev instance.
+ */
+static void split_thread_entry(void *p1, void *p2, void *p3);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int bmi323_split_start(struct bmi3_dev *dev)
+{
+    int8_t rslt;
+
+    if (!gpio_is_ready_dt(&int1))
+    {
+        return -ENODEV;
+    }
+
+    if (gpio_pin_configure_dt(&int1, GPIO_INPUT) < 0)
+    {
+        return -EIO;
+    }
+
+    rslt = set_int1_config(dev);
+    bmi3_error_codes_print_result("set_int1_config", rslt);
+
+    if (rslt != BMI323_OK)
+    {
+        return -EIO;
+    }
+
+    gpio_init_callback(&int1_cb_data, int1_triggered, BIT(int1.pin));
+
+    if (gpio_add_callback_dt(&int1, &int1_cb_data) < 0)
+    {
+        return -EIO;
+    }
+
+    if (gpio_pin_interrupt_configure_dt(&int1, GPIO_INT_EDGE_TO_ACTIVE) < 0)
+    {
+        return -EIO;
+    }
+
+    k_thread_create(&split_thread, split_stack, K_THREAD_STACK_SIZEOF(split_stack),
+                    split_thread_entry, dev, NULL, NULL,
+                    CONFIG_L3_DRDY_THREAD_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&split_thread, "bmi323_split");
+
+    /* A sample may already be waiting, its edge happened before the interrupt was enabled. */
+    k_sem_give(&split_sem);
+
+    return 0;
+}
+
+int bmi323_split_get(bmi323_split_stream_t stream, imu_axis_sample_t *sample, k_timeout_t timeout)
+{
+    if (stream >= BMI323_SPLIT_COUNT)
+    {
+        return -EINVAL;
+    }
+
+    return k_msgq_get(split_msgq[stream], sample, timeout);
+}
+
+void bmi323_split_poll_init(struct k_poll_event *events)
+{
+    uint8_t i;
+
+    for (i = 0; i < BMI323_SPLIT_COUNT; i++)
+    {
+        k_poll_event_init(&events[i], K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, split_msgq[i]);
+    }
+}
+
+uint32_t bmi323_split_overruns(bmi323_split_stream_t stream)
+{
+    if (stream >= BMI323_SPLIT_COUNT)
+    {
+        return 0;
+    }
+
+    return (uint32_t)atomic_get(&overruns[stream]);
+}
+
+/*!
+ * @brief This internal API configures the INT1 pin of the BMI323.
+ *
+ * @details
+ *      the pin is push-pull, active high and non-latched. the accel and the gyro data-ready are both
+ *      mapped to it: the line rises when the first of the two has a new sample and falls once the data
+ *      registers of every pending sensor are read. the burst of the thread reads both, so every sample of
+ *      either sensor gives a new edge.
+ */
+static int8_t set_int1_config(struct bmi3_dev *dev)
+{
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    struct bmi3_int_pin_config int_cfg;
+    struct bmi3_map_int map_int = { 0 };
+
+    rslt = bmi323_get_int_pin_config(&int_cfg, dev);
+
+    if (rslt == BMI323_OK)
+    {
+        int_cfg.pin_type = BMI3_INT1;
+        int_cfg.int_latch = BMI3_INT_LATCH_DIS;
+        int_cfg.pin_cfg[0].output_en = BMI3_INT_OUTPUT_ENABLE;
+        int_cfg.pin_cfg[0].od = BMI3_INT_PUSH_PULL;
+        int_cfg.pin_cfg[0].lvl = BMI3_INT_ACTIVE_HIGH;
+
+        rslt = bmi323_set_int_pin_config(&int_cfg, dev);
+    }
+
+    if (rslt == BMI323_OK)
+    {
+        map_int.acc_drdy_int = BMI3_INT1;
+        map_int.gyr_drdy_int = BMI3_INT1;
+        rslt = bmi323_map_interrupt(map_int, dev);
+    }
+
+    return rslt;
+}
+
+/*!
+ * @brief GPIOTE callback of the INT1 line.
+ *
+ * @details
+ *      nothing is read here (the I2C driver cannot be used from an interrupt), we only wake the
+ *      acquisition thread. an edge while the semaphore is still given is not lost: STATUS keeps its
+ *      flags until the next burst reads them.
+ */
+static void int1_triggered(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins)
+{
+    k_sem_give(&split_sem);
+}
+
+/*!
+ * @brief Entry of the acquisition thread.
+ *
+ * @details
+ *      STATUS sits right before the data registers, so one burst from STATUS to SENSOR_TIME_1 costs a
+ *      single I2C transaction per edge: fewer bytes on the bus than a separate STATUS read followed by
+ *      the data of the ready sensor. reading STATUS clears its data-ready flags, a sensor whose flag is
+ *      not set has no new sample and its part of the burst is dropped. INT1 is edge triggered and not
+ *      latched, a data-ready during the burst can keep the line high with no new edge: the wait ends
+ *      after SPLIT_TIMEOUT_US and the burst runs anyway, its STATUS tells what is new.
+ */
+static void split_thread_entry(void *p1, void *p2, void *p3)
+{
+    struct bmi3_dev *dev = (struct bmi3_dev *)p1;
+
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    uint8_t burst[SPLIT_BURST_WORDS * 2U];
+    uint16_t status;
+
+    while (1)
+    {
+        /* A timeout is not an error, the burst below only queues what STATUS flags as new. */
+        (void)k_sem_take(&split_sem, K_USEC(SPLIT_TIMEOUT_US));
+
+        rslt = bmi323_get_regs(BMI3_REG_STATUS, burst, sizeof(burst), dev);
+
+        if (rslt != BMI323_OK)
+        {
+            bmi3_error_codes_print_result("bmi323_get_regs", rslt);
+            continue;
+        }
+
+        status = sys_get_le16(&burst[BURST_STATUS * 2U]);
+
+        if (status & BMI3_STATUS_DRDY_ACC)
+        {
+            queue_axes(BMI323_SPLIT_ACC, burst, BURST_ACC_X);
+        }
+
+        if (status & BMI3_STATUS_DRDY_GYR)
+        {
+            queue_axes(BMI323_SPLIT_GYR, burst, BURST_GYR_X);
+        }
+    }
+}
+
+/*!
+ * @brief This internal function decodes one sensor of a burst and queues it, a full queue counts as an overrun.
+ */
+static void queue_axes(bmi323_split_stream_t stream, const uint8_t *burst, uint8_t axis_word)
+{
+    imu_axis_sample_t sample;
+
+    sample.x = (int16_t)sys_get_le16(&burst[(axis_word + 0U) * 2U]);
+    sample.y = (int16_t)sys_get_le16(&burst[(axis_word + 1U) * 2U]);
+    sample.z = (int16_t)sys_get_le16(&burst[(axis_word + 2U) * 2U]);
+    sample.sensor_time = sys_get_le32(&burst[BURST_TIME_0 * 2U]);
+
+    if (k_msgq_put(split_msgq[stream], &sample, K_NO_WAIT) != 0)
+    {
+        atomic_inc(&overruns[stream]);
+    }
+}
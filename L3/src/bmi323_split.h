@@ -0,0 +1,173 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   BMI323 independent accel and gyro streams                                                                   |
+ * |    @file           :   bmi323_split.h                                                                                              |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the data-ready acquisition of accel and gyro as two streams with their own ODR and queue |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef BMI323_SPLIT_H_
+#define BMI323_SPLIT_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the 'k_timeout_t' and 'struct k_poll_event' types
+ */
+#include <zephyr/kernel.h>
+
+/**
+ * @reason: provide 'struct bmi3_dev' and the BMI323 interrupt API
+ */
+#include <bmi323.h>
+
+/**
+ * @reason: provide the 'imu_axis_sample_t' type of the two streams
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: the independent streams of the BMI323, each one has its own ODR and its own queue
+ */
+typedef enum {
+    BMI323_SPLIT_ACC = 0,       /**< accel, at CONFIG_L3_IMU_ODR_HZ */
+    BMI323_SPLIT_GYR,           /**< gyro, at CONFIG_L3_GYR_ODR_HZ */
+    BMI323_SPLIT_COUNT
+} bmi323_split_stream_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int bmi323_split_start(struct bmi3_dev *dev);
+ *  \b Description                              :       route the accel and the gyro data-ready interrupts of the BMI323 to its INT1 pin,
+ *                                                      enable a GPIOTE edge interrupt on the MCU side and start the acquisition thread.
+ *  @param  dev [IN]                            :       structure instance of bmi3_dev, it has to stay valid while the thread runs.
+ *  @note                                       :       every INT1 edge is served with one burst from STATUS to SENSOR_TIME_1, the data-ready
+ *                                                      flags of STATUS decide which stream gets a sample. a sensor that is not ready is not
+ *                                                      queued, so each stream runs at the ODR of its own sensor.
+ *  \b PRE-CONDITION                            :       bmi323_init() succeeded and both accel and gyro are configured.
+ *  \b POST-CONDITION                           :       every new accel and gyro sample is queued for bmi323_split_get().
+ *  @return                                     :       0 on success, -ENODEV if the INT1 gpio is not ready, -EIO if the sensor or the gpio
+ *                                                      could not be configured.
+ *  @see                                        :       int bmi323_split_get(bmi323_split_stream_t stream, imu_axis_sample_t *sample, k_timeout_t timeout);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_split_start(struct bmi3_dev *dev);
+
+
+/**
+ *  \b function                                 :       int bmi323_split_get(bmi323_split_stream_t stream, imu_axis_sample_t *sample, k_timeout_t timeout);
+ *  \b Description                              :       take the oldest sample of one stream.
+ *  @param  stream [IN]                         :       BMI323_SPLIT_ACC or BMI323_SPLIT_GYR.
+ *  @param  sample [OUT]                        :       receives the sample.
+ *  @param  timeout [IN]                        :       how long to wait for a sample, K_NO_WAIT after bmi323_split_poll_init() reported data.
+ *  @note                                       :       each stream has exactly one consumer.
+ *  \b PRE-CONDITION                            :       bmi323_split_start() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -EAGAIN if no sample arrived before 'timeout' (-ENOMSG with K_NO_WAIT),
+ *                                                      -EINVAL for an unknown stream.
+ *  @see                                        :       void bmi323_split_poll_init(struct k_poll_event *events);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_split_get(bmi323_split_stream_t stream, imu_axis_sample_t *sample, k_timeout_t timeout);
+
+
+/**
+ *  \b function                                 :       void bmi323_split_poll_init(struct k_poll_event *events);
+ *  \b Description                              :       initialize one k_poll() event per stream, each one signals that its queue holds data.
+ *  @param  events [OUT]                        :       array of BMI323_SPLIT_COUNT events, indexed by bmi323_split_stream_t.
+ *  @note                                       :       lets a single thread sleep on both streams, set the 'state' of each event back to
+ *                                                      K_POLL_STATE_NOT_READY after k_poll() returns.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void bmi323_split_poll_init(struct k_poll_event *events);
+
+
+/**
+ *  \b function                                 :       uint32_t bmi323_split_overruns(bmi323_split_stream_t stream);
+ *  \b Description                              :       number of samples of one stream lost so far because its queue was full.
+ *  @param  stream [IN]                         :       BMI323_SPLIT_ACC or BMI323_SPLIT_GYR.
+ *  @note                                       :       size the queues with CONFIG_L3_SPLIT_ACC_QUEUE_DEPTH and CONFIG_L3_SPLIT_GYR_QUEUE_DEPTH.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       the overrun counter of the stream, 0 for an unknown stream.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+uint32_t bmi323_split_overruns(bmi323_split_stream_t stream);
+
+
+/*** End of File **************************************************************/
+
+#endif /*BMI323_SPLIT_H_*/
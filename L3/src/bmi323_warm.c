@@ -0,0 +1,188 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include <errno.h>
+#include <stddef.h>
+
+// include printk() for the report of the first sample
+#include <zephyr/sys/printk.h>
+
+// include the CRC-32 of the registers and of the retained record
+#include <zephyr/sys/crc.h>
+
+#include "bmi323_warm.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * __noinit                         |   https://docs.zephyrproject.org/latest/kernel/memory_management/index.html
+ * crc32_ieee() / crc32_ieee_update |   https://docs.zephyrproject.org/latest/doxygen/html/group__checksum.html
+ * k_uptime_ticks()                 |   https://docs.zephyrproject.org/latest/kernel/services/timing/clocks.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Marks a record written by this module, RAM holds random values after a power-on. */
+#define WARM_MAGIC              (0x4D524157UL)
+
+/*! ACC_CONF and GYR_CONF, one word each. */
+#define CONF_BYTES              (4U)
+
+/******************************************************************************/
+/*!         Typedefs                                                          */
+
+/*! What survives an MCU-only reset, the CRC covers every field before it. */
+typedef struct {
+    uint32_t magic;
+    uint32_t config_crc;        /**< configuration the build applied */
+    uint32_t regs_crc;          /**< ACC_CONF and GYR_CONF as read back after applying it */
+    uint32_t cold_first_us;     /**< time to the first sample of the last cold boot, 0 if none */
+    uint32_t crc;
+} warm_record_t;
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! Not cleared by the startup code: the nRF52832 keeps its RAM over a soft, pin or watchdog reset. */
+static __noinit warm_record_t record;
+
+/*! Outcome of bmi323_warm_check(), and whether the first sample was reported already. */
+static bool warm;
+static bool reported;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function computes the CRC-32 of the configuration registers of the sensor.
+ */
+static int read_regs_crc(struct bmi3_dev *dev, uint32_t *crc);
+
+/*!
+ *  @brief This internal function computes the CRC-32 of the record.
+ */
+static uint32_t record_crc(void);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+/*!
+ * @brief tell whether the reset and the configuration of the sensor can be skipped.
+ *
+ * @details
+ *      the record alone is not enough, the sensor may have been powered down while the MCU was not (or
+ *      reset by a debugger), and the registers alone are not enough, another build may want another
+ *      configuration. a configuration read back from the sensor is only trusted if both still match.
+ */
+bool bmi323_warm_check(struct bmi3_dev *dev, uint32_t config_crc)
+{
+    uint32_t regs_crc;
+
+    warm = false;
+
+    if ((record.magic != WARM_MAGIC) || (record.crc != record_crc()))
+    {
+        /* Power-on: nothing to trust, not even the time of a former cold boot. */
+        record.magic = WARM_MAGIC;
+        record.config_crc = 0;
+        record.regs_crc = 0;
+        record.cold_first_us = 0;
+        record.crc = record_crc();
+        return false;
+    }
+
+    if ((record.config_crc != config_crc) || (read_regs_crc(dev, &regs_crc) != 0) || (regs_crc != record.regs_crc))
+    {
+        return false;
+    }
+
+    warm = true;
+
+    return true;
+}
+
+int bmi323_warm_save(struct bmi3_dev *dev, uint32_t config_crc)
+{
+    uint32_t regs_crc;
+
+    if (read_regs_crc(dev, &regs_crc) != 0)
+    {
+        return -EIO;
+    }
+
+    record.magic = WARM_MAGIC;
+    record.config_crc = config_crc;
+    record.regs_crc = regs_crc;
+    record.crc = record_crc();
+
+    return 0;
+}
+
+/*!
+ * @brief report the time to the first sample once.
+ *
+ * @details
+ *      the time counts from the start of the kernel, the driver init (with or without the reset) and the
+ *      configuration are both part of it. the kernel boot before them is the same for both kinds of boot,
+ *      the difference to the last cold boot is what the warm boot saved.
+ */
+void bmi323_warm_first_sample(void)
+{
+    uint32_t first_us;
+
+    if (reported)
+    {
+        return;
+    }
+
+    reported = true;
+    first_us = (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks());
+
+    if (!warm)
+    {
+        record.cold_first_us = first_us;
+        record.crc = record_crc();
+
+        printk("boot: cold, first sample %u us after the kernel started\n\r", first_us);
+        return;
+    }
+
+    if (record.cold_first_us == 0U)
+    {
+        printk("boot: warm, first sample %u us after the kernel started (no cold boot measured)\n\r", first_us);
+        return;
+    }
+
+    printk("boot: warm, first sample %u us after the kernel started (cold boot: %u us, %d us saved)\n\r",
+           first_us, record.cold_first_us, (int32_t)(record.cold_first_us - first_us));
+}
+
+/*!
+ * @brief This internal function computes the CRC-32 of the configuration registers.
+ */
+static int read_regs_crc(struct bmi3_dev *dev, uint32_t *crc)
+{
+    uint8_t conf[CONF_BYTES];
+
+    if (bmi323_get_regs(BMI3_REG_ACC_CONF, conf, sizeof(conf), dev) != BMI323_OK)
+    {
+        return -EIO;
+    }
+
+    *crc = crc32_ieee(conf, sizeof(conf));
+
+    return 0;
+}
+
+/*!
+ * @brief This internal function computes the CRC-32 of the record, its own CRC field excluded.
+ */
+static uint32_t record_crc(void)
+{
+    return crc32_ieee((const uint8_t *)&record, offsetof(warm_record_t, crc));
+}
@@ -0,0 +1,137 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   BMI323 warm boot                                                                                            |
+ * |    @file           :   bmi323_warm.h                                                                                               |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the check that lets an MCU-only reset skip the reset and configuration of the BMI323     |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef BMI323_WARM_H_
+#define BMI323_WARM_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint32_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'bool' data-type
+ */
+#include <stdbool.h>
+
+/**
+ * @reason: provide 'struct bmi3_dev'
+ */
+#include <bmi323.h>
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       bool bmi323_warm_check(struct bmi3_dev *dev, uint32_t config_crc);
+ *  \b Description                              :       tell whether the sensor still runs the configuration this build wants, so its reset and
+ *                                                      its configuration can be skipped.
+ *  @param  dev [IN]                            :       the sensor, attached without a reset (CONFIG_BMI323_SENSORAPI_WARM_BOOT).
+ *  @param  config_crc [IN]                     :       CRC-32 of the accel and gyro configuration this build applies.
+ *  @note                                       :       true only if the record in retained RAM is intact, was written for the same
+ *                                                      'config_crc' and the ACC_CONF / GYR_CONF registers read back as they were when it
+ *                                                      was written. a sensor that lost its supply reads back its defaults.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       true for a warm boot, false if the sensor has to be reset and configured.
+ *  @see                                        :       int bmi323_warm_save(struct bmi3_dev *dev, uint32_t config_crc);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+bool bmi323_warm_check(struct bmi3_dev *dev, uint32_t config_crc);
+
+
+/**
+ *  \b function                                 :       int bmi323_warm_save(struct bmi3_dev *dev, uint32_t config_crc);
+ *  \b Description                              :       read the configuration registers back and keep them with 'config_crc' in retained RAM.
+ *  @param  dev [IN]                            :       the sensor.
+ *  @param  config_crc [IN]                     :       CRC-32 of the configuration that was just applied.
+ *  \b PRE-CONDITION                            :       the accel and the gyro were configured after a reset.
+ *  \b POST-CONDITION                           :       the next MCU-only reset is a warm boot.
+ *  @return                                     :       0 on success, -EIO if the registers could not be read.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int bmi323_warm_save(struct bmi3_dev *dev, uint32_t config_crc);
+
+
+/**
+ *  \b function                                 :       void bmi323_warm_first_sample(void);
+ *  \b Description                              :       take the time from the start of the kernel to the first sample and print it once, next
+ *                                                      to the time of the last cold boot and the difference.
+ *  @note                                       :       call it for every sample, every call after the first one returns at once. the time of a
+ *                                                      cold boot is kept in retained RAM for the next warm boot.
+ *  \b PRE-CONDITION                            :       bmi323_warm_check() was called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void bmi323_warm_first_sample(void);
+
+
+/*** End of File **************************************************************/
+
+#endif /*BMI323_WARM_H_*/
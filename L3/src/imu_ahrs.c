@@ -0,0 +1,416 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include <errno.h>
+
+// include the math library, only used at initialisation and to compute the Euler angles
+#include <math.h>
+
+// include the gyro scale of the configured range
+#include "imu_convert.h"
+
+#include "imu_ahrs.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * Mahony filter                    |   https://hal.science/hal-00488376/document
+ * sqrtf() / atan2f() / asinf()     |   https://en.cppreference.com/w/c/numeric/math
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Conversion between degrees and radians. */
+#define DEG_TO_RAD              (0.017453292519943295f)
+#define RAD_TO_DEG              (57.29577951308232f)
+
+/*! One tick of the sensor time in seconds (39.0625 us). */
+#define TICK_S                  (1.0f / 25600.0f)
+
+/*! Longer gaps (lost samples, a stalled consumer) are integrated as this many ticks at most. */
+#define MAX_TICKS               (4U * IMU_SAMPLE_NOMINAL_TICKS)
+
+/*! Gains of the filter, the proportional one pulls the estimated gravity towards the measured one. */
+#define KP                      ((float)CONFIG_L3_AHRS_KP_MILLI / 1000.0f)
+#define KI                      ((float)CONFIG_L3_AHRS_KI_MILLI / 1000.0f)
+
+#if defined(CONFIG_L3_AHRS_Q30)
+/*! Fixed-point formats: the quaternion, the normalised vectors and the angle increments are Q30, the rates Q46. */
+#define Q30_ONE                 (1L << 30)
+#define Q46_SCALE               (70368744177664.0f)
+#define Q56_SCALE               (72057594037927936.0f)
+
+/*! Largest half-angle increment of one step (0.25 rad per axis), keeps every quaternion component below 2^31. */
+#define MAX_INCREMENT           (1L << 28)
+#endif
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+#if defined(CONFIG_L3_AHRS_Q30)
+/*! Orientation, Q30. */
+static int32_t q0, q1, q2, q3;
+
+/*! Integral feedback, half-angle per tick in Q46. */
+static int64_t ix, iy, iz;
+
+/*! Half-angle per tick and LSB of the gyro, Kp and Ki applied to the error vector, see imu_ahrs_init(). */
+static int64_t gyr_k_q46;
+static int64_t kp_q46;
+static int64_t ki_q56;
+#else
+/*! Orientation. */
+static float q0, q1, q2, q3;
+
+/*! Integral feedback in rad/s. */
+static float ix, iy, iz;
+
+/*! Gyro scale in rad/s per LSB. */
+static float gyr_rad_per_lsb;
+#endif
+
+/*! Sensor time of the previous sample, the first sample initialises the orientation. */
+static bool started;
+static uint16_t prev_time;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function sets roll and pitch from the gravity measured by one sample, the yaw is 0.
+ */
+static void init_from_accel(const imu_sample_t *sample);
+
+/*!
+ *  @brief This internal function runs one step of the filter over 'ticks' sensor time ticks.
+ */
+static void step(const imu_sample_t *sample, uint32_t ticks);
+
+#if defined(CONFIG_L3_AHRS_Q30)
+/*!
+ *  @brief This internal function computes the integer square root of a 32-bit value.
+ */
+static uint32_t isqrt32(uint32_t value);
+#endif
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+/*!
+ * @brief reset the orientation and compute the coefficients of the filter.
+ *
+ * @details
+ *      the fixed-point variant folds every constant of a step into one factor, computed here once:
+ *          - gyro  : half-angle per tick and LSB = 0.5 * tick * rad_per_lsb, Q46 (2^17 to 2^21 for 125 to 2000 dps).
+ *          - Kp    : 0.5 * tick * Kp, Q46, multiplies the Q30 error vector into a Q46 rate.
+ *          - Ki    : 0.5 * tick^2 * Ki, Q56, the integral grows by the error times the step.
+ */
+int imu_ahrs_init(void)
+{
+    float rad_per_lsb = imu_convert_gyr_scale.f32 * DEG_TO_RAD;
+
+    if (rad_per_lsb <= 0.0f)
+    {
+        return -EINVAL;
+    }
+
+#if defined(CONFIG_L3_AHRS_Q30)
+    q0 = Q30_ONE;
+    gyr_k_q46 = (int64_t)(0.5f * TICK_S * rad_per_lsb * Q46_SCALE);
+    kp_q46 = (int64_t)(0.5f * TICK_S * KP * Q46_SCALE);
+    ki_q56 = (int64_t)(0.5f * TICK_S * TICK_S * KI * Q56_SCALE);
+#else
+    q0 = 1.0f;
+    gyr_rad_per_lsb = rad_per_lsb;
+#endif
+
+    q1 = 0;
+    q2 = 0;
+    q3 = 0;
+    ix = 0;
+    iy = 0;
+    iz = 0;
+    started = false;
+
+    return 0;
+}
+
+void imu_ahrs_update(const imu_sample_t *samples, uint16_t count)
+{
+    uint16_t ticks;
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (!started)
+        {
+            init_from_accel(&samples[i]);
+            prev_time = (uint16_t)samples[i].sensor_time;
+            started = true;
+            continue;
+        }
+
+        /* The FIFO only keeps the lower 16 bits of the sensor time, they are enough for the difference. */
+        ticks = (uint16_t)((uint16_t)samples[i].sensor_time - prev_time);
+        prev_time = (uint16_t)samples[i].sensor_time;
+
+        if (ticks == 0)
+        {
+            continue;
+        }
+
+        step(&samples[i], MIN(ticks, MAX_TICKS));
+    }
+}
+
+void imu_ahrs_get_quat(imu_ahrs_quat_t *quat)
+{
+#if defined(CONFIG_L3_AHRS_Q30)
+    quat->w = (float)q0 / (float)Q30_ONE;
+    quat->x = (float)q1 / (float)Q30_ONE;
+    quat->y = (float)q2 / (float)Q30_ONE;
+    quat->z = (float)q3 / (float)Q30_ONE;
+#else
+    quat->w = q0;
+    quat->x = q1;
+    quat->y = q2;
+    quat->z = q3;
+#endif
+}
+
+/*!
+ * @brief read the current orientation as aerospace (z-y-x) Euler angles.
+ */
+void imu_ahrs_get_euler(imu_ahrs_euler_t *euler)
+{
+    imu_ahrs_quat_t q;
+    float sin_pitch;
+
+    imu_ahrs_get_quat(&q);
+
+    sin_pitch = CLAMP(2.0f * ((q.w * q.y) - (q.z * q.x)), -1.0f, 1.0f);
+
+    euler->roll = atan2f(2.0f * ((q.w * q.x) + (q.y * q.z)), 1.0f - (2.0f * ((q.x * q.x) + (q.y * q.y)))) * RAD_TO_DEG;
+    euler->pitch = asinf(sin_pitch) * RAD_TO_DEG;
+    euler->yaw = atan2f(2.0f * ((q.w * q.z) + (q.x * q.y)), 1.0f - (2.0f * ((q.y * q.y) + (q.z * q.z)))) * RAD_TO_DEG;
+}
+
+/*!
+ * @brief This internal function sets roll and pitch from the gravity measured by one sample.
+ *
+ * @details
+ *      without it the filter would start level and take a few seconds (1 / Kp) to settle on the real
+ *      orientation. runs once, so it uses the float math library in both variants.
+ */
+static void init_from_accel(const imu_sample_t *sample)
+{
+    float ax = (float)sample->acc_x;
+    float ay = (float)sample->acc_y;
+    float az = (float)sample->acc_z;
+    float roll, pitch;
+
+    if ((ax == 0.0f) && (ay == 0.0f) && (az == 0.0f))
+    {
+        return;
+    }
+
+    roll = atan2f(ay, az);
+    pitch = atan2f(-ax, sqrtf((ay * ay) + (az * az)));
+
+#if defined(CONFIG_L3_AHRS_Q30)
+    q0 = (int32_t)(cosf(roll / 2.0f) * cosf(pitch / 2.0f) * (float)Q30_ONE);
+    q1 = (int32_t)(sinf(roll / 2.0f) * cosf(pitch / 2.0f) * (float)Q30_ONE);
+    q2 = (int32_t)(cosf(roll / 2.0f) * sinf(pitch / 2.0f) * (float)Q30_ONE);
+    q3 = (int32_t)(-sinf(roll / 2.0f) * sinf(pitch / 2.0f) * (float)Q30_ONE);
+#else
+    q0 = cosf(roll / 2.0f) * cosf(pitch / 2.0f);
+    q1 = sinf(roll / 2.0f) * cosf(pitch / 2.0f);
+    q2 = cosf(roll / 2.0f) * sinf(pitch / 2.0f);
+    q3 = -sinf(roll / 2.0f) * sinf(pitch / 2.0f);
+#endif
+}
+
+#if defined(CONFIG_L3_AHRS_Q30)
+/*!
+ * @brief This internal function runs one step of the filter, Q30 fixed point.
+ *
+ * @details
+ *      same steps as the float variant below. the accel only gives a direction, it is normalised with one
+ *      32-bit integer square root and one 32-bit division. the quaternion only moves a little per step, so
+ *      its norm stays close to 1 and a single Newton step, 1/sqrt(n) ~ (3 - n) / 2, normalises it without
+ *      any division. the largest products (Q30 x Q30) stay below 2^62.
+ */
+static void step(const imu_sample_t *sample, uint32_t ticks)
+{
+    int32_t ax = sample->acc_x;
+    int32_t ay = sample->acc_y;
+    int32_t az = sample->acc_z;
+    uint32_t norm2 = (uint32_t)(ax * ax) + (uint32_t)(ay * ay) + (uint32_t)(az * az);
+    int64_t hx = (int64_t)sample->gyr_x * gyr_k_q46;
+    int64_t hy = (int64_t)sample->gyr_y * gyr_k_q46;
+    int64_t hz = (int64_t)sample->gyr_z * gyr_k_q46;
+    int32_t vx, vy, vz;
+    int32_t ex, ey, ez;
+    int32_t dx, dy, dz;
+    int32_t qa, qb, qc;
+    int32_t inv;
+    int64_t n2;
+
+    if (norm2 != 0)
+    {
+        /* Normalised accel, Q30. */
+        inv = (int32_t)((uint32_t)Q30_ONE / isqrt32(norm2));
+        ax *= inv;
+        ay *= inv;
+        az *= inv;
+
+        /* Gravity as the current orientation sees it, Q30. */
+        vx = (int32_t)((((int64_t)q1 * q3) - ((int64_t)q0 * q2)) >> 29);
+        vy = (int32_t)((((int64_t)q0 * q1) + ((int64_t)q2 * q3)) >> 29);
+        vz = (int32_t)((((int64_t)q0 * q0) - ((int64_t)q1 * q1) - ((int64_t)q2 * q2) + ((int64_t)q3 * q3)) >> 30);
+
+        /* Error between the two directions, Q30. */
+        ex = (int32_t)((((int64_t)ay * vz) - ((int64_t)az * vy)) >> 30);
+        ey = (int32_t)((((int64_t)az * vx) - ((int64_t)ax * vz)) >> 30);
+        ez = (int32_t)((((int64_t)ax * vy) - ((int64_t)ay * vx)) >> 30);
+
+        if (ki_q56 != 0)
+        {
+            ix += (((int64_t)ex * ki_q56) >> 40) * ticks;
+            iy += (((int64_t)ey * ki_q56) >> 40) * ticks;
+            iz += (((int64_t)ez * ki_q56) >> 40) * ticks;
+        }
+
+        hx += (((int64_t)ex * kp_q46) >> 30) + ix;
+        hy += (((int64_t)ey * kp_q46) >> 30) + iy;
+        hz += (((int64_t)ez * kp_q46) >> 30) + iz;
+    }
+
+    /* Half-angle increments of the step, Q30. */
+    dx = (int32_t)CLAMP((hx * (int64_t)ticks) >> 16, -MAX_INCREMENT, MAX_INCREMENT);
+    dy = (int32_t)CLAMP((hy * (int64_t)ticks) >> 16, -MAX_INCREMENT, MAX_INCREMENT);
+    dz = (int32_t)CLAMP((hz * (int64_t)ticks) >> 16, -MAX_INCREMENT, MAX_INCREMENT);
+
+    qa = q0;
+    qb = q1;
+    qc = q2;
+    q0 += (int32_t)(((-(int64_t)qb * dx) - ((int64_t)qc * dy) - ((int64_t)q3 * dz)) >> 30);
+    q1 += (int32_t)((((int64_t)qa * dx) + ((int64_t)qc * dz) - ((int64_t)q3 * dy)) >> 30);
+    q2 += (int32_t)((((int64_t)qa * dy) - ((int64_t)qb * dz) + ((int64_t)q3 * dx)) >> 30);
+    q3 += (int32_t)((((int64_t)qa * dz) + ((int64_t)qb * dy) - ((int64_t)qc * dx)) >> 30);
+
+    /* Squared norm Q30, then one Newton step towards 1 / norm. */
+    n2 = (((int64_t)q0 * q0) + ((int64_t)q1 * q1) + ((int64_t)q2 * q2) + ((int64_t)q3 * q3)) >> 30;
+    inv = (int32_t)(((3LL * Q30_ONE) - n2) >> 1);
+
+    q0 = (int32_t)(((int64_t)q0 * inv) >> 30);
+    q1 = (int32_t)(((int64_t)q1 * inv) >> 30);
+    q2 = (int32_t)(((int64_t)q2 * inv) >> 30);
+    q3 = (int32_t)(((int64_t)q3 * inv) >> 30);
+}
+
+/*!
+ * @brief This internal function computes the integer square root of a 32-bit value, one result bit per iteration.
+ */
+static uint32_t isqrt32(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0)
+    {
+        if (value >= (root + bit))
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return root;
+}
+#else
+/*!
+ * @brief This internal function runs one step of the filter, single precision float.
+ *
+ * @details
+ *      the error is the cross product of the measured gravity and the gravity the current orientation
+ *      predicts, it is fed back into the gyro rate as a PI correction, then the quaternion is integrated
+ *      over the step and normalised. with the FPU every operation is a single instruction, sqrtf() too.
+ */
+static void step(const imu_sample_t *sample, uint32_t ticks)
+{
+    float dt = (float)ticks * TICK_S;
+    float ax = (float)sample->acc_x;
+    float ay = (float)sample->acc_y;
+    float az = (float)sample->acc_z;
+    float gx = (float)sample->gyr_x * gyr_rad_per_lsb;
+    float gy = (float)sample->gyr_y * gyr_rad_per_lsb;
+    float gz = (float)sample->gyr_z * gyr_rad_per_lsb;
+    float norm2 = (ax * ax) + (ay * ay) + (az * az);
+    float vx, vy, vz;
+    float ex, ey, ez;
+    float qa, qb, qc;
+    float inv;
+
+    if (norm2 > 0.0f)
+    {
+        inv = 1.0f / sqrtf(norm2);
+        ax *= inv;
+        ay *= inv;
+        az *= inv;
+
+        vx = 2.0f * ((q1 * q3) - (q0 * q2));
+        vy = 2.0f * ((q0 * q1) + (q2 * q3));
+        vz = (q0 * q0) - (q1 * q1) - (q2 * q2) + (q3 * q3);
+
+        ex = (ay * vz) - (az * vy);
+        ey = (az * vx) - (ax * vz);
+        ez = (ax * vy) - (ay * vx);
+
+        if (KI > 0.0f)
+        {
+            ix += KI * ex * dt;
+            iy += KI * ey * dt;
+            iz += KI * ez * dt;
+        }
+
+        gx += (KP * ex) + ix;
+        gy += (KP * ey) + iy;
+        gz += (KP * ez) + iz;
+    }
+
+    gx *= 0.5f * dt;
+    gy *= 0.5f * dt;
+    gz *= 0.5f * dt;
+
+    qa = q0;
+    qb = q1;
+    qc = q2;
+    q0 += (-qb * gx) - (qc * gy) - (q3 * gz);
+    q1 += (qa * gx) + (qc * gz) - (q3 * gy);
+    q2 += (qa * gy) - (qb * gz) + (q3 * gx);
+    q3 += (qa * gz) + (qb * gy) - (qc * gx);
+
+    inv = 1.0f / sqrtf((q0 * q0) + (q1 * q1) + (q2 * q2) + (q3 * q3));
+    q0 *= inv;
+    q1 *= inv;
+    q2 *= inv;
+    q3 *= inv;
+}
+#endif
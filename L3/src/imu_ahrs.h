@@ -0,0 +1,194 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   orientation estimation (AHRS) of the L3 IMU samples                                                         |
+ * |    @file           :   imu_ahrs.h                                                                                                  |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides a Mahony filter fusing accel and gyro into a quaternion, in float or Q30 fixed point     |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_AHRS_H_
+#define IMU_AHRS_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type the filter consumes
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: imu_ahrs_quat_t
+ * @brief: unit quaternion rotating the sensor frame into the earth frame (z up)
+ */
+typedef struct {
+    float w;                    /**< scalar part */
+    float x;                    /**< x vector part */
+    float y;                    /**< y vector part */
+    float z;                    /**< z vector part */
+} imu_ahrs_quat_t;
+
+/**
+ * @struct: imu_ahrs_euler_t
+ * @brief: the same orientation as aerospace (z-y-x) Euler angles
+ */
+typedef struct {
+    float roll;                 /**< rotation around x in degrees, -180 to 180 */
+    float pitch;                /**< rotation around y in degrees, -90 to 90 */
+    float yaw;                  /**< rotation around z in degrees, -180 to 180, drifts without a magnetometer */
+} imu_ahrs_euler_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int imu_ahrs_init(void);
+ *  \b Description                              :       reset the orientation and compute the coefficients of the filter from the gyro range.
+ *  @note                                       :       the gyro scale is taken from 'imu_convert.h', the gains from CONFIG_L3_AHRS_KP_MILLI and
+ *                                                      CONFIG_L3_AHRS_KI_MILLI. the first sample sets roll and pitch from the gravity it measures.
+ *  \b PRE-CONDITION                            :       imu_convert_set_gyro_range() succeeded.
+ *  \b POST-CONDITION                           :       imu_ahrs_update() can be used.
+ *  @return                                     :       0 on success, -EINVAL if the gyro range was not set.
+ *  @see                                        :       void imu_ahrs_update(const imu_sample_t *samples, uint16_t count);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_ahrs_init(void);
+
+
+/**
+ *  \b function                                 :       void imu_ahrs_update(const imu_sample_t *samples, uint16_t count);
+ *  \b Description                              :       run one filter step per sample, oldest first.
+ *  @param  samples [IN]                        :       raw samples, in the order they were measured.
+ *  @param  count [IN]                          :       number of samples.
+ *  @note                                       :       the step of every sample is the difference of its sensor time to the previous one, a lost
+ *                                                      sample does not slow the integration down. not reentrant, one caller only.
+ *  \b PRE-CONDITION                            :       imu_ahrs_init() succeeded.
+ *  \b POST-CONDITION                           :       the orientation is the one of the last sample.
+ *  @return                                     :       None.
+ *  @see                                        :       void imu_ahrs_get_quat(imu_ahrs_quat_t *quat);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_ahrs_update(const imu_sample_t *samples, uint16_t count);
+
+
+/**
+ *  \b function                                 :       void imu_ahrs_get_quat(imu_ahrs_quat_t *quat);
+ *  \b Description                              :       read the current orientation as a quaternion.
+ *  @param  quat [OUT]                          :       receives the quaternion.
+ *  @note                                       :       same context as imu_ahrs_update().
+ *  \b PRE-CONDITION                            :       imu_ahrs_init() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_ahrs_get_quat(imu_ahrs_quat_t *quat);
+
+
+/**
+ *  \b function                                 :       void imu_ahrs_get_euler(imu_ahrs_euler_t *euler);
+ *  \b Description                              :       read the current orientation as Euler angles.
+ *  @param  euler [OUT]                         :       receives the angles in degrees.
+ *  @note                                       :       uses atan2f() / asinf(), computed on demand only and never inside the filter step.
+ *  \b PRE-CONDITION                            :       imu_ahrs_init() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_ahrs_get_euler(imu_ahrs_euler_t *euler);
+
+
+#if defined(CONFIG_L3_AHRS_BENCH)
+/**
+ *  \b function                                 :       void imu_ahrs_bench_run(void);
+ *  \b Description                              :       measure and print the cycles per filter step and the CPU load at the configured ODR.
+ *  @note                                       :       blocks for a few milliseconds, to be called once at startup. resets the orientation.
+ *  \b PRE-CONDITION                            :       imu_ahrs_init() succeeded.
+ *  \b POST-CONDITION                           :       the orientation is reset with imu_ahrs_init().
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_ahrs_bench_run(void);
+#endif
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_AHRS_H_*/
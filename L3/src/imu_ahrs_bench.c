@@ -0,0 +1,106 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+// include the printk function file header
+#include <zephyr/sys/printk.h>
+
+// include the cycle accurate timing functions (DWT CYCCNT on the nRF52832, the host counter on native_sim)
+#include <zephyr/timing/timing.h>
+
+#include "imu_ahrs.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                 |   Documentation Link
+ * =========================|=====================
+ * timing_counter_get()     |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * timing_cycles_get()      |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * timing_cycles_to_ns()    |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Number of samples of one batch, the size of the batches of the processing thread. */
+#define BENCH_SAMPLES       (32U)
+
+/*! Every batch is repeated to average out the interrupt noise. */
+#define BENCH_ROUNDS        (32U)
+
+/*! Sensor time ticks between two samples at the configured ODR. */
+#define BENCH_TICKS         (25600U / CONFIG_L3_IMU_ODR_HZ)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+static imu_sample_t bench_samples[BENCH_SAMPLES];
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+/*!
+ * @brief measure and print the cycles per filter step.
+ *
+ * @details
+ *      the samples tilt the sensor a little and turn it around every axis, so no branch of the step is
+ *      skipped. the load is the share of the CPU one step per sample takes at CONFIG_L3_IMU_ODR_HZ.
+ */
+void imu_ahrs_bench_run(void)
+{
+    timing_t start, end;
+    uint64_t cycles, ns;
+    uint32_t per_update_x100, load_x100;
+    uint32_t round, i;
+
+    for (i = 0; i < BENCH_SAMPLES; i++)
+    {
+        bench_samples[i].acc_x = (int16_t)(i * 40U);
+        bench_samples[i].acc_y = (int16_t)(-(int32_t)(i * 25U));
+        bench_samples[i].acc_z = 8192;
+        bench_samples[i].gyr_x = 600;
+        bench_samples[i].gyr_y = -300;
+        bench_samples[i].gyr_z = 1200;
+    }
+
+    timing_init();
+    timing_start();
+
+    start = timing_counter_get();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        /* Keep the sensor time running across the rounds, every sample is one real step. */
+        for (i = 0; i < BENCH_SAMPLES; i++)
+        {
+            bench_samples[i].sensor_time = ((round * BENCH_SAMPLES) + i + 1U) * BENCH_TICKS;
+        }
+
+        imu_ahrs_update(bench_samples, BENCH_SAMPLES);
+    }
+    end = timing_counter_get();
+
+    cycles = timing_cycles_get(&start, &end);
+    ns = timing_cycles_to_ns(cycles);
+
+    timing_stop();
+
+    per_update_x100 = (uint32_t)((cycles * 100U) / (BENCH_SAMPLES * BENCH_ROUNDS));
+    /* load in % = ns per update * ODR / 10^9 * 100. */
+    load_x100 = (uint32_t)((ns * CONFIG_L3_IMU_ODR_HZ) / (BENCH_SAMPLES * BENCH_ROUNDS * 100000ULL));
+
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("AHRS benchmark (%s), %u samples x %u rounds\n\r",
+           IS_ENABLED(CONFIG_L3_AHRS_Q30) ? "Q30" : "f32", BENCH_SAMPLES, BENCH_ROUNDS);
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("%u.%02u cycles/update, %u ns/update, %u.%02u %% CPU at %u Hz\n\r",
+           per_update_x100 / 100U, per_update_x100 % 100U,
+           (uint32_t)(ns / (BENCH_SAMPLES * BENCH_ROUNDS)),
+           load_x100 / 100U, load_x100 % 100U,
+           CONFIG_L3_IMU_ODR_HZ);
+
+    /* The benchmark moved the orientation, start over from the first real sample. */
+    imu_ahrs_init();
+}
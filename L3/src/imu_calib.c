@@ -0,0 +1,516 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+// include printk() for the save report
+#include <zephyr/sys/printk.h>
+
+// include the settings subsystem, the calibration is one key of it (stored in NVS)
+#include <zephyr/settings/settings.h>
+
+// include the math library, only used once per still window
+#include <math.h>
+
+// include the scales of the configured ranges, the thresholds are given in physical units
+#include "imu_convert.h"
+
+#include "imu_calib.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * settings_subsys_init()           |   https://docs.zephyrproject.org/latest/services/storage/settings/index.html
+ * settings_load_subtree()          |   https://docs.zephyrproject.org/latest/services/storage/settings/index.html
+ * settings_save_one()              |   https://docs.zephyrproject.org/latest/services/storage/settings/index.html
+ * k_work_submit()                  |   https://docs.zephyrproject.org/latest/kernel/services/threads/workqueue.html
+ * k_spin_lock() / k_spin_unlock()  |   https://docs.zephyrproject.org/latest/kernel/services/smp/smp.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! The six axes of a sample, accel first. */
+#define CALIB_AXES              (6U)
+#define CALIB_ACC               (0U)
+#define CALIB_GYR               (3U)
+
+/*! Subtree and key of the calibration in the settings. */
+#define CALIB_SETTINGS_ROOT     "l3"
+#define CALIB_SETTINGS_NAME     "calib"
+#define CALIB_SETTINGS_KEY      CALIB_SETTINGS_ROOT "/" CALIB_SETTINGS_NAME
+
+/*! Layout version of 'struct calib_record', a record of another version is ignored. */
+#define CALIB_RECORD_VERSION    (1U)
+
+/*! The estimates are kept in 1/16 LSB, the samples are corrected by whole LSB. */
+#define Q4_ONE                  (16)
+
+/*! Weight of a new still window in the gyro bias (1/4). */
+#define GYR_EMA_SHIFT           (2)
+
+/*! Step of the accel offset towards the 1 g sphere per still window. */
+#define ACC_STEP                (0.25f)
+
+/*! Largest accel offset that is accepted, in g (the BMI323 is specified for +/-50 mg at most). */
+#define ACC_OFFSET_MAX_G        (0.15f)
+
+BUILD_ASSERT(CONFIG_L3_CALIB_WINDOW <= 4096, "the window sums are kept in 32 / 64 bits");
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*!
+ * @brief Record of the calibration in flash.
+ *
+ * @details
+ *      the offsets are only meaningful together with the scales they were estimated with, a record
+ *      written with other ranges is rescaled when it is loaded.
+ */
+struct calib_record {
+    uint8_t version;
+    uint8_t reserved[3];
+    float acc_scale;
+    float gyr_scale;
+    int32_t offset_q4[CALIB_AXES];
+};
+
+/*! Sums of the current window, on the uncorrected samples. */
+static int32_t win_sum[CALIB_AXES];
+static int64_t win_sum_sq[CALIB_AXES];
+static uint16_t win_count;
+
+/*! Largest N^2 * variance of a still window, for the accel and for the gyro axes, in LSB^2. */
+static int64_t acc_still_n2;
+static int64_t gyr_still_n2;
+
+/*! 1 g in accel LSB. */
+static float gravity_lsb;
+
+/*! Current estimate in 1/16 LSB, and the whole LSB subtracted from the samples. */
+static int32_t offset_q4[CALIB_AXES];
+static int16_t correction[CALIB_AXES];
+
+/*! Record read by the settings handler at startup. */
+static struct calib_record loaded_record;
+static bool record_found;
+
+/*! Estimate last written to flash, and when a write was last started. */
+static int32_t saved_q4[CALIB_AXES];
+static bool saved_valid;
+static int64_t last_save_ms;
+
+/*! State shared with imu_calib_get() and the save work item. */
+static imu_calib_t calib_state;
+static struct k_spinlock calib_lock;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief Settings handler, receives the stored record while 'CALIB_SETTINGS_ROOT' is loaded.
+ */
+static int calib_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg);
+
+/*!
+ *  @brief This internal function adds one uncorrected sample to the window and evaluates the window once it is full.
+ */
+static void accumulate(const imu_sample_t *sample);
+
+/*!
+ *  @brief This internal function updates the estimate from the means of a still window.
+ */
+static void update_estimate(void);
+
+/*!
+ *  @brief This internal function recomputes the whole LSB corrections and starts a save if one is due.
+ */
+static void publish_estimate(void);
+
+/*!
+ *  @brief This internal function rounds a value in 1/16 LSB to the nearest LSB, saturated to int16.
+ */
+static int16_t q4_to_lsb(int32_t q4);
+
+/*!
+ *  @brief This internal function subtracts a correction from a raw value, saturated to int16.
+ */
+static int16_t sub_sat(int16_t raw, int16_t corr);
+
+/*!
+ *  @brief Work handler writing the estimate to flash, runs in the system work queue.
+ */
+static void save_handler(struct k_work *work);
+
+SETTINGS_STATIC_HANDLER_DEFINE(l3_calib, CALIB_SETTINGS_ROOT, NULL, calib_settings_set, NULL, NULL);
+
+K_WORK_DEFINE(save_work, save_handler);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int imu_calib_init(void)
+{
+    float acc_still_lsb = ((float)CONFIG_L3_CALIB_ACC_STILL_MG / 1000.0f) / imu_convert_acc_scale.f32;
+    float gyr_still_lsb = ((float)CONFIG_L3_CALIB_GYR_STILL_MDPS / 1000.0f) / imu_convert_gyr_scale.f32;
+    float rescale;
+    uint8_t axis;
+    int err;
+
+    acc_still_n2 = (int64_t)(acc_still_lsb * acc_still_lsb * (float)CONFIG_L3_CALIB_WINDOW * (float)CONFIG_L3_CALIB_WINDOW);
+    gyr_still_n2 = (int64_t)(gyr_still_lsb * gyr_still_lsb * (float)CONFIG_L3_CALIB_WINDOW * (float)CONFIG_L3_CALIB_WINDOW);
+    gravity_lsb = 1.0f / imu_convert_acc_scale.f32;
+
+    win_count = 0;
+    memset(offset_q4, 0, sizeof(offset_q4));
+    memset(&calib_state, 0, sizeof(calib_state));
+    saved_valid = false;
+
+    err = settings_subsys_init();
+
+    if (err == 0)
+    {
+        err = settings_load_subtree(CALIB_SETTINGS_ROOT);
+    }
+
+    if ((err == 0) && record_found)
+    {
+        /* Offsets in LSB of the ranges they were saved with, brought to the current ranges. */
+        for (axis = 0; axis < CALIB_AXES; axis++)
+        {
+            rescale = (axis < CALIB_GYR) ? (loaded_record.acc_scale / imu_convert_acc_scale.f32)
+                                         : (loaded_record.gyr_scale / imu_convert_gyr_scale.f32);
+
+            offset_q4[axis] = (int32_t)((float)loaded_record.offset_q4[axis] * rescale);
+        }
+
+        /* What is in flash now matches the estimate, there is nothing to save until it changes. */
+        memcpy(saved_q4, offset_q4, sizeof(saved_q4));
+        saved_valid = true;
+
+        calib_state.loaded = true;
+        calib_state.gyr_valid = true;
+    }
+
+    for (axis = 0; axis < CALIB_AXES; axis++)
+    {
+        correction[axis] = q4_to_lsb(offset_q4[axis]);
+    }
+
+    for (axis = 0; axis < 3U; axis++)
+    {
+        calib_state.acc_offset[axis] = correction[CALIB_ACC + axis];
+        calib_state.gyr_bias[axis] = calib_state.gyr_valid ? correction[CALIB_GYR + axis] : 0;
+    }
+
+    if (!calib_state.gyr_valid)
+    {
+        /* Nothing to subtract from the gyro before the first estimate. */
+        memset(&correction[CALIB_GYR], 0, 3U * sizeof(int16_t));
+    }
+
+    return err;
+}
+
+void imu_calib_update(imu_sample_t *samples, uint16_t count)
+{
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        /* The window is built from the raw values, the estimate is the mean of the uncorrected samples. */
+        accumulate(&samples[i]);
+
+        samples[i].acc_x = sub_sat(samples[i].acc_x, correction[CALIB_ACC + 0U]);
+        samples[i].acc_y = sub_sat(samples[i].acc_y, correction[CALIB_ACC + 1U]);
+        samples[i].acc_z = sub_sat(samples[i].acc_z, correction[CALIB_ACC + 2U]);
+        samples[i].gyr_x = sub_sat(samples[i].gyr_x, correction[CALIB_GYR + 0U]);
+        samples[i].gyr_y = sub_sat(samples[i].gyr_y, correction[CALIB_GYR + 1U]);
+        samples[i].gyr_z = sub_sat(samples[i].gyr_z, correction[CALIB_GYR + 2U]);
+    }
+}
+
+void imu_calib_get(imu_calib_t *calib)
+{
+    k_spinlock_key_t key = k_spin_lock(&calib_lock);
+
+    *calib = calib_state;
+
+    k_spin_unlock(&calib_lock, key);
+}
+
+/*!
+ * @brief Settings handler of the calibration.
+ *
+ * @details
+ *      only called from settings_load_subtree() in imu_calib_init(). a record of another size or version
+ *      (written by an older firmware) is skipped, the calibration then starts from zero.
+ */
+static int calib_settings_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg)
+{
+    const char *next;
+    ssize_t rc;
+
+    if (!settings_name_steq(name, CALIB_SETTINGS_NAME, &next) || (next != NULL))
+    {
+        return -ENOENT;
+    }
+
+    if (len != sizeof(loaded_record))
+    {
+        return 0;
+    }
+
+    rc = read_cb(cb_arg, &loaded_record, sizeof(loaded_record));
+
+    if (rc < 0)
+    {
+        return (int)rc;
+    }
+
+    record_found = (rc == sizeof(loaded_record)) && (loaded_record.version == CALIB_RECORD_VERSION) &&
+                   (loaded_record.acc_scale > 0.0f) && (loaded_record.gyr_scale > 0.0f);
+
+    return 0;
+}
+
+/*!
+ * @brief This internal function adds one sample to the window.
+ *
+ * @details
+ *      N^2 * variance = N * sum(x^2) - sum(x)^2 is evaluated in integers, the window is still when it stays
+ *      below the threshold on every axis: the gyro shows no rotation and the accel sees gravity alone.
+ */
+static void accumulate(const imu_sample_t *sample)
+{
+    const int16_t raw[CALIB_AXES] = {
+        sample->acc_x, sample->acc_y, sample->acc_z, sample->gyr_x, sample->gyr_y, sample->gyr_z,
+    };
+    k_spinlock_key_t key;
+    bool still = true;
+    int64_t var_n2;
+    uint8_t axis;
+
+    for (axis = 0; axis < CALIB_AXES; axis++)
+    {
+        win_sum[axis] += raw[axis];
+        win_sum_sq[axis] += (int32_t)raw[axis] * raw[axis];
+    }
+
+    win_count++;
+
+    if (win_count < CONFIG_L3_CALIB_WINDOW)
+    {
+        return;
+    }
+
+    for (axis = 0; axis < CALIB_AXES; axis++)
+    {
+        var_n2 = ((int64_t)CONFIG_L3_CALIB_WINDOW * win_sum_sq[axis]) - ((int64_t)win_sum[axis] * win_sum[axis]);
+
+        if (var_n2 > ((axis < CALIB_GYR) ? acc_still_n2 : gyr_still_n2))
+        {
+            still = false;
+        }
+    }
+
+    if (still)
+    {
+        update_estimate();
+    }
+
+    key = k_spin_lock(&calib_lock);
+
+    calib_state.windows++;
+    calib_state.still_windows += still ? 1U : 0U;
+
+    k_spin_unlock(&calib_lock, key);
+
+    if (still)
+    {
+        publish_estimate();
+    }
+
+    win_count = 0;
+    memset(win_sum, 0, sizeof(win_sum));
+    memset(win_sum_sq, 0, sizeof(win_sum_sq));
+}
+
+/*!
+ * @brief This internal function updates the estimate from a still window.
+ *
+ * @details
+ *      the gyro bias is the mean of the window, averaged over the still windows (the first one is taken
+ *      as it is). the accel offset is one gradient step of the sphere fit |mean - offset| = 1 g: the
+ *      offset moves along the measured gravity until its length is 1 g. resting in a single orientation
+ *      only fixes the axis that gravity points along, every further orientation fixes more of the offset.
+ */
+static void update_estimate(void)
+{
+    float d[3];
+    float len = 0.0f;
+    float err;
+    float o;
+    int32_t mean_q4;
+    uint8_t i;
+
+    for (i = 0; i < 3U; i++)
+    {
+        mean_q4 = (int32_t)(((int64_t)win_sum[CALIB_GYR + i] * Q4_ONE) / CONFIG_L3_CALIB_WINDOW);
+
+        if (calib_state.gyr_valid)
+        {
+            offset_q4[CALIB_GYR + i] += (mean_q4 - offset_q4[CALIB_GYR + i]) / (1 << GYR_EMA_SHIFT);
+        }
+        else
+        {
+            offset_q4[CALIB_GYR + i] = mean_q4;
+        }
+    }
+
+    for (i = 0; i < 3U; i++)
+    {
+        d[i] = ((float)win_sum[CALIB_ACC + i] / (float)CONFIG_L3_CALIB_WINDOW) - ((float)offset_q4[CALIB_ACC + i] / (float)Q4_ONE);
+        len += d[i] * d[i];
+    }
+
+    len = sqrtf(len);
+
+    if (len < (0.5f * gravity_lsb))
+    {
+        /* Not gravity (free fall or a broken axis), the accel offset is left alone. */
+        return;
+    }
+
+    err = len - gravity_lsb;
+
+    for (i = 0; i < 3U; i++)
+    {
+        o = ((float)offset_q4[CALIB_ACC + i] / (float)Q4_ONE) + (ACC_STEP * err * d[i] / len);
+        o = CLAMP(o, -ACC_OFFSET_MAX_G * gravity_lsb, ACC_OFFSET_MAX_G * gravity_lsb);
+
+        offset_q4[CALIB_ACC + i] = (int32_t)lroundf(o * (float)Q4_ONE);
+    }
+}
+
+/*!
+ * @brief This internal function applies a new estimate and decides whether it is written to flash.
+ *
+ * @details
+ *      flash is only written when the estimate moved by CONFIG_L3_CALIB_SAVE_MIN_LSB on any axis since
+ *      the last write, and at most once per CONFIG_L3_CALIB_SAVE_INTERVAL_SEC (the first estimate of a
+ *      device without a stored calibration is written right away). the write itself runs in the system
+ *      work queue, the acquisition never waits for the flash.
+ */
+static void publish_estimate(void)
+{
+    k_spinlock_key_t key;
+    bool changed = !saved_valid;
+    bool save = false;
+    int64_t now = k_uptime_get();
+    uint8_t axis;
+
+    key = k_spin_lock(&calib_lock);
+
+    for (axis = 0; axis < CALIB_AXES; axis++)
+    {
+        correction[axis] = q4_to_lsb(offset_q4[axis]);
+
+        if (saved_valid && (abs(offset_q4[axis] - saved_q4[axis]) >= (CONFIG_L3_CALIB_SAVE_MIN_LSB * Q4_ONE)))
+        {
+            changed = true;
+        }
+    }
+
+    for (axis = 0; axis < 3U; axis++)
+    {
+        calib_state.acc_offset[axis] = correction[CALIB_ACC + axis];
+        calib_state.gyr_bias[axis] = correction[CALIB_GYR + axis];
+    }
+
+    calib_state.gyr_valid = true;
+
+    if (changed && (!saved_valid || ((now - last_save_ms) >= (CONFIG_L3_CALIB_SAVE_INTERVAL_SEC * 1000LL))))
+    {
+        /* Taken as written from here on, a failed write is retried with the next change after the interval. */
+        memcpy(saved_q4, offset_q4, sizeof(saved_q4));
+        saved_valid = true;
+        last_save_ms = now;
+        save = true;
+    }
+
+    k_spin_unlock(&calib_lock, key);
+
+    if (save)
+    {
+        k_work_submit(&save_work);
+    }
+}
+
+/*!
+ * @brief This internal function rounds a value in 1/16 LSB to whole LSB.
+ */
+static int16_t q4_to_lsb(int32_t q4)
+{
+    int32_t lsb = (q4 >= 0) ? ((q4 + (Q4_ONE / 2)) / Q4_ONE) : ((q4 - (Q4_ONE / 2)) / Q4_ONE);
+
+    return (int16_t)CLAMP(lsb, INT16_MIN, INT16_MAX);
+}
+
+/*!
+ * @brief This internal function subtracts a correction from a raw value.
+ */
+static int16_t sub_sat(int16_t raw, int16_t corr)
+{
+    int32_t value = (int32_t)raw - corr;
+
+    return (int16_t)CLAMP(value, INT16_MIN, INT16_MAX);
+}
+
+/*!
+ * @brief Work handler writing the estimate to flash.
+ *
+ * @details
+ *      the record is taken from 'saved_q4' under the lock, publish_estimate() only changes it together
+ *      with the submission of this work item.
+ */
+static void save_handler(struct k_work *work)
+{
+    struct calib_record record = { 0 };
+    k_spinlock_key_t key;
+    int err;
+
+    record.version = CALIB_RECORD_VERSION;
+    record.acc_scale = imu_convert_acc_scale.f32;
+    record.gyr_scale = imu_convert_gyr_scale.f32;
+
+    key = k_spin_lock(&calib_lock);
+    memcpy(record.offset_q4, saved_q4, sizeof(record.offset_q4));
+    k_spin_unlock(&calib_lock, key);
+
+    err = settings_save_one(CALIB_SETTINGS_KEY, &record, sizeof(record));
+
+    if (err != 0)
+    {
+        printk("calib: save failed (%d)\n\r", err);
+        return;
+    }
+
+    key = k_spin_lock(&calib_lock);
+    calib_state.saves++;
+    k_spin_unlock(&calib_lock, key);
+
+    printk("calib: saved gyro bias %d %d %d LSB, accel offset %d %d %d LSB\n\r",
+           q4_to_lsb(record.offset_q4[CALIB_GYR + 0U]),
+           q4_to_lsb(record.offset_q4[CALIB_GYR + 1U]),
+           q4_to_lsb(record.offset_q4[CALIB_GYR + 2U]),
+           q4_to_lsb(record.offset_q4[CALIB_ACC + 0U]),
+           q4_to_lsb(record.offset_q4[CALIB_ACC + 1U]),
+           q4_to_lsb(record.offset_q4[CALIB_ACC + 2U]));
+}
@@ -0,0 +1,158 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   Online IMU calibration                                                                                      |
+ * |    @file           :   imu_calib.h                                                                                                 |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the online gyro bias and accel offset calibration, kept in flash across resets           |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_CALIB_H_
+#define IMU_CALIB_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'bool' data-type
+ */
+#include <stdbool.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type that is corrected in place
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: imu_calib_t
+ * @brief: the calibration currently applied to the samples and how it was obtained
+ */
+typedef struct {
+    int16_t gyr_bias[3];        /**< gyro bias x/y/z in raw LSB of the configured range, subtracted from every sample */
+    int16_t acc_offset[3];      /**< accel offset x/y/z in raw LSB of the configured range, subtracted from every sample */
+    bool loaded;                /**< the calibration was restored from flash at startup */
+    bool gyr_valid;             /**< the gyro bias was loaded or estimated from at least one still window */
+    uint32_t windows;           /**< windows evaluated since startup */
+    uint32_t still_windows;     /**< windows the sensor was found still in (the estimate was updated) */
+    uint32_t saves;             /**< calibrations written to flash since startup */
+} imu_calib_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int imu_calib_init(void);
+ *  \b Description                              :       initialise the settings subsystem and restore the last saved calibration, a
+ *                                                      calibration saved with other ranges is rescaled to the current ones.
+ *  @note                                       :       with a stored calibration the samples are corrected from the first one on, without
+ *                                                      it the gyro is only corrected once the sensor was still for one window.
+ *  \b PRE-CONDITION                            :       the ranges of both sensors were applied (imu_convert_set_accel_range() and
+ *                                                      imu_convert_set_gyro_range()).
+ *  \b POST-CONDITION                           :       imu_calib_update() can be given samples.
+ *  @return                                     :       0 on success (with or without a stored calibration), a negative error code if the
+ *                                                      settings storage could not be initialised or read.
+ *  @see                                        :       void imu_calib_update(imu_sample_t *samples, uint16_t count);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_calib_init(void);
+
+
+/**
+ *  \b function                                 :       void imu_calib_update(imu_sample_t *samples, uint16_t count);
+ *  \b Description                              :       feed raw samples to the stillness detector and subtract the current gyro bias and
+ *                                                      accel offset from them in place (saturating int16 arithmetic).
+ *  @param  samples [IN/OUT]                    :       raw samples, oldest first, corrected on return.
+ *  @param  count [IN]                          :       number of samples.
+ *  @note                                       :       every CONFIG_L3_CALIB_WINDOW samples the variance of every axis is checked, a still
+ *                                                      window updates the estimate. a changed estimate is written to flash from the system
+ *                                                      work queue, at most once per CONFIG_L3_CALIB_SAVE_INTERVAL_SEC. not reentrant, to be
+ *                                                      called from the acquisition context only.
+ *  \b PRE-CONDITION                            :       imu_calib_init() was called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_calib_update(imu_sample_t *samples, uint16_t count);
+
+
+/**
+ *  \b function                                 :       void imu_calib_get(imu_calib_t *calib);
+ *  \b Description                              :       read the calibration that is currently applied and its counters.
+ *  @param  calib [OUT]                         :       receives a consistent copy.
+ *  @note                                       :       can be called from any context.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_calib_get(imu_calib_t *calib);
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_CALIB_H_*/
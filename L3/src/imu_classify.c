@@ -0,0 +1,419 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include <errno.h>
+#include <string.h>
+
+// include the math library, for the Hann window, the logarithms and the magnitudes
+#include <math.h>
+
+// include the CMSIS-DSP real FFT, the statistics and the vector functions of the features
+#include <arm_math.h>
+
+// include the CMSIS-NN int8 kernels of the network
+#include <arm_nnfunctions.h>
+
+// include the accel and gyro scales of the configured ranges
+#include "imu_convert.h"
+
+// include the network and the feature scaling, generated by 'tools/classify_train.py'
+#include "imu_classify_model.h"
+
+#include "imu_classify.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                                 |   Documentation Link
+ * =========================================|=====================
+ * arm_rfft_fast_f32()                      |   https://arm-software.github.io/CMSIS-DSP/latest/group__RealFFT.html
+ * arm_cmplx_mag_squared_f32()              |   https://arm-software.github.io/CMSIS-DSP/latest/group__cmplx__mag__squared.html
+ * arm_mean_f32() / arm_power_f32()         |   https://arm-software.github.io/CMSIS-DSP/latest/group__groupStats.html
+ * arm_fully_connected_s8()                 |   https://arm-software.github.io/CMSIS-NN/latest/group__FC.html
+ * arm_softmax_s8()                         |   https://arm-software.github.io/CMSIS-NN/latest/group__Softmax.html
+ * imu_convert_f32()                        |   refer to 'imu_convert.h'
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Samples per window and bins of the one sided spectrum (the Nyquist bin is left out). */
+#define WINDOW                  (IMU_CLASSIFY_MODEL_WINDOW)
+#define BINS                    (IMU_CLASSIFY_MODEL_WINDOW / 2U)
+#define BANDS                   (IMU_CLASSIFY_MODEL_BANDS)
+#define FEATURES                (IMU_CLASSIFY_MODEL_FEATURES)
+#define HIDDEN                  (IMU_CLASSIFY_MODEL_HIDDEN)
+#define CLASSES                 (IMU_CLASSIFY_MODEL_CLASSES)
+
+/*! Accel x, y, z and gyro x, y, z, with mean, log variance and zero crossings each. */
+#define AXES                    (6U)
+#define AXIS_FEATURES           (3U)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(IMU_CLASSIFY_MODEL_WINDOW), "the window has to be a power of 2");
+BUILD_ASSERT(FEATURES == ((AXES * AXIS_FEATURES) + (2U * BANDS)), "the model was exported for other features");
+BUILD_ASSERT((CONFIG_L3_IMU_ODR_HZ / IMU_SAMPLE_DECIMATION) == IMU_CLASSIFY_MODEL_RATE_HZ,
+             "the model was trained at another sample rate, retrain it or change the ODR / decimation");
+BUILD_ASSERT(CONFIG_L3_CLASSIFY_HOP <= IMU_CLASSIFY_MODEL_WINDOW, "the hop may not skip samples");
+BUILD_ASSERT(CONFIG_L3_PROC_BATCH <= CONFIG_L3_CLASSIFY_HOP, "a batch may complete at most one window");
+
+/*! Floors of the logarithms, in g^2 (dps^2): below the noise of the sensor. Keep in sync with the tool. */
+#define VAR_EPS                 (1e-6f)
+#define BAND_EPS                (1e-6f)
+
+/*! Hann window: the noise power is scaled by sum(w^2) = 3N / 8, the same scale as the vibration spectrum. */
+#define POWER_SCALE             (2.0f / (0.375f * (float)WINDOW * (float)WINDOW))
+
+/*! Scratch of the CMSIS-NN fully connected kernel, only the MVE variant uses it (one sum per output). */
+#define NN_SCRATCH_WORDS        (MAX(HIDDEN, CLASSES))
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! Raw samples of the sliding window, one ring per axis, 'head' is the oldest sample once the window is full. */
+static int16_t window_raw[AXES][WINDOW];
+static uint16_t head;
+static uint16_t fill;
+static uint16_t since_last;
+static uint32_t last_time;
+
+/*! Work buffers of one signal: time domain, packed complex spectrum (and the power per bin after it). */
+static float series[WINDOW];
+static float spectrum[WINDOW];
+
+/*! Hann window, computed once. */
+static float hann[WINDOW];
+
+static arm_rfft_fast_instance_f32 rfft;
+
+/*! Features and the int8 activations of the network. */
+static float features[FEATURES];
+static int8_t nn_input[FEATURES];
+static int8_t nn_hidden[HIDDEN];
+static int8_t nn_logits[CLASSES];
+static int8_t nn_probs[CLASSES];
+static int32_t nn_scratch[NN_SCRATCH_WORDS];
+
+static imu_classify_result_t last_result;
+static uint32_t inferences;
+
+/*! Shapes and quantization of the two layers, from the generated model. */
+static const cmsis_nn_dims input_dims = { .n = 1, .h = 1, .w = 1, .c = FEATURES };
+static const cmsis_nn_dims l1_filter_dims = { .n = FEATURES, .h = 1, .w = 1, .c = HIDDEN };
+static const cmsis_nn_dims l1_bias_dims = { .n = 1, .h = 1, .w = 1, .c = HIDDEN };
+static const cmsis_nn_dims l1_output_dims = { .n = 1, .h = 1, .w = 1, .c = HIDDEN };
+static const cmsis_nn_dims l2_filter_dims = { .n = HIDDEN, .h = 1, .w = 1, .c = CLASSES };
+static const cmsis_nn_dims l2_bias_dims = { .n = 1, .h = 1, .w = 1, .c = CLASSES };
+static const cmsis_nn_dims l2_output_dims = { .n = 1, .h = 1, .w = 1, .c = CLASSES };
+
+/*! Layer 1 ends in a ReLU: the lowest output is the zero point. */
+static const cmsis_nn_fc_params l1_params = {
+    .input_offset = 0,
+    .filter_offset = 0,
+    .output_offset = IMU_CLASSIFY_MODEL_L1_OUT_OFFSET,
+    .activation = { .min = IMU_CLASSIFY_MODEL_L1_OUT_OFFSET, .max = INT8_MAX },
+};
+
+static const cmsis_nn_fc_params l2_params = {
+    .input_offset = -IMU_CLASSIFY_MODEL_L1_OUT_OFFSET,
+    .filter_offset = 0,
+    .output_offset = IMU_CLASSIFY_MODEL_L2_OUT_OFFSET,
+    .activation = { .min = INT8_MIN, .max = INT8_MAX },
+};
+
+static const cmsis_nn_per_tensor_quant_params l1_quant = {
+    .multiplier = IMU_CLASSIFY_MODEL_L1_MULT,
+    .shift = IMU_CLASSIFY_MODEL_L1_SHIFT,
+};
+
+static const cmsis_nn_per_tensor_quant_params l2_quant = {
+    .multiplier = IMU_CLASSIFY_MODEL_L2_MULT,
+    .shift = IMU_CLASSIFY_MODEL_L2_SHIFT,
+};
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function copies one axis of the window, oldest sample first, into 'series' in g or dps.
+ */
+static void load_axis(uint8_t axis);
+
+/*!
+ *  @brief This internal function computes the mean, the log variance and the zero crossings of 'series'.
+ *
+ *  @param[out] out      : The three features.
+ */
+static void axis_features(float *out);
+
+/*!
+ *  @brief This internal function computes the log power of the bands of the magnitude of three axes.
+ *
+ *  @param[in]  first    : First axis of the sensor, 0 (accel) or 3 (gyro).
+ *  @param[in]  scale    : LSB to g or dps.
+ *  @param[out] out      : BANDS features.
+ */
+static void magnitude_features(uint8_t first, float scale, float *out);
+
+/*!
+ *  @brief This internal function computes the features of the window and runs the network over them.
+ *
+ *  @return 0 on success, -EIO if a CMSIS-NN kernel failed.
+ */
+static int classify(void);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int imu_classify_init(void)
+{
+    uint16_t n;
+
+    if (arm_rfft_fast_init_f32(&rfft, WINDOW) != ARM_MATH_SUCCESS)
+    {
+        return -EINVAL;
+    }
+
+    if ((arm_fully_connected_s8_get_buffer_size(&l1_filter_dims) > (int32_t)sizeof(nn_scratch)) ||
+        (arm_fully_connected_s8_get_buffer_size(&l2_filter_dims) > (int32_t)sizeof(nn_scratch)))
+    {
+        return -ENOMEM;
+    }
+
+    /* Periodic Hann window, like the one of the vibration spectrum. */
+    for (n = 0; n < WINDOW; n++)
+    {
+        hann[n] = 0.5f * (1.0f - cosf((2.0f * PI * (float)n) / (float)WINDOW));
+    }
+
+    head = 0;
+    fill = 0;
+    since_last = 0;
+    inferences = 0;
+    memset(&last_result, 0, sizeof(last_result));
+
+    return 0;
+}
+
+int imu_classify_update(const imu_sample_t *samples, uint16_t count)
+{
+    int ready = 0;
+    int err;
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        /* A lost sample breaks the time base of the window, start a new one from this sample. */
+        if ((fill > 0) && ((uint32_t)(samples[i].sensor_time - last_time) > (IMU_SAMPLE_NOMINAL_TICKS + (IMU_SAMPLE_NOMINAL_TICKS / 2U))))
+        {
+            fill = 0;
+            since_last = 0;
+        }
+
+        last_time = samples[i].sensor_time;
+
+        window_raw[0][head] = samples[i].acc_x;
+        window_raw[1][head] = samples[i].acc_y;
+        window_raw[2][head] = samples[i].acc_z;
+        window_raw[3][head] = samples[i].gyr_x;
+        window_raw[4][head] = samples[i].gyr_y;
+        window_raw[5][head] = samples[i].gyr_z;
+
+        head = (head + 1U) % WINDOW;
+        fill = MIN(fill + 1U, WINDOW);
+        since_last++;
+
+        if ((fill == WINDOW) && (since_last >= CONFIG_L3_CLASSIFY_HOP))
+        {
+            since_last = 0;
+
+            err = classify();
+            if (err != 0)
+            {
+                return err;
+            }
+
+            last_result.sensor_time = last_time;
+            ready = 1;
+        }
+    }
+
+    return ready;
+}
+
+void imu_classify_get_result(imu_classify_result_t *result)
+{
+    *result = last_result;
+}
+
+void imu_classify_get_info(imu_classify_info_t *info)
+{
+    info->window = WINDOW;
+    info->hop = CONFIG_L3_CLASSIFY_HOP;
+    info->rate_hz = IMU_CLASSIFY_MODEL_RATE_HZ;
+    info->features = FEATURES;
+    info->classes = CLASSES;
+    info->ram_bytes = sizeof(window_raw) + sizeof(series) + sizeof(spectrum) + sizeof(hann) + sizeof(rfft) +
+                      sizeof(features) + sizeof(nn_input) + sizeof(nn_hidden) + sizeof(nn_logits) +
+                      sizeof(nn_probs) + sizeof(nn_scratch);
+    info->model_bytes = sizeof(imu_classify_model_w1) + sizeof(imu_classify_model_b1) +
+                        sizeof(imu_classify_model_w2) + sizeof(imu_classify_model_b2) +
+                        sizeof(imu_classify_model_feature_mean) + sizeof(imu_classify_model_feature_scale);
+    info->inferences = inferences;
+}
+
+/*!
+ * @brief This internal function copies one axis of the window into 'series'.
+ *
+ * @details
+ *      the ring is not rotated, its two parts are converted in place of a copy: from the oldest sample at
+ *      'head' to the end of the ring, then from the start of the ring up to 'head'.
+ */
+static void load_axis(uint8_t axis)
+{
+    const imu_convert_scale_t *scale = (axis < 3U) ? &imu_convert_acc_scale : &imu_convert_gyr_scale;
+
+    imu_convert_f32(scale, &window_raw[axis][head], series, WINDOW - head);
+    imu_convert_f32(scale, window_raw[axis], &series[WINDOW - head], head);
+}
+
+/*!
+ * @brief This internal function computes the features of one axis.
+ *
+ * @details
+ *      the variance is taken over N like the training tool does (arm_var_f32() divides by N - 1). a zero
+ *      crossing is a change of sign of the series around its mean, at rest the noise alone crosses about
+ *      every other sample, in motion only the motion does.
+ */
+static void axis_features(float *out)
+{
+    float mean, power;
+    uint16_t crossings = 0;
+    uint16_t n;
+
+    arm_mean_f32(series, WINDOW, &mean);
+    arm_offset_f32(series, -mean, series, WINDOW);
+    arm_power_f32(series, WINDOW, &power);
+
+    for (n = 1; n < WINDOW; n++)
+    {
+        if ((series[n - 1U] < 0.0f) != (series[n] < 0.0f))
+        {
+            crossings++;
+        }
+    }
+
+    out[0] = mean;
+    out[1] = logf((power / (float)WINDOW) + VAR_EPS);
+    out[2] = (float)crossings;
+}
+
+/*!
+ * @brief This internal function computes the band features of the magnitude of one sensor.
+ *
+ * @details
+ *      the magnitude does not depend on how the sensor is mounted. its mean (gravity, for the accel) is
+ *      removed and the Hann windowed real FFT split into BANDS equal bands, like the vibration spectrum.
+ *      the real FFT packs the DC and Nyquist bins into spectrum[0] and spectrum[1], the complex bins
+ *      1 .. N/2-1 follow, their power lands in 'series' which is free again after the transform.
+ */
+static void magnitude_features(uint8_t first, float scale, float *out)
+{
+    const int16_t *x = window_raw[first];
+    const int16_t *y = window_raw[first + 1U];
+    const int16_t *z = window_raw[first + 2U];
+    float band_power[BANDS] = { 0 };
+    float mean;
+    uint16_t n, k;
+    uint8_t b;
+
+    /* Oldest sample first, the Hann window has to line up with the samples. */
+    for (n = 0; n < WINDOW; n++)
+    {
+        k = (head + n) % WINDOW;
+        series[n] = sqrtf(((float)x[k] * (float)x[k]) + ((float)y[k] * (float)y[k]) + ((float)z[k] * (float)z[k])) * scale;
+    }
+
+    arm_mean_f32(series, WINDOW, &mean);
+    arm_offset_f32(series, -mean, series, WINDOW);
+    arm_mult_f32(series, hann, series, WINDOW);
+
+    arm_rfft_fast_f32(&rfft, series, spectrum, 0);
+
+    arm_cmplx_mag_squared_f32(&spectrum[2], &series[1], BINS - 1U);
+
+    for (k = 1; k < BINS; k++)
+    {
+        band_power[((uint32_t)k * BANDS) / BINS] += series[k];
+    }
+
+    for (b = 0; b < BANDS; b++)
+    {
+        out[b] = logf((band_power[b] * POWER_SCALE) + BAND_EPS);
+    }
+}
+
+/*!
+ * @brief This internal function classifies the window.
+ *
+ * @details
+ *      the features are standardised with the mean and the scale of the training set and quantized to the
+ *      int8 input of the network (0 is the mean, 32 one standard deviation). the two fully connected
+ *      layers and the softmax are the CMSIS-NN kernels, the softmax output q is the probability
+ *      (q + 128) / 256.
+ */
+static int classify(void)
+{
+    const cmsis_nn_context ctx = { .buf = nn_scratch, .size = sizeof(nn_scratch) };
+    int32_t q;
+    uint8_t axis, i, best;
+
+    for (axis = 0; axis < AXES; axis++)
+    {
+        load_axis(axis);
+        axis_features(&features[axis * AXIS_FEATURES]);
+    }
+
+    magnitude_features(0, imu_convert_acc_scale.f32, &features[AXES * AXIS_FEATURES]);
+    magnitude_features(3, imu_convert_gyr_scale.f32, &features[(AXES * AXIS_FEATURES) + BANDS]);
+
+    for (i = 0; i < FEATURES; i++)
+    {
+        q = (int32_t)lroundf((features[i] - imu_classify_model_feature_mean[i]) * imu_classify_model_feature_scale[i]);
+        nn_input[i] = (int8_t)CLAMP(q, INT8_MIN, INT8_MAX);
+    }
+
+    if (arm_fully_connected_s8(&ctx, &l1_params, &l1_quant, &input_dims, nn_input, &l1_filter_dims,
+                               imu_classify_model_w1, &l1_bias_dims, imu_classify_model_b1,
+                               &l1_output_dims, nn_hidden) != ARM_CMSIS_NN_SUCCESS)
+    {
+        return -EIO;
+    }
+
+    if (arm_fully_connected_s8(&ctx, &l2_params, &l2_quant, &l1_output_dims, nn_hidden, &l2_filter_dims,
+                               imu_classify_model_w2, &l2_bias_dims, imu_classify_model_b2,
+                               &l2_output_dims, nn_logits) != ARM_CMSIS_NN_SUCCESS)
+    {
+        return -EIO;
+    }
+
+    arm_softmax_s8(nn_logits, 1, CLASSES, IMU_CLASSIFY_MODEL_SM_MULT, IMU_CLASSIFY_MODEL_SM_SHIFT,
+                   IMU_CLASSIFY_MODEL_SM_DIFF_MIN, nn_probs);
+
+    best = 0;
+    for (i = 1; i < CLASSES; i++)
+    {
+        if (nn_probs[i] > nn_probs[best])
+        {
+            best = i;
+        }
+    }
+
+    last_result.label = best;
+    last_result.confidence = (uint8_t)((((int32_t)nn_probs[best] + 128) * 100) / 256);
+    last_result.name = imu_classify_model_labels[best];
+    inferences++;
+
+    return 0;
+}
@@ -0,0 +1,199 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   Activity classifier on windows of samples                                                                   |
+ * |    @file           :   imu_classify.h                                                                                              |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the on-device activity classifier: window features and a small int8 network (CMSIS-NN)   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_CLASSIFY_H_
+#define IMU_CLASSIFY_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type the windows are built from
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: imu_classify_result_t
+ * @brief: the class of one window, the only thing the stage hands on instead of the samples
+ */
+typedef struct {
+    uint32_t sensor_time;       /**< sensor time of the last sample of the window */
+    uint8_t label;              /**< index of the most probable class */
+    uint8_t confidence;         /**< its probability after the int8 softmax, in % */
+    const char *name;           /**< name of the class, as given to 'tools/classify_train.py' */
+} imu_classify_result_t;
+
+/**
+ * @struct: imu_classify_info_t
+ * @brief: shape and footprint of the classifier, for the benchmark
+ */
+typedef struct {
+    uint16_t window;            /**< samples per window */
+    uint16_t hop;               /**< new samples between two inferences */
+    uint16_t rate_hz;           /**< sample rate the model was trained at */
+    uint8_t features;           /**< features per window, the inputs of the network */
+    uint8_t classes;            /**< outputs of the network */
+    uint32_t ram_bytes;         /**< static RAM of the stage: window, FFT buffers and activations */
+    uint32_t model_bytes;       /**< flash of the model: weights, biases and feature scaling */
+    uint32_t inferences;        /**< windows classified since imu_classify_init() */
+} imu_classify_info_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int imu_classify_init(void);
+ *  \b Description                              :       set up the real FFT and the Hann window of the features and empty the window.
+ *  \b PRE-CONDITION                            :       imu_convert_set_accel_range() and imu_convert_set_gyro_range() succeeded.
+ *  \b POST-CONDITION                           :       imu_classify_update() can be used.
+ *  @return                                     :       0 on success, -EINVAL if CMSIS-DSP does not support the window size,
+ *                                                      -ENOMEM if the CMSIS-NN kernels need more scratch than reserved.
+ *  @see                                        :       int imu_classify_update(const imu_sample_t *samples, uint16_t count);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_classify_init(void);
+
+
+/**
+ *  \b function                                 :       int imu_classify_update(const imu_sample_t *samples, uint16_t count);
+ *  \b Description                              :       append the samples to the sliding window, every CONFIG_L3_CLASSIFY_HOP samples of
+ *                                                      a full window extract the features and run the int8 network (CMSIS-NN).
+ *  @param  samples [IN]                        :       raw samples, oldest first.
+ *  @param  count [IN]                          :       number of samples, at most CONFIG_L3_CLASSIFY_HOP.
+ *  @note                                       :       a gap in the sensor time (a lost sample) empties the window, a window never spans
+ *                                                      a broken time base. not reentrant, one caller only.
+ *  \b PRE-CONDITION                            :       imu_classify_init() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       1 if a window was classified (read it with imu_classify_get_result()), 0 otherwise,
+ *                                                      -EIO if a CMSIS-NN kernel failed.
+ *  @see                                        :       void imu_classify_get_result(imu_classify_result_t *result);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_classify_update(const imu_sample_t *samples, uint16_t count);
+
+
+/**
+ *  \b function                                 :       void imu_classify_get_result(imu_classify_result_t *result);
+ *  \b Description                              :       read the class of the last classified window.
+ *  @param  result [OUT]                        :       receives the class, all zero (and no name) before the first window.
+ *  @note                                       :       same context as imu_classify_update().
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_classify_get_result(imu_classify_result_t *result);
+
+
+/**
+ *  \b function                                 :       void imu_classify_get_info(imu_classify_info_t *info);
+ *  \b Description                              :       read the shape of the model and the RAM and flash the stage takes.
+ *  @param  info [OUT]                          :       receives the numbers.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_classify_get_info(imu_classify_info_t *info);
+
+#if defined(CONFIG_L3_CLASSIFY_BENCH)
+/**
+ *  \b function                                 :       void imu_classify_bench_run(void);
+ *  \b Description                              :       measure the cycles per inference (features and network) and print them with the
+ *                                                      CPU load at the inference rate and the RAM of the stage and of the whole image.
+ *  @note                                       :       empties the window, run it before the acquisition starts.
+ *  \b PRE-CONDITION                            :       imu_classify_init() succeeded.
+ *  \b POST-CONDITION                           :       the window is empty, like after imu_classify_init().
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_classify_bench_run(void);
+#endif
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_CLASSIFY_H_*/
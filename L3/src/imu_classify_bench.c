@@ -0,0 +1,150 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+// include the printk function file header
+#include <zephyr/sys/printk.h>
+
+// include the cycle accurate timing functions (DWT CYCCNT on the nRF52832, the host counter on native_sim)
+#include <zephyr/timing/timing.h>
+
+// include the linker symbols of the RAM the image takes (data, bss, stacks and heap)
+#include <zephyr/linker/linker-defs.h>
+
+#include "imu_classify.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                 |   Documentation Link
+ * =========================|=====================
+ * timing_counter_get()     |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * timing_cycles_get()      |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * timing_cycles_to_ns()    |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Windows classified and timed, after the first window is filled. */
+#define BENCH_INFERENCES    (32U)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+static imu_sample_t bench_samples[CONFIG_L3_CLASSIFY_HOP];
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function fills 'bench_samples' with the next hop of a walking like motion.
+ */
+static void next_hop(uint32_t *index, uint32_t ticks);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+/*!
+ * @brief measure and print the cycles per inference and the RAM of the classifier.
+ *
+ * @details
+ *      every timed call of imu_classify_update() takes one hop of samples and completes one window, the
+ *      time covers the copy of the hop into the window, the features and the network. the load is the
+ *      share of the CPU at the inference rate (sample rate / hop). the RAM of the image is everything the
+ *      linker placed in RAM, stacks and heap included, the stage has to fit into what is left of
+ *      CONFIG_SRAM_SIZE next to the acquisition.
+ */
+void imu_classify_bench_run(void)
+{
+    imu_classify_info_t info;
+    timing_t start, end;
+    uint64_t cycles, ns, total_cycles = 0, total_ns = 0;
+    uint64_t min_cycles = UINT64_MAX, max_cycles = 0;
+    uint32_t index = 0, ticks, load_x100, image_ram;
+    uint32_t round, filled;
+
+    imu_classify_get_info(&info);
+    ticks = 25600U / info.rate_hz;
+
+    /* The first window is not timed, it only completes once the whole window was taken. */
+    for (filled = 0; filled < (uint32_t)(info.window - info.hop); filled += info.hop)
+    {
+        next_hop(&index, ticks);
+        imu_classify_update(bench_samples, info.hop);
+    }
+
+    timing_init();
+    timing_start();
+
+    for (round = 0; round < BENCH_INFERENCES; round++)
+    {
+        next_hop(&index, ticks);
+
+        start = timing_counter_get();
+        imu_classify_update(bench_samples, info.hop);
+        end = timing_counter_get();
+
+        cycles = timing_cycles_get(&start, &end);
+        total_cycles += cycles;
+        total_ns += timing_cycles_to_ns(cycles);
+        min_cycles = MIN(min_cycles, cycles);
+        max_cycles = MAX(max_cycles, cycles);
+    }
+
+    timing_stop();
+
+    cycles = total_cycles / BENCH_INFERENCES;
+    ns = total_ns / BENCH_INFERENCES;
+    /* load in % = ns per inference * (rate / hop) inferences per second / 10^9 * 100. */
+    load_x100 = (uint32_t)((ns * info.rate_hz) / (info.hop * 100000ULL));
+    image_ram = (uint32_t)(_image_ram_end - _image_ram_start);
+
+    imu_classify_get_info(&info);
+
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("Classifier benchmark, %u features -> %u classes, window %u, hop %u at %u Hz\n\r",
+           info.features, info.classes, info.window, info.hop, info.rate_hz);
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("%u cycles/inference (min %u, max %u), %u us/inference, %u.%02u %% CPU\n\r",
+           (uint32_t)cycles, (uint32_t)min_cycles, (uint32_t)max_cycles, (uint32_t)(ns / 1000U),
+           load_x100 / 100U, load_x100 % 100U);
+    printk("%u bytes of RAM in the stage, %u bytes of model in flash, %u inferences\n\r",
+           info.ram_bytes, info.model_bytes, info.inferences);
+    printk("%u of %u bytes of RAM taken by the image\n\r", image_ram, CONFIG_SRAM_SIZE * 1024U);
+
+    /* The benchmark filled the window with made-up samples, start over from the first real sample. */
+    imu_classify_init();
+}
+
+/*!
+ * @brief This internal function fills the next hop of samples.
+ *
+ * @details
+ *      a 2 Hz step of +/-0.25 g on top of gravity and a sway of the gyro, drawn as triangles to stay in
+ *      integers. the values only have to run through every part of the features, the class is not checked.
+ */
+static void next_hop(uint32_t *index, uint32_t ticks)
+{
+    uint32_t i, phase;
+    int32_t tri;
+
+    for (i = 0; i < CONFIG_L3_CLASSIFY_HOP; i++)
+    {
+        /* Triangle of period 50 samples (2 Hz at 100 Hz), from -25 to +25. */
+        phase = *index % 50U;
+        tri = (phase < 25U) ? ((int32_t)phase * 2 - 25) : (75 - ((int32_t)phase * 2));
+
+        bench_samples[i].sensor_time = (*index + 1U) * ticks;
+        bench_samples[i].acc_x = (int16_t)(tri * 20);
+        bench_samples[i].acc_y = (int16_t)(-300 + (int32_t)(*index & 7U));
+        bench_samples[i].acc_z = (int16_t)(8192 + (tri * 80));
+        bench_samples[i].gyr_x = (int16_t)(tri * 60);
+        bench_samples[i].gyr_y = (int16_t)(-tri * 30);
+        bench_samples[i].gyr_z = (int16_t)(*index & 15U);
+
+        (*index)++;
+    }
+}
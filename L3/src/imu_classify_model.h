@@ -0,0 +1,92 @@
+/*
+ * activity classifier of L3, generated by 'tools/classify_train.py', do not edit.
+ *
+ * trained on: synthetic windows (--synthetic), replace with recordings
+ * features: 26 per window of 128 samples at 100 Hz (4 bands per magnitude)
+ * network: 26 -> 16 (ReLU) -> 4, int8 weights, 560 bytes of weights and biases
+ */
+
+#ifndef IMU_CLASSIFY_MODEL_H_
+#define IMU_CLASSIFY_MODEL_H_
+
+#include <stdint.h>
+
+#define IMU_CLASSIFY_MODEL_RATE_HZ          (100U)
+#define IMU_CLASSIFY_MODEL_WINDOW           (128U)
+#define IMU_CLASSIFY_MODEL_BANDS            (4U)
+#define IMU_CLASSIFY_MODEL_FEATURES         (26U)
+#define IMU_CLASSIFY_MODEL_HIDDEN           (16U)
+#define IMU_CLASSIFY_MODEL_CLASSES          (4U)
+
+/* requantization of the layers (multiplier, shift) and the zero points of their outputs */
+#define IMU_CLASSIFY_MODEL_L1_MULT          (1865644602)
+#define IMU_CLASSIFY_MODEL_L1_SHIFT         (-7)
+#define IMU_CLASSIFY_MODEL_L1_OUT_OFFSET    (-128)
+#define IMU_CLASSIFY_MODEL_L2_MULT          (1122668529)
+#define IMU_CLASSIFY_MODEL_L2_SHIFT         (-8)
+#define IMU_CLASSIFY_MODEL_L2_OUT_OFFSET    (3)
+
+/* arm_softmax_s8() of the logits */
+#define IMU_CLASSIFY_MODEL_SM_MULT          (1419801754)
+#define IMU_CLASSIFY_MODEL_SM_SHIFT         (24)
+#define IMU_CLASSIFY_MODEL_SM_DIFF_MIN      (-124)
+
+static const char *const imu_classify_model_labels[IMU_CLASSIFY_MODEL_CLASSES] = {
+    "still", "walk", "run", "shake"
+};
+
+/* int8 input = (feature - mean) * scale */
+static const float imu_classify_model_feature_mean[IMU_CLASSIFY_MODEL_FEATURES] = {
+    -4.78796512e-02f, -5.17703049e+00f, 2.37281250e+01f, -1.93865031e-02f, -5.22855032e+00f, 2.34375000e+01f,
+    2.37373799e-02f, -5.29096102e+00f, 2.35500000e+01f, -1.97329745e-01f, 3.53187649e+00f, 2.02656250e+01f,
+    1.48307532e-02f, 3.37075229e+00f, 2.02406250e+01f, -1.28908828e-01f, 3.59738738e+00f, 1.99812500e+01f,
+    -4.26255993e+00f, -1.07406844e+01f, -1.23390265e+01f, -1.26740038e+01f, 3.34958860e+00f, -9.00740516e-01f,
+    -2.51990854e+00f, -3.27346330e+00f,
+};
+
+static const float imu_classify_model_feature_scale[IMU_CLASSIFY_MODEL_FEATURES] = {
+    5.03644945e+01f, 7.27911143e+00f, 1.31718425e+00f, 5.10302963e+01f, 7.38531983e+00f, 1.31757007e+00f,
+    4.93428263e+01f, 7.32304427e+00f, 1.33403122e+00f, 8.93403060e+00f, 6.09797373e+00f, 1.24399598e+00f,
+    9.98241853e+00f, 6.10849689e+00f, 1.25834015e+00f, 9.46263412e+00f, 6.26344627e+00f, 1.25520999e+00f,
+    6.04035464e+00f, 8.23653557e+00f, 1.76351922e+01f, 2.49930734e+01f, 5.63052574e+00f, 7.72028649e+00f,
+    9.13845415e+00f, 1.03643375e+01f,
+};
+
+/* [IMU_CLASSIFY_MODEL_HIDDEN][IMU_CLASSIFY_MODEL_FEATURES] */
+static const int8_t imu_classify_model_w1[IMU_CLASSIFY_MODEL_HIDDEN * IMU_CLASSIFY_MODEL_FEATURES] = {
+    -12, -8, -19, 50, 70, -51, 32, 55, -48, -19, 5, 6, 16, 47, -18, -15, 33, 23, 4, 41, 31, 1, 45, 11, 30, 91,
+    -40, -44, -64, 17, -19, -55, -36, 18, -3, -27, 9, 12, 18, 14, -46, -19, 38, -34, -47, -45, -89, -67, 1, -108, -55, -127,
+    -7, -3, 12, 44, 35, 51, 52, 35, 71, 1, 33, 27, 6, 48, 41, 49, -19, -2, -23, 48, 42, 83, -4, 35, 53, 114,
+    -8, 20, -48, 7, 18, 5, 19, 17, -12, -25, 61, -30, -16, 71, -25, -16, 31, 2, 39, 101, 63, -13, 69, 76, 100, 72,
+    9, -8, -51, -12, -4, -54, -14, -55, -82, 26, -57, -42, 6, -23, -23, 30, -10, -61, -84, -30, -4, -12, -1, -16, -86, -26,
+    -3, 62, -52, 17, 49, -37, -19, 1, -36, 9, 49, -46, 6, -3, -90, -27, 41, -91, 55, -98, -51, -96, -7, -81, -85, -40,
+    -23, 76, -10, 2, 96, -9, 26, 91, -25, 16, 41, 6, 8, 45, -52, 35, 79, 13, 28, 48, 24, 4, 52, 83, 60, 59,
+    -30, 10, -72, -54, -7, -77, -47, -8, -103, 33, 2, -34, -17, 9, -47, -5, 2, -28, -25, -74, -67, -56, 48, -65, -35, -43,
+    8, 41, -56, -29, 80, -5, -41, 56, 9, -25, 14, -40, 31, 42, 22, 12, 46, 21, -10, -18, -72, -27, 62, -15, 5, -39,
+    -23, -20, 52, -32, -57, 44, -2, -68, 47, 45, -1, 29, 27, -5, 40, -14, 6, 58, -30, -61, -43, -25, -57, 2, -47, -57,
+    20, -44, -28, -14, -20, -29, 15, -45, -72, -12, -48, -65, 18, -44, -53, -13, -62, -41, -58, -26, -78, -36, -58, -80, -85, -99,
+    -25, -8, 53, 32, -37, -10, -27, -49, 57, 16, -4, -11, 29, 2, 47, 19, -31, 42, -70, -24, 27, 43, -27, 2, -16, 41,
+    -5, 58, -21, -12, 76, -39, -54, -43, -40, 32, 32, -20, 11, 34, -43, 14, 20, 7, -2, -22, -29, -4, 14, 36, -43, 6,
+    1, 72, -30, 0, 4, -21, -21, 48, -64, 64, -6, 8, -48, -13, -44, -11, -28, -16, 26, -31, -39, -3, 17, -2, -4, 15,
+    13, 45, 24, 7, -21, 48, -34, -6, -16, -39, -16, 1, 50, 34, 31, -40, -13, 34, 59, 13, 22, -24, 26, -2, 24, -6,
+    -38, -51, 55, -6, 2, 29, -13, -46, 52, 6, 19, 13, -42, -28, 68, 27, -2, 2, -50, -32, -23, -10, -65, -57, -2, 15,
+};
+
+static const int32_t imu_classify_model_b1[IMU_CLASSIFY_MODEL_HIDDEN] = {
+    432, 2120, 1321, 1410, 573, 1526, 945, 1357,
+    -54, 692, 1218, 585, -468, -247, -163, 765,
+};
+
+/* [IMU_CLASSIFY_MODEL_CLASSES][IMU_CLASSIFY_MODEL_HIDDEN] */
+static const int8_t imu_classify_model_w2[IMU_CLASSIFY_MODEL_CLASSES * IMU_CLASSIFY_MODEL_HIDDEN] = {
+    -70, 25, 13, -41, -81, -15, -15, -85, -50, 9, -3, 40, 12, -27, -12, 37,
+    -53, 56, -55, -62, 53, 28, -56, 84, -46, -87, 102, -32, -22, -58, -73, -66,
+    22, -33, -127, 2, -74, 36, 48, 30, 70, -50, -111, 7, 85, 70, -27, -46,
+    68, -103, 66, 65, -59, -127, 76, -88, -30, -68, -89, 26, -18, -83, 16, -27,
+};
+
+static const int32_t imu_classify_model_b2[IMU_CLASSIFY_MODEL_CLASSES] = {
+    -712, -153, -223, 494,
+};
+
+#endif /*IMU_CLASSIFY_MODEL_H_*/
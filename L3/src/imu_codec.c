@@ -0,0 +1,213 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include "imu_codec.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * LEB128 varint                    |   https://en.wikipedia.org/wiki/LEB128
+ * zigzag mapping                   |   https://protobuf.dev/programming-guides/encoding/#signed-ints
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Longest varint of a 32 bit and of a 16 bit value. */
+#define VARINT32_MAX            (5U)
+#define VARINT16_MAX            (3U)
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function writes 'value' as a varint to 'out'.
+ *
+ *  @return Number of bytes written.
+ */
+static size_t put_varint(uint32_t value, uint8_t *out);
+
+/*!
+ *  @brief This internal function reads a varint of at most 'max' bytes.
+ *
+ *  @param[in]  in       : Code to read.
+ *  @param[in]  len      : Bytes available at 'in'.
+ *  @param[in]  max      : Longest valid varint.
+ *  @param[out] value    : Decoded value.
+ *
+ *  @return Number of bytes read, 0 if the varint is truncated or too long.
+ */
+static size_t get_varint(const uint8_t *in, size_t len, size_t max, uint32_t *value);
+
+/*!
+ *  @brief This internal function maps a signed difference to an unsigned one, small magnitudes to small values.
+ */
+static uint32_t zigzag32(int32_t value);
+static uint16_t zigzag16(int16_t value);
+
+/*!
+ *  @brief This internal function undoes zigzag32() / zigzag16().
+ */
+static int32_t unzigzag32(uint32_t value);
+static int16_t unzigzag16(uint16_t value);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+void imu_codec_reset(imu_codec_t *codec)
+{
+    memset(codec, 0, sizeof(*codec));
+}
+
+/*!
+ * @brief delta code one sample.
+ *
+ * @details
+ *      the differences are taken in the unsigned types and wrap, the decoder adds them back with the same
+ *      wrap, so no input can overflow the coded ranges.
+ */
+size_t imu_codec_encode(imu_codec_t *codec, const imu_sample_t *sample, uint8_t *out)
+{
+    const uint32_t delta = sample->sensor_time - codec->prev.sensor_time;
+    size_t n;
+
+    n = put_varint(zigzag32((int32_t)(delta - codec->prev_delta)), out);
+
+    n += put_varint(zigzag16((int16_t)(uint16_t)(sample->acc_x - codec->prev.acc_x)), &out[n]);
+    n += put_varint(zigzag16((int16_t)(uint16_t)(sample->acc_y - codec->prev.acc_y)), &out[n]);
+    n += put_varint(zigzag16((int16_t)(uint16_t)(sample->acc_z - codec->prev.acc_z)), &out[n]);
+    n += put_varint(zigzag16((int16_t)(uint16_t)(sample->gyr_x - codec->prev.gyr_x)), &out[n]);
+    n += put_varint(zigzag16((int16_t)(uint16_t)(sample->gyr_y - codec->prev.gyr_y)), &out[n]);
+    n += put_varint(zigzag16((int16_t)(uint16_t)(sample->gyr_z - codec->prev.gyr_z)), &out[n]);
+
+    codec->prev = *sample;
+    codec->prev_delta = delta;
+
+    return n;
+}
+
+int imu_codec_decode(imu_codec_t *codec, const uint8_t *in, size_t len, imu_sample_t *sample)
+{
+    int16_t *const prev_axes[6] = {
+        &codec->prev.acc_x, &codec->prev.acc_y, &codec->prev.acc_z,
+        &codec->prev.gyr_x, &codec->prev.gyr_y, &codec->prev.gyr_z,
+    };
+    int16_t axes[6];
+    uint32_t delta;
+    uint32_t value;
+    size_t n, used;
+    uint8_t i;
+
+    used = get_varint(in, len, VARINT32_MAX, &value);
+    if (used == 0)
+    {
+        return -EINVAL;
+    }
+
+    delta = codec->prev_delta + (uint32_t)unzigzag32(value);
+
+    for (i = 0; i < 6U; i++)
+    {
+        n = get_varint(&in[used], len - used, VARINT16_MAX, &value);
+        if ((n == 0) || (value > UINT16_MAX))
+        {
+            return -EINVAL;
+        }
+
+        used += n;
+        axes[i] = (int16_t)(uint16_t)(*prev_axes[i] + unzigzag16((uint16_t)value));
+    }
+
+    /* The state only moves on once the whole sample was valid. */
+    for (i = 0; i < 6U; i++)
+    {
+        *prev_axes[i] = axes[i];
+    }
+
+    codec->prev_delta = delta;
+    codec->prev.sensor_time += delta;
+
+    *sample = codec->prev;
+    sample->read_cycles = 0;
+
+    return (int)used;
+}
+
+/*!
+ * @brief This internal function writes a varint.
+ */
+static size_t put_varint(uint32_t value, uint8_t *out)
+{
+    size_t n = 0;
+
+    while (value >= 0x80U)
+    {
+        out[n++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+
+    out[n++] = (uint8_t)value;
+
+    return n;
+}
+
+/*!
+ * @brief This internal function reads a varint.
+ */
+static size_t get_varint(const uint8_t *in, size_t len, size_t max, uint32_t *value)
+{
+    uint32_t result = 0;
+    size_t n;
+
+    for (n = 0; (n < len) && (n < max); n++)
+    {
+        result |= (uint32_t)(in[n] & 0x7FU) << (7U * n);
+
+        if ((in[n] & 0x80U) == 0)
+        {
+            *value = result;
+            return n + 1U;
+        }
+    }
+
+    return 0;
+}
+
+/*!
+ * @brief This internal function zigzag maps a 32 bit difference: 0, -1, 1, -2 ... become 0, 1, 2, 3 ...
+ */
+static uint32_t zigzag32(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ ((value < 0) ? 0xFFFFFFFFUL : 0UL);
+}
+
+/*!
+ * @brief This internal function zigzag maps a 16 bit difference.
+ */
+static uint16_t zigzag16(int16_t value)
+{
+    return (uint16_t)(((uint16_t)value << 1) ^ ((value < 0) ? 0xFFFFU : 0U));
+}
+
+/*!
+ * @brief This internal function undoes zigzag32().
+ */
+static int32_t unzigzag32(uint32_t value)
+{
+    return (int32_t)((value >> 1) ^ (0U - (value & 1U)));
+}
+
+/*!
+ * @brief This internal function undoes zigzag16().
+ */
+static int16_t unzigzag16(uint16_t value)
+{
+    return (int16_t)(uint16_t)((value >> 1) ^ (0U - (value & 1U)));
+}
@@ -0,0 +1,167 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   IMU sample delta codec                                                                                      |
+ * |    @file           :   imu_codec.h                                                                                                 |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides a streaming delta / zigzag varint codec that shrinks successive IMU samples              |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_CODEC_H_
+#define IMU_CODEC_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'size_t' data-type
+ */
+#include <stddef.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type that is encoded
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * encoding of one sample, every field is a LEB128 varint (7 bits per byte, least significant group first,
+ * bit 7 set on all but the last byte):
+ *
+ *      | sensor time (1..5) | acc x/y/z (1..3 each) | gyr x/y/z (1..3 each) |
+ *
+ * the sensor time is coded as zigzag(delta - previous delta), a steady ODR gives 0. every axis is coded as
+ * zigzag(value - previous value) taken modulo 2^16, so even a full scale jump fits 3 bytes. after
+ * imu_codec_reset() the previous sample and delta are all zero, the first sample is coded in full.
+ * refer to 'tools/telemetry_decode.py' for the host decoder.
+ */
+#define IMU_CODEC_MAX_SAMPLE_SIZE       (5U + (6U * 3U))
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: imu_codec_t
+ * @brief: state of one encoder or decoder, the sample the next one is coded against
+ */
+typedef struct {
+    imu_sample_t prev;          /**< last sample coded (only the axes and the sensor time are used) */
+    uint32_t prev_delta;        /**< sensor time between the last two samples */
+} imu_codec_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       void imu_codec_reset(imu_codec_t *codec);
+ *  \b Description                              :       start a new independent stream, the next sample is coded without reference.
+ *  @param  codec [IN/OUT]                      :       the encoder or decoder.
+ *  @note                                       :       encoder and decoder have to be reset at the same sample, e.g. at the start of every
+ *                                                      packet so that a lost packet does not break the following ones.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_codec_reset(imu_codec_t *codec);
+
+
+/**
+ *  \b function                                 :       size_t imu_codec_encode(imu_codec_t *codec, const imu_sample_t *sample, uint8_t *out);
+ *  \b Description                              :       delta code one sample against the previous one and append it to 'out'.
+ *  @param  codec [IN/OUT]                      :       the encoder.
+ *  @param  sample [IN]                         :       the sample, 'read_cycles' is not coded.
+ *  @param  out [OUT]                           :       receives the code, room for @IMU_CODEC_MAX_SAMPLE_SIZE bytes.
+ *  @note                                       :       a sample at rest typically takes 7 to 10 bytes instead of 16.
+ *  \b PRE-CONDITION                            :       imu_codec_reset() was called once.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       number of bytes written.
+ *  @see                                        :       int imu_codec_decode(imu_codec_t *codec, const uint8_t *in, size_t len, imu_sample_t *sample);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+size_t imu_codec_encode(imu_codec_t *codec, const imu_sample_t *sample, uint8_t *out);
+
+
+/**
+ *  \b function                                 :       int imu_codec_decode(imu_codec_t *codec, const uint8_t *in, size_t len, imu_sample_t *sample);
+ *  \b Description                              :       decode the next sample of a stream written by imu_codec_encode().
+ *  @param  codec [IN/OUT]                      :       the decoder.
+ *  @param  in [IN]                             :       the code of the next sample.
+ *  @param  len [IN]                            :       bytes available at 'in'.
+ *  @param  sample [OUT]                        :       receives the sample, 'read_cycles' is 0.
+ *  \b PRE-CONDITION                            :       imu_codec_reset() was called at the same sample as for the encoder.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       number of bytes consumed, -EINVAL if the code is truncated or malformed.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_codec_decode(imu_codec_t *codec, const uint8_t *in, size_t len, imu_sample_t *sample);
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_CODEC_H_*/
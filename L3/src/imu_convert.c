@@ -0,0 +1,180 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <errno.h>
+
+// include the BMI3_ACC_RANGE_x / BMI3_GYR_RANGE_x definitions
+#include <bmi323.h>
+
+#include "imu_convert.h"
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! The only data resolution the fixed-point paths support, the raw values are then a Q15 fraction of the range. */
+#define SUPPORTED_BIT_WIDTH     (16U)
+
+/******************************************************************************/
+/*!         Global Variables                                                  */
+
+imu_convert_scale_t imu_convert_acc_scale;
+imu_convert_scale_t imu_convert_gyr_scale;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function computes all the scale factors of one sensor.
+ *
+ *  @param[out] scale          : Scale factors to fill.
+ *  @param[in]  range          : Range of the sensor in g or dps.
+ *  @param[in]  q31_frac_bits  : Fractional bits of the Q31 output.
+ *  @param[in]  q15_full_scale : Physical value of a Q15 output of 1.0.
+ */
+static void compute_scale(imu_convert_scale_t *scale, uint32_t range, uint8_t q31_frac_bits, uint32_t q15_full_scale);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int imu_convert_set_accel_range(uint8_t range, uint8_t bit_width)
+{
+    uint32_t g_range;
+
+    switch (range)
+    {
+        case BMI3_ACC_RANGE_2G:
+            g_range = 2;
+            break;
+        case BMI3_ACC_RANGE_4G:
+            g_range = 4;
+            break;
+        case BMI3_ACC_RANGE_8G:
+            g_range = 8;
+            break;
+        case BMI3_ACC_RANGE_16G:
+            g_range = 16;
+            break;
+        default:
+            return -EINVAL;
+    }
+
+    if (bit_width != SUPPORTED_BIT_WIDTH)
+    {
+        return -EINVAL;
+    }
+
+    compute_scale(&imu_convert_acc_scale, g_range, IMU_CONVERT_ACC_Q31_FRAC_BITS, IMU_CONVERT_ACC_Q15_FULL_SCALE);
+
+    return 0;
+}
+
+int imu_convert_set_gyro_range(uint8_t range, uint8_t bit_width)
+{
+    uint32_t dps_range;
+
+    switch (range)
+    {
+        case BMI3_GYR_RANGE_125DPS:
+            dps_range = 125;
+            break;
+        case BMI3_GYR_RANGE_250DPS:
+            dps_range = 250;
+            break;
+        case BMI3_GYR_RANGE_500DPS:
+            dps_range = 500;
+            break;
+        case BMI3_GYR_RANGE_1000DPS:
+            dps_range = 1000;
+            break;
+        case BMI3_GYR_RANGE_2000DPS:
+            dps_range = 2000;
+            break;
+        default:
+            return -EINVAL;
+    }
+
+    if (bit_width != SUPPORTED_BIT_WIDTH)
+    {
+        return -EINVAL;
+    }
+
+    compute_scale(&imu_convert_gyr_scale, dps_range, IMU_CONVERT_GYR_Q31_FRAC_BITS, IMU_CONVERT_GYR_Q15_FULL_SCALE);
+
+    return 0;
+}
+
+void imu_convert_f32(const imu_convert_scale_t *scale, const int16_t *raw, float *out, uint32_t n)
+{
+#if defined(CONFIG_CMSIS_DSP)
+    /* raw / 32768 is exact, so both passes together round only once, like the portable loop below. */
+    arm_q15_to_float(raw, out, n);
+    arm_scale_f32(out, scale->f32 * 32768.0f, out, n);
+#else
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        out[i] = (float)raw[i] * scale->f32;
+    }
+#endif
+}
+
+void imu_convert_q31(const imu_convert_scale_t *scale, const int16_t *raw, q31_t *out, uint32_t n)
+{
+#if defined(CONFIG_CMSIS_DSP)
+    arm_q15_to_q31(raw, out, n);
+    arm_scale_q31(out, scale->q31_fract, scale->q31_shift, out, n);
+#else
+    uint32_t i;
+
+    /* same arithmetic as arm_q15_to_q31() followed by arm_scale_q31(), no bits are lost on the way. */
+    for (i = 0; i < n; i++)
+    {
+        out[i] = (q31_t)((((int64_t)raw[i] << 16) * scale->q31_fract) >> (31 - scale->q31_shift));
+    }
+#endif
+}
+
+void imu_convert_q15(const imu_convert_scale_t *scale, const int16_t *raw, q15_t *out, uint32_t n)
+{
+#if defined(CONFIG_CMSIS_DSP)
+    arm_scale_q15(raw, scale->q15_fract, 1, out, n);
+#else
+    uint32_t i;
+
+    /* the scale is never above 1.0, so the result always fits in 16 bits. */
+    for (i = 0; i < n; i++)
+    {
+        out[i] = (q15_t)(((int32_t)raw[i] * scale->q15_fract) >> 14);
+    }
+#endif
+}
+
+/*!
+ * @brief This internal function computes all the scale factors of one sensor.
+ *
+ * @details
+ *      the raw 16-bit value is a Q15 fraction of the range, so:
+ *          - float : value = raw * range / 32768.
+ *          - Q31   : value = raw * range * 2^(frac_bits - 15), the range is normalised into a Q31 mantissa
+ *                    in [0.5, 1) and an exponent, which is the form 'arm_scale_q31()' expects.
+ *          - Q15   : value = raw * (range / full_scale), applied as a Q15 fraction with a shift of 1 so that
+ *                    a ratio of exactly 1.0 (range == full_scale) is representable.
+ *      all the ranges of the BMI323 are integers, so every factor above is exact.
+ */
+static void compute_scale(imu_convert_scale_t *scale, uint32_t range, uint8_t q31_frac_bits, uint32_t q15_full_scale)
+{
+    uint8_t exponent = 0;
+
+    scale->f32 = (float)range / 32768.0f;
+
+    while ((range << exponent) < 0x40000000UL)
+    {
+        exponent++;
+    }
+
+    scale->q31_fract = (q31_t)(range << exponent);
+    scale->q31_shift = (int8_t)((int8_t)q31_frac_bits - (int8_t)exponent);
+
+    scale->q15_fract = (q15_t)((range << 14) / q15_full_scale);
+}
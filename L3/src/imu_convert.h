@@ -0,0 +1,271 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   precomputed IMU unit conversion                                                                             |
+ * |    @file           :   imu_convert.h                                                                                               |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file converts raw BMI323 LSB blocks to g and dps in float, Q31 and Q15                                 |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_CONVERT_H_
+#define IMU_CONVERT_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'q15_t' and 'q31_t' fixed-point types (CMSIS-DSP when enabled)
+ */
+#if defined(CONFIG_CMSIS_DSP)
+#include <arm_math.h>
+#else
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+#endif
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * fractional bits of the Q31 outputs: accel in g as Q5.26 (+/-32 g) and gyro in dps as Q12.19 (+/-4096 dps),
+ * both leave head-room above the largest range of the sensor (16 g and 2000 dps)
+ */
+#define IMU_CONVERT_ACC_Q31_FRAC_BITS   (26U)
+#define IMU_CONVERT_GYR_Q31_FRAC_BITS   (19U)
+
+/**
+ * full scale of the Q15 outputs: a Q15 value of 1.0 means 16 g for accel and 2048 dps for gyro,
+ * the Q15 outputs do not change meaning when the range of the sensor is changed
+ */
+#define IMU_CONVERT_ACC_Q15_FULL_SCALE  (16U)
+#define IMU_CONVERT_GYR_Q15_FULL_SCALE  (2048U)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: imu_convert_scale_t
+ * @brief: scale factors of one sensor, computed once when its range is applied
+ */
+typedef struct {
+    float f32;              /**< LSB to physical unit (g or dps) */
+    q31_t q31_fract;        /**< mantissa of the Q31 scale, in [0.5, 1) */
+    int8_t q31_shift;       /**< exponent of the Q31 scale */
+    q15_t q15_fract;        /**< Q15 scale towards the fixed Q15 full scale, applied with a shift of 1 */
+} imu_convert_scale_t;
+
+/******************************************************************************
+ * Variables
+ *******************************************************************************/
+
+/**
+ * current accel and gyro scales, only written by imu_convert_set_accel_range() / imu_convert_set_gyro_range()
+ */
+extern imu_convert_scale_t imu_convert_acc_scale;
+extern imu_convert_scale_t imu_convert_gyr_scale;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int imu_convert_set_accel_range(uint8_t range, uint8_t bit_width);
+ *  \b Description                              :       compute the accel scale factors for the given range, this is the only place where
+ *                                                      the (slow) scale computation happens.
+ *  @param  range [IN]                          :       one of BMI3_ACC_RANGE_2G, BMI3_ACC_RANGE_4G, BMI3_ACC_RANGE_8G or BMI3_ACC_RANGE_16G.
+ *  @param  bit_width [IN]                      :       resolution of the accel data, only 16 is supported.
+ *  @note                                       :       to be called every time a new accel range is written to the sensor.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       the accel conversion functions use the new range.
+ *  @return                                     :       0 on success, -EINVAL for an unknown range or bit width.
+ *  @see                                        :       int imu_convert_set_gyro_range(uint8_t range, uint8_t bit_width);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_convert_set_accel_range(uint8_t range, uint8_t bit_width);
+
+
+/**
+ *  \b function                                 :       int imu_convert_set_gyro_range(uint8_t range, uint8_t bit_width);
+ *  \b Description                              :       compute the gyro scale factors for the given range.
+ *  @param  range [IN]                          :       one of BMI3_GYR_RANGE_125DPS, 250DPS, 500DPS, 1000DPS or 2000DPS.
+ *  @param  bit_width [IN]                      :       resolution of the gyro data, only 16 is supported.
+ *  @note                                       :       to be called every time a new gyro range is written to the sensor.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       the gyro conversion functions use the new range.
+ *  @return                                     :       0 on success, -EINVAL for an unknown range or bit width.
+ *  @see                                        :       int imu_convert_set_accel_range(uint8_t range, uint8_t bit_width);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_convert_set_gyro_range(uint8_t range, uint8_t bit_width);
+
+
+/**
+ *  \b function                                 :       void imu_convert_f32(const imu_convert_scale_t *scale, const int16_t *raw, float *out, uint32_t n);
+ *  \b Description                              :       convert a block of raw values to g or dps in single precision.
+ *  @param  scale [IN]                          :       &imu_convert_acc_scale or &imu_convert_gyr_scale.
+ *  @param  raw [IN]                            :       raw LSB values, the axes may be interleaved (x, y, z, x, y, z, ...).
+ *  @param  out [OUT]                           :       converted values, same layout as 'raw'.
+ *  @param  n [IN]                              :       number of values (not samples) in 'raw'.
+ *  @note                                       :       uses arm_q15_to_float() + arm_scale_f32() when CMSIS-DSP is enabled.
+ *  \b PRE-CONDITION                            :       the range of the sensor was applied.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_convert_f32(const imu_convert_scale_t *scale, const int16_t *raw, float *out, uint32_t n);
+
+
+/**
+ *  \b function                                 :       void imu_convert_q31(const imu_convert_scale_t *scale, const int16_t *raw, q31_t *out, uint32_t n);
+ *  \b Description                              :       convert a block of raw values to g (Q5.26) or dps (Q12.19).
+ *  @param  scale [IN]                          :       &imu_convert_acc_scale or &imu_convert_gyr_scale.
+ *  @param  raw [IN]                            :       raw LSB values, the axes may be interleaved.
+ *  @param  out [OUT]                           :       converted values, refer to @IMU_CONVERT_ACC_Q31_FRAC_BITS and @IMU_CONVERT_GYR_Q31_FRAC_BITS.
+ *  @param  n [IN]                              :       number of values in 'raw'.
+ *  @note                                       :       the conversion is exact (no rounding) for every supported range.
+ *  \b PRE-CONDITION                            :       the range of the sensor was applied.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_convert_q31(const imu_convert_scale_t *scale, const int16_t *raw, q31_t *out, uint32_t n);
+
+
+/**
+ *  \b function                                 :       void imu_convert_q15(const imu_convert_scale_t *scale, const int16_t *raw, q15_t *out, uint32_t n);
+ *  \b Description                              :       convert a block of raw values to a fraction of the fixed Q15 full scale.
+ *  @param  scale [IN]                          :       &imu_convert_acc_scale or &imu_convert_gyr_scale.
+ *  @param  raw [IN]                            :       raw LSB values, the axes may be interleaved.
+ *  @param  out [OUT]                           :       converted values, refer to @IMU_CONVERT_ACC_Q15_FULL_SCALE and @IMU_CONVERT_GYR_Q15_FULL_SCALE.
+ *  @param  n [IN]                              :       number of values in 'raw'.
+ *  @note                                       :       uses the SIMD arm_scale_q15() when CMSIS-DSP is enabled.
+ *  \b PRE-CONDITION                            :       the range of the sensor was applied.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_convert_q15(const imu_convert_scale_t *scale, const int16_t *raw, q15_t *out, uint32_t n);
+
+
+/**
+ *  \b function                                 :       float imu_convert_acc_g(int16_t val);
+ *  \b Description                              :       convert a single raw accel value to g (replaces the old 'lsb_to_g()').
+ *  @param  val [IN]                            :       LSB from one axis.
+ *  @return                                     :       accel value in g.
+ */
+static inline float imu_convert_acc_g(int16_t val)
+{
+    return (float)val * imu_convert_acc_scale.f32;
+}
+
+
+/**
+ *  \b function                                 :       float imu_convert_gyr_dps(int16_t val);
+ *  \b Description                              :       convert a single raw gyro value to dps (replaces the old 'lsb_to_dps()').
+ *  @param  val [IN]                            :       LSB from one axis.
+ *  @return                                     :       gyro value in degree per second.
+ */
+static inline float imu_convert_gyr_dps(int16_t val)
+{
+    return (float)val * imu_convert_gyr_scale.f32;
+}
+
+
+#if defined(CONFIG_L3_CONVERT_BENCH)
+/**
+ *  \b function                                 :       void imu_convert_bench_run(void);
+ *  \b Description                              :       measure the cycles per converted value of the old pow() based 'lsb_to_g()' and
+ *                                                      'lsb_to_dps()' against the float, Q31 and Q15 block paths and print the result.
+ *  @note                                       :       blocks for a few milliseconds, to be called once at startup.
+ *  \b PRE-CONDITION                            :       the ranges of both sensors were applied.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_convert_bench_run(void);
+#endif
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_CONVERT_H_*/
@@ -0,0 +1,202 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+// include the printk function file header
+#include <zephyr/sys/printk.h>
+
+// include the cycle accurate timing functions (DWT CYCCNT on the nRF52832)
+#include <zephyr/timing/timing.h>
+
+// include the math library, only needed by the reference functions
+#include <math.h>
+
+#include "imu_convert.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                 |   Documentation Link
+ * =========================|=====================
+ * timing_counter_get()     |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * timing_cycles_get()      |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Number of raw values converted by every path (a block of 32 samples x 3 axes). */
+#define BENCH_VALUES        (96U)
+
+/*! Every path is repeated to average out the interrupt noise. */
+#define BENCH_ROUNDS        (32U)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+static int16_t bench_raw[BENCH_VALUES];
+static float bench_f32[BENCH_VALUES];
+static q31_t bench_q31[BENCH_VALUES];
+static q15_t bench_q15[BENCH_VALUES];
+
+/*! Resolution handed to the reference, volatile like the run time 'dev->resolution' of the original loop: a literal 16 lets the compiler fold pow() away. */
+static volatile uint8_t bench_bit_width = 16;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief The original conversion of L3, kept here as the reference of the benchmark.
+ *
+ *  @param[in] val       : LSB from each axis.
+ *  @param[in] g_range   : Gravity range.
+ *  @param[in] bit_width : Resolution for accel.
+ *
+ *  @return Accel values in g.
+ */
+static float lsb_to_g(int16_t val, int8_t g_range, uint8_t bit_width);
+
+/*!
+ *  @brief The original conversion of L3, kept here as the reference of the benchmark.
+ *
+ *  @param[in] val       : LSB from each axis.
+ *  @param[in] dps       : Degree per second.
+ *  @param[in] bit_width : Resolution for gyro.
+ *
+ *  @return Degree per second.
+ */
+static float lsb_to_dps(int16_t val, float dps, uint8_t bit_width);
+
+/*!
+ *  @brief This internal function prints the cycles per value of one path.
+ */
+static void print_result(const char *name, uint64_t cycles, uint64_t reference);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+void imu_convert_bench_run(void)
+{
+    timing_t start, end;
+    uint64_t legacy, block_f32, block_q31, block_q15;
+    uint32_t round, i;
+
+    /* Spread the test values over the whole 16-bit range. */
+    for (i = 0; i < BENCH_VALUES; i++)
+    {
+        bench_raw[i] = (int16_t)((i * 683U) - 32768U);
+    }
+
+    timing_init();
+    timing_start();
+
+    /* Reference: one pow() per value, like the original sample loop. */
+    start = timing_counter_get();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (i = 0; i < BENCH_VALUES; i += 2)
+        {
+            bench_f32[i] = lsb_to_g(bench_raw[i], 4, bench_bit_width);
+            bench_f32[i + 1] = lsb_to_dps(bench_raw[i + 1], (float)500, bench_bit_width);
+        }
+    }
+    end = timing_counter_get();
+    legacy = timing_cycles_get(&start, &end);
+
+    start = timing_counter_get();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        imu_convert_f32(&imu_convert_acc_scale, bench_raw, bench_f32, BENCH_VALUES / 2);
+        imu_convert_f32(&imu_convert_gyr_scale, &bench_raw[BENCH_VALUES / 2], &bench_f32[BENCH_VALUES / 2], BENCH_VALUES / 2);
+    }
+    end = timing_counter_get();
+    block_f32 = timing_cycles_get(&start, &end);
+
+    start = timing_counter_get();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        imu_convert_q31(&imu_convert_acc_scale, bench_raw, bench_q31, BENCH_VALUES / 2);
+        imu_convert_q31(&imu_convert_gyr_scale, &bench_raw[BENCH_VALUES / 2], &bench_q31[BENCH_VALUES / 2], BENCH_VALUES / 2);
+    }
+    end = timing_counter_get();
+    block_q31 = timing_cycles_get(&start, &end);
+
+    start = timing_counter_get();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        imu_convert_q15(&imu_convert_acc_scale, bench_raw, bench_q15, BENCH_VALUES / 2);
+        imu_convert_q15(&imu_convert_gyr_scale, &bench_raw[BENCH_VALUES / 2], &bench_q15[BENCH_VALUES / 2], BENCH_VALUES / 2);
+    }
+    end = timing_counter_get();
+    block_q15 = timing_cycles_get(&start, &end);
+
+    timing_stop();
+
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("conversion benchmark, %u values x %u rounds, cycles per value (x100)\n\r", BENCH_VALUES, BENCH_ROUNDS);
+    printk("----------------------------------------------------------------------------------\n\r");
+    print_result("lsb_to_g/dps (pow)", legacy, legacy);
+    print_result("block f32", block_f32, legacy);
+    print_result("block q31", block_q31, legacy);
+    print_result("block q15", block_q15, legacy);
+}
+
+/*!
+ * @brief This internal function prints the cycles per value of one path and its speed-up against the reference.
+ */
+static void print_result(const char *name, uint64_t cycles, uint64_t reference)
+{
+    uint32_t per_value_x100 = (uint32_t)((cycles * 100U) / (BENCH_VALUES * BENCH_ROUNDS));
+    uint32_t speedup_x10 = (cycles == 0) ? 0 : (uint32_t)((reference * 10U) / cycles);
+
+    printk("%-20s: %u.%02u cycles/value, x%u.%u\n\r",
+           name,
+           per_value_x100 / 100U, per_value_x100 % 100U,
+           speedup_x10 / 10U, speedup_x10 % 10U);
+}
+
+/*!
+ * @brief This function converts lsb to meter per second squared for 16 bit accelerometer at
+ * range 2G, 4G, 8G or 16G.
+ *
+ * @details:
+ *      this function works as follows -:
+ *          'val' is the returned number from the accelerometer which is by default a 16-bit value
+ *                 ranging between -32768 and 32767 all-inclusive.
+ *          we will first normalize this number to be in the range of '-1 to 1'. we will need to just divide 'val' by
+ *              its maximum value which is stored in the variable 'half_scale' according to the bitwidth of 'val'
+ *          then depending on the sensor range whether it's '±2G', '±4G', '±8G' or '±16G'. We will map the values '-1 to 1' to
+ *              the range of 'g_range' by simple multiplication. if
+ */
+static float lsb_to_g(int16_t val, int8_t g_range, uint8_t bit_width)
+{
+    double power = 2;
+
+    float half_scale = (float)((pow((double)power, (double)bit_width) / 2.0f));
+
+    return (val * g_range) / half_scale;
+}
+
+/*!
+ * @brief This function converts lsb to degree per second for 16 bit gyro at
+ * range 125, 250, 500, 1000 or 2000dps.
+ *
+ * @details
+ *      this function works as follows -:
+ *          'val' is the returned number from the gyroscope which is by default a 16-bit value
+ *                 ranging between -32768 and 32767 all-inclusive.
+ *          we will first normalize this number to be in the range of '-1 to 1'. we will need to just divide 'val' by
+ *              its maximum value which is stored in the variable 'half_scale' according to the bitwidth of 'val'
+ *          then depending on the sensor range whether it's '±125dps', '±250dps', '±500dps', '±1000dps' or '±2000'. We will map the values '-1 to 1' to
+ *              the range of 'dps' by simple multiplication.
+ */
+static float lsb_to_dps(int16_t val, float dps, uint8_t bit_width)
+{
+    double power = 2;
+
+    float half_scale = (float)((pow((double)power, (double)bit_width) / 2.0f));
+
+    return (dps / (half_scale)) * (val);
+}
@@ -0,0 +1,288 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+// include the math library, only used to design the filter at initialisation
+#include <math.h>
+
+// include the CMSIS-DSP filtering functions
+#include <arm_math.h>
+
+#include "imu_filter.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * arm_fir_decimate_q15()           |   https://arm-software.github.io/CMSIS-DSP/latest/group__FIR__decimate.html
+ * arm_biquad_cascade_df1_q15()     |   https://arm-software.github.io/CMSIS-DSP/latest/group__BiquadCascadeDF1.html
+ * arm_float_to_q15()               |   https://arm-software.github.io/CMSIS-DSP/latest/group__float__to__x.html
+ * biquad low-pass coefficients     |   https://www.w3.org/TR/audio-eq-cookbook/
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! The six axes of a sample: accel x/y/z and gyro x/y/z. */
+#define FILTER_AXES             (6U)
+
+/*! Raw samples per block and filtered samples per block. */
+#define BLOCK_IN                (CONFIG_L3_FILTER_BLOCK)
+#define BLOCK_OUT               (CONFIG_L3_FILTER_BLOCK / CONFIG_L3_FILTER_DECIMATION)
+
+BUILD_ASSERT((CONFIG_L3_FILTER_BLOCK % CONFIG_L3_FILTER_DECIMATION) == 0,
+             "the block of the filter has to be a multiple of its decimation");
+
+/*! Cut-off of the low-pass in cycles per input sample: a share of the Nyquist frequency of the output. */
+#define CUTOFF                  (((float)CONFIG_L3_FILTER_CUTOFF_PERMILLE / 1000.0f) * 0.5f / (float)CONFIG_L3_FILTER_DECIMATION)
+
+#if defined(CONFIG_L3_FILTER_BIQUAD)
+/*! Coefficients per biquad stage in the CMSIS-DSP layout {b0, 0, b1, b2, a1, a2}, and state words per stage. */
+#define BIQUAD_COEFFS           (6U)
+#define BIQUAD_STATE            (4U)
+
+/*! The feedback coefficients of a low-pass reach almost 2.0, all the coefficients are stored halved (post-shift 1). */
+#define BIQUAD_POST_SHIFT       (1)
+#endif
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! Offset of every axis in 'imu_sample_t'. */
+static const size_t axis_offset[FILTER_AXES] = {
+    offsetof(imu_sample_t, acc_x), offsetof(imu_sample_t, acc_y), offsetof(imu_sample_t, acc_z),
+    offsetof(imu_sample_t, gyr_x), offsetof(imu_sample_t, gyr_y), offsetof(imu_sample_t, gyr_z),
+};
+
+/*! Raw samples collected until a block is complete, and the filtered block. */
+static imu_sample_t block_in[BLOCK_IN];
+static imu_sample_t block_out[BLOCK_OUT];
+static uint16_t block_fill;
+
+/*! One axis of the block before and after the filter. */
+static q15_t axis_in[BLOCK_IN];
+static q15_t axis_out[BLOCK_IN];
+
+#if defined(CONFIG_L3_FILTER_FIR)
+/*! Windowed-sinc low-pass, shared by the axes, and the delay line of every axis. */
+static q15_t fir_coeffs[CONFIG_L3_FILTER_FIR_TAPS];
+static q15_t fir_state[FILTER_AXES][CONFIG_L3_FILTER_FIR_TAPS + BLOCK_IN - 1U];
+static arm_fir_decimate_instance_q15 fir[FILTER_AXES];
+#else
+/*! Butterworth cascade, shared by the axes, and the state of every axis. */
+static q15_t biquad_coeffs[CONFIG_L3_FILTER_BIQUAD_STAGES * BIQUAD_COEFFS];
+static q15_t biquad_state[FILTER_AXES][CONFIG_L3_FILTER_BIQUAD_STAGES * BIQUAD_STATE];
+static arm_biquad_casd_df1_inst_q15 biquad[FILTER_AXES];
+#endif
+
+/*! Receives the filtered blocks. */
+static imu_proc_handler_t filter_output;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+#if defined(CONFIG_L3_FILTER_FIR)
+/*!
+ *  @brief This internal function designs the FIR low-pass (Hamming windowed sinc, unity gain at DC).
+ */
+static void design_fir(void);
+#else
+/*!
+ *  @brief This internal function designs the biquad cascade (Butterworth low-pass, one pole pair per stage).
+ */
+static void design_biquad(void);
+#endif
+
+/*!
+ *  @brief This internal function filters and decimates one complete block of 'block_in' into 'block_out'.
+ */
+static void filter_block(void);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int imu_filter_init(imu_proc_handler_t output)
+{
+    uint8_t axis;
+
+    if (output == NULL)
+    {
+        return -EINVAL;
+    }
+
+#if defined(CONFIG_L3_FILTER_FIR)
+    design_fir();
+
+    for (axis = 0; axis < FILTER_AXES; axis++)
+    {
+        if (arm_fir_decimate_init_q15(&fir[axis], CONFIG_L3_FILTER_FIR_TAPS, CONFIG_L3_FILTER_DECIMATION,
+                                      fir_coeffs, fir_state[axis], BLOCK_IN) != ARM_MATH_SUCCESS)
+        {
+            return -EINVAL;
+        }
+    }
+#else
+    design_biquad();
+
+    for (axis = 0; axis < FILTER_AXES; axis++)
+    {
+        arm_biquad_cascade_df1_init_q15(&biquad[axis], CONFIG_L3_FILTER_BIQUAD_STAGES,
+                                        biquad_coeffs, biquad_state[axis], BIQUAD_POST_SHIFT);
+    }
+#endif
+
+    block_fill = 0;
+    filter_output = output;
+
+    return 0;
+}
+
+void imu_filter_update(const imu_sample_t *samples, uint16_t count)
+{
+    uint16_t n;
+
+    while (count > 0)
+    {
+        n = MIN(count, (uint16_t)(BLOCK_IN - block_fill));
+
+        memcpy(&block_in[block_fill], samples, n * sizeof(imu_sample_t));
+        block_fill += n;
+        samples += n;
+        count -= n;
+
+        if (block_fill == BLOCK_IN)
+        {
+            filter_block();
+            block_fill = 0;
+
+            filter_output(block_out, BLOCK_OUT);
+        }
+    }
+}
+
+/*!
+ * @brief This internal function filters and decimates one block.
+ *
+ * @details
+ *      the axes are gathered one at a time into a contiguous Q15 buffer (the raw values already are Q15
+ *      fractions of the range) so that every CMSIS-DSP call runs over the whole block. output sample k
+ *      was computed from the input samples up to k * M + M - 1, it keeps that sample's timestamps.
+ */
+static void filter_block(void)
+{
+    uint8_t axis;
+    uint16_t i;
+
+    for (axis = 0; axis < FILTER_AXES; axis++)
+    {
+        for (i = 0; i < BLOCK_IN; i++)
+        {
+            axis_in[i] = *(const int16_t *)((const uint8_t *)&block_in[i] + axis_offset[axis]);
+        }
+
+#if defined(CONFIG_L3_FILTER_FIR)
+        /* Only every M-th output is computed, the decimator writes BLOCK_OUT values. */
+        arm_fir_decimate_q15(&fir[axis], axis_in, axis_out, BLOCK_IN);
+
+        for (i = 0; i < BLOCK_OUT; i++)
+        {
+            *(int16_t *)((uint8_t *)&block_out[i] + axis_offset[axis]) = axis_out[i];
+        }
+#else
+        /* The recursive filter has to run at the full rate, the decimation only keeps every M-th output. */
+        arm_biquad_cascade_df1_q15(&biquad[axis], axis_in, axis_out, BLOCK_IN);
+
+        for (i = 0; i < BLOCK_OUT; i++)
+        {
+            *(int16_t *)((uint8_t *)&block_out[i] + axis_offset[axis]) =
+                axis_out[(i * CONFIG_L3_FILTER_DECIMATION) + CONFIG_L3_FILTER_DECIMATION - 1U];
+        }
+#endif
+    }
+
+    for (i = 0; i < BLOCK_OUT; i++)
+    {
+        block_out[i].sensor_time = block_in[(i * CONFIG_L3_FILTER_DECIMATION) + CONFIG_L3_FILTER_DECIMATION - 1U].sensor_time;
+        block_out[i].read_cycles = block_in[(i * CONFIG_L3_FILTER_DECIMATION) + CONFIG_L3_FILTER_DECIMATION - 1U].read_cycles;
+    }
+}
+
+#if defined(CONFIG_L3_FILTER_FIR)
+/*!
+ * @brief This internal function designs the FIR low-pass.
+ *
+ * @details
+ *      h[n] = 2 fc sinc(2 fc (n - (N - 1) / 2)) * hamming(n), normalised to a sum of 1 so that the
+ *      gravity and the gyro bias pass unchanged. the coefficients are computed in float, the largest one
+ *      is far below 1.0 and fits the Q15 format.
+ */
+static void design_fir(void)
+{
+    static float taps[CONFIG_L3_FILTER_FIR_TAPS];
+    const float centre = (float)(CONFIG_L3_FILTER_FIR_TAPS - 1U) / 2.0f;
+    float sum = 0.0f;
+    float x;
+    uint16_t n;
+
+    for (n = 0; n < CONFIG_L3_FILTER_FIR_TAPS; n++)
+    {
+        x = (float)n - centre;
+
+        taps[n] = (x == 0.0f) ? (2.0f * CUTOFF) : (sinf(2.0f * PI * CUTOFF * x) / (PI * x));
+        taps[n] *= 0.54f - (0.46f * cosf((2.0f * PI * (float)n) / (float)(CONFIG_L3_FILTER_FIR_TAPS - 1U)));
+
+        sum += taps[n];
+    }
+
+    for (n = 0; n < CONFIG_L3_FILTER_FIR_TAPS; n++)
+    {
+        taps[n] /= sum;
+    }
+
+    arm_float_to_q15(taps, fir_coeffs, CONFIG_L3_FILTER_FIR_TAPS);
+}
+#else
+/*!
+ * @brief This internal function designs the biquad cascade.
+ *
+ * @details
+ *      the low-pass of the audio EQ cookbook, one stage per pole pair of a Butterworth filter of order
+ *      2 * stages (Q of stage k = 1 / (2 cos(pi (2k + 1) / (4 * stages)))). CMSIS-DSP adds the feedback
+ *      terms, so a1 and a2 are stored negated, and every coefficient is halved for the post-shift of 1.
+ */
+static void design_biquad(void)
+{
+    const float w0 = 2.0f * PI * CUTOFF;
+    const float cos_w0 = cosf(w0);
+    float coeffs[BIQUAD_COEFFS];
+    float alpha, q, a0;
+    uint8_t stage;
+
+    for (stage = 0; stage < CONFIG_L3_FILTER_BIQUAD_STAGES; stage++)
+    {
+        q = 1.0f / (2.0f * cosf((PI * (float)((2U * stage) + 1U)) / (4.0f * (float)CONFIG_L3_FILTER_BIQUAD_STAGES)));
+        alpha = sinf(w0) / (2.0f * q);
+        a0 = 1.0f + alpha;
+
+        coeffs[0] = ((1.0f - cos_w0) / 2.0f) / a0;
+        coeffs[1] = 0.0f;
+        coeffs[2] = (1.0f - cos_w0) / a0;
+        coeffs[3] = coeffs[0];
+        coeffs[4] = (2.0f * cos_w0) / a0;
+        coeffs[5] = -(1.0f - alpha) / a0;
+
+        for (uint8_t i = 0; i < BIQUAD_COEFFS; i++)
+        {
+            coeffs[i] /= (float)(1 << BIQUAD_POST_SHIFT);
+        }
+
+        arm_float_to_q15(coeffs, &biquad_coeffs[stage * BIQUAD_COEFFS], BIQUAD_COEFFS);
+    }
+}
+#endif
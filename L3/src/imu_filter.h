@@ -0,0 +1,115 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   IMU low-pass filter and decimation                                                                          |
+ * |    @file           :   imu_filter.h                                                                                                |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides a block based CMSIS-DSP low-pass filter that reduces the rate of the samples             |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_FILTER_H_
+#define IMU_FILTER_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type and the 'imu_proc_handler_t' type the filtered blocks are handed to
+ */
+#include "imu_proc.h"
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int imu_filter_init(imu_proc_handler_t output);
+ *  \b Description                              :       design the low-pass filter of the configured type (FIR decimator or biquad cascade, refer
+ *                                                      to 'CONFIG_L3_FILTER_*') and set up one CMSIS-DSP instance per axis.
+ *  @param  output [IN]                         :       receives every filtered block of CONFIG_L3_FILTER_BLOCK / CONFIG_L3_FILTER_DECIMATION
+ *                                                      samples, at the decimated rate.
+ *  @note                                       :       the coefficients are computed in float once, only the Q15 filters run per sample.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       imu_filter_update() can be given samples.
+ *  @return                                     :       0 on success, -EINVAL if 'output' is NULL or CMSIS-DSP rejects the configuration.
+ *  @see                                        :       void imu_filter_update(const imu_sample_t *samples, uint16_t count);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_filter_init(imu_proc_handler_t output);
+
+
+/**
+ *  \b function                                 :       void imu_filter_update(const imu_sample_t *samples, uint16_t count);
+ *  \b Description                              :       collect raw samples until a block of CONFIG_L3_FILTER_BLOCK is complete, then filter and
+ *                                                      decimate the six axes of the block and hand the result to the output.
+ *  @param  samples [IN]                        :       raw samples, oldest first.
+ *  @param  count [IN]                          :       number of samples, any number (the block boundaries do not have to match).
+ *  @note                                       :       has the signature of 'imu_proc_handler_t', it can be started as the handler of the
+ *                                                      processing thread. every output sample keeps the sensor time and the readout time of
+ *                                                      the last input sample it was computed from, the group delay of the filter is not
+ *                                                      taken out.
+ *  \b PRE-CONDITION                            :       imu_filter_init() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_filter_update(const imu_sample_t *samples, uint16_t count);
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_FILTER_H_*/
@@ -0,0 +1,496 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include <errno.h>
+#include <string.h>
+
+// include printk() for the dump
+#include <zephyr/sys/printk.h>
+
+// include the little-endian helpers of the block header
+#include <zephyr/sys/byteorder.h>
+
+// include the flash partitions and the flash circular buffer on top of them
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/fs/fcb.h>
+
+// include the delta codec the samples are stored with
+#include "imu_codec.h"
+
+#include "imu_log.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * fcb_init() / fcb_append()        |   https://docs.zephyrproject.org/latest/services/storage/fcb/fcb.html
+ * fcb_rotate() / fcb_walk()        |   https://docs.zephyrproject.org/latest/services/storage/fcb/fcb.html
+ * flash_area_get_sectors()         |   https://docs.zephyrproject.org/latest/services/storage/flash_map/flash_map.html
+ * k_mem_slab_alloc()               |   https://docs.zephyrproject.org/latest/kernel/memory_management/slabs.html
+ * k_msgq_put() / k_msgq_get()      |   https://docs.zephyrproject.org/latest/kernel/services/data_passing/message_queues.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Partition of the log, chosen as 'l3,imu-log' (refer to 'flashlog.overlay'). */
+#define LOG_PARTITION_ID        DT_FIXED_PARTITION_ID(DT_CHOSEN(l3_imu_log))
+
+/*! Identifies the sectors of this log, a sector with another magic is not part of it. */
+#define LOG_FCB_MAGIC           (0x4D493345UL)
+#define LOG_FCB_VERSION         (1U)
+
+/*! Offsets of the block header fields. */
+#define HDR_VERSION             (0U)
+#define HDR_SESSION             (1U)
+#define HDR_SAMPLES             (3U)
+#define HDR_DROPPED             (5U)
+
+/*! Largest write block of the flash the padding of a block supports (4 bytes on the nRF52832). */
+#define MAX_WRITE_BLOCK         (32U)
+
+/*! Bytes of a block printed per printk() of the dump. */
+#define DUMP_CHUNK              (32U)
+
+BUILD_ASSERT(CONFIG_L3_LOG_BLOCK_SIZE >= (IMU_LOG_BLOCK_HEADER_SIZE + IMU_CODEC_MAX_SAMPLE_SIZE),
+             "a block has to hold at least one sample");
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*!
+ * @brief One block on its way from the acquisition to the flash.
+ */
+struct log_block {
+    uint16_t len;
+    uint8_t data[CONFIG_L3_LOG_BLOCK_SIZE];
+} __aligned(4);
+
+/*! Block buffers, and the full ones waiting for the writer. */
+K_MEM_SLAB_DEFINE_STATIC(block_slab, sizeof(struct log_block), CONFIG_L3_LOG_QUEUE_BLOCKS, 4);
+K_MSGQ_DEFINE(block_msgq, sizeof(struct log_block *), CONFIG_L3_LOG_QUEUE_BLOCKS, 4);
+
+K_THREAD_STACK_DEFINE(log_stack, CONFIG_L3_LOG_THREAD_STACK_SIZE);
+static struct k_thread log_thread;
+static bool log_started;
+
+/*! The FCB and the sectors of its partition. */
+static struct fcb log_fcb;
+static struct flash_sector log_sectors[CONFIG_L3_LOG_MAX_SECTORS];
+
+/*! Block being filled by the acquisition, its codec and the samples dropped since the last block. */
+static struct log_block *fill_block;
+static uint16_t fill_count;
+static uint16_t pending_dropped;
+static imu_codec_t log_codec;
+
+/*! Counters, shared between the acquisition, the writer and imu_log_get_stats(). */
+static imu_log_stats_t log_stats;
+static struct k_spinlock log_lock;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function reads the sectors of the partition and initialises the FCB on them.
+ */
+static int open_fcb(void);
+
+/*!
+ *  @brief This internal function queues the filled block for the writer.
+ */
+static void queue_block(void);
+
+/*!
+ *  @brief fcb_walk() callback finding the last session in the log.
+ */
+static int find_session(struct fcb_entry_ctx *ctx, void *arg);
+
+/*!
+ *  @brief fcb_walk() callback printing one block as a hex line.
+ */
+static int dump_block(struct fcb_entry_ctx *ctx, void *arg);
+
+/*!
+ *  @brief Entry of the writer thread, it writes the queued blocks to flash.
+ */
+static void log_thread_entry(void *p1, void *p2, void *p3);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int imu_log_init(void)
+{
+    uint16_t last_session = 0;
+    int err;
+
+    err = open_fcb();
+
+    if (err == -ENOMSG)
+    {
+        /* Not a log (an old image in the slot, or a log of another format): start with an empty one. */
+        printk("imu_log: the partition holds no log, erasing it\n\r");
+
+        err = flash_area_erase(log_fcb.fap, 0, log_fcb.fap->fa_size);
+
+        if (err == 0)
+        {
+            err = open_fcb();
+        }
+    }
+
+    if (err != 0)
+    {
+        return err;
+    }
+
+    err = fcb_walk(&log_fcb, NULL, find_session, &last_session);
+
+    if (err != 0)
+    {
+        return err;
+    }
+
+    memset(&log_stats, 0, sizeof(log_stats));
+    log_stats.session = (uint16_t)(last_session + 1U);
+
+    return 0;
+}
+
+int imu_log_start(void)
+{
+    if (log_started)
+    {
+        return -EALREADY;
+    }
+
+    log_started = true;
+
+    k_thread_create(&log_thread, log_stack, K_THREAD_STACK_SIZEOF(log_stack),
+                    log_thread_entry, NULL, NULL, NULL,
+                    CONFIG_L3_LOG_THREAD_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&log_thread, "imu_log");
+
+    return 0;
+}
+
+void imu_log_put(const imu_sample_t *samples, uint16_t count)
+{
+    k_spinlock_key_t key;
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (fill_block == NULL)
+        {
+            /* No buffer free: the writer is behind, the samples are counted and dropped. */
+            if (k_mem_slab_alloc(&block_slab, (void **)&fill_block, K_NO_WAIT) != 0)
+            {
+                fill_block = NULL;
+                pending_dropped = (uint16_t)MIN((uint32_t)pending_dropped + (count - i), UINT16_MAX);
+
+                key = k_spin_lock(&log_lock);
+                log_stats.dropped += count - i;
+                k_spin_unlock(&log_lock, key);
+                return;
+            }
+
+            fill_block->len = IMU_LOG_BLOCK_HEADER_SIZE;
+            fill_count = 0;
+            imu_codec_reset(&log_codec);
+        }
+
+        fill_block->len += imu_codec_encode(&log_codec, &samples[i], &fill_block->data[fill_block->len]);
+        fill_count++;
+
+        /* Sent as soon as the next sample might not fit, a block never has to be cut. */
+        if ((fill_block->len + IMU_CODEC_MAX_SAMPLE_SIZE) > CONFIG_L3_LOG_BLOCK_SIZE)
+        {
+            queue_block();
+        }
+    }
+}
+
+/*!
+ * @brief append one block to the FCB.
+ *
+ * @details
+ *      the blocks are aligned to the write block of the flash, not to its pages. FCB puts the length and
+ *      the data of every entry at offsets that are multiples of flash_area_align(), and the end of the
+ *      block is padded here, so every flash_area_write() starts and ends on a write block. the NVMC of
+ *      the nRF52832 programs one 32-bit word at a time, it has no page buffer and a write costs the same
+ *      wherever it falls in a 4 KiB page. only the erase works on whole pages, and it runs ahead of the
+ *      writes. padding every block to a page would waste most of the partition and buy nothing.
+ */
+int imu_log_write(const uint8_t *block, size_t len)
+{
+    struct fcb_entry loc;
+    k_spinlock_key_t key;
+    uint8_t tail[MAX_WRITE_BLOCK];
+    uint32_t align = flash_area_align(log_fcb.fap);
+    size_t body = ROUND_DOWN(len, align);
+    size_t padded = ROUND_UP(len, align);
+    uint32_t erases = 0;
+    int err;
+
+    if ((len == 0) || (len > CONFIG_L3_LOG_BLOCK_SIZE) || (align > sizeof(tail)))
+    {
+        return -EINVAL;
+    }
+
+    err = fcb_append(&log_fcb, (uint16_t)padded, &loc);
+
+    if (err == -ENOSPC)
+    {
+        /* Only without a spare sector (the writes went faster than the erases), the write waits for the erase. */
+        err = fcb_rotate(&log_fcb);
+        erases++;
+
+        if (err == 0)
+        {
+            err = fcb_append(&log_fcb, (uint16_t)padded, &loc);
+        }
+    }
+
+    /* The flash only takes whole write blocks, the end of the block is padded (the sample count ends it). */
+    if ((err == 0) && (body > 0))
+    {
+        err = flash_area_write(log_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), block, body);
+    }
+
+    if ((err == 0) && (padded > body))
+    {
+        memset(tail, 0xFF, sizeof(tail));
+        memcpy(tail, &block[body], len - body);
+
+        err = flash_area_write(log_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc) + body, tail, padded - body);
+    }
+
+    if (err == 0)
+    {
+        err = fcb_append_finish(&log_fcb, &loc);
+    }
+
+    /* Erase ahead: the next writes find an erased sector and never wait for an erase. */
+    while ((err == 0) && (fcb_free_sector_cnt(&log_fcb) < CONFIG_L3_LOG_SPARE_SECTORS))
+    {
+        err = fcb_rotate(&log_fcb);
+        erases++;
+    }
+
+    key = k_spin_lock(&log_lock);
+
+    log_stats.erases += erases;
+
+    if (err == 0)
+    {
+        log_stats.blocks++;
+        log_stats.bytes += len;
+    }
+    else
+    {
+        log_stats.errors++;
+    }
+
+    k_spin_unlock(&log_lock, key);
+
+    return err;
+}
+
+int imu_log_dump(void)
+{
+    int blocks = 0;
+    int err;
+
+    printk("imu_log: dump begin\n\r");
+
+    err = fcb_walk(&log_fcb, NULL, dump_block, &blocks);
+
+    printk("imu_log: dump end, %d blocks\n\r", blocks);
+
+    return (err != 0) ? err : blocks;
+}
+
+int imu_log_clear(void)
+{
+    int err = fcb_clear(&log_fcb);
+
+    if (err == 0)
+    {
+        log_stats.session = 1;
+    }
+
+    return err;
+}
+
+void imu_log_get_stats(imu_log_stats_t *stats)
+{
+    k_spinlock_key_t key = k_spin_lock(&log_lock);
+
+    *stats = log_stats;
+
+    k_spin_unlock(&log_lock, key);
+}
+
+/*!
+ * @brief This internal function initialises the FCB.
+ *
+ * @details
+ *      every sector of the partition belongs to the log, none is kept as scratch: the log only appends
+ *      and rotates, it never moves entries between sectors.
+ */
+static int open_fcb(void)
+{
+    uint32_t sector_cnt = ARRAY_SIZE(log_sectors);
+    int err;
+
+    err = flash_area_get_sectors(LOG_PARTITION_ID, &sector_cnt, log_sectors);
+
+    if (err != 0)
+    {
+        return err;
+    }
+
+    memset(&log_fcb, 0, sizeof(log_fcb));
+    log_fcb.f_magic = LOG_FCB_MAGIC;
+    log_fcb.f_version = LOG_FCB_VERSION;
+    log_fcb.f_sector_cnt = (uint8_t)sector_cnt;
+    log_fcb.f_scratch_cnt = 0;
+    log_fcb.f_sectors = log_sectors;
+
+    /* Returns -ENOMSG for a sector that is neither erased nor part of this log, the area is open by then. */
+    return fcb_init(LOG_PARTITION_ID, &log_fcb);
+}
+
+/*!
+ * @brief This internal function queues the filled block.
+ *
+ * @details
+ *      the queue holds as many entries as there are buffers, putting a buffer that was allocated never
+ *      fails.
+ */
+static void queue_block(void)
+{
+    k_spinlock_key_t key;
+    uint32_t queued;
+
+    fill_block->data[HDR_VERSION] = IMU_LOG_BLOCK_VERSION;
+    sys_put_le16(log_stats.session, &fill_block->data[HDR_SESSION]);
+    sys_put_le16(fill_count, &fill_block->data[HDR_SAMPLES]);
+    sys_put_le16(pending_dropped, &fill_block->data[HDR_DROPPED]);
+
+    (void)k_msgq_put(&block_msgq, &fill_block, K_NO_WAIT);
+
+    queued = k_msgq_num_used_get(&block_msgq);
+
+    key = k_spin_lock(&log_lock);
+    log_stats.queue_high_water = MAX(log_stats.queue_high_water, queued);
+    k_spin_unlock(&log_lock, key);
+
+    fill_block = NULL;
+    pending_dropped = 0;
+}
+
+/*!
+ * @brief fcb_walk() callback finding the last session.
+ *
+ * @details
+ *      the sessions only grow (modulo 2^16) from the oldest to the newest block, the last valid block
+ *      holds the last one.
+ */
+static int find_session(struct fcb_entry_ctx *ctx, void *arg)
+{
+    uint8_t header[IMU_LOG_BLOCK_HEADER_SIZE];
+
+    if (ctx->loc.fe_data_len < sizeof(header))
+    {
+        return 0;
+    }
+
+    if ((flash_area_read(ctx->fap, FCB_ENTRY_FA_DATA_OFF(ctx->loc), header, sizeof(header)) == 0) &&
+        (header[HDR_VERSION] == IMU_LOG_BLOCK_VERSION))
+    {
+        *(uint16_t *)arg = sys_get_le16(&header[HDR_SESSION]);
+    }
+
+    return 0;
+}
+
+/*!
+ * @brief fcb_walk() callback printing one block.
+ *
+ * @details
+ *      the block is read and printed in chunks, the whole line stays one block for the decoder.
+ */
+static int dump_block(struct fcb_entry_ctx *ctx, void *arg)
+{
+    static const char hex[] = "0123456789abcdef";
+    uint8_t chunk[DUMP_CHUNK];
+    char line[(2U * DUMP_CHUNK) + 1U];
+    uint16_t off, n, i;
+    int err;
+
+    printk("imu_log: ");
+
+    for (off = 0; off < ctx->loc.fe_data_len; off += n)
+    {
+        n = MIN((uint16_t)(ctx->loc.fe_data_len - off), (uint16_t)DUMP_CHUNK);
+
+        err = flash_area_read(ctx->fap, FCB_ENTRY_FA_DATA_OFF(ctx->loc) + off, chunk, n);
+
+        if (err != 0)
+        {
+            printk("\n\r");
+            return err;
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            line[2U * i] = hex[chunk[i] >> 4];
+            line[(2U * i) + 1U] = hex[chunk[i] & 0x0FU];
+        }
+
+        line[2U * n] = '\0';
+        printk("%s", line);
+    }
+
+    printk("\n\r");
+
+    (*(int *)arg)++;
+
+    return 0;
+}
+
+/*!
+ * @brief Entry of the writer thread.
+ *
+ * @details
+ *      runs below the acquisition and the processing, a write or an erase of the flash only delays this
+ *      thread. on the nRF52832 the CPU itself is halted while the flash is erased (about 85 ms per
+ *      sector), the FIFO of the BMI323 has to hold the samples for that time.
+ */
+static void log_thread_entry(void *p1, void *p2, void *p3)
+{
+    struct log_block *block;
+    k_spinlock_key_t key;
+    uint16_t samples;
+
+    while (1)
+    {
+        k_msgq_get(&block_msgq, &block, K_FOREVER);
+
+        samples = sys_get_le16(&block->data[HDR_SAMPLES]);
+
+        if (imu_log_write(block->data, block->len) == 0)
+        {
+            key = k_spin_lock(&log_lock);
+            log_stats.samples += samples;
+            k_spin_unlock(&log_lock, key);
+        }
+
+        k_mem_slab_free(&block_slab, block);
+    }
+}
@@ -0,0 +1,267 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   IMU flash log                                                                                               |
+ * |    @file           :   imu_log.h                                                                                                   |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the circular flash log of coded sample blocks (FCB), its dump and its write benchmark    |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_LOG_H_
+#define IMU_LOG_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'size_t' type
+ */
+#include <stddef.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type that is recorded
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * every entry of the log is one block (all fields little-endian):
+ *
+ *      | version (1) | session (2) | samples (2) | dropped (2) | samples coded by 'imu_codec' (n) |
+ *
+ * the session counts the boots that recorded into the log, the dropped samples were lost ahead of this
+ * block because no block buffer was free. the codec is reset at the start of every block, a block decodes
+ * on its own. the entry is padded with 0xFF to the write block size of the flash, the sample count ends it. refer to 'tools/imu_log_decode.py' for the host decoder.
+ */
+#define IMU_LOG_BLOCK_VERSION           (1U)
+#define IMU_LOG_BLOCK_HEADER_SIZE       (7U)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: imu_log_stats_t
+ * @brief: counters of the recording since imu_log_init()
+ */
+typedef struct {
+    uint16_t session;           /**< session written into the new blocks */
+    uint32_t blocks;            /**< blocks written to flash */
+    uint32_t bytes;             /**< bytes of the written blocks (without the FCB headers) */
+    uint32_t samples;           /**< samples in the written blocks */
+    uint32_t dropped;           /**< samples lost because no block buffer was free */
+    uint32_t erases;            /**< sectors erased ahead of the writes (the oldest data is overwritten) */
+    uint32_t errors;            /**< blocks that could not be written */
+    uint32_t queue_high_water;  /**< most blocks waiting for the writer at the same time */
+} imu_log_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int imu_log_init(void);
+ *  \b Description                              :       open the flash circular buffer (FCB) on the partition chosen as 'l3,imu-log' and
+ *                                                      find the session of the new recording.
+ *  @note                                       :       a partition that holds something else than the log (e.g. an old image in the slot)
+ *                                                      is erased once.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       imu_log_dump(), imu_log_clear() and imu_log_write() can be used.
+ *  @return                                     :       0 on success, a negative error code of the flash or the FCB.
+ *  @see                                        :       int imu_log_start(void);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_log_init(void);
+
+
+/**
+ *  \b function                                 :       int imu_log_start(void);
+ *  \b Description                              :       start the writer thread, from here on imu_log_put() records the samples.
+ *  \b PRE-CONDITION                            :       imu_log_init() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -EALREADY if the writer already runs.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_log_start(void);
+
+
+/**
+ *  \b function                                 :       void imu_log_put(const imu_sample_t *samples, uint16_t count);
+ *  \b Description                              :       code the samples into the current block, a full block is queued for the writer thread.
+ *  @param  samples [IN]                        :       samples, oldest first.
+ *  @param  count [IN]                          :       number of samples.
+ *  @note                                       :       never waits: the flash is written and erased by the writer thread, the acquisition
+ *                                                      only codes the samples. without a free block buffer the samples are dropped and
+ *                                                      counted. to be called from the acquisition context only.
+ *  \b PRE-CONDITION                            :       imu_log_start() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_log_put(const imu_sample_t *samples, uint16_t count);
+
+
+/**
+ *  \b function                                 :       int imu_log_write(const uint8_t *block, size_t len);
+ *  \b Description                              :       append one block to the log and erase the oldest sectors until
+ *                                                      CONFIG_L3_LOG_SPARE_SECTORS are free again.
+ *  @param  block [IN]                          :       the block, header included.
+ *  @param  len [IN]                            :       bytes of the block, at most CONFIG_L3_LOG_BLOCK_SIZE.
+ *  @note                                       :       blocks until the flash is written (and erased), used by the writer thread and the
+ *                                                      benchmark.
+ *  \b PRE-CONDITION                            :       imu_log_init() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -EINVAL for a bad length, a negative error code of the flash or the FCB.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_log_write(const uint8_t *block, size_t len);
+
+
+/**
+ *  \b function                                 :       int imu_log_dump(void);
+ *  \b Description                              :       print every block of the log, oldest first, as one hex line "imu_log: <hex>" on the console.
+ *  @note                                       :       capture the console and decode it with 'tools/imu_log_decode.py'. the log is not changed.
+ *  \b PRE-CONDITION                            :       imu_log_init() succeeded, the writer thread is not started.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       number of blocks printed, or a negative error code of the flash.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_log_dump(void);
+
+
+/**
+ *  \b function                                 :       int imu_log_clear(void);
+ *  \b Description                              :       erase the whole log.
+ *  \b PRE-CONDITION                            :       imu_log_init() succeeded, the writer thread is not started.
+ *  \b POST-CONDITION                           :       the log is empty, the session starts over at 1.
+ *  @return                                     :       0 on success, a negative error code of the flash.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_log_clear(void);
+
+
+/**
+ *  \b function                                 :       void imu_log_get_stats(imu_log_stats_t *stats);
+ *  \b Description                              :       read the counters of the recording.
+ *  @param  stats [OUT]                         :       receives a consistent copy.
+ *  @note                                       :       can be called from any context.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_log_get_stats(imu_log_stats_t *stats);
+
+
+#if defined(CONFIG_L3_LOG_BENCH)
+/**
+ *  \b function                                 :       void imu_log_bench_run(void);
+ *  \b Description                              :       write CONFIG_L3_LOG_BENCH_KB of coded samples through imu_log_write() and print the
+ *                                                      sustained bandwidth (erases included) against the rate the configured ODR needs.
+ *  @note                                       :       blocks for a few seconds, to be called once at startup. overwrites the log and clears
+ *                                                      it when done.
+ *  \b PRE-CONDITION                            :       imu_log_init() succeeded, the writer thread is not started.
+ *  \b POST-CONDITION                           :       the log is empty.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_log_bench_run(void);
+#endif
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_LOG_H_*/
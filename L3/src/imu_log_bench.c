@@ -0,0 +1,149 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+// include the printk function file header
+#include <zephyr/sys/printk.h>
+
+// include the little-endian helpers of the block header
+#include <zephyr/sys/byteorder.h>
+
+// include the cycle accurate timing functions (DWT CYCCNT on the nRF52832, the host counter on native_sim)
+#include <zephyr/timing/timing.h>
+
+// include the delta codec, the benchmark writes blocks like the recording does
+#include "imu_codec.h"
+
+#include "imu_log.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                 |   Documentation Link
+ * =========================|=====================
+ * timing_counter_get()     |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * timing_cycles_get()      |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * timing_cycles_to_ns()    |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Bytes written by the benchmark. */
+#define BENCH_BYTES         ((uint32_t)CONFIG_L3_LOG_BENCH_KB * 1024U)
+
+/*! Sensor time ticks between two samples at the configured ODR. */
+#define BENCH_TICKS         (25600U / CONFIG_L3_IMU_ODR_HZ)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+static uint8_t bench_block[CONFIG_L3_LOG_BLOCK_SIZE];
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+/*!
+ * @brief write coded blocks back to back and print the sustained bandwidth.
+ *
+ * @details
+ *      the samples are a slow swing with a few LSB of noise on every axis, they code to about the size of
+ *      a sensor at rest. the erases of the sectors ahead of the writes are part of the measured time, the
+ *      bandwidth is what the writer thread sustains over a full sector cycle. the result is compared with
+ *      the bytes per second the configured ODR produces at the bytes per sample seen here.
+ */
+void imu_log_bench_run(void)
+{
+    imu_log_stats_t before, after;
+    imu_codec_t codec;
+    imu_sample_t sample = { 0 };
+    timing_t start, end, t0, t1;
+    uint64_t ns, write_ns, max_ns = 0;
+    uint32_t written = 0, samples = 0, noise = 1U;
+    uint32_t bytes_per_s, need_per_s, per_sample_x100;
+    uint16_t count, len;
+    int err = 0;
+
+    imu_log_get_stats(&before);
+
+    timing_init();
+    timing_start();
+
+    start = timing_counter_get();
+
+    while ((written < BENCH_BYTES) && (err == 0))
+    {
+        imu_codec_reset(&codec);
+        len = IMU_LOG_BLOCK_HEADER_SIZE;
+        count = 0;
+
+        while ((len + IMU_CODEC_MAX_SAMPLE_SIZE) <= CONFIG_L3_LOG_BLOCK_SIZE)
+        {
+            /* LCG noise of +/-4 LSB on top of a ramp, close to a sensor lying on a table. */
+            noise = (noise * 1664525U) + 1013904223U;
+
+            sample.sensor_time += BENCH_TICKS;
+            sample.acc_x = (int16_t)((samples & 0x3FFU) + ((noise >> 8) & 7U));
+            sample.acc_y = (int16_t)(-(int32_t)((noise >> 12) & 7U));
+            sample.acc_z = (int16_t)(8192U + ((noise >> 16) & 7U));
+            sample.gyr_x = (int16_t)((noise >> 20) & 7U);
+            sample.gyr_y = (int16_t)((noise >> 24) & 7U);
+            sample.gyr_z = (int16_t)((noise >> 28) & 7U);
+
+            len += imu_codec_encode(&codec, &sample, &bench_block[len]);
+            count++;
+            samples++;
+        }
+
+        bench_block[0] = IMU_LOG_BLOCK_VERSION;
+        sys_put_le16(0xFFFFU, &bench_block[1]);
+        sys_put_le16(count, &bench_block[3]);
+        sys_put_le16(0, &bench_block[5]);
+
+        t0 = timing_counter_get();
+        err = imu_log_write(bench_block, len);
+        t1 = timing_counter_get();
+
+        write_ns = timing_cycles_to_ns(timing_cycles_get(&t0, &t1));
+        max_ns = MAX(max_ns, write_ns);
+
+        written += len;
+    }
+
+    end = timing_counter_get();
+    ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+    timing_stop();
+
+    imu_log_get_stats(&after);
+
+    bytes_per_s = (uint32_t)(((uint64_t)written * 1000000000ULL) / MAX(ns, 1U));
+    per_sample_x100 = (written * 100U) / MAX(samples, 1U);
+    need_per_s = (per_sample_x100 * CONFIG_L3_IMU_ODR_HZ) / 100U;
+
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("Flash log benchmark, %u bytes in blocks of %u bytes\n\r", written, CONFIG_L3_LOG_BLOCK_SIZE);
+    printk("----------------------------------------------------------------------------------\n\r");
+
+    if (err != 0)
+    {
+        printk("imu_log_write failed (%d)\n\r", err);
+    }
+
+    printk("%u bytes/s sustained, %u sectors erased, slowest block %u us\n\r",
+           bytes_per_s, after.erases - before.erases, (uint32_t)(max_ns / 1000U));
+    printk("%u.%02u bytes/sample, %u bytes/s needed at %u Hz: %s\n\r",
+           per_sample_x100 / 100U, per_sample_x100 % 100U,
+           need_per_s, CONFIG_L3_IMU_ODR_HZ,
+           (bytes_per_s >= need_per_s) ? "keeps up" : "too slow");
+
+    /* The benchmark blocks are no recording, the log starts empty. */
+    err = imu_log_clear();
+
+    if (err != 0)
+    {
+        printk("imu_log_clear failed (%d)\n\r", err);
+    }
+}
@@ -0,0 +1,142 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+// include the lock-free ring the samples are queued in
+#include "imu_ring.h"
+
+#include "imu_proc.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * k_sem_give() / k_sem_take()      |   https://docs.zephyrproject.org/latest/kernel/services/synchronization/semaphores.html
+ * k_thread_create()                |   https://docs.zephyrproject.org/latest/kernel/services/threads/index.html
+ * atomic_inc() / atomic_add()      |   https://docs.zephyrproject.org/latest/kernel/services/other/atomic.html
+ * imu_ring_put() / imu_ring_get()  |   refer to 'imu_ring.h'
+ */
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! Samples handed from the acquisition context to the processing thread. */
+IMU_RING_DEFINE(sample_ring, CONFIG_L3_PROC_RING_CAPACITY);
+
+/*! Given for every queued sample, limit 1: the thread drains everything that is queued once it wakes up. */
+K_SEM_DEFINE(proc_sem, 0, 1);
+
+K_THREAD_STACK_DEFINE(proc_stack, CONFIG_L3_PROC_THREAD_STACK_SIZE);
+static struct k_thread proc_thread;
+
+/*! Set by imu_proc_start(), only read by the processing thread. */
+static imu_proc_handler_t proc_handler;
+
+/*! Samples queued by imu_proc_put() and samples the handler returned from, imu_proc_flush() waits for both to meet. */
+static atomic_t queued_samples;
+static atomic_t handled_samples;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief Entry of the processing thread, it hands the queued samples to the handler in batches.
+ */
+static void proc_thread_entry(void *p1, void *p2, void *p3);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int imu_proc_start(imu_proc_handler_t handler)
+{
+    if (handler == NULL)
+    {
+        return -EINVAL;
+    }
+
+    if (proc_handler != NULL)
+    {
+        return -EALREADY;
+    }
+
+    proc_handler = handler;
+
+    k_thread_create(&proc_thread, proc_stack, K_THREAD_STACK_SIZEOF(proc_stack),
+                    proc_thread_entry, NULL, NULL, NULL,
+                    CONFIG_L3_PROC_THREAD_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&proc_thread, "imu_proc");
+
+    return 0;
+}
+
+int imu_proc_put(const imu_sample_t *sample)
+{
+    int ret = imu_ring_put(&sample_ring, sample);
+
+    if (ret == 0)
+    {
+        atomic_inc(&queued_samples);
+    }
+
+    /* Also wake the thread when the ring is full, it may not have run since the last sample. */
+    k_sem_give(&proc_sem);
+
+    return ret;
+}
+
+void imu_proc_get_stats(imu_proc_stats_t *stats)
+{
+    stats->capacity = CONFIG_L3_PROC_RING_CAPACITY;
+    stats->count = imu_ring_count(&sample_ring);
+    stats->high_water = imu_ring_high_water(&sample_ring);
+    stats->overruns = imu_ring_overruns(&sample_ring);
+}
+
+int imu_proc_flush(k_timeout_t timeout)
+{
+    k_timepoint_t end = sys_timepoint_calc(timeout);
+
+    /* An empty ring is not enough, the last batch may still be in the handler. */
+    while (atomic_get(&handled_samples) != atomic_get(&queued_samples))
+    {
+        if (sys_timepoint_expired(end))
+        {
+            return -EAGAIN;
+        }
+
+        k_sleep(K_MSEC(1));
+    }
+
+    return 0;
+}
+
+/*!
+ * @brief Entry of the processing thread.
+ *
+ * @details
+ *      one wake-up can stand for many samples, the ring is drained completely before sleeping again. the
+ *      batch buffer is static to keep it off the thread stack.
+ */
+static void proc_thread_entry(void *p1, void *p2, void *p3)
+{
+    static imu_sample_t batch[CONFIG_L3_PROC_BATCH];
+    uint16_t count;
+
+    while (1)
+    {
+        k_sem_take(&proc_sem, K_FOREVER);
+
+        do
+        {
+            count = imu_ring_get(&sample_ring, batch, ARRAY_SIZE(batch));
+
+            if (count > 0)
+            {
+                proc_handler(batch, count);
+                atomic_add(&handled_samples, count);
+            }
+        } while (count == ARRAY_SIZE(batch));
+    }
+}
@@ -0,0 +1,179 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   processing thread of the L3 IMU samples                                                                     |
+ * |    @file           :   imu_proc.h                                                                                                  |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file moves the processing of the samples out of the acquisition context, behind a lock-free ring       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_PROC_H_
+#define IMU_PROC_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'k_timeout_t' type
+ */
+#include <zephyr/kernel.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type handed to the processing thread
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: called from the processing thread with a batch of samples taken out of the ring, oldest first
+ * @param  samples      : the samples, only valid during the call.
+ * @param  count        : number of samples, between 1 and CONFIG_L3_PROC_BATCH.
+ */
+typedef void (*imu_proc_handler_t)(const imu_sample_t *samples, uint16_t count);
+
+/**
+ * @struct: imu_proc_stats_t
+ * @brief: state of the ring between the acquisition and the processing thread, to size CONFIG_L3_PROC_RING_CAPACITY
+ */
+typedef struct {
+    uint32_t capacity;          /**< CONFIG_L3_PROC_RING_CAPACITY */
+    uint32_t count;             /**< samples queued right now */
+    uint32_t high_water;        /**< largest number of samples queued at the same time */
+    uint32_t overruns;          /**< samples dropped because the ring was full */
+} imu_proc_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int imu_proc_start(imu_proc_handler_t handler);
+ *  \b Description                              :       start the processing thread, it sleeps until samples are queued and hands them to
+ *                                                      'handler' in batches of up to CONFIG_L3_PROC_BATCH samples.
+ *  @param  handler [IN]                        :       the processing of the samples (conversion, printing, telemetry ...).
+ *  @note                                       :       the thread runs at CONFIG_L3_PROC_THREAD_PRIORITY, below the acquisition, so a slow
+ *                                                      handler only fills the ring instead of delaying the next read.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       the samples given to imu_proc_put() reach 'handler'.
+ *  @return                                     :       0 on success, -EINVAL if 'handler' is NULL, -EALREADY if the thread already runs.
+ *  @see                                        :       int imu_proc_put(const imu_sample_t *sample);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_proc_start(imu_proc_handler_t handler);
+
+
+/**
+ *  \b function                                 :       int imu_proc_put(const imu_sample_t *sample);
+ *  \b Description                              :       queue one sample for the processing thread and wake it up.
+ *  @param  sample [IN]                         :       the sample, copied into the ring.
+ *  @note                                       :       only one context may call this function (single producer): the poll / FIFO loop, the
+ *                                                      data-ready thread or the I2C completion thread, depending on the acquisition mode.
+ *                                                      safe from an interrupt, never blocks.
+ *  \b PRE-CONDITION                            :       None, samples queued before imu_proc_start() are processed once it is called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -ENOBUFS if the ring is full and the sample was dropped.
+ *  @see                                        :       int imu_proc_start(imu_proc_handler_t handler);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_proc_put(const imu_sample_t *sample);
+
+
+/**
+ *  \b function                                 :       void imu_proc_get_stats(imu_proc_stats_t *stats);
+ *  \b Description                              :       read the fill level, the high-water mark and the overruns of the ring.
+ *  @param  stats [OUT]                         :       receives the statistics.
+ *  @note                                       :       can be called from any context.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_proc_get_stats(imu_proc_stats_t *stats);
+
+
+/**
+ *  \b function                                 :       int imu_proc_flush(k_timeout_t timeout);
+ *  \b Description                              :       wait until the handler returned from every sample that was queued.
+ *  @param  timeout [IN]                        :       how long to wait at most.
+ *  @note                                       :       called by the producer once it stopped queueing (the end of a replay), it polls
+ *                                                      every millisecond.
+ *  \b PRE-CONDITION                            :       imu_proc_start() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -EAGAIN if samples are still queued after 'timeout'.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_proc_flush(k_timeout_t timeout);
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_PROC_H_*/
@@ -0,0 +1,212 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include <string.h>
+
+// include printk() for the periodic summary
+#include <zephyr/sys/printk.h>
+
+// include the cycle accurate timing functions (DWT CYCCNT on the nRF52832, the host counter on native_sim)
+#include <zephyr/timing/timing.h>
+
+#include "imu_prof.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * timing_counter_get()             |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * timing_cycles_get()              |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * timing_cycles_to_ns()            |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * k_spin_lock() / k_spin_unlock()  |   https://docs.zephyrproject.org/latest/kernel/services/smp/smp.html
+ * k_work_schedule()                |   https://docs.zephyrproject.org/latest/kernel/services/threads/workqueue.html
+ */
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! Names of the stages in the summary, indexed by imu_prof_stage_t. */
+static const char *const stage_names[IMU_PROF_COUNT] = {
+    "status", "read_acc", "read_gyr", "read_fifo", "convert", "output", "encode", "loop",
+};
+
+/*! Statistics of every stage since the last summary. */
+static imu_prof_stats_t prof_stats[IMU_PROF_COUNT];
+static struct k_spinlock prof_lock;
+
+/*! Prints the summary every CONFIG_L3_PROF_REPORT_SEC seconds. */
+static struct k_work_delayable report_work;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief Work handler printing and clearing the statistics, runs in the system work queue.
+ */
+static void report_handler(struct k_work *work);
+
+/*!
+ *  @brief This internal function prints the non-empty part of a histogram on a single line.
+ */
+static void print_histogram(const uint32_t *hist);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+void imu_prof_init(void)
+{
+    timing_init();
+    timing_start();
+
+    k_work_init_delayable(&report_work, report_handler);
+    k_work_schedule(&report_work, K_SECONDS(CONFIG_L3_PROF_REPORT_SEC));
+}
+
+void imu_prof_record(imu_prof_stage_t stage, const timing_t *start)
+{
+    timing_t begin = *start;
+    timing_t end = timing_counter_get();
+    uint32_t cycles = (uint32_t)MIN(timing_cycles_get(&begin, &end), (uint64_t)UINT32_MAX);
+    imu_prof_stats_t *stats;
+    k_spinlock_key_t key;
+
+    if (stage >= IMU_PROF_COUNT)
+    {
+        return;
+    }
+
+    stats = &prof_stats[stage];
+
+    key = k_spin_lock(&prof_lock);
+
+    if ((stats->count == 0) || (cycles < stats->min))
+    {
+        stats->min = cycles;
+    }
+
+    stats->max = MAX(stats->max, cycles);
+    stats->total += cycles;
+    stats->hist[MIN(find_msb_set(cycles), IMU_PROF_BINS - 1U)]++;
+    stats->count++;
+
+    k_spin_unlock(&prof_lock, key);
+}
+
+void imu_prof_get_stats(imu_prof_stage_t stage, imu_prof_stats_t *stats)
+{
+    k_spinlock_key_t key;
+
+    if (stage >= IMU_PROF_COUNT)
+    {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+
+    key = k_spin_lock(&prof_lock);
+
+    *stats = prof_stats[stage];
+
+    k_spin_unlock(&prof_lock, key);
+}
+
+/*!
+ * @brief Work handler printing the summary.
+ *
+ * @details
+ *      all the stages are copied and cleared at once, every summary covers the last
+ *      CONFIG_L3_PROF_REPORT_SEC seconds only. the busy share of the 'loop' stage is the part of the
+ *      period the CPU spent in the loop rather than in its sleep.
+ */
+static void report_handler(struct k_work *work)
+{
+    static imu_prof_stats_t snapshot[IMU_PROF_COUNT];
+    k_spinlock_key_t key;
+    uint32_t avg;
+    uint32_t busy_x100;
+    uint8_t i;
+
+    key = k_spin_lock(&prof_lock);
+    memcpy(snapshot, prof_stats, sizeof(snapshot));
+    memset(prof_stats, 0, sizeof(prof_stats));
+    k_spin_unlock(&prof_lock, key);
+
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("Profile of the last %u s, %u MHz counter\n\r", CONFIG_L3_PROF_REPORT_SEC, timing_freq_get_mhz());
+    printk("Stage, Count, Min, Avg, Max (cycles), Avg (ns), Histogram (log2 cycles)\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+
+    for (i = 0; i < IMU_PROF_COUNT; i++)
+    {
+        if (snapshot[i].count == 0)
+        {
+            continue;
+        }
+
+        avg = (uint32_t)(snapshot[i].total / snapshot[i].count);
+
+        printk("%s, %u, %u, %u, %u, %u,",
+               stage_names[i],
+               snapshot[i].count,
+               snapshot[i].min,
+               avg,
+               snapshot[i].max,
+               (uint32_t)timing_cycles_to_ns(avg));
+        print_histogram(snapshot[i].hist);
+    }
+
+    if (snapshot[IMU_PROF_LOOP].count != 0)
+    {
+        /* busy in % = ns in the loop / (period in s * 10^9) * 100, printed with two decimals. */
+        busy_x100 = (uint32_t)(timing_cycles_to_ns(snapshot[IMU_PROF_LOOP].total) /
+                               (CONFIG_L3_PROF_REPORT_SEC * 100000ULL));
+
+        printk("loop busy %u.%02u %% of the time\n\r", busy_x100 / 100U, busy_x100 % 100U);
+    }
+
+    k_work_schedule(&report_work, K_SECONDS(CONFIG_L3_PROF_REPORT_SEC));
+}
+
+/*!
+ * @brief This internal function prints the non-empty part of a histogram.
+ *
+ * @details
+ *      printed as "2^first: count count ...", the first count is the bin of the fastest pass, the next
+ *      ones double the number of cycles each.
+ */
+static void print_histogram(const uint32_t *hist)
+{
+    uint8_t first = 0;
+    uint8_t last = IMU_PROF_BINS - 1U;
+    uint8_t i;
+
+    while ((first < last) && (hist[first] == 0))
+    {
+        first++;
+    }
+
+    while ((last > first) && (hist[last] == 0))
+    {
+        last--;
+    }
+
+    /* Bin 0 holds the passes of 0 cycles, bin i starts at 2^(i-1) cycles. */
+    if (first == 0)
+    {
+        printk(" 0:");
+    }
+    else
+    {
+        printk(" 2^%u:", (uint32_t)(first - 1U));
+    }
+
+    for (i = first; i <= last; i++)
+    {
+        printk(" %u", hist[i]);
+    }
+
+    printk("\n\r");
+}
@@ -0,0 +1,190 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   Acquisition loop profiling                                                                                  |
+ * |    @file           :   imu_prof.h                                                                                                  |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides cycle counter probes with min / avg / max and a histogram per stage of the loop          |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_PROF_H_
+#define IMU_PROF_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+#if defined(CONFIG_L3_PROF)
+/**
+ * @reason: provide 'timing_t' and timing_counter_get(), the DWT CYCCNT on the nRF52832 and the host counter on native_sim
+ */
+#include <zephyr/timing/timing.h>
+#endif
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * number of histogram bins, bin 0 counts 0 cycles, bin i (i >= 1) counts [2^(i-1), 2^i) cycles and the last bin
+ * everything above
+ */
+#define IMU_PROF_BINS           (24U)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: the profiled stages of the acquisition loop, a stage that is never recorded is left out of the summary
+ */
+typedef enum {
+    IMU_PROF_STATUS = 0,        /**< read of the data-ready / interrupt status */
+    IMU_PROF_READ_ACC,          /**< read of the accel data */
+    IMU_PROF_READ_GYR,          /**< read of the gyro data */
+    IMU_PROF_READ_FIFO,         /**< burst read and parsing of the FIFO */
+    IMU_PROF_CONVERT,           /**< conversion of the raw values to units */
+    IMU_PROF_OUTPUT,            /**< printk, telemetry or hand-over to the processing thread */
+    IMU_PROF_ENCODE,            /**< delta coding of one telemetry sample */
+    IMU_PROF_LOOP,              /**< one pass of the loop without its sleep */
+    IMU_PROF_COUNT              /**< number of stages */
+} imu_prof_stage_t;
+
+/**
+ * @struct: imu_prof_stats_t
+ * @brief: cycles spent in one stage since the last summary
+ */
+typedef struct {
+    uint32_t count;                     /**< number of recorded passes */
+    uint32_t min;                       /**< fewest cycles of one pass */
+    uint32_t max;                       /**< most cycles of one pass */
+    uint64_t total;                     /**< sum of the cycles of all passes, total / count is the average */
+    uint32_t hist[IMU_PROF_BINS];       /**< log2 histogram of the cycles of one pass */
+} imu_prof_stats_t;
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/**
+ * probes around one stage of the acquisition loop, they compile to nothing without CONFIG_L3_PROF.
+ * IMU_PROF_BEGIN() declares 'var' and reads the cycle counter, IMU_PROF_END() accounts the cycles since then.
+ */
+#if defined(CONFIG_L3_PROF)
+#define IMU_PROF_BEGIN(var)         timing_t var = timing_counter_get()
+#define IMU_PROF_END(stage, var)    imu_prof_record((stage), &(var))
+#else
+#define IMU_PROF_BEGIN(var)
+#define IMU_PROF_END(stage, var)
+#endif
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+#if defined(CONFIG_L3_PROF)
+/**
+ *  \b function                                 :       void imu_prof_init(void);
+ *  \b Description                              :       start the cycle counter and the periodic summary, every CONFIG_L3_PROF_REPORT_SEC
+ *                                                      seconds min / avg / max and the histogram of every stage are printed and cleared.
+ *  @note                                       :       the summary is printed from the system work queue, its own printk is not part of any
+ *                                                      stage.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       IMU_PROF_BEGIN() / IMU_PROF_END() can be used.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_prof_init(void);
+
+
+/**
+ *  \b function                                 :       void imu_prof_record(imu_prof_stage_t stage, const timing_t *start);
+ *  \b Description                              :       account the cycles from 'start' until now to 'stage', use IMU_PROF_END() instead.
+ *  @param  stage [IN]                          :       the profiled stage.
+ *  @param  start [IN]                          :       counter value taken by IMU_PROF_BEGIN().
+ *  @note                                       :       a few tens of cycles, no division. callable from any thread.
+ *  \b PRE-CONDITION                            :       imu_prof_init() was called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_prof_record(imu_prof_stage_t stage, const timing_t *start);
+
+
+/**
+ *  \b function                                 :       void imu_prof_get_stats(imu_prof_stage_t stage, imu_prof_stats_t *stats);
+ *  \b Description                              :       copy the statistics of one stage since the last summary.
+ *  @param  stage [IN]                          :       the profiled stage.
+ *  @param  stats [OUT]                         :       receives the statistics, all zero for an invalid stage.
+ *  @note                                       :       can be called from any thread, the copy is consistent.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_prof_get_stats(imu_prof_stage_t stage, imu_prof_stats_t *stats);
+#endif
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_PROF_H_*/
@@ -0,0 +1,256 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include <errno.h>
+#include <string.h>
+
+// include printk() for the report
+#include <zephyr/sys/printk.h>
+
+// include the little-endian helpers of the output records
+#include <zephyr/sys/byteorder.h>
+
+// include the CRC-32 the output is summed up with
+#include <zephyr/sys/crc.h>
+
+// the recording, the output and the golden file are read and written by the host side of native_sim, refer to 'imu_replay_native.c'
+#include "imu_replay_native.h"
+
+// include the conversion to g / dps and the delta codec, two of the stages the output records
+#include "imu_convert.h"
+#include "imu_codec.h"
+
+#include "imu_replay.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * k_sleep() / K_TIMEOUT_ABS_TICKS  |   https://docs.zephyrproject.org/latest/kernel/services/timing/clocks.html
+ * crc32_ieee_update()              |   https://docs.zephyrproject.org/latest/doxygen/html/group__checksum.html
+ * sys_put_le32() / sys_put_le16()  |   https://docs.zephyrproject.org/latest/doxygen/html/group__byteorder.html
+ * imu_convert_f32()                |   refer to 'imu_convert.h'
+ * imu_codec_encode()               |   refer to 'imu_codec.h'
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Sensor time of the BMI323, 39.0625 us per tick: 25600 ticks per second. */
+#define SENSOR_TICKS_PER_SEC    (25600U)
+
+/*! Payload of a SAMPLE record: sensor time and the 6 axes. */
+#define SAMPLE_REC_SIZE         (4U + (6U * 2U))
+
+/*! Largest output record, a record is one write of the host side. */
+#define RECORD_MAX_SIZE         (IMU_REPLAY_REC_HEADER_SIZE + UINT8_MAX)
+
+BUILD_ASSERT(IMU_CODEC_MAX_SAMPLE_SIZE <= UINT8_MAX, "a coded sample has to fit into one record");
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! Samples replayed, and the recorded time they span in sensor ticks. */
+static uint32_t replayed;
+static uint64_t span_ticks;
+static uint32_t last_time;
+
+/*! Kernel tick the replay started at, the real-time pace is kept against it. */
+static int64_t start_tick;
+
+/*! Host clock at the start, for the throughput. */
+static uint64_t start_ns;
+
+/*! Records and bytes written, and the CRC-32 over them. */
+static uint32_t records;
+static uint64_t bytes;
+static uint32_t crc;
+
+/*! One stream over the whole replay, like one telemetry session. */
+static imu_codec_t codec;
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int imu_replay_open(void)
+{
+    if (imu_replay_native_open(CONFIG_L3_REPLAY_FILE, CONFIG_L3_REPLAY_OUTPUT_FILE, CONFIG_L3_REPLAY_GOLDEN_FILE) != 0)
+    {
+        printk("imu_replay: cannot open '%s', '%s' or '%s'\n\r", CONFIG_L3_REPLAY_FILE,
+               CONFIG_L3_REPLAY_OUTPUT_FILE, CONFIG_L3_REPLAY_GOLDEN_FILE);
+        return -ENOENT;
+    }
+
+    replayed = 0;
+    span_ticks = 0;
+    records = 0;
+    bytes = 0;
+    crc = 0;
+    imu_codec_reset(&codec);
+
+    start_tick = k_uptime_ticks();
+    start_ns = imu_replay_native_now_ns();
+
+    return 0;
+}
+
+/*!
+ * @brief read the next batch of recorded samples.
+ *
+ * @details
+ *      the recorded sensor times are kept as they are, so the timing and every stage see the stream the
+ *      sensor produced. the span is summed up from the differences of the sensor times, a wrap of the
+ *      counter is one more difference. with CONFIG_L3_REPLAY_REALTIME the batch is held back until the
+ *      last sample of it would have been read out of the sensor.
+ */
+int imu_replay_drain(imu_sample_t *samples, uint16_t max_samples, uint16_t *count)
+{
+    int16_t axes[6];
+    uint32_t sensor_time, read_cycles;
+    uint16_t n = 0;
+
+    while ((n < max_samples) && (imu_replay_native_next(&sensor_time, axes) == 0))
+    {
+        if (replayed > 0)
+        {
+            span_ticks += (uint32_t)(sensor_time - last_time);
+        }
+
+        last_time = sensor_time;
+        replayed++;
+
+        samples[n].acc_x = axes[0];
+        samples[n].acc_y = axes[1];
+        samples[n].acc_z = axes[2];
+        samples[n].gyr_x = axes[3];
+        samples[n].gyr_y = axes[4];
+        samples[n].gyr_z = axes[5];
+        samples[n].sensor_time = sensor_time;
+        n++;
+    }
+
+    *count = n;
+
+    if (n == 0)
+    {
+        return -ENODATA;
+    }
+
+#if defined(CONFIG_L3_REPLAY_REALTIME)
+    k_sleep(K_TIMEOUT_ABS_TICKS(start_tick + (int64_t)k_us_to_ticks_ceil64((span_ticks * 1000000ULL) / SENSOR_TICKS_PER_SEC)));
+#endif
+
+    /* One read-out for the whole batch, like a FIFO burst. */
+    read_cycles = k_cycle_get_32();
+
+    for (uint16_t i = 0; i < n; i++)
+    {
+        samples[i].read_cycles = read_cycles;
+    }
+
+    return 0;
+}
+
+void imu_replay_put(imu_replay_rec_t type, const void *payload, uint8_t len)
+{
+    uint8_t record[RECORD_MAX_SIZE];
+
+    record[0] = (uint8_t)type;
+    record[1] = len;
+    memcpy(&record[IMU_REPLAY_REC_HEADER_SIZE], payload, len);
+
+    imu_replay_native_write(record, IMU_REPLAY_REC_HEADER_SIZE + len);
+
+    crc = crc32_ieee_update(crc, record, IMU_REPLAY_REC_HEADER_SIZE + len);
+    bytes += IMU_REPLAY_REC_HEADER_SIZE + len;
+    records++;
+}
+
+/*!
+ * @brief append the records of the samples that left the chain.
+ *
+ * @details
+ *      the floats are written as they are in memory, native_sim is little-endian like the target. a
+ *      different rounding of the conversion shows up in the CONVERTED records even when the raw
+ *      samples are equal.
+ */
+void imu_replay_put_samples(const imu_sample_t *samples, uint16_t count)
+{
+    uint8_t payload[MAX(SAMPLE_REC_SIZE, IMU_CODEC_MAX_SAMPLE_SIZE)];
+    int16_t raw[6];
+    float converted[6];
+    size_t len;
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        raw[0] = samples[i].acc_x;
+        raw[1] = samples[i].acc_y;
+        raw[2] = samples[i].acc_z;
+        raw[3] = samples[i].gyr_x;
+        raw[4] = samples[i].gyr_y;
+        raw[5] = samples[i].gyr_z;
+
+        sys_put_le32(samples[i].sensor_time, payload);
+        for (uint8_t axis = 0; axis < 6; axis++)
+        {
+            sys_put_le16((uint16_t)raw[axis], &payload[4U + (axis * 2U)]);
+        }
+        imu_replay_put(IMU_REPLAY_REC_SAMPLE, payload, SAMPLE_REC_SIZE);
+
+        imu_convert_f32(&imu_convert_acc_scale, &raw[0], &converted[0], 3);
+        imu_convert_f32(&imu_convert_gyr_scale, &raw[3], &converted[3], 3);
+        imu_replay_put(IMU_REPLAY_REC_CONVERTED, converted, sizeof(converted));
+
+        len = imu_codec_encode(&codec, &samples[i], payload);
+        imu_replay_put(IMU_REPLAY_REC_CODED, payload, (uint8_t)len);
+    }
+}
+
+/*!
+ * @brief close the files and print the report of the replay.
+ *
+ * @details
+ *      the throughput is taken with the clock of the host: the simulated time of native_sim only moves
+ *      while every thread sleeps, a replay that never sleeps would take no time at all. run 'zephyr.exe'
+ *      with '--no-rt' to replay as fast as the host can, and without it for CONFIG_L3_REPLAY_REALTIME.
+ */
+int imu_replay_finish(void)
+{
+    uint64_t elapsed_ns = imu_replay_native_now_ns() - start_ns;
+    uint64_t span_us = (span_ticks * 1000000ULL) / SENSOR_TICKS_PER_SEC;
+    uint64_t rate, speed_x100, differ_byte = 0, differ_record = 0;
+    int golden = imu_replay_native_golden(&differ_byte, &differ_record);
+
+    elapsed_ns = MAX(elapsed_ns, 1U);
+    rate = ((uint64_t)replayed * 1000000000ULL) / elapsed_ns;
+    speed_x100 = (span_us * 100000ULL) / elapsed_ns;
+
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("Replay of '%s'\n\r", CONFIG_L3_REPLAY_FILE);
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("%u samples in %u.%03u s of host time, %u samples/s, %u.%02u x real time\n\r",
+           replayed, (uint32_t)(elapsed_ns / 1000000000ULL), (uint32_t)((elapsed_ns / 1000000ULL) % 1000U),
+           (uint32_t)rate, (uint32_t)(speed_x100 / 100U), (uint32_t)(speed_x100 % 100U));
+    printk("%u records, %u bytes, CRC-32 0x%08x\n\r", records, (uint32_t)bytes, crc);
+
+    if (golden == IMU_REPLAY_NATIVE_GOLDEN_NONE)
+    {
+        printk("no golden file, the output was not compared\n\r");
+        return 0;
+    }
+
+    if (golden == IMU_REPLAY_NATIVE_GOLDEN_DIFFER)
+    {
+        printk("golden '%s': MISMATCH at record %u (byte %u)\n\r", CONFIG_L3_REPLAY_GOLDEN_FILE,
+               (uint32_t)differ_record, (uint32_t)differ_byte);
+        return -EBADMSG;
+    }
+
+    printk("golden '%s': match\n\r", CONFIG_L3_REPLAY_GOLDEN_FILE);
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   Deterministic replay of a recording                                                                         |
+ * |    @file           :   imu_replay.h                                                                                                |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the replay harness: recorded samples in, output records checked against a golden file    |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_REPLAY_H_
+#define IMU_REPLAY_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type the recording is replayed as
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: the output of the replay is a sequence of records (little-endian):
+ *
+ * | type (1) | length (1) | payload (length) |
+ *
+ * one record per stage result, in the order the chain produced them. two runs over the same recording with the
+ * same build write the same bytes, a different byte is a change of behaviour of a stage.
+ */
+#define IMU_REPLAY_REC_HEADER_SIZE      (2U)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: types of the output records
+ */
+typedef enum {
+    IMU_REPLAY_REC_SAMPLE = 1,          /**< sample at the end of the chain (after the filter): sensor time (4) + 6 raw axes (12) */
+    IMU_REPLAY_REC_CONVERTED,           /**< the same sample in g and dps: 6 IEEE-754 floats (24) */
+    IMU_REPLAY_REC_CODED,               /**< the same sample coded by 'imu_codec', one stream over the whole replay */
+    IMU_REPLAY_REC_ORIENTATION          /**< quaternion w, x, y, z of the orientation filter every CONFIG_L3_REPLAY_ORIENTATION_SAMPLES samples (16) */
+} imu_replay_rec_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int imu_replay_open(void);
+ *  \b Description                              :       open the recording (CONFIG_L3_REPLAY_FILE), the output (CONFIG_L3_REPLAY_OUTPUT_FILE) and
+ *                                                      the golden file (CONFIG_L3_REPLAY_GOLDEN_FILE).
+ *  \b PRE-CONDITION                            :       imu_convert_set_accel_range() and imu_convert_set_gyro_range() succeeded.
+ *  \b POST-CONDITION                           :       imu_replay_drain() returns the samples of the recording.
+ *  @return                                     :       0 on success, -ENOENT if a file could not be opened.
+ *  @see                                        :       int imu_replay_drain(imu_sample_t *samples, uint16_t max_samples, uint16_t *count);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_replay_open(void);
+
+
+/**
+ *  \b function                                 :       int imu_replay_drain(imu_sample_t *samples, uint16_t max_samples, uint16_t *count);
+ *  \b Description                              :       read the next batch of recorded samples, like bmi323_fifo_drain() reads a FIFO burst.
+ *  @param  samples [OUT]                       :       array that receives the samples.
+ *  @param  max_samples [IN]                    :       capacity of 'samples'.
+ *  @param  count [OUT]                         :       number of samples written into 'samples'.
+ *  @note                                       :       with CONFIG_L3_REPLAY_REALTIME the call sleeps until the recorded sensor time of the last
+ *                                                      sample of the batch is due, otherwise it returns at once. 'read_cycles' is taken once
+ *                                                      per batch, like a FIFO burst, it is not part of any output record.
+ *  \b PRE-CONDITION                            :       imu_replay_open() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -ENODATA once the recording is over ('count' is 0 then).
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_replay_drain(imu_sample_t *samples, uint16_t max_samples, uint16_t *count);
+
+
+/**
+ *  \b function                                 :       void imu_replay_put(imu_replay_rec_t type, const void *payload, uint8_t len);
+ *  \b Description                              :       append one record to the output and compare it with the golden file.
+ *  @param  type [IN]                           :       type of the record.
+ *  @param  payload [IN]                        :       its payload.
+ *  @param  len [IN]                            :       length of the payload.
+ *  @note                                       :       one context only: the end of the chain (the processing thread, or the replay loop).
+ *  \b PRE-CONDITION                            :       imu_replay_open() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_replay_put(imu_replay_rec_t type, const void *payload, uint8_t len);
+
+
+/**
+ *  \b function                                 :       void imu_replay_put_samples(const imu_sample_t *samples, uint16_t count);
+ *  \b Description                              :       append the SAMPLE, CONVERTED and CODED records of every sample that left the chain.
+ *  @param  samples [IN]                        :       the samples, oldest first.
+ *  @param  count [IN]                          :       number of samples.
+ *  @note                                       :       same context as imu_replay_put().
+ *  \b PRE-CONDITION                            :       imu_replay_open() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_replay_put_samples(const imu_sample_t *samples, uint16_t count);
+
+
+/**
+ *  \b function                                 :       int imu_replay_finish(void);
+ *  \b Description                              :       close the files and print the report: samples replayed, end-to-end throughput in samples per
+ *                                                      second of the host, speed against real time, records, CRC-32 of the output and the
+ *                                                      result of the comparison with the golden file.
+ *  @note                                       :       call it once every sample went through the chain (imu_proc_flush() with the processing
+ *                                                      thread).
+ *  \b PRE-CONDITION                            :       imu_replay_drain() returned -ENODATA.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 if the output is the golden file or there is none, -EBADMSG if it differs.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_replay_finish(void);
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_REPLAY_H_*/
@@ -0,0 +1,182 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+/*
+ * NOTE: this file is compiled in the native_sim runner (host) context and linked with the host C library,
+ * that is why it can use fopen()/fread() and clock_gettime(). it must not include any zephyr header.
+ * documentation can be found at: https://docs.zephyrproject.org/latest/boards/native/native_sim/doc/index.html
+ */
+#include <stdio.h>
+#include <time.h>
+
+#include "imu_replay_native.h"
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Longest CSV line, 9 numbers and their separators. */
+#define LINE_MAX_LEN            (160)
+
+/*! Longest output record (type, length and 255 bytes), it is compared in one piece. */
+#define RECORD_MAX_LEN          (2 + 255)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+static FILE *input_file;
+static FILE *output_file;
+static FILE *golden_file;
+
+/*! Bytes and records written so far, and where the output first left the golden file. */
+static uint64_t out_bytes;
+static uint64_t out_records;
+static int differ;
+static uint64_t differ_byte;
+static uint64_t differ_record;
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int imu_replay_native_open(const char *input, const char *output, const char *golden)
+{
+    input_file = fopen(input, "r");
+    if (input_file == NULL)
+    {
+        return -1;
+    }
+
+    if ((output[0] != '\0') && ((output_file = fopen(output, "wb")) == NULL))
+    {
+        return -1;
+    }
+
+    if ((golden[0] != '\0') && ((golden_file = fopen(golden, "rb")) == NULL))
+    {
+        return -1;
+    }
+
+    out_bytes = 0;
+    out_records = 0;
+    differ = 0;
+
+    return 0;
+}
+
+int imu_replay_native_next(uint32_t *sensor_time, int16_t *axes)
+{
+    char line[LINE_MAX_LEN];
+    unsigned int first, second, third;
+    int values[6];
+    int i;
+
+    if (input_file == NULL)
+    {
+        return 1;
+    }
+
+    while (fgets(line, sizeof(line), input_file) != NULL)
+    {
+        /* 'imu_log_decode.py': session,block,sensor_time,6 axes. */
+        if (sscanf(line, "%u,%u,%u,%d,%d,%d,%d,%d,%d", &first, &second, &third, &values[0], &values[1], &values[2],
+                   &values[3], &values[4], &values[5]) == 9)
+        {
+            *sensor_time = third;
+        }
+        /* 'telemetry_decode.py': seq,sensor_time,6 axes. */
+        else if (sscanf(line, "%u,%u,%d,%d,%d,%d,%d,%d", &first, &second, &values[0], &values[1], &values[2],
+                        &values[3], &values[4], &values[5]) == 8)
+        {
+            *sensor_time = second;
+        }
+        else
+        {
+            continue;
+        }
+
+        for (i = 0; i < 6; i++)
+        {
+            axes[i] = (int16_t)values[i];
+        }
+
+        return 0;
+    }
+
+    return 1;
+}
+
+void imu_replay_native_write(const void *data, size_t len)
+{
+    unsigned char golden[RECORD_MAX_LEN];
+    size_t got, i;
+
+    if (output_file != NULL)
+    {
+        fwrite(data, 1, len, output_file);
+    }
+
+    if ((golden_file != NULL) && !differ && (len <= sizeof(golden)))
+    {
+        got = fread(golden, 1, len, golden_file);
+
+        for (i = 0; (i < got) && (golden[i] == ((const unsigned char *)data)[i]); i++)
+        {
+        }
+
+        /* A differing byte, or the golden file ended inside the record. */
+        if (i < len)
+        {
+            differ = 1;
+            differ_byte = out_bytes + i;
+            differ_record = out_records;
+        }
+    }
+
+    out_bytes += len;
+    out_records++;
+}
+
+int imu_replay_native_golden(uint64_t *byte, uint64_t *record)
+{
+    int state = IMU_REPLAY_NATIVE_GOLDEN_NONE;
+
+    if (golden_file != NULL)
+    {
+        /* The golden file goes on after the last record: the output ended early. */
+        if (!differ && (fgetc(golden_file) != EOF))
+        {
+            differ = 1;
+            differ_byte = out_bytes;
+            differ_record = out_records;
+        }
+
+        state = differ ? IMU_REPLAY_NATIVE_GOLDEN_DIFFER : IMU_REPLAY_NATIVE_GOLDEN_MATCH;
+        *byte = differ_byte;
+        *record = differ_record;
+
+        fclose(golden_file);
+        golden_file = NULL;
+    }
+
+    if (output_file != NULL)
+    {
+        fclose(output_file);
+        output_file = NULL;
+    }
+
+    if (input_file != NULL)
+    {
+        fclose(input_file);
+        input_file = NULL;
+    }
+
+    return state;
+}
+
+uint64_t imu_replay_native_now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
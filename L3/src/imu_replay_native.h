@@ -0,0 +1,179 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   native_sim replay files                                                                                     |
+ * |    @file           :   imu_replay_native.h                                                                                         |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file declares the host side files and clock the replay harness uses on native_sim                      |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_REPLAY_NATIVE_H_
+#define IMU_REPLAY_NATIVE_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'int16_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'size_t' data-type
+ */
+#include <stddef.h>
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * @brief: state of the comparison with the golden file, returned by imu_replay_native_golden()
+ */
+#define IMU_REPLAY_NATIVE_GOLDEN_NONE       (0)     /**< no golden file was given */
+#define IMU_REPLAY_NATIVE_GOLDEN_MATCH      (1)     /**< the output is the golden file, byte for byte */
+#define IMU_REPLAY_NATIVE_GOLDEN_DIFFER     (-1)    /**< a byte differs, or one of both is shorter */
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int imu_replay_native_open(const char *input, const char *output, const char *golden);
+ *  \b Description                              :       open the recording, create the output file and open the golden file.
+ *  @param  input [IN]                          :       recording in the CSV format of 'tools/telemetry_decode.py' or 'tools/imu_log_decode.py'.
+ *  @param  output [IN]                         :       file the output records are written to, "" to only compare them.
+ *  @param  golden [IN]                         :       file the output is compared with, "" to compare nothing.
+ *  @note                                       :       only available on native_sim, this runs in the host (runner) context. the paths are
+ *                                                      relative to the working directory of 'zephyr.exe'.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -1 if a file could not be opened.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_replay_native_open(const char *input, const char *output, const char *golden);
+
+
+/**
+ *  \b function                                 :       int imu_replay_native_next(uint32_t *sensor_time, int16_t *axes);
+ *  \b Description                              :       read the next sample of the recording, the recording is played once.
+ *  @param  sensor_time [OUT]                   :       recorded sensor time of the sample.
+ *  @param  axes [OUT]                          :       acc x/y/z then gyr x/y/z, 6 values.
+ *  @note                                       :       lines that are not samples (the CSV header) are skipped.
+ *  \b PRE-CONDITION                            :       imu_replay_native_open() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, 1 at the end of the recording.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_replay_native_next(uint32_t *sensor_time, int16_t *axes);
+
+
+/**
+ *  \b function                                 :       void imu_replay_native_write(const void *data, size_t len);
+ *  \b Description                              :       append one output record to the output file and compare it with the golden file.
+ *  @param  data [IN]                           :       the record.
+ *  @param  len [IN]                            :       its length in bytes.
+ *  \b PRE-CONDITION                            :       imu_replay_native_open() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_replay_native_write(const void *data, size_t len);
+
+
+/**
+ *  \b function                                 :       int imu_replay_native_golden(uint64_t *byte, uint64_t *record);
+ *  \b Description                              :       close the files and tell whether the output was the golden file.
+ *  @param  byte [OUT]                          :       offset of the first differing byte (the length of the shorter file if one ends early).
+ *  @param  record [OUT]                        :       index of the record holding that byte.
+ *  \b PRE-CONDITION                            :       the last record was written.
+ *  \b POST-CONDITION                           :       the output file is complete.
+ *  @return                                     :       IMU_REPLAY_NATIVE_GOLDEN_NONE, _MATCH or _DIFFER.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_replay_native_golden(uint64_t *byte, uint64_t *record);
+
+
+/**
+ *  \b function                                 :       uint64_t imu_replay_native_now_ns(void);
+ *  \b Description                              :       read the monotonic clock of the host.
+ *  @note                                       :       the simulated time of native_sim does not pass while the CPU is busy, the throughput
+ *                                                      of the replay is measured with the host clock instead.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       nanoseconds since an arbitrary start.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+uint64_t imu_replay_native_now_ns(void);
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_REPLAY_NATIVE_H_*/
@@ -0,0 +1,87 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include "imu_ring.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * atomic_get() / atomic_set()      |   https://docs.zephyrproject.org/latest/kernel/services/other/atomic.html
+ */
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+/*!
+ * @brief copy one sample at the head of the ring.
+ *
+ * @details
+ *      'head' and 'tail' run freely and wrap at 2^32, their difference is the fill level as long as the
+ *      capacity is a power of 2. the sample is written before 'head' is published, atomic_set() is a full
+ *      barrier so the consumer never sees the new index before the data behind it.
+ */
+int imu_ring_put(imu_ring_t *ring, const imu_sample_t *sample)
+{
+    uint32_t head = (uint32_t)atomic_get(&ring->head);
+    uint32_t used = head - (uint32_t)atomic_get(&ring->tail);
+
+    if (used > ring->mask)
+    {
+        atomic_inc(&ring->overruns);
+        return -ENOBUFS;
+    }
+
+    ring->buf[head & ring->mask] = *sample;
+
+    atomic_set(&ring->head, (atomic_val_t)(head + 1U));
+
+    if ((used + 1U) > (uint32_t)atomic_get(&ring->high_water))
+    {
+        atomic_set(&ring->high_water, (atomic_val_t)(used + 1U));
+    }
+
+    return 0;
+}
+
+/*!
+ * @brief copy up to 'max' of the oldest samples out of the ring.
+ *
+ * @details
+ *      the slots are only given back by publishing 'tail' once all of them were copied, the producer can
+ *      not overwrite a sample that is still being read.
+ */
+uint16_t imu_ring_get(imu_ring_t *ring, imu_sample_t *out, uint16_t max)
+{
+    uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+    uint32_t used = (uint32_t)atomic_get(&ring->head) - tail;
+    uint16_t count = (uint16_t)MIN(used, (uint32_t)max);
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        out[i] = ring->buf[(tail + i) & ring->mask];
+    }
+
+    atomic_set(&ring->tail, (atomic_val_t)(tail + count));
+
+    return count;
+}
+
+uint32_t imu_ring_count(imu_ring_t *ring)
+{
+    return (uint32_t)atomic_get(&ring->head) - (uint32_t)atomic_get(&ring->tail);
+}
+
+uint32_t imu_ring_overruns(imu_ring_t *ring)
+{
+    return (uint32_t)atomic_get(&ring->overruns);
+}
+
+uint32_t imu_ring_high_water(imu_ring_t *ring)
+{
+    return (uint32_t)atomic_get(&ring->high_water);
+}
@@ -0,0 +1,216 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   lock-free single-producer / single-consumer ring of IMU samples                                             |
+ * |    @file           :   imu_ring.h                                                                                                  |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the ring that decouples the acquisition of the samples from their processing             |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_RING_H_
+#define IMU_RING_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the 'atomic_t' type and the BUILD_ASSERT() / IS_POWER_OF_TWO() macros
+ */
+#include <zephyr/kernel.h>
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type stored in the ring
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * the indices written by the producer and by the consumer live in separate blocks of this size, so they never share a cache
+ * line. the nRF52832 has no data cache, 32 bytes is the line of the Cortex-M7 and keeps the layout right on cached parts too
+ */
+#define IMU_RING_CACHE_LINE         (32U)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: imu_ring_t
+ * @brief: fixed capacity ring of raw samples for exactly one producer and one consumer, no lock is taken on either side.
+ *         'head' and the statistics are only written by the producer, 'tail' only by the consumer.
+ */
+typedef struct {
+    atomic_t head __aligned(IMU_RING_CACHE_LINE);   /**< free running count of the samples put (private) */
+    atomic_t overruns;                              /**< samples dropped because the ring was full (private) */
+    atomic_t high_water;                            /**< largest fill level seen by the producer (private) */
+    atomic_t tail __aligned(IMU_RING_CACHE_LINE);   /**< free running count of the samples taken (private) */
+    imu_sample_t *buf __aligned(IMU_RING_CACHE_LINE); /**< storage of 'mask + 1' samples */
+    uint32_t mask;                                  /**< capacity - 1, the capacity is a power of 2 */
+} imu_ring_t;
+
+/******************************************************************************
+ * Macros
+ *******************************************************************************/
+
+/**
+ * defines an empty ring 'name' of 'capacity' samples, 'capacity' has to be a power of 2
+ */
+#define IMU_RING_DEFINE(name, capacity)                                                         \
+    BUILD_ASSERT(IS_POWER_OF_TWO(capacity), "the capacity of an imu_ring_t is a power of 2");   \
+    static imu_sample_t name##_buf[(capacity)];                                                 \
+    static imu_ring_t name = { .buf = name##_buf, .mask = (capacity) - 1U }
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int imu_ring_put(imu_ring_t *ring, const imu_sample_t *sample);
+ *  \b Description                              :       copy one sample at the head of the ring.
+ *  @param  ring [IN]                           :       the ring.
+ *  @param  sample [IN]                         :       the sample to copy.
+ *  @note                                       :       producer side only, safe from an interrupt. when the ring is full the new sample is
+ *                                                      dropped and counted, the samples already queued are never touched.
+ *  \b PRE-CONDITION                            :       the ring was defined with IMU_RING_DEFINE().
+ *  \b POST-CONDITION                           :       the sample is visible to the consumer.
+ *  @return                                     :       0 on success, -ENOBUFS if the ring is full.
+ *  @see                                        :       uint16_t imu_ring_get(imu_ring_t *ring, imu_sample_t *out, uint16_t max);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_ring_put(imu_ring_t *ring, const imu_sample_t *sample);
+
+
+/**
+ *  \b function                                 :       uint16_t imu_ring_get(imu_ring_t *ring, imu_sample_t *out, uint16_t max);
+ *  \b Description                              :       copy up to 'max' of the oldest samples out of the ring and free their slots.
+ *  @param  ring [IN]                           :       the ring.
+ *  @param  out [OUT]                           :       receives the samples, oldest first.
+ *  @param  max [IN]                            :       capacity of 'out' in samples.
+ *  @note                                       :       consumer side only, never blocks.
+ *  \b PRE-CONDITION                            :       the ring was defined with IMU_RING_DEFINE().
+ *  \b POST-CONDITION                           :       the slots of the copied samples can be reused by the producer.
+ *  @return                                     :       the number of samples copied, 0 if the ring is empty.
+ *  @see                                        :       int imu_ring_put(imu_ring_t *ring, const imu_sample_t *sample);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+uint16_t imu_ring_get(imu_ring_t *ring, imu_sample_t *out, uint16_t max);
+
+
+/**
+ *  \b function                                 :       uint32_t imu_ring_count(imu_ring_t *ring);
+ *  \b Description                              :       number of samples currently queued.
+ *  @param  ring [IN]                           :       the ring.
+ *  @note                                       :       can be called from both sides, the value may be stale by the time it is used.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       the fill level in samples.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+uint32_t imu_ring_count(imu_ring_t *ring);
+
+
+/**
+ *  \b function                                 :       uint32_t imu_ring_overruns(imu_ring_t *ring);
+ *  \b Description                              :       number of samples dropped so far because the ring was full.
+ *  @param  ring [IN]                           :       the ring.
+ *  @note                                       :       None.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       the overrun counter.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+uint32_t imu_ring_overruns(imu_ring_t *ring);
+
+
+/**
+ *  \b function                                 :       uint32_t imu_ring_high_water(imu_ring_t *ring);
+ *  \b Description                              :       largest number of samples that were queued at the same time.
+ *  @param  ring [IN]                           :       the ring.
+ *  @note                                       :       a high-water mark that stays well below the capacity after a long run under the worst
+ *                                                      output load means the ring can be made smaller.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       the high-water mark in samples.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+uint32_t imu_ring_high_water(imu_ring_t *ring);
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_RING_H_*/
@@ -0,0 +1,116 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   common IMU sample type shared by the L3 acquisition and processing stages                                   |
+ * |    @file           :   imu_sample.h                                                                                                |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file defines the raw 6-axis sample that every acquisition mode produces                                |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_SAMPLE_H_
+#define IMU_SAMPLE_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * ticks of the BMI323 sensor time per second, one tick = 39.0625 us
+ */
+#define IMU_SAMPLE_TICKS_PER_SEC        (25600U)
+
+/**
+ * samples taken from the sensor per sample the stages behind the filter see, the filter stage hands on one sample
+ * per CONFIG_L3_FILTER_DECIMATION
+ */
+#if defined(CONFIG_L3_FILTER)
+#define IMU_SAMPLE_DECIMATION           (CONFIG_L3_FILTER_DECIMATION)
+#else
+#define IMU_SAMPLE_DECIMATION           (1U)
+#endif
+
+/**
+ * sensor time ticks between two samples behind the filter stage at CONFIG_L3_IMU_ODR_HZ
+ */
+#define IMU_SAMPLE_NOMINAL_TICKS        ((IMU_SAMPLE_TICKS_PER_SEC / CONFIG_L3_IMU_ODR_HZ) * IMU_SAMPLE_DECIMATION)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: imu_sample_t
+ * @brief: one raw accel + gyro reading exactly as it left the sensor (no unit conversion is done here),
+ *         keeping the samples raw lets the later stages decide if and when to pay for the conversion.
+ */
+typedef struct {
+    int16_t acc_x;          /**< raw accel x-axis LSB */
+    int16_t acc_y;          /**< raw accel y-axis LSB */
+    int16_t acc_z;          /**< raw accel z-axis LSB */
+    int16_t gyr_x;          /**< raw gyro x-axis LSB */
+    int16_t gyr_y;          /**< raw gyro y-axis LSB */
+    int16_t gyr_z;          /**< raw gyro z-axis LSB */
+    uint32_t sensor_time;   /**< BMI323 sensor time of the sample, one tick = 39.0625 us */
+    uint32_t read_cycles;   /**< k_cycle_get_32() when the sample was read out of the sensor (or its FIFO burst) */
+} imu_sample_t;
+
+/**
+ * @struct: imu_axis_sample_t
+ * @brief: one raw reading of a single sensor (accel or gyro), used where the two sensors are acquired as
+ *         independent streams at their own ODR.
+ */
+typedef struct {
+    int16_t x;              /**< raw x-axis LSB */
+    int16_t y;              /**< raw y-axis LSB */
+    int16_t z;              /**< raw z-axis LSB */
+    uint32_t sensor_time;   /**< BMI323 sensor time of the sample, one tick = 39.0625 us */
+} imu_axis_sample_t;
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_SAMPLE_H_*/
@@ -0,0 +1,343 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include <string.h>
+
+// include the cycle counter of the measurements
+#include <zephyr/timing/timing.h>
+
+// include the little-endian helpers of the packed summary
+#include <zephyr/sys/byteorder.h>
+
+#include "imu_stats.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * timing_counter_get()             |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * timing_cycles_get()              |   https://docs.zephyrproject.org/latest/kernel/timing_functions/index.html
+ * sys_put_le32() / sys_put_le16()  |   https://docs.zephyrproject.org/latest/doxygen/html/group__byteorder.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Length of a window in sensor ticks, 25.6 ticks per ms. */
+#define WINDOW_TICKS            ((uint32_t)(((uint64_t)CONFIG_L3_STATS_WINDOW_MS * 25600U) / 1000U))
+
+/*!
+ * Samples summed up before they are merged into the window. the sums of a block are exact: the sum
+ * stays below 2^23 and the sum of the squares below 2^38, and the merge term below 2^56.
+ */
+#define BLOCK_MAX               (256U)
+
+/******************************************************************************/
+/*!         Typedefs                                                          */
+
+/*! Running statistics of one axis over the window. */
+typedef struct {
+    int64_t mean_q16;           /**< mean, Q16 LSB */
+    uint64_t m2_q8;             /**< sum of the squared differences to the mean, Q8 LSB^2 */
+    int16_t min;
+    int16_t max;
+} axis_acc_t;
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+static axis_acc_t acc[IMU_STATS_AXES];
+
+/*! Samples in the window and the sensor time of its first and last one. */
+static uint32_t window_count;
+static uint32_t start_time;
+static uint32_t end_time;
+
+/*! Cycles of the accumulation in the window. */
+static uint64_t window_cycles;
+static uint32_t max_block_cycles;
+
+static imu_stats_summary_t last_summary;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function sums up a block exactly and merges it into the window.
+ *
+ *  @param[in] samples   : Samples of the block.
+ *  @param[in] count     : Number of samples, at most BLOCK_MAX.
+ */
+static void add_block(const imu_sample_t *samples, uint16_t count);
+
+/*!
+ *  @brief This internal function writes the summary of the window and empties it.
+ */
+static void close_window(void);
+
+/*!
+ *  @brief This internal function divides and rounds to the nearest, halves away from zero.
+ */
+static int64_t div_round(int64_t num, int64_t den);
+
+/*!
+ *  @brief This internal function computes the integer square root.
+ *
+ *  @return floor(sqrt(value)).
+ */
+static uint32_t isqrt64(uint64_t value);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+void imu_stats_init(void)
+{
+    timing_init();
+    timing_start();
+
+    memset(acc, 0, sizeof(acc));
+    memset(&last_summary, 0, sizeof(last_summary));
+    window_count = 0;
+    window_cycles = 0;
+    max_block_cycles = 0;
+}
+
+/*!
+ * @brief add the samples to the window.
+ *
+ * @details
+ *      the batch is cut into blocks at the end of the window and every BLOCK_MAX samples. only the
+ *      blocks are timed, the cycles of a window are the price of the statistics alone.
+ */
+int imu_stats_update(const imu_sample_t *samples, uint16_t count)
+{
+    timing_t begin, end;
+    uint32_t cycles;
+    uint16_t i = 0, len;
+    int closed = 0;
+
+    while (i < count)
+    {
+        if (window_count == 0)
+        {
+            start_time = samples[i].sensor_time;
+        }
+
+        len = 0;
+        while (((i + len) < count) && (len < BLOCK_MAX) &&
+               ((uint32_t)(samples[i + len].sensor_time - start_time) < WINDOW_TICKS))
+        {
+            len++;
+        }
+
+        if (len == 0)
+        {
+            close_window();
+            closed = 1;
+            continue;
+        }
+
+        begin = timing_counter_get();
+        add_block(&samples[i], len);
+        end = timing_counter_get();
+
+        cycles = (uint32_t)MIN(timing_cycles_get(&begin, &end), (uint64_t)UINT32_MAX);
+        window_cycles += cycles;
+        max_block_cycles = MAX(max_block_cycles, cycles);
+
+        i += len;
+        end_time = samples[i - 1U].sensor_time;
+    }
+
+    return closed;
+}
+
+void imu_stats_get_summary(imu_stats_summary_t *summary)
+{
+    *summary = last_summary;
+}
+
+size_t imu_stats_pack(const imu_stats_summary_t *summary, uint8_t *buf)
+{
+    uint8_t *p = buf;
+
+    sys_put_le32(summary->start_time, &p[0]);
+    sys_put_le32(summary->end_time, &p[4]);
+    sys_put_le32(summary->count, &p[8]);
+    sys_put_le16(summary->cycles_per_sample, &p[12]);
+    sys_put_le16(summary->max_block_cycles, &p[14]);
+    p += 16;
+
+    for (uint8_t axis = 0; axis < IMU_STATS_AXES; axis++)
+    {
+        sys_put_le32((uint32_t)summary->axis[axis].mean_q8, &p[0]);
+        sys_put_le32(summary->axis[axis].std_q8, &p[4]);
+        sys_put_le32(summary->axis[axis].rms_q8, &p[8]);
+        sys_put_le16((uint16_t)summary->axis[axis].min, &p[12]);
+        sys_put_le16((uint16_t)summary->axis[axis].max, &p[14]);
+        p += 16;
+    }
+
+    return IMU_STATS_PACKED_SIZE;
+}
+
+/*!
+ * @brief This internal function sums up a block and merges it into the window.
+ *
+ * @details
+ *      a sample by sample Welford update divides by the count for every sample, in fixed point the
+ *      rounding of the mean then adds up over a long window. the block is summed up exactly instead,
+ *      its mean and its sum of squared differences follow without any loss, and it is merged into the
+ *      window with the pairwise update (Chan et al.): the mean moves by the difference of both means
+ *      weighted by the share of the block, and the spread of both means adds d^2 * n_a * n_b / n to the
+ *      sum of squares. one division per block and axis is left, none per sample.
+ */
+static void add_block(const imu_sample_t *samples, uint16_t count)
+{
+    int32_t sum[IMU_STATS_AXES] = { 0 };
+    uint64_t sum_sq[IMU_STATS_AXES] = { 0 };
+    int16_t lo[IMU_STATS_AXES], hi[IMU_STATS_AXES];
+    int16_t x[IMU_STATS_AXES];
+    uint32_t n_a = window_count, n = window_count + count;
+    int64_t mean_b, d, d8;
+    uint64_t num, m2_b, t;
+    uint8_t axis;
+
+    for (axis = 0; axis < IMU_STATS_AXES; axis++)
+    {
+        lo[axis] = INT16_MAX;
+        hi[axis] = INT16_MIN;
+    }
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        x[0] = samples[i].acc_x;
+        x[1] = samples[i].acc_y;
+        x[2] = samples[i].acc_z;
+        x[3] = samples[i].gyr_x;
+        x[4] = samples[i].gyr_y;
+        x[5] = samples[i].gyr_z;
+
+        for (axis = 0; axis < IMU_STATS_AXES; axis++)
+        {
+            sum[axis] += x[axis];
+            sum_sq[axis] += (uint32_t)((int32_t)x[axis] * x[axis]);
+            lo[axis] = MIN(lo[axis], x[axis]);
+            hi[axis] = MAX(hi[axis], x[axis]);
+        }
+    }
+
+    for (axis = 0; axis < IMU_STATS_AXES; axis++)
+    {
+        axis_acc_t *a = &acc[axis];
+
+        /* Mean and sum of squared differences of the block: n * sum_sq - sum^2 is exact and never negative. */
+        mean_b = div_round((int64_t)sum[axis] * 65536, count);
+        num = ((uint64_t)count * sum_sq[axis]) - (uint64_t)((int64_t)sum[axis] * sum[axis]);
+        m2_b = ((num / count) << 8) + (((num % count) << 8) / count);
+
+        if (n_a == 0)
+        {
+            a->mean_q16 = mean_b;
+            a->m2_q8 = m2_b;
+            a->min = lo[axis];
+            a->max = hi[axis];
+            continue;
+        }
+
+        /* Both means are within the range of int16_t: |d| < 2^32 in Q16, d8^2 * count < 2^56 in Q16. */
+        d = mean_b - a->mean_q16;
+        a->mean_q16 += div_round(d * count, n);
+
+        d8 = div_round(d, 256);
+        t = (uint64_t)(d8 * d8) * count;
+        t -= (t / n) * count;
+
+        a->m2_q8 += m2_b + ((t + 128U) >> 8);
+        a->min = MIN(a->min, lo[axis]);
+        a->max = MAX(a->max, hi[axis]);
+    }
+
+    window_count = n;
+}
+
+/*!
+ * @brief This internal function writes the summary of the window.
+ *
+ * @details
+ *      the variance is the population variance, the sum of squares over the count: the RMS follows
+ *      from it and the mean without a second accumulator (rms^2 = mean^2 + variance). the square roots
+ *      of Q16 values are the Q8 results.
+ */
+static void close_window(void)
+{
+    uint64_t var_q16;
+    int64_t mean_q8;
+
+    last_summary.start_time = start_time;
+    last_summary.end_time = end_time;
+    last_summary.count = window_count;
+    last_summary.cycles_per_sample = (uint16_t)MIN(window_cycles / MAX(window_count, 1U), (uint64_t)UINT16_MAX);
+    last_summary.max_block_cycles = (uint16_t)MIN(max_block_cycles, (uint32_t)UINT16_MAX);
+
+    for (uint8_t axis = 0; axis < IMU_STATS_AXES; axis++)
+    {
+        const axis_acc_t *a = &acc[axis];
+
+        mean_q8 = div_round(a->mean_q16, 256);
+        var_q16 = ((a->m2_q8 / window_count) << 8) + (((a->m2_q8 % window_count) << 8) / window_count);
+
+        last_summary.axis[axis].mean_q8 = (int32_t)mean_q8;
+        last_summary.axis[axis].std_q8 = isqrt64(var_q16);
+        last_summary.axis[axis].rms_q8 = isqrt64((uint64_t)(mean_q8 * mean_q8) + var_q16);
+        last_summary.axis[axis].min = a->min;
+        last_summary.axis[axis].max = a->max;
+    }
+
+    memset(acc, 0, sizeof(acc));
+    window_count = 0;
+    window_cycles = 0;
+    max_block_cycles = 0;
+}
+
+/*!
+ * @brief This internal function divides and rounds to the nearest.
+ */
+static int64_t div_round(int64_t num, int64_t den)
+{
+    return (num >= 0) ? ((num + (den / 2)) / den) : ((num - (den / 2)) / den);
+}
+
+/*!
+ * @brief This internal function computes the integer square root, one result bit per step.
+ */
+static uint32_t isqrt64(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return (uint32_t)root;
+}
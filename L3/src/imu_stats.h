@@ -0,0 +1,199 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   streaming statistics of the L3 IMU samples                                                                  |
+ * |    @file           :   imu_stats.h                                                                                                 |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file sums the samples up per axis over windows (Welford, fixed point) into compact summaries           |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_STATS_H_
+#define IMU_STATS_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'size_t' type
+ */
+#include <stddef.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type the statistics are taken of
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * accel x, y, z and gyro x, y, z, in the order of 'imu_sample_t'
+ */
+#define IMU_STATS_AXES                  (6U)
+
+/**
+ * size of a summary packed by imu_stats_pack(): times, samples and cycles (16) + 16 per axis
+ */
+#define IMU_STATS_PACKED_SIZE           (16U + (IMU_STATS_AXES * 16U))
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: imu_stats_axis_t
+ * @brief: statistics of one axis over one window, in raw LSB, Q8 (1/256 LSB) for the fractional ones
+ */
+typedef struct {
+    int32_t mean_q8;
+    uint32_t std_q8;            /**< population standard deviation */
+    uint32_t rms_q8;
+    int16_t min;
+    int16_t max;
+} imu_stats_axis_t;
+
+/**
+ * @struct: imu_stats_summary_t
+ * @brief: what is left of one window of samples
+ */
+typedef struct {
+    uint32_t start_time;        /**< sensor time of the first sample of the window */
+    uint32_t end_time;          /**< sensor time of the last sample of the window */
+    uint32_t count;             /**< samples in the window */
+    uint16_t cycles_per_sample; /**< average cycles of the accumulation per sample */
+    uint16_t max_block_cycles;  /**< cycles of the slowest block, saturated at 65535 */
+    imu_stats_axis_t axis[IMU_STATS_AXES];
+} imu_stats_summary_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       void imu_stats_init(void);
+ *  \b Description                              :       empty the window and start the cycle counter of the measurements.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       imu_stats_update() can be used.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_stats_init(void);
+
+
+/**
+ *  \b function                                 :       int imu_stats_update(const imu_sample_t *samples, uint16_t count);
+ *  \b Description                              :       add the samples to the window, a sample CONFIG_L3_STATS_WINDOW_MS or more after the
+ *                                                      first one of the window closes it and starts the next one.
+ *  @param  samples [IN]                        :       raw samples, oldest first.
+ *  @param  count [IN]                          :       number of samples.
+ *  @note                                       :       the samples are summed up exactly in blocks of integers, each block is then merged into
+ *                                                      the window with the pairwise Welford update in fixed point. the window is cut by the
+ *                                                      sensor time, a replay cuts it where the recording did. not reentrant, one caller only.
+ *  \b PRE-CONDITION                            :       imu_stats_init() was called.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       1 if a window was closed (read it with imu_stats_get_summary()), 0 otherwise.
+ *  @see                                        :       void imu_stats_get_summary(imu_stats_summary_t *summary);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_stats_update(const imu_sample_t *samples, uint16_t count);
+
+
+/**
+ *  \b function                                 :       void imu_stats_get_summary(imu_stats_summary_t *summary);
+ *  \b Description                              :       read the summary of the last closed window.
+ *  @param  summary [OUT]                       :       receives the summary, all zero before the first window.
+ *  @note                                       :       same context as imu_stats_update().
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_stats_get_summary(imu_stats_summary_t *summary);
+
+
+/**
+ *  \b function                                 :       size_t imu_stats_pack(const imu_stats_summary_t *summary, uint8_t *buf);
+ *  \b Description                              :       write a summary in the little-endian layout of the telemetry packet.
+ *  @param  summary [IN]                        :       the summary.
+ *  @param  buf [OUT]                           :       at least @IMU_STATS_PACKED_SIZE bytes.
+ *  @note                                       :       start time, end time, count (4 each), cycles per sample and of the slowest block (2 each),
+ *                                                      then per axis: mean, std, rms (4 each, Q8), min and max (2 each). refer to
+ *                                                      'tools/telemetry_decode.py'.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       @IMU_STATS_PACKED_SIZE.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+size_t imu_stats_pack(const imu_stats_summary_t *summary, uint8_t *buf);
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_STATS_H_*/
@@ -0,0 +1,323 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+// include printk() for the periodic report
+#include <zephyr/sys/printk.h>
+
+#include "imu_timing.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * k_cycle_get_32()                 |   https://docs.zephyrproject.org/latest/kernel/services/timing/clocks.html
+ * k_cyc_to_ns_floor64()            |   https://docs.zephyrproject.org/latest/kernel/services/timing/clocks.html
+ * k_spin_lock() / k_spin_unlock()  |   https://docs.zephyrproject.org/latest/kernel/services/smp/smp.html
+ * k_work_submit()                  |   https://docs.zephyrproject.org/latest/kernel/services/threads/workqueue.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! One tick of the sensor time is 39062.5 ns, kept as twice that to stay in integers. */
+#define TICK_NS_X2              (78125ULL)
+
+/*! Sensor time ticks between two samples at the configured ODR. */
+#define NOMINAL_TICKS           (25600U / CONFIG_L3_IMU_ODR_HZ)
+
+/*! A gap longer than 1.5 sample periods means at least one sample is missing. */
+#define DROP_TICKS              (NOMINAL_TICKS + (NOMINAL_TICKS / 2U))
+
+/*! Weight of a new window in the drift estimate (1/8). */
+#define DRIFT_EMA_SHIFT         (3)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! Statistics, shared between the reading context and imu_timing_get_stats(). */
+static imu_timing_stats_t timing_stats;
+static struct k_spinlock timing_lock;
+
+/*! Raw counters of the previous sample, the first sample only initialises them. */
+static bool started;
+static uint32_t last_cycles;
+static uint32_t last_time;
+
+/*! Both clocks unwrapped to 64 bits since the first sample, and the previous values in ns. */
+static uint64_t mcu_cycles;
+static uint64_t sens_ticks;
+static int64_t last_mcu_ns;
+static int64_t last_sens_ns;
+
+/*! Smallest offset (readout - sensor time) of the current window and the sensor time it was seen at. */
+static int64_t win_min_offset;
+static int64_t win_min_sens_ns;
+static uint32_t win_count;
+
+/*! Minimum of the last complete window, the drift line starts there. */
+static bool base_valid;
+static int64_t base_offset;
+static int64_t base_sens_ns;
+
+/*! Drift estimate in ppm, smoothed over the windows. */
+static bool drift_valid;
+static float drift_ppm;
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function maps a duration in us to its histogram bin (log2).
+ */
+static uint8_t us_to_bin(uint32_t us);
+
+/*!
+ *  @brief This internal function tracks the lower envelope of the offset and updates the drift once per window.
+ *
+ *  @param[in] offset    : Readout time minus sensor time of the sample, in ns.
+ *  @param[in] sens_ns   : Sensor time of the sample, in ns.
+ */
+static void track_envelope(int64_t offset, int64_t sens_ns);
+
+/*!
+ *  @brief This internal function returns the offset a readout without any delay would have at 'sens_ns'.
+ */
+static int64_t expected_offset(int64_t sens_ns);
+
+/*!
+ *  @brief Work handler printing the statistics, runs in the system work queue.
+ */
+static void report_handler(struct k_work *work);
+
+/*!
+ *  @brief This internal function prints one histogram on a single line.
+ */
+static void print_histogram(const char *name, const uint32_t *bins);
+
+K_WORK_DEFINE(report_work, report_handler);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+void imu_timing_update(const imu_sample_t *sample)
+{
+    k_spinlock_key_t key;
+
+    /* Elapsed sensor time since the previous sample. */
+    uint32_t d_ticks = sample->sensor_time - last_time;
+
+    /* Samples of one FIFO burst share the same readout time. */
+    bool same_readout = (sample->read_cycles == last_cycles);
+
+    int64_t mcu_ns;
+    int64_t sens_ns;
+    int64_t offset;
+    int64_t latency_ns;
+    int64_t jitter_ns;
+    uint32_t lost = 0;
+    uint32_t samples;
+
+    /* The first sample, or the sensor time went backwards (the sensor was reset): start over from here. */
+    if (!started || (d_ticks == 0) || (d_ticks >= 0x80000000UL))
+    {
+        started = true;
+        last_cycles = sample->read_cycles;
+        last_time = sample->sensor_time;
+        mcu_cycles = 0;
+        sens_ticks = 0;
+        last_mcu_ns = 0;
+        last_sens_ns = 0;
+        win_count = 0;
+        base_valid = false;
+
+        track_envelope(0, 0);
+
+        key = k_spin_lock(&timing_lock);
+        timing_stats.samples++;
+        k_spin_unlock(&timing_lock, key);
+        return;
+    }
+
+    mcu_cycles += (uint32_t)(sample->read_cycles - last_cycles);
+    sens_ticks += d_ticks;
+    last_cycles = sample->read_cycles;
+    last_time = sample->sensor_time;
+
+    mcu_ns = (int64_t)k_cyc_to_ns_floor64(mcu_cycles);
+    sens_ns = (int64_t)((sens_ticks * TICK_NS_X2) / 2U);
+    offset = mcu_ns - sens_ns;
+
+    track_envelope(offset, sens_ns);
+
+    /* Anything above the fastest readout seen so far is read latency: bus, scheduling, FIFO buffering. */
+    latency_ns = MAX(offset - expected_offset(sens_ns), 0);
+
+    /* The readout interval should match the sensor interval, the drift only adds a few ns per sample. */
+    jitter_ns = (mcu_ns - last_mcu_ns) - (sens_ns - last_sens_ns);
+    jitter_ns = (jitter_ns < 0) ? -jitter_ns : jitter_ns;
+
+    last_mcu_ns = mcu_ns;
+    last_sens_ns = sens_ns;
+
+    if (d_ticks > DROP_TICKS)
+    {
+        lost = ((d_ticks + (NOMINAL_TICKS / 2U)) / NOMINAL_TICKS) - 1U;
+    }
+
+    key = k_spin_lock(&timing_lock);
+
+    timing_stats.samples++;
+    timing_stats.dropped += lost;
+    timing_stats.drift_ppm = drift_valid ? drift_ppm : 0.0f;
+    timing_stats.latency[us_to_bin((uint32_t)(latency_ns / 1000))]++;
+    timing_stats.latency_max_us = MAX(timing_stats.latency_max_us, (uint32_t)(latency_ns / 1000));
+
+    if (!same_readout)
+    {
+        timing_stats.interval_jitter[us_to_bin((uint32_t)(jitter_ns / 1000))]++;
+    }
+
+    samples = timing_stats.samples;
+
+    k_spin_unlock(&timing_lock, key);
+
+    if ((samples % CONFIG_L3_TIMING_REPORT_SAMPLES) == 0)
+    {
+        k_work_submit(&report_work);
+    }
+}
+
+void imu_timing_get_stats(imu_timing_stats_t *stats)
+{
+    k_spinlock_key_t key = k_spin_lock(&timing_lock);
+
+    *stats = timing_stats;
+
+    k_spin_unlock(&timing_lock, key);
+}
+
+/*!
+ * @brief This internal function maps a duration in us to its histogram bin.
+ *
+ * @details
+ *      bin 0 holds everything below 1 us, bin i the range [2^(i-1), 2^i) us, the last bin is open ended.
+ */
+static uint8_t us_to_bin(uint32_t us)
+{
+    return (uint8_t)MIN(find_msb_set(us), IMU_TIMING_BINS - 1U);
+}
+
+/*!
+ * @brief This internal function tracks the lower envelope of the offset.
+ *
+ * @details
+ *      the offset between the readout and the sensor time is the read latency plus the slowly growing
+ *      difference of the two clocks. the latency is never negative, so the smallest offset of a window
+ *      of CONFIG_L3_TIMING_WINDOW samples is a sample read with (almost) no delay and sits on the clock
+ *      difference alone. the slope between the minima of two consecutive windows is the drift, every new
+ *      window moves the estimate 1/8 of the way towards its slope to smooth out the quantisation of the
+ *      MCU cycle counter.
+ */
+static void track_envelope(int64_t offset, int64_t sens_ns)
+{
+    float slope_ppm;
+
+    if ((win_count == 0) || (offset < win_min_offset))
+    {
+        win_min_offset = offset;
+        win_min_sens_ns = sens_ns;
+    }
+
+    win_count++;
+
+    if (win_count < CONFIG_L3_TIMING_WINDOW)
+    {
+        return;
+    }
+
+    win_count = 0;
+
+    if (base_valid && (win_min_sens_ns > base_sens_ns))
+    {
+        slope_ppm = ((float)(win_min_offset - base_offset) * 1e6f) / (float)(win_min_sens_ns - base_sens_ns);
+
+        if (drift_valid)
+        {
+            drift_ppm += (slope_ppm - drift_ppm) / (float)(1 << DRIFT_EMA_SHIFT);
+        }
+        else
+        {
+            drift_ppm = slope_ppm;
+            drift_valid = true;
+        }
+    }
+
+    base_offset = win_min_offset;
+    base_sens_ns = win_min_sens_ns;
+    base_valid = true;
+}
+
+/*!
+ * @brief This internal function returns the offset of a readout without any delay.
+ *
+ * @details
+ *      the drift line through the last window minimum once it exists, until then the smallest offset
+ *      seen in the first window.
+ */
+static int64_t expected_offset(int64_t sens_ns)
+{
+    if (!base_valid)
+    {
+        return win_min_offset;
+    }
+
+    if (!drift_valid)
+    {
+        return base_offset;
+    }
+
+    return base_offset + (int64_t)(drift_ppm * 1e-6f * (float)(sens_ns - base_sens_ns));
+}
+
+/*!
+ * @brief Work handler printing the statistics.
+ *
+ * @details
+ *      the report is printed from the system work queue, the reading context only submits the work item
+ *      and never waits for the console.
+ */
+static void report_handler(struct k_work *work)
+{
+    imu_timing_stats_t stats;
+
+    imu_timing_get_stats(&stats);
+
+    printk("timing: %u samples, %u dropped, drift %.1f ppm, max latency %u us\n\r",
+           stats.samples,
+           stats.dropped,
+           stats.drift_ppm,
+           stats.latency_max_us);
+    printk("timing: bins (us)  <1 1 2 4 8 16 32 64 128 256 512 1k 2k 4k 8k 16k+\n\r");
+    print_histogram("timing: interval  ", stats.interval_jitter);
+    print_histogram("timing: latency   ", stats.latency);
+}
+
+/*!
+ * @brief This internal function prints one histogram on a single line.
+ */
+static void print_histogram(const char *name, const uint32_t *bins)
+{
+    uint8_t i;
+
+    printk("%s", name);
+
+    for (i = 0; i < IMU_TIMING_BINS; i++)
+    {
+        printk(" %u", bins[i]);
+    }
+
+    printk("\n\r");
+}
@@ -0,0 +1,138 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   IMU sample timing statistics                                                                                |
+ * |    @file           :   imu_timing.h                                                                                                |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the drop detection, clock drift and jitter / latency histograms of the samples           |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_TIMING_H_
+#define IMU_TIMING_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type, it carries both timestamps
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * number of histogram bins, bin 0 counts values below 1 us, bin i (i >= 1) values in [2^(i-1), 2^i) us and the
+ * last bin everything above
+ */
+#define IMU_TIMING_BINS         (16U)
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @struct: imu_timing_stats_t
+ * @brief: timing of the samples, measured between the sensor time of each sample and the MCU cycle counter at its readout
+ */
+typedef struct {
+    uint32_t samples;                           /**< samples seen */
+    uint32_t dropped;                           /**< samples missing in the sequence of sensor times */
+    float drift_ppm;                            /**< rate of the MCU clock against the sensor clock, in ppm (0 until estimated) */
+    uint32_t latency_max_us;                    /**< largest read latency */
+    uint32_t interval_jitter[IMU_TIMING_BINS];  /**< |readout interval - sensor time interval| of consecutive samples */
+    uint32_t latency[IMU_TIMING_BINS];          /**< readout time - expected readout time from the sensor time */
+} imu_timing_stats_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       void imu_timing_update(const imu_sample_t *sample);
+ *  \b Description                              :       account one sample: drop detection from the gap of the sensor time, one step of the
+ *                                                      drift estimator and one entry in both histograms. a report is printed from the system
+ *                                                      work queue every CONFIG_L3_TIMING_REPORT_SAMPLES samples.
+ *  @param  sample [IN]                         :       the sample, with its 'sensor_time' and 'read_cycles'.
+ *  @note                                       :       only one context may call this function, the one that reads the samples (the poll or
+ *                                                      FIFO loop, the data-ready thread or the I2C completion thread). a handful of 64-bit
+ *                                                      operations, no division on the per-sample path except the drop count.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_timing_update(const imu_sample_t *sample);
+
+
+/**
+ *  \b function                                 :       void imu_timing_get_stats(imu_timing_stats_t *stats);
+ *  \b Description                              :       copy the counters, the drift estimate and the histograms.
+ *  @param  stats [OUT]                         :       receives the statistics.
+ *  @note                                       :       can be called from any thread, the copy is consistent.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_timing_get_stats(imu_timing_stats_t *stats);
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_TIMING_H_*/
@@ -0,0 +1,262 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include <errno.h>
+#include <string.h>
+
+// include the math library, for the Hann window and the square roots of the results
+#include <math.h>
+
+// include the CMSIS-DSP real FFT and the vector functions
+#include <arm_math.h>
+
+// include the accel scale of the configured range
+#include "imu_convert.h"
+
+#include "imu_vib.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                         |   Documentation Link
+ * =================================|=====================
+ * arm_rfft_fast_f32()              |   https://arm-software.github.io/CMSIS-DSP/latest/group__RealFFT.html
+ * arm_cmplx_mag_squared_f32()      |   https://arm-software.github.io/CMSIS-DSP/latest/group__cmplx__mag__squared.html
+ * arm_mult_f32() / arm_offset_f32()|   https://arm-software.github.io/CMSIS-DSP/latest/group__groupMath.html
+ * imu_convert_f32()                |   refer to 'imu_convert.h'
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Points of the FFT and bins of the one sided spectrum (the Nyquist bin is left out). */
+#define FFT_SIZE                (CONFIG_L3_VIB_FFT_SIZE)
+#define FFT_BINS                (CONFIG_L3_VIB_FFT_SIZE / 2U)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_L3_VIB_FFT_SIZE), "the FFT size has to be a power of 2");
+BUILD_ASSERT(CONFIG_L3_PROC_BATCH <= CONFIG_L3_VIB_FFT_SIZE, "a batch may complete at most one window");
+
+/*! Rate of the analysed samples. */
+#define SAMPLE_RATE_HZ          ((float)CONFIG_L3_IMU_ODR_HZ / (float)IMU_SAMPLE_DECIMATION)
+
+/*! Hann window: a sine of amplitude A gives |X| = A * N / 4, and the noise power is scaled by sum(w^2) = 3N / 8. */
+#define AMP_SCALE               (4.0f / (float)FFT_SIZE)
+#define POWER_SCALE             (2.0f / (0.375f * (float)FFT_SIZE * (float)FFT_SIZE))
+
+/*! g to mg. */
+#define G_TO_MG                 (1000.0f)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! Raw accel of the current window, one row per axis. */
+static int16_t window_raw[IMU_VIB_AXES][FFT_SIZE];
+static uint16_t window_fill;
+static uint32_t last_time;
+
+/*! Work buffers of one axis: time domain, packed complex spectrum and power per bin. */
+static float fft_in[FFT_SIZE];
+static float fft_out[FFT_SIZE];
+static float power[FFT_BINS];
+
+/*! Hann window, computed once. */
+static float hann[FFT_SIZE];
+
+static arm_rfft_fast_instance_f32 rfft;
+
+/*! Summary of the last window of every axis. */
+static imu_vib_result_t results[IMU_VIB_AXES];
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function computes the spectrum of one axis of the full window and summarises it.
+ *
+ *  @param[in]  raw      : Raw accel of the axis, FFT_SIZE values.
+ *  @param[out] result   : Summary of the spectrum.
+ */
+static void analyse_axis(const int16_t *raw, imu_vib_result_t *result);
+
+/*!
+ *  @brief This internal function finds the strongest local maxima of 'power'.
+ */
+static void find_peaks(imu_vib_result_t *result);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int imu_vib_init(void)
+{
+    uint16_t n;
+
+    if (arm_rfft_fast_init_f32(&rfft, FFT_SIZE) != ARM_MATH_SUCCESS)
+    {
+        return -EINVAL;
+    }
+
+    /* Periodic Hann window, the spectrum of a window repeats without a seam. */
+    for (n = 0; n < FFT_SIZE; n++)
+    {
+        hann[n] = 0.5f * (1.0f - cosf((2.0f * PI * (float)n) / (float)FFT_SIZE));
+    }
+
+    window_fill = 0;
+    memset(results, 0, sizeof(results));
+
+    return 0;
+}
+
+int imu_vib_update(const imu_sample_t *samples, uint16_t count)
+{
+    int ready = 0;
+    uint8_t axis;
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        /* A lost sample breaks the time base of the window, start a new one from this sample. */
+        if ((window_fill > 0) && ((uint32_t)(samples[i].sensor_time - last_time) > (IMU_SAMPLE_NOMINAL_TICKS + (IMU_SAMPLE_NOMINAL_TICKS / 2U))))
+        {
+            window_fill = 0;
+        }
+
+        last_time = samples[i].sensor_time;
+
+        window_raw[IMU_VIB_X][window_fill] = samples[i].acc_x;
+        window_raw[IMU_VIB_Y][window_fill] = samples[i].acc_y;
+        window_raw[IMU_VIB_Z][window_fill] = samples[i].acc_z;
+        window_fill++;
+
+        if (window_fill == FFT_SIZE)
+        {
+            for (axis = 0; axis < IMU_VIB_AXES; axis++)
+            {
+                analyse_axis(window_raw[axis], &results[axis]);
+                results[axis].sensor_time = last_time;
+            }
+
+            window_fill = 0;
+            ready = 1;
+        }
+    }
+
+    return ready;
+}
+
+void imu_vib_get_result(imu_vib_axis_t axis, imu_vib_result_t *result)
+{
+    if (axis >= IMU_VIB_AXES)
+    {
+        memset(result, 0, sizeof(*result));
+        return;
+    }
+
+    *result = results[axis];
+}
+
+/*!
+ * @brief This internal function computes the spectrum of one axis.
+ *
+ * @details
+ *      the mean (gravity and the offset of the sensor) is removed first, it would otherwise leak through
+ *      the window into the low bins. the real FFT packs the DC and Nyquist bins into fft_out[0] and
+ *      fft_out[1], the complex bins 1 .. N/2-1 follow. every band sums the power of its bins, with the
+ *      noise power of the Hann window taken out its square root is the RMS of the band.
+ */
+static void analyse_axis(const int16_t *raw, imu_vib_result_t *result)
+{
+    float mean = 0.0f;
+    float band_power[CONFIG_L3_VIB_BANDS] = { 0 };
+    float total = 0.0f;
+    uint16_t k;
+    uint8_t b;
+
+    imu_convert_f32(&imu_convert_acc_scale, raw, fft_in, FFT_SIZE);
+
+    for (k = 0; k < FFT_SIZE; k++)
+    {
+        mean += fft_in[k];
+    }
+
+    arm_offset_f32(fft_in, -mean / (float)FFT_SIZE, fft_in, FFT_SIZE);
+    arm_mult_f32(fft_in, hann, fft_in, FFT_SIZE);
+
+    arm_rfft_fast_f32(&rfft, fft_in, fft_out, 0);
+
+    power[0] = 0.0f;
+    arm_cmplx_mag_squared_f32(&fft_out[2], &power[1], FFT_BINS - 1U);
+
+    for (k = 1; k < FFT_BINS; k++)
+    {
+        band_power[((uint32_t)k * CONFIG_L3_VIB_BANDS) / FFT_BINS] += power[k];
+        total += power[k];
+    }
+
+    for (b = 0; b < CONFIG_L3_VIB_BANDS; b++)
+    {
+        result->band_mg[b] = sqrtf(band_power[b] * POWER_SCALE) * G_TO_MG;
+    }
+
+    result->rms_mg = sqrtf(total * POWER_SCALE) * G_TO_MG;
+
+    find_peaks(result);
+}
+
+/*!
+ * @brief This internal function finds the strongest local maxima of the spectrum.
+ *
+ * @details
+ *      the peaks are kept sorted by insertion, strongest first. the frequency and the amplitude of a peak
+ *      come from a parabola through the magnitudes of the bin and its two neighbours, that takes most of
+ *      the scalloping loss of the window out.
+ */
+static void find_peaks(imu_vib_result_t *result)
+{
+    uint16_t bins[CONFIG_L3_VIB_PEAKS];
+    uint8_t found = 0;
+    uint8_t i, j;
+    uint16_t k;
+    float a, b, c, p;
+
+    for (k = 2; k < (FFT_BINS - 1U); k++)
+    {
+        if ((power[k] <= power[k - 1U]) || (power[k] < power[k + 1U]))
+        {
+            continue;
+        }
+
+        /* Position of this peak among the strongest so far, a weaker one than all the kept ones is dropped. */
+        for (i = 0; (i < found) && (power[bins[i]] >= power[k]); i++)
+        {
+        }
+
+        if (i >= CONFIG_L3_VIB_PEAKS)
+        {
+            continue;
+        }
+
+        for (j = MIN(found, CONFIG_L3_VIB_PEAKS - 1U); j > i; j--)
+        {
+            bins[j] = bins[j - 1U];
+        }
+
+        bins[i] = k;
+        found = MIN(found + 1U, CONFIG_L3_VIB_PEAKS);
+    }
+
+    for (i = 0; i < found; i++)
+    {
+        a = sqrtf(power[bins[i] - 1U]);
+        b = sqrtf(power[bins[i]]);
+        c = sqrtf(power[bins[i] + 1U]);
+        p = 0.5f * (a - c) / (a - (2.0f * b) + c);
+
+        result->peaks[i].freq_hz = ((float)bins[i] + p) * SAMPLE_RATE_HZ / (float)FFT_SIZE;
+        result->peaks[i].amp_mg = (b - (0.25f * (a - c) * p)) * AMP_SCALE * G_TO_MG;
+    }
+
+    result->peak_count = found;
+}
@@ -0,0 +1,165 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   Accelerometer vibration spectrum                                                                            |
+ * |    @file           :   imu_vib.h                                                                                                   |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides the FFT vibration analysis: peaks and band energies of every accel axis per window       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef IMU_VIB_H_
+#define IMU_VIB_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type the spectra are computed from
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/**
+ * @brief: the accel axes a spectrum is computed for
+ */
+typedef enum {
+    IMU_VIB_X = 0,              /**< accel x-axis */
+    IMU_VIB_Y,                  /**< accel y-axis */
+    IMU_VIB_Z,                  /**< accel z-axis */
+    IMU_VIB_AXES                /**< number of axes */
+} imu_vib_axis_t;
+
+/**
+ * @struct: imu_vib_peak_t
+ * @brief: one peak of a spectrum
+ */
+typedef struct {
+    float freq_hz;              /**< frequency, interpolated between the bins */
+    float amp_mg;               /**< amplitude of the sine at that frequency */
+} imu_vib_peak_t;
+
+/**
+ * @struct: imu_vib_result_t
+ * @brief: summary of the spectrum of one axis over one window, everything the host needs instead of the raw samples
+ */
+typedef struct {
+    uint32_t sensor_time;                           /**< sensor time of the last sample of the window */
+    float rms_mg;                                   /**< RMS of the vibration (without the DC part) */
+    uint8_t peak_count;                             /**< valid entries in 'peaks', strongest first */
+    imu_vib_peak_t peaks[CONFIG_L3_VIB_PEAKS];      /**< strongest local maxima of the spectrum */
+    float band_mg[CONFIG_L3_VIB_BANDS];             /**< RMS of equal width bands from 0 Hz to the Nyquist frequency */
+} imu_vib_result_t;
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int imu_vib_init(void);
+ *  \b Description                              :       set up the real FFT of CONFIG_L3_VIB_FFT_SIZE points and its Hann window.
+ *  \b PRE-CONDITION                            :       imu_convert_set_accel_range() succeeded.
+ *  \b POST-CONDITION                           :       imu_vib_update() can be used.
+ *  @return                                     :       0 on success, -EINVAL if CMSIS-DSP does not support the FFT size.
+ *  @see                                        :       int imu_vib_update(const imu_sample_t *samples, uint16_t count);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_vib_init(void);
+
+
+/**
+ *  \b function                                 :       int imu_vib_update(const imu_sample_t *samples, uint16_t count);
+ *  \b Description                              :       append the accel of the samples to the current window, once it is full compute the
+ *                                                      spectrum of every axis: DC removed, Hann window, real FFT, peaks and band energies.
+ *  @param  samples [IN]                        :       raw samples, oldest first.
+ *  @param  count [IN]                          :       number of samples, at most CONFIG_L3_VIB_FFT_SIZE.
+ *  @note                                       :       a gap in the sensor time (a lost sample) restarts the window, a spectrum is never taken
+ *                                                      over a broken time base. not reentrant, one caller only.
+ *  \b PRE-CONDITION                            :       imu_vib_init() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       1 if a new window was analysed (read it with imu_vib_get_result()), 0 otherwise.
+ *  @see                                        :       void imu_vib_get_result(imu_vib_axis_t axis, imu_vib_result_t *result);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int imu_vib_update(const imu_sample_t *samples, uint16_t count);
+
+
+/**
+ *  \b function                                 :       void imu_vib_get_result(imu_vib_axis_t axis, imu_vib_result_t *result);
+ *  \b Description                              :       read the summary of the last analysed window of one axis.
+ *  @param  axis [IN]                           :       the accel axis.
+ *  @param  result [OUT]                        :       receives the summary, all zero before the first window or for an invalid axis.
+ *  @note                                       :       same context as imu_vib_update().
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       None.
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+void imu_vib_get_result(imu_vib_axis_t axis, imu_vib_result_t *result);
+
+
+/*** End of File **************************************************************/
+
+#endif /*IMU_VIB_H_*/
@@ -12,8 +12,106 @@
 // include bmi323 API function haeders
 #include <bmi323.h>
 
-// include the math library
-#include <math.h>
+// include the unit conversion (scale factors are computed once per range)
+#include "imu_convert.h"
+
+// include the raw sample type, it carries the sensor time and the MCU cycle counter of the readout
+#include "imu_sample.h"
+
+#if defined(CONFIG_BMI323_SENSORAPI)
+// include the BMI323 sensor driver, it owns the bus and the SensorAPI instance
+#include "bmi323_sensorapi.h"
+#endif
+
+#if defined(CONFIG_L3_BUS_BENCH)
+// include the throughput benchmark of the sensor bus
+#include "bmi323_bus_bench.h"
+#endif
+
+#if defined(CONFIG_L3_TELEMETRY)
+// include the binary telemetry channel, it replaces the per-sample printk
+#include "telemetry.h"
+#endif
+
+#if defined(CONFIG_L3_PROC_THREAD)
+// include the processing thread, the acquisition only queues the samples for it
+#include "imu_proc.h"
+#endif
+
+#if defined(CONFIG_L3_FILTER)
+// include the low-pass and decimation stage, it runs in the processing thread ahead of everything else
+#include "imu_filter.h"
+#endif
+
+#if defined(CONFIG_L3_AHRS)
+// include the orientation filter, it runs in the processing thread
+#include "imu_ahrs.h"
+#endif
+
+#if defined(CONFIG_L3_VIB)
+// include the vibration spectrum, it runs in the processing thread
+#include "imu_vib.h"
+#endif
+
+#if defined(CONFIG_L3_CLASSIFY)
+// include the activity classifier, it runs in the processing thread
+#include "imu_classify.h"
+#endif
+
+#if defined(CONFIG_L3_STATS)
+// include the window statistics, they run in the processing thread
+#include "imu_stats.h"
+#endif
+
+#if defined(CONFIG_L3_CALIB)
+// include the online calibration, it corrects the raw samples in the acquisition context
+#include "imu_calib.h"
+#endif
+
+#if defined(CONFIG_L3_LOG)
+// include the circular flash log, the acquisition only codes the samples into its blocks
+#include "imu_log.h"
+#endif
+
+#if defined(CONFIG_L3_TIMING)
+// include the drop, drift and jitter statistics of the samples
+#include "imu_timing.h"
+#endif
+
+#if defined(CONFIG_L3_WARM_BOOT)
+// include the warm boot check, and the CRC-32 the configuration of this build is identified with
+#include "bmi323_warm.h"
+#include <zephyr/sys/crc.h>
+#endif
+
+// include the cycle counter probes of the loop stages, they compile to nothing without CONFIG_L3_PROF
+#include "imu_prof.h"
+
+#if defined(CONFIG_L3_ACQ_FIFO)
+// include the FIFO-batched acquisition
+#include "bmi323_fifo.h"
+#elif defined(CONFIG_L3_ACQ_DRDY)
+// include the interrupt driven acquisition
+#include "bmi323_drdy.h"
+#elif defined(CONFIG_L3_ACQ_SPLIT)
+// include the independent accel and gyro streams
+#include "bmi323_split.h"
+#elif defined(CONFIG_L3_ACQ_MOTION)
+// include the event driven mode of the feature engine
+#include "bmi323_motion.h"
+#elif defined(CONFIG_L3_ACQ_DUAL)
+// include the drain of both FIFOs and the fusion of their frames
+#include "bmi323_fifo.h"
+#include "bmi323_dual.h"
+#elif defined(CONFIG_L3_ACQ_REPLAY)
+// include the replay of a recording, and posix_exit() to end the run with the result of the golden compare
+#include "imu_replay.h"
+#include <posix_board_if.h>
+#elif defined(CONFIG_L3_ACQ_STREAM)
+// include the sensor streaming API and the RTIO context the stream buffers are taken from
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio.h>
+#endif
 
 // this code was taken from the '<BMI323_SensorAPI/examples/accel/accel.c>' example
 
@@ -23,50 +121,223 @@
 /*! Earth's gravity in m/s^2 */
 #define GRAVITY_EARTH  (9.80665f)
 
+/*! Output data rate of the accel, selected in 'prj.conf' */
+#if (CONFIG_L3_IMU_ODR_HZ == 25)
+#define ACC_ODR        BMI3_ACC_ODR_25HZ
+#elif (CONFIG_L3_IMU_ODR_HZ == 50)
+#define ACC_ODR        BMI3_ACC_ODR_50HZ
+#elif (CONFIG_L3_IMU_ODR_HZ == 200)
+#define ACC_ODR        BMI3_ACC_ODR_200HZ
+#elif (CONFIG_L3_IMU_ODR_HZ == 400)
+#define ACC_ODR        BMI3_ACC_ODR_400HZ
+#elif (CONFIG_L3_IMU_ODR_HZ == 800)
+#define ACC_ODR        BMI3_ACC_ODR_800HZ
+#elif (CONFIG_L3_IMU_ODR_HZ == 1600)
+#define ACC_ODR        BMI3_ACC_ODR_1600HZ
+#elif (CONFIG_L3_IMU_ODR_HZ == 3200)
+#define ACC_ODR        BMI3_ACC_ODR_3200HZ
+#elif (CONFIG_L3_IMU_ODR_HZ == 6400)
+#define ACC_ODR        BMI3_ACC_ODR_6400HZ
+#else
+#define ACC_ODR        BMI3_ACC_ODR_100HZ
+#endif
+
+/*! Output data rate of the gyro, the accel ODR unless the streams are split (CONFIG_L3_GYR_ODR) */
+#if (CONFIG_L3_GYR_ODR_HZ == 25)
+#define GYR_ODR        BMI3_GYR_ODR_25HZ
+#elif (CONFIG_L3_GYR_ODR_HZ == 50)
+#define GYR_ODR        BMI3_GYR_ODR_50HZ
+#elif (CONFIG_L3_GYR_ODR_HZ == 200)
+#define GYR_ODR        BMI3_GYR_ODR_200HZ
+#elif (CONFIG_L3_GYR_ODR_HZ == 400)
+#define GYR_ODR        BMI3_GYR_ODR_400HZ
+#elif (CONFIG_L3_GYR_ODR_HZ == 800)
+#define GYR_ODR        BMI3_GYR_ODR_800HZ
+#elif (CONFIG_L3_GYR_ODR_HZ == 1600)
+#define GYR_ODR        BMI3_GYR_ODR_1600HZ
+#elif (CONFIG_L3_GYR_ODR_HZ == 3200)
+#define GYR_ODR        BMI3_GYR_ODR_3200HZ
+#elif (CONFIG_L3_GYR_ODR_HZ == 6400)
+#define GYR_ODR        BMI3_GYR_ODR_6400HZ
+#else
+#define GYR_ODR        BMI3_GYR_ODR_100HZ
+#endif
+
+#if defined(CONFIG_L3_ACQ_FIFO) || defined(CONFIG_L3_ACQ_DUAL)
+/*! The FIFO frames only carry the lower 16 bits of the sensor time, a watermark period has to be shorter than one wrap (65536 ticks) */
+BUILD_ASSERT(((CONFIG_L3_FIFO_WATERMARK_FRAMES * 25600U) / CONFIG_L3_IMU_ODR_HZ) < 65536U,
+             "CONFIG_L3_FIFO_WATERMARK_FRAMES spans a wrap of the 16-bit FIFO sensor time at CONFIG_L3_IMU_ODR_HZ");
+#endif
+
+#if defined(CONFIG_L3_ACQ_FIFO)
+/*! Check the watermark twice per watermark period so the FIFO never runs full between two checks */
+#define FIFO_POLL_PERIOD_MS  MAX(1, (CONFIG_L3_FIFO_WATERMARK_FRAMES * 1000) / (2 * CONFIG_L3_IMU_ODR_HZ))
+#endif
+
+#if defined(CONFIG_L3_ACQ_DUAL)
+/*! Both FIFOs are read once per watermark period, the watermark interrupts are not used */
+#define DUAL_PERIOD_US       ((CONFIG_L3_FIFO_WATERMARK_FRAMES * 1000000ULL) / CONFIG_L3_IMU_ODR_HZ)
+
+/*! Clock of the I2C bus both sensors share */
+#define DUAL_BUS_HZ          DT_PROP(DT_BUS(DT_NODELABEL(bmi323)), clock_frequency)
+
+/*! Bytes around the data of every read: address + W, register, address + R and the 2 dummy bytes */
+#define DUAL_READ_BYTES      (5U)
+
+/*!
+ * Bytes of one drain sequence on the bus: both sensor times (4 bytes each), then per sensor the fill
+ * level (2 bytes) and a watermark of 14 byte frames in chunks of BMI323_FIFO_CHUNK_FRAMES
+ */
+#define DUAL_BUS_BYTES       ((2U * (4U + DUAL_READ_BYTES)) + \
+                              (2U * ((2U + DUAL_READ_BYTES) + (CONFIG_L3_FIFO_WATERMARK_FRAMES * BMI323_FIFO_FRAME_SIZE_BYTES) + \
+                                     (DIV_ROUND_UP(CONFIG_L3_FIFO_WATERMARK_FRAMES, BMI323_FIFO_CHUNK_FRAMES) * DUAL_READ_BYTES))))
+
+/*! Every byte takes 9 clocks (8 bits and the acknowledge) */
+#define DUAL_BUS_US          ((DUAL_BUS_BYTES * 9ULL * 1000000ULL) / DUAL_BUS_HZ)
+
+BUILD_ASSERT(DUAL_BUS_US < DUAL_PERIOD_US,
+             "the chunked drains of both sensors do not fit one watermark period on this bus, lower CONFIG_L3_IMU_ODR_HZ");
+
+/*! The frames, the overruns and the bus occupancy of both sensors are printed every few seconds */
+#define DUAL_STATS_PERIOD_MS (5000)
+#endif
+
+#if defined(CONFIG_L3_ACQ_STREAM)
+/*! Memory pool of the stream buffers: two watermark batches of 14 byte frames plus their headers */
+#define STREAM_BLOCK_SIZE    (64U)
+#define STREAM_BLOCK_COUNT   (((2U * CONFIG_BMI323_SENSORAPI_FIFO_WATERMARK_FRAMES * 14U) / STREAM_BLOCK_SIZE) + 2U)
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+// stream request of the 'bmi323' node, completed by the driver at every FIFO watermark
+SENSOR_DT_STREAM_IODEV(stream_iodev, DT_NODELABEL(bmi323), {SENSOR_TRIG_FIFO_WATERMARK, SENSOR_STREAM_DATA_INCLUDE});
+
+// RTIO context the driver takes the stream buffers from
+RTIO_DEFINE_WITH_MEMPOOL(stream_ctx, 4, 4, STREAM_BLOCK_COUNT, STREAM_BLOCK_SIZE, sizeof(void *));
+#endif
+
 /******************************************************************************/
 /*!           Static Function Declaration                                     */
 
+/*!
+ *  @brief This internal API fills the accel configuration this application runs the sensor with.
+ *
+ *  @param[out] config   : Configuration, only its 'cfg.acc' part is written.
+ */
+static void fill_accel_config(struct bmi3_sens_config *config);
+
+/*!
+ *  @brief This internal API fills the gyro configuration this application runs the sensor with.
+ *
+ *  @param[out] config   : Configuration, only its 'cfg.gyr' part is written.
+ */
+static void fill_gyro_config(struct bmi3_sens_config *config);
+
 /*!
  *  @brief This internal API is used to set configurations for accel.
  *
  *  @param[in] dev       : Structure instance of bmi3_dev.
+ *  @param[in] keep      : The sensor already runs this configuration, only the conversion scale is computed.
  *
  *  @return Status of execution.
  */
-static int8_t set_accel_config(struct bmi3_dev *dev);
+static int8_t set_accel_config(struct bmi3_dev *dev, bool keep);
 
 /*!
- *  @brief This internal function converts lsb to meter per second squared for 16 bit accelerometer for
- *  range 2G, 4G, 8G or 16G.
+ *  @brief This internal API is used to set configurations for gyro.
  *
- *  @param[in] val       : LSB from each axis.
- *  @param[in] g_range   : Gravity range.
- *  @param[in] bit_width : Resolution for accel.
+ *  @param[in] dev       : Structure instance of bmi3_dev.
+ *  @param[in] keep      : The sensor already runs this configuration, only the conversion scale is computed.
  *
- *  @return Accel values in meter per second squared.
+ *  @return Status of execution.
  */
-static float lsb_to_g(int16_t val, int8_t g_range, uint8_t bit_width);
+static int8_t set_gyro_config(struct bmi3_dev *dev, bool keep);
 
+#if defined(CONFIG_L3_WARM_BOOT)
 /*!
- *  @brief This internal API is used to set configurations for gyro.
+ *  @brief This internal API computes the CRC-32 of the accel and gyro configuration of this build.
+ *
+ *  @return The CRC-32, it changes with any setting of fill_accel_config() or fill_gyro_config().
+ */
+static uint32_t sensor_config_crc(void);
+#endif
+
+#if defined(CONFIG_L3_PROC_THREAD)
+/*!
+ *  @brief This internal API converts and prints (or sends) a batch of samples, it runs in the processing thread.
+ *
+ *  @param[in] samples   : Samples taken out of the ring, oldest first.
+ *  @param[in] count     : Number of samples.
+ */
+static void process_samples(const imu_sample_t *samples, uint16_t count);
+#endif
+
+#if defined(CONFIG_L3_ACQ_FIFO)
+/*!
+ *  @brief This internal API drains the FIFO every time its watermark is reached and prints a summary of each batch.
  *
  *  @param[in] dev       : Structure instance of bmi3_dev.
+ */
+static void run_fifo_loop(struct bmi3_dev *dev);
+#elif defined(CONFIG_L3_ACQ_DRDY)
+/*!
+ *  @brief This internal API starts the data-ready acquisition thread and prints every sample it reads.
  *
- *  @return Status of execution.
+ *  @param[in] dev       : Structure instance of bmi3_dev.
+ */
+static void run_drdy_loop(struct bmi3_dev *dev);
+#elif defined(CONFIG_L3_ACQ_SPLIT)
+/*!
+ *  @brief This internal API starts the independent accel and gyro streams and prints a summary of each.
+ *
+ *  @param[in] dev       : Structure instance of bmi3_dev.
+ */
+static void run_split_loop(struct bmi3_dev *dev);
+#elif defined(CONFIG_L3_ACQ_MOTION)
+/*!
+ *  @brief This internal API hands the detection to the feature engine and prints the counters at every event.
+ *
+ *  @param[in] dev       : Structure instance of bmi3_dev.
+ */
+static void run_motion_loop(struct bmi3_dev *dev);
+#elif defined(CONFIG_L3_ACQ_DUAL)
+/*!
+ *  @brief This internal API configures the second sensor, drains both FIFOs every watermark period and prints the fused samples.
+ *
+ *  @param[in] dev       : Structure instance of bmi3_dev of the first sensor.
  */
-static int8_t set_gyro_config(struct bmi3_dev *dev);
+static void run_dual_loop(struct bmi3_dev *dev);
+#elif defined(CONFIG_L3_ACQ_REPLAY)
+/*!
+ *  @brief This internal API feeds a recording through the processing chain once, checks the output and exits.
+ */
+static void run_replay_loop(void);
+#elif defined(CONFIG_L3_ACQ_STREAM)
+/*!
+ *  @brief This internal API starts a FIFO watermark stream through the sensor driver and prints a summary of each batch.
+ *
+ *  @param[in] sensor    : The BMI323 device.
+ */
+static void run_stream_loop(const struct device *sensor);
 
 /*!
- *  @brief This function converts lsb to degree per second for 16 bit gyro at
- *  range 125, 250, 500, 1000 or 2000dps.
+ *  @brief This internal API converts a q31_t value of the sensor decoder to float.
  *
- *  @param[in] val       : LSB from each axis.
- *  @param[in] dps       : Degree per second.
- *  @param[in] bit_width : Resolution for gyro.
+ *  @param[in] value     : Decoded value.
+ *  @param[in] shift     : Shift of the decoded data.
  *
- *  @return Degree per second.
+ *  @return The value in m/s^2 or rad/s.
  */
-static float lsb_to_dps(int16_t val, float dps, uint8_t bit_width);
+static float q31_to_float(q31_t value, int8_t shift);
+#else
+/*!
+ *  @brief This internal API polls the data-ready status and reads and prints one accel and gyro sample at a time.
+ *
+ *  @param[in] dev       : Structure instance of bmi3_dev.
+ */
+static void run_poll_loop(struct bmi3_dev *dev);
+#endif
 
 
 /******************************************************************************/
@@ -78,288 +349,1478 @@ static float lsb_to_dps(int16_t val, float dps, uint8_t bit_width);
  */
 int main(void)
 {
-    /* Sensor initialization configuration. */
-    struct bmi3_dev dev = { 0 };
-
     /* Status of API are returned to this variable. */
     int8_t rslt;
 
-    /* Create an instance of sensor data structure. */
-    struct bmi3_sensor_data acc_sensor_data = { 0 };
-    struct bmi3_sensor_data gyr_sensor_data = { 0 };
-
-    /* Initialize the interrupt status of accel. */
-    uint16_t sens_status = 0;
-
-    // dummy variable for printing current line
-    uint8_t indx = 0;
+#if defined(CONFIG_BMI323_SENSORAPI)
+    /* The sensor driver already set up the bus and ran bmi323_init() when the kernel started. */
+    const struct device *sensor = DEVICE_DT_GET(DT_NODELABEL(bmi323));
 
-    /** acceleration values in m/s^2 */
-    float acc_x = 0, acc_y = 0, acc_z = 0;
+    /* Sensor instance of the SensorAPI, owned by the driver. */
+    struct bmi3_dev *dev;
 
-    /** gyroscope values in degree/s */
-    float gyr_x = 0, gyr_y = 0, gyr_z = 0;
+    if (!device_is_ready(sensor))
+    {
+        printk("BMI323 device not ready\n\r");
+        return 0;
+    }
 
-    /* Select both accel and gyro sensor. */
-    acc_sensor_data.type = BMI323_ACCEL;
-    gyr_sensor_data.type = BMI323_GYRO;
+    dev = bmi323_sensorapi_get_bmi3_dev(sensor);
+    rslt = BMI323_OK;
+#else
+    /* Sensor initialization configuration. */
+    struct bmi3_dev bmi = { 0 };
+    struct bmi3_dev *dev = &bmi;
 
     /* Function to select interface between SPI and I2C, according to that the device structure gets updated.
      * Interface reference is given as a parameter
      * For I2C : BMI3_I2C_INTF
      * For SPI : BMI3_SPI_INTF
      */
-    rslt = bmi3_interface_init(&dev, BMI3_I2C_INTF);
+    rslt = bmi3_interface_init(dev, BMI3_I2C_INTF);
     bmi3_error_codes_print_result("bmi3_interface_init", rslt);
 
     /* Initialize bmi323. */
-    rslt = bmi323_init(&dev);
+    rslt = bmi323_init(dev);
     bmi3_error_codes_print_result("bmi323_init", rslt);
+#endif
 
     if (rslt == BMI323_OK)
     {
+        /* The sensor kept the configuration of this build over an MCU-only reset, it is not applied again. */
+        bool warm = false;
+
+#if defined(CONFIG_L3_WARM_BOOT)
+        warm = bmi323_warm_check(dev, sensor_config_crc());
+
+        /* The driver left the sensor as it found it, anything else than a warm boot starts from a reset. */
+        if (!warm && (bmi323_sensorapi_reset(sensor) != 0))
+        {
+            printk("bmi323_sensorapi_reset failed\n\r");
+            return 0;
+        }
+#endif
+
         /* Accel configuration settings. */
-        rslt = set_accel_config(&dev);
+        rslt = set_accel_config(dev, warm);
         bmi3_error_codes_print_result("accel config set", rslt);
 
         /* Gyroscope configuration settings. */
-        rslt = set_gyro_config(&dev);
+        rslt = set_gyro_config(dev, warm);
+
+#if defined(CONFIG_L3_WARM_BOOT)
+        if (!warm && (rslt == BMI323_OK) && (bmi323_warm_save(dev, sensor_config_crc()) != 0))
+        {
+            printk("bmi323_warm_save failed, the next boot is a cold one\n\r");
+        }
+#endif
         
 
         if (rslt == BMI323_OK)
         {
+#if defined(CONFIG_L3_CONVERT_BENCH)
+            imu_convert_bench_run();
+#endif
+
+#if defined(CONFIG_L3_BUS_BENCH)
+            bmi323_bus_bench_run(dev);
+#endif
+
+#if defined(CONFIG_L3_CALIB)
+            /* A calibration kept from the last run corrects the samples right away, a failed load only costs the warm-up. */
+            if (imu_calib_init() != 0)
+            {
+                printk("imu_calib_init failed, starting uncalibrated\n\r");
+            }
+            else
+            {
+                imu_calib_t calib;
+
+                imu_calib_get(&calib);
+
+                if (calib.loaded)
+                {
+                    printk("calib: restored gyro bias %d %d %d LSB, accel offset %d %d %d LSB\n\r",
+                           calib.gyr_bias[0], calib.gyr_bias[1], calib.gyr_bias[2],
+                           calib.acc_offset[0], calib.acc_offset[1], calib.acc_offset[2]);
+                }
+                else
+                {
+                    printk("calib: nothing stored, the gyro is corrected once the sensor was still for %u samples\n\r",
+                           CONFIG_L3_CALIB_WINDOW);
+                }
+            }
+#endif
+
+#if defined(CONFIG_L3_LOG)
+            if (imu_log_init() != 0)
+            {
+                printk("imu_log_init failed\n\r");
+                return 0;
+            }
+
+#if defined(CONFIG_L3_LOG_DUMP_AT_BOOT)
+            /* The recording of the previous runs, before anything new is written. */
+            imu_log_dump();
+#endif
+
+#if defined(CONFIG_L3_LOG_CLEAR_AT_BOOT)
+            imu_log_clear();
+#endif
+
+#if defined(CONFIG_L3_LOG_BENCH)
+            imu_log_bench_run();
+#endif
+
+            if (imu_log_start() != 0)
+            {
+                printk("imu_log_start failed\n\r");
+                return 0;
+            }
+#endif
+
+#if defined(CONFIG_L3_TELEMETRY)
+            if (telemetry_init() != 0)
+            {
+                printk("telemetry_init failed\n\r");
+                return 0;
+            }
+#endif
+
+#if defined(CONFIG_L3_AHRS)
+            if (imu_ahrs_init() != 0)
+            {
+                printk("imu_ahrs_init failed\n\r");
+                return 0;
+            }
+
+#if defined(CONFIG_L3_AHRS_BENCH)
+            imu_ahrs_bench_run();
+#endif
+#endif
+
+#if defined(CONFIG_L3_VIB)
+            if (imu_vib_init() != 0)
+            {
+                printk("imu_vib_init failed\n\r");
+                return 0;
+            }
+#endif
+
+#if defined(CONFIG_L3_CLASSIFY)
+            if (imu_classify_init() != 0)
+            {
+                printk("imu_classify_init failed\n\r");
+                return 0;
+            }
+
+#if defined(CONFIG_L3_CLASSIFY_BENCH)
+            imu_classify_bench_run();
+#endif
+#endif
+
+#if defined(CONFIG_L3_STATS)
+            imu_stats_init();
+#endif
+
+#if defined(CONFIG_L3_PROC_THREAD)
+#if defined(CONFIG_L3_AHRS) && !defined(CONFIG_L3_TELEMETRY)
+            printk("\n\r");
+            printk("----------------------------------------------------------------------------------\n\r");
+            printk("Batch, Sensor_Time, Q_W, Q_X, Q_Y, Q_Z, Roll, Pitch, Yaw (deg), Ring_Max, Ring_Overruns\n\r");
+            printk("----------------------------------------------------------------------------------\n\r");
+#elif defined(CONFIG_L3_VIB)
             printk("\n\r");
             printk("----------------------------------------------------------------------------------\n\r");
-            printk("Data set, Acc_Raw_X, Acc_Raw_Y, Acc_Raw_Z, Acc_g_X, Acc_g_Y, Acc_g_Z\n\r");
-            printk("Data set, Gyr_Raw_X, Gyr_Raw_Y, Gyr_Raw_Z, Gyr_dps_X, Gyr_dps_Y, Gyr_dps_Z\n\r");
+            printk("Window, Axis, Sensor_Time, RMS (mg), Peaks (Hz:mg), Bands (mg RMS, 0 Hz to Nyquist)\n\r");
             printk("----------------------------------------------------------------------------------\n\r");
+#elif defined(CONFIG_L3_CLASSIFY)
+            printk("\n\r");
+            printk("----------------------------------------------------------------------------------\n\r");
+            printk("Window, Sensor_Time, Class, Confidence (%%)\n\r");
+            printk("----------------------------------------------------------------------------------\n\r");
+#elif defined(CONFIG_L3_STATS) && !defined(CONFIG_L3_TELEMETRY)
+            printk("\n\r");
+            printk("----------------------------------------------------------------------------------\n\r");
+            printk("Window, First_Time, Last_Time, Samples, Cycles/Sample, Max_Block_Cycles\n\r");
+            printk("Window, Axis, Mean, Std, RMS, Min, Max (raw LSB)\n\r");
+            printk("----------------------------------------------------------------------------------\n\r");
+#elif !defined(CONFIG_L3_TELEMETRY) && !defined(CONFIG_L3_ACQ_REPLAY)
+            printk("\n\r");
+            printk("----------------------------------------------------------------------------------\n\r");
+            printk("Data set, Sensor_Time, Acc_Raw_X, Acc_Raw_Y, Acc_Raw_Z, Acc_g_X, Acc_g_Y, Acc_g_Z\n\r");
+            printk("Data set, Ring_Max, Ring_Overruns, Gyr_Raw_X, Gyr_Raw_Y, Gyr_Raw_Z, Gyr_dps_X, Gyr_dps_Y, Gyr_dps_Z\n\r");
+            printk("----------------------------------------------------------------------------------\n\r");
+#endif
+
+#if defined(CONFIG_L3_FILTER)
+            if (imu_filter_init(process_samples) != 0)
+            {
+                printk("imu_filter_init failed\n\r");
+                return 0;
+            }
+#endif
+
+            /* From here on the acquisition only queues the samples, the conversion and the output run in this thread. */
+#if defined(CONFIG_L3_FILTER)
+            /* The raw samples go through the filter first, only the decimated blocks reach process_samples(). */
+            if (imu_proc_start(imu_filter_update) != 0)
+#else
+            if (imu_proc_start(process_samples) != 0)
+#endif
+            {
+                printk("imu_proc_start failed\n\r");
+                return 0;
+            }
+#endif
+
+#if defined(CONFIG_L3_PROF)
+            /* Started after the benchmarks, they stop the timing functions when they are done. */
+            imu_prof_init();
+#endif
+
+#if defined(CONFIG_L3_ACQ_FIFO)
+            run_fifo_loop(dev);
+#elif defined(CONFIG_L3_ACQ_DRDY)
+            run_drdy_loop(dev);
+#elif defined(CONFIG_L3_ACQ_SPLIT)
+            run_split_loop(dev);
+#elif defined(CONFIG_L3_ACQ_MOTION)
+            run_motion_loop(dev);
+#elif defined(CONFIG_L3_ACQ_DUAL)
+            run_dual_loop(dev);
+#elif defined(CONFIG_L3_ACQ_REPLAY)
+            run_replay_loop();
+#elif defined(CONFIG_L3_ACQ_STREAM)
+            run_stream_loop(sensor);
+#else
+            run_poll_loop(dev);
+#endif
+
+#if defined(CONFIG_L3_TELEMETRY)
+            /* The acquisition stopped, the samples still waiting in a delta packet go out now. */
+            telemetry_flush();
+#endif
+        }
+    }
+
+    return 0;
+}
+
+#if defined(CONFIG_L3_ACQ_FIFO)
+/*!
+ * @brief This internal API drains the FIFO every time its watermark is reached.
+ *
+ * @details
+ *      instead of three I2C transactions per sample (status, accel and gyro), the sensor collects
+ *      'CONFIG_L3_FIFO_WATERMARK_FRAMES' frames on its own and we read all of them in a few chunked bursts.
+ *      the watermark bit of the INT1 status is polled here, the MCU sleeps in between.
+ */
+static void run_fifo_loop(struct bmi3_dev *dev)
+{
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    /* Samples parsed from one FIFO burst, static to keep them off the main stack. */
+    static imu_sample_t samples[BMI323_FIFO_MAX_FRAMES];
+
+    /* Number of valid entries in 'samples'. */
+    uint16_t count = 0;
+
+    /* Interrupt status of INT1, the FIFO watermark is mapped to it. */
+    uint16_t int_status = 0;
+
+    // dummy variable for printing current batch
+    uint32_t batch = 0;
 
+    /* Sensor time and overruns of the FIFO between two bursts. */
+    static bmi323_fifo_t fifo;
 
-            // infinite loop
-            while (1)
+    rslt = bmi323_fifo_init(&fifo, CONFIG_L3_FIFO_WATERMARK_FRAMES, dev);
+    bmi3_error_codes_print_result("bmi323_fifo_init", rslt);
+
+    if (rslt != BMI323_OK)
+    {
+        return;
+    }
+
+#if !defined(CONFIG_L3_TELEMETRY) && !defined(CONFIG_L3_PROC_THREAD)
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("Batch, Samples, First_Time, Last_Time, Acc_Raw_X, Acc_Raw_Y, Acc_Raw_Z, Gyr_Raw_X, Gyr_Raw_Y, Gyr_Raw_Z\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+#endif
+
+    // infinite loop
+    while (1)
+    {
+        IMU_PROF_BEGIN(t_loop);
+
+        IMU_PROF_BEGIN(t_status);
+        rslt = bmi323_get_int1_status(&int_status, dev);
+        IMU_PROF_END(IMU_PROF_STATUS, t_status);
+        bmi3_error_codes_print_result("bmi323_get_int1_status", rslt);
+
+        if (int_status & BMI3_INT_STATUS_FWM)
+        {
+            /* A few chunked burst reads for the whole batch. */
+            IMU_PROF_BEGIN(t_fifo);
+            rslt = bmi323_fifo_drain(&fifo, samples, ARRAY_SIZE(samples), &count, dev);
+            IMU_PROF_END(IMU_PROF_READ_FIFO, t_fifo);
+            bmi3_error_codes_print_result("bmi323_fifo_drain", rslt);
+
+            if (count > 0)
             {
-                /* To get the status of accel data ready interrupt. */
-                rslt = bmi323_get_sensor_status(&sens_status, &dev);
-                bmi3_error_codes_print_result("bmi323_get_int1_status", rslt);
+#if defined(CONFIG_L3_WARM_BOOT)
+                bmi323_warm_first_sample();
+#endif
 
-                /* To check the accel data ready status and print the status.*/
-                /* The problem with the below line is that it waits till both Acc and Gyro data are ready */
-                if ((sens_status & BMI3_STATUS_DRDY_ACC) && (sens_status && BMI3_STATUS_DRDY_GYR))
+#if defined(CONFIG_L3_TIMING)
+                for (uint16_t i = 0; i < count; i++)
                 {
-                    /* Get accelerometer data for x, y and z axis. 1 is the number of readings to get*/
-                    rslt = bmi323_get_sensor_data(&acc_sensor_data, 1, &dev);
-                    bmi3_error_codes_print_result("Get sensor data", rslt);
-
-                    /* Get gyro data for x, y and z axis */
-                    rslt = bmi323_get_sensor_data(&gyr_sensor_data, 1, &dev);
-                    bmi3_error_codes_print_result("Get sensor data", rslt);
-
-                    /* Converting lsb to g for 16 bit accelerometer at 4G range. */
-                    acc_x = lsb_to_g(acc_sensor_data.sens_data.acc.x, 4, dev.resolution);
-                    acc_y = lsb_to_g(acc_sensor_data.sens_data.acc.y, 4, dev.resolution);
-                    acc_z = lsb_to_g(acc_sensor_data.sens_data.acc.z, 4, dev.resolution);
-                    
-                    /* Converting lsb to degree per second for 16 bit gyro at 500dps range. */
-                    gyr_x = lsb_to_dps(gyr_sensor_data.sens_data.gyr.x, (float)500, dev.resolution);
-                    gyr_y = lsb_to_dps(gyr_sensor_data.sens_data.gyr.y, (float)500, dev.resolution);
-                    gyr_z = lsb_to_dps(gyr_sensor_data.sens_data.gyr.z, (float)500, dev.resolution);
-
-                    /* Print the data in g units for serial monitor. */
-                    /* %4.2d means to use at least 4 places for the decimal part and exactly 2 places for the fracitonal part*/
-                    printk("------------------------------------\n\r");
-                    printk("%d, %d, %d, %d, %4.2f g, %4.2f g, %4.2f g\n\r",
-                           indx,
-                           acc_sensor_data.sens_data.acc.x,
-                           acc_sensor_data.sens_data.acc.y,
-                           acc_sensor_data.sens_data.acc.z,
-                           acc_x,
-                           acc_y,
-                           acc_z);
-                    printk("%d, %d, %d, %d, %4.2f dsp, %4.2f dsp, %4.2f dsp\n\r",
-                           indx,
-                           gyr_sensor_data.sens_data.gyr.x,
-                           gyr_sensor_data.sens_data.gyr.y,
-                           gyr_sensor_data.sens_data.gyr.z,
-                           gyr_x,
-                           gyr_y,
-                           gyr_z);
-                    // printk("------------------------------------\n\r");
-                    
-
-                   /* Print the data in g units for serial plotter. */
-                   /* Note: no special characters are allowed as labels like '_' or '-', etc... */
-                    // printk("ACCx%4.2f", acc_x);
-                    // printk("ACCy%4.2f", acc_y);
-                    // printk("ACCz%4.2f", acc_z);
-                    // printk("GYROx%4.2f", gyr_x);
-                    // printk("GYROy%4.2f", gyr_y);
-                    // printk("GYROz%4.2f", gyr_z); 
-
-                    // printk("\n\r");
-                
-                    indx++;
+                    imu_timing_update(&samples[i]);
                 }
+#endif
+
+#if defined(CONFIG_L3_CALIB)
+                imu_calib_update(samples, count);
+#endif
+
+#if defined(CONFIG_L3_LOG)
+                imu_log_put(samples, count);
+#endif
 
-                // sample a new reading every 20 mS (running at ~50HZ)
-                k_msleep(20);
+                IMU_PROF_BEGIN(t_output);
+
+#if defined(CONFIG_L3_PROC_THREAD)
+                /* Only queue the batch, the processing thread handles every sample of it. */
+                for (uint16_t i = 0; i < count; i++)
+                {
+                    imu_proc_put(&samples[i]);
+                }
+#elif defined(CONFIG_L3_TELEMETRY)
+                /* Every sample of the batch goes out as a binary packet, no formatting at all. */
+                for (uint16_t i = 0; i < count; i++)
+                {
+                    telemetry_send_sample(&samples[i]);
+                }
+#else
+                /* Only the last sample of the batch is printed, printing all of them would saturate the console. */
+                printk("%u, %u, %u, %u, %d, %d, %d, %d, %d, %d\n\r",
+                       batch,
+                       count,
+                       samples[0].sensor_time,
+                       samples[count - 1].sensor_time,
+                       samples[count - 1].acc_x,
+                       samples[count - 1].acc_y,
+                       samples[count - 1].acc_z,
+                       samples[count - 1].gyr_x,
+                       samples[count - 1].gyr_y,
+                       samples[count - 1].gyr_z);
+#endif
+
+                IMU_PROF_END(IMU_PROF_OUTPUT, t_output);
+
+                batch++;
             }
         }
+
+        IMU_PROF_END(IMU_PROF_LOOP, t_loop);
+
+        k_msleep(FIFO_POLL_PERIOD_MS);
     }
+}
+#elif defined(CONFIG_L3_ACQ_DRDY)
+/*!
+ * @brief This internal API prints the samples read by the data-ready acquisition thread.
+ *
+ * @details
+ *      the sensor is never polled from here, the acquisition thread is woken by the INT1 edge and
+ *      reads the sample as soon as it is ready. this loop sleeps until a sample is queued, so a slow
+ *      printk only fills the queue instead of delaying the next read.
+ */
+static void run_drdy_loop(struct bmi3_dev *dev)
+{
+#if defined(CONFIG_L3_PROC_THREAD)
+    /* The acquisition thread puts the samples straight into the ring of the processing thread, nothing is left to do here. */
+    if (bmi323_drdy_start(dev) != 0)
+    {
+        printk("bmi323_drdy_start failed\n\r");
+    }
+#else
+    imu_sample_t sample;
 
-    return 0;
+    // dummy variable for printing current line
+    uint32_t indx = 0;
+
+    if (bmi323_drdy_start(dev) != 0)
+    {
+        printk("bmi323_drdy_start failed\n\r");
+        return;
+    }
+
+#if !defined(CONFIG_L3_TELEMETRY)
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("Data set, Sensor_Time, Acc_Raw_X, Acc_Raw_Y, Acc_Raw_Z, Acc_g_X, Acc_g_Y, Acc_g_Z\n\r");
+    printk("Data set, Overruns, Gyr_Raw_X, Gyr_Raw_Y, Gyr_Raw_Z, Gyr_dps_X, Gyr_dps_Y, Gyr_dps_Z\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+#endif
+
+    // infinite loop
+    while (1)
+    {
+        /* Sleep until the acquisition thread hands over a sample. */
+        bmi323_drdy_get(&sample, K_FOREVER);
+
+#if defined(CONFIG_L3_CALIB)
+        imu_calib_update(&sample, 1);
+#endif
+
+#if defined(CONFIG_L3_LOG)
+        imu_log_put(&sample, 1);
+#endif
+
+#if defined(CONFIG_L3_TELEMETRY)
+        telemetry_send_sample(&sample);
+#else
+        printk("%u, %u, %d, %d, %d, %4.2f g, %4.2f g, %4.2f g\n\r",
+               indx,
+               sample.sensor_time,
+               sample.acc_x,
+               sample.acc_y,
+               sample.acc_z,
+               imu_convert_acc_g(sample.acc_x),
+               imu_convert_acc_g(sample.acc_y),
+               imu_convert_acc_g(sample.acc_z));
+        printk("%u, %u, %d, %d, %d, %4.2f dsp, %4.2f dsp, %4.2f dsp\n\r",
+               indx,
+               bmi323_drdy_overruns(),
+               sample.gyr_x,
+               sample.gyr_y,
+               sample.gyr_z,
+               imu_convert_gyr_dps(sample.gyr_x),
+               imu_convert_gyr_dps(sample.gyr_y),
+               imu_convert_gyr_dps(sample.gyr_z));
+#endif
+
+        indx++;
+    }
+#endif
+}
+#elif defined(CONFIG_L3_ACQ_SPLIT)
+/*!
+ * @brief This internal API prints a summary of the accel and of the gyro stream.
+ *
+ * @details
+ *      each stream arrives at the ODR of its own sensor in its own queue, this loop sleeps on both
+ *      queues with k_poll() and drains whichever has samples. printing every sample at 1600 Hz would
+ *      saturate the console, so each stream prints its last sample once per second of its own data.
+ */
+static void run_split_loop(struct bmi3_dev *dev)
+{
+    struct k_poll_event events[BMI323_SPLIT_COUNT];
+    imu_axis_sample_t sample;
+
+    /* Samples received per stream. */
+    uint32_t acc_count = 0;
+    uint32_t gyr_count = 0;
+
+    if (bmi323_split_start(dev) != 0)
+    {
+        printk("bmi323_split_start failed\n\r");
+        return;
+    }
+
+    bmi323_split_poll_init(events);
+
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("Acc, Samples, Sensor_Time, Acc_Raw_X, Acc_Raw_Y, Acc_Raw_Z, Acc_g_X, Acc_g_Y, Acc_g_Z, Overruns\n\r");
+    printk("Gyr, Samples, Sensor_Time, Gyr_Raw_X, Gyr_Raw_Y, Gyr_Raw_Z, Gyr_dps_X, Gyr_dps_Y, Gyr_dps_Z, Overruns\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+
+    // infinite loop
+    while (1)
+    {
+        /* Sleep until either stream has a sample. */
+        k_poll(events, ARRAY_SIZE(events), K_FOREVER);
+
+        while (bmi323_split_get(BMI323_SPLIT_ACC, &sample, K_NO_WAIT) == 0)
+        {
+            acc_count++;
+
+            if ((acc_count % CONFIG_L3_IMU_ODR_HZ) == 0)
+            {
+                printk("Acc, %u, %u, %d, %d, %d, %4.2f g, %4.2f g, %4.2f g, %u\n\r",
+                       acc_count,
+                       sample.sensor_time,
+                       sample.x,
+                       sample.y,
+                       sample.z,
+                       imu_convert_acc_g(sample.x),
+                       imu_convert_acc_g(sample.y),
+                       imu_convert_acc_g(sample.z),
+                       bmi323_split_overruns(BMI323_SPLIT_ACC));
+            }
+        }
+
+        while (bmi323_split_get(BMI323_SPLIT_GYR, &sample, K_NO_WAIT) == 0)
+        {
+            gyr_count++;
+
+            if ((gyr_count % CONFIG_L3_GYR_ODR_HZ) == 0)
+            {
+                printk("Gyr, %u, %u, %d, %d, %d, %4.2f dsp, %4.2f dsp, %4.2f dsp, %u\n\r",
+                       gyr_count,
+                       sample.sensor_time,
+                       sample.x,
+                       sample.y,
+                       sample.z,
+                       imu_convert_gyr_dps(sample.x),
+                       imu_convert_gyr_dps(sample.y),
+                       imu_convert_gyr_dps(sample.z),
+                       bmi323_split_overruns(BMI323_SPLIT_GYR));
+            }
+        }
+
+        events[BMI323_SPLIT_ACC].state = K_POLL_STATE_NOT_READY;
+        events[BMI323_SPLIT_GYR].state = K_POLL_STATE_NOT_READY;
+    }
 }
+#elif defined(CONFIG_L3_ACQ_MOTION)
+/*!
+ * @brief This internal API prints the counters of the motion mode at every event.
+ *
+ * @details
+ *      there is no timer and no polling here: the thread sleeps in bmi323_motion_wait() and the MCU idles
+ *      until the sensor pulls INT1. the wake-ups per hour and (with CONFIG_SCHED_THREAD_USAGE_ALL) the share
+ *      of the time the CPU was not idle show how much the offload saves against the 50 wake-ups per second
+ *      of the poll loop.
+ */
+static void run_motion_loop(struct bmi3_dev *dev)
+{
+    bmi323_motion_stats_t stats;
+    uint16_t events;
+    uint32_t per_hour;
+
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+    k_thread_runtime_stats_t runtime;
+    float busy;
+#endif
+
+    if (bmi323_motion_start(dev) != 0)
+    {
+        printk("bmi323_motion_start failed\n\r");
+        return;
+    }
+
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("Events, Wakeups, Any_Motion, No_Motion, Taps, Steps, Spurious, Uptime_s, Wakeups_per_hour, CPU_busy\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+
+    // infinite loop
+    while (1)
+    {
+        /* Sleep until the sensor reports an event, nothing runs in between. */
+        if (bmi323_motion_wait(&events, K_FOREVER) != 0)
+        {
+            continue;
+        }
 
+        bmi323_motion_get_stats(&stats);
+
+        per_hour = (stats.uptime_ms > 0) ? (uint32_t)(((int64_t)stats.wakeups * 3600000LL) / stats.uptime_ms) : 0U;
+
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+        k_thread_runtime_stats_all_get(&runtime);
+        busy = (runtime.execution_cycles > 0U) ? ((100.0f * (float)runtime.total_cycles) / (float)runtime.execution_cycles) : 0.0f;
+#endif
+
+        printk("0x%04x, %u, %u, %u, %u, %u, %u, %u, %u, ",
+               events,
+               stats.wakeups,
+               stats.any_motion,
+               stats.no_motion,
+               stats.taps,
+               stats.steps,
+               stats.spurious,
+               (uint32_t)(stats.uptime_ms / 1000),
+               per_hour);
+
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+        printk("%6.3f %%\n\r", busy);
+#else
+        printk("n/a\n\r");
+#endif
+    }
+}
+#elif defined(CONFIG_L3_ACQ_DUAL)
 /*!
- * @brief This internal API is used to set configurations for accel.
- * 
+ * @brief This internal API reads two sensors on one bus and fuses their samples.
+ *
+ * @details
+ *      the second sensor gets the configuration of the first one, both FIFOs are then read back to
+ *      back once per watermark period, on an absolute deadline so the period does not stretch by the
+ *      time of the reads. no interrupt status is polled in between, the bus is idle for the rest of
+ *      the period. the fused samples take the way of the FIFO batches.
  */
-static int8_t set_accel_config(struct bmi3_dev *dev)
+static void run_dual_loop(struct bmi3_dev *dev)
 {
     /* Status of API are returned to this variable. */
     int8_t rslt;
 
-    /* Structure to define accelerometer configuration. */
-    struct bmi3_sens_config config;
+    /* The second sensor, its driver ran bmi323_init() when the kernel started. */
+    const struct device *sensor_b = DEVICE_DT_GET(DT_NODELABEL(bmi323_b));
+    struct bmi3_dev *dev_b;
 
-    /* Configure the type of feature. */
-    config.type = BMI323_ACCEL;
+    /* Fused samples of one period, static to keep them off the main stack. */
+    static imu_sample_t samples[BMI323_FIFO_MAX_FRAMES];
+
+    /* Number of valid entries in 'samples'. */
+    uint16_t count = 0;
+
+    bmi323_dual_stats_t stats;
+    int64_t next_tick, next_stats_ms;
+
+    // dummy variable for printing current batch
+    uint32_t batch = 0;
+
+    if (!device_is_ready(sensor_b))
+    {
+        printk("second BMI323 device not ready\n\r");
+        return;
+    }
 
-    /* Get default configurations for the type of feature selected. */
-    rslt = bmi323_get_sensor_config(&config, 1, dev);
-    bmi3_error_codes_print_result("bmi323_get_sensor_config", rslt);
+    dev_b = bmi323_sensorapi_get_bmi3_dev(sensor_b);
+
+    rslt = set_accel_config(dev_b, false);
+    bmi3_error_codes_print_result("accel config set (second sensor)", rslt);
 
     if (rslt == BMI323_OK)
     {
+        rslt = set_gyro_config(dev_b, false);
+        bmi3_error_codes_print_result("gyro config set (second sensor)", rslt);
+    }
 
-        /* NOTE: The user can change the following configuration parameters according to their requirement. */
-        /* Output Data Rate. By default ODR is set as 100Hz for accel. */
-        config.cfg.acc.odr = BMI3_ACC_ODR_100HZ;
+    if (rslt == BMI323_OK)
+    {
+        rslt = bmi323_dual_init(dev, dev_b, CONFIG_L3_FIFO_WATERMARK_FRAMES, CONFIG_L3_IMU_ODR_HZ);
+        bmi3_error_codes_print_result("bmi323_dual_init", rslt);
+    }
 
-        /* Gravity range of the sensor (+/- 2G, 4G, 8G, 16G). */
-        config.cfg.acc.range = BMI3_ACC_RANGE_4G;
+    if (rslt != BMI323_OK)
+    {
+        return;
+    }
 
-        /* The Accel bandwidth coefficient defines the 3 dB cutoff frequency in relation to the ODR. */
-        /* In other words, it defines the bandwidth limits upon which the low pass filter will act */
-        config.cfg.acc.bwp = BMI3_ACC_BW_ODR_QUARTER;
+#if !defined(CONFIG_L3_TELEMETRY) && !defined(CONFIG_L3_PROC_THREAD)
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("Batch, Samples, First_Time, Last_Time, Acc_Raw_X, Acc_Raw_Y, Acc_Raw_Z, Gyr_Raw_X, Gyr_Raw_Y, Gyr_Raw_Z\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+#endif
 
-        /* Set number of average samples for accel. in other words, its output is the average of the most recent 8 samples*/
-        config.cfg.acc.avg_num = BMI3_ACC_AVG8;
+    next_tick = k_uptime_ticks();
+    next_stats_ms = k_uptime_get() + DUAL_STATS_PERIOD_MS;
 
-        /* Enable the accel mode where averaging of samples
-        * will be done based on above set bandwidth and ODR.
-        * Note : By default accel is disabled. The accel will get enable by selecting the mode.
-        */
-        config.cfg.acc.acc_mode = BMI3_ACC_MODE_NORMAL;
+    // infinite loop
+    while (1)
+    {
+        next_tick += (int64_t)k_us_to_ticks_floor64(DUAL_PERIOD_US);
+        k_sleep(K_TIMEOUT_ABS_TICKS(next_tick));
+
+        rslt = bmi323_dual_drain(samples, ARRAY_SIZE(samples), &count);
+        bmi3_error_codes_print_result("bmi323_dual_drain", rslt);
+
+        if (count > 0)
+        {
+#if defined(CONFIG_L3_PROC_THREAD)
+            for (uint16_t i = 0; i < count; i++)
+            {
+                imu_proc_put(&samples[i]);
+            }
+#elif defined(CONFIG_L3_TELEMETRY)
+            for (uint16_t i = 0; i < count; i++)
+            {
+                telemetry_send_sample(&samples[i]);
+            }
+#else
+            /* Only the last sample of the batch is printed, printing all of them would saturate the console. */
+            printk("%u, %u, %u, %u, %d, %d, %d, %d, %d, %d\n\r",
+                   batch,
+                   count,
+                   samples[0].sensor_time,
+                   samples[count - 1].sensor_time,
+                   samples[count - 1].acc_x,
+                   samples[count - 1].acc_y,
+                   samples[count - 1].acc_z,
+                   samples[count - 1].gyr_x,
+                   samples[count - 1].gyr_y,
+                   samples[count - 1].gyr_z);
+#endif
+
+            batch++;
+        }
+
+        if (k_uptime_get() >= next_stats_ms)
+        {
+            next_stats_ms += DUAL_STATS_PERIOD_MS;
+            bmi323_dual_get_stats(&stats);
+
+            for (uint8_t s = 0; s < BMI323_DUAL_SENSORS; s++)
+            {
+                printk("dual: sensor %u: %u frames, %u overruns, %u unpaired\n\r", s,
+                       stats.sensor[s].frames, stats.sensor[s].overruns, stats.sensor[s].unpaired);
+            }
+
+            printk("dual: %u fused, offset %d ticks, drift %d ppm, bus %u us per drain, %u.%u %% busy\n\r",
+                   stats.fused, stats.offset_ticks, stats.drift_ppm, stats.bus_us_per_drain,
+                   stats.bus_permille / 10U, stats.bus_permille % 10U);
+        }
+    }
+}
+#elif defined(CONFIG_L3_ACQ_REPLAY)
+/*!
+ * @brief This internal API replays a recording through the processing chain.
+ *
+ * @details
+ *      the batches of the recording take the place of the FIFO bursts, everything after the read runs as
+ *      it would on the board. the ring of the processing thread is never allowed to overrun: a dropped
+ *      sample would make the output depend on the scheduling of the host instead of the recording, the
+ *      loop waits for room instead. once the recording is over the chain is drained, the report is
+ *      printed and 'zephyr.exe' exits with 1 if the output differs from the golden file.
+ */
+static void run_replay_loop(void)
+{
+    /* One batch of the recording, static to keep it off the main stack. */
+    static imu_sample_t samples[CONFIG_L3_REPLAY_BATCH];
+
+    /* Number of valid entries in 'samples'. */
+    uint16_t count = 0;
+
+    int ret;
+
+#if defined(CONFIG_L3_PROC_THREAD)
+    imu_proc_stats_t stats;
+#endif
+
+    if (imu_replay_open() != 0)
+    {
+        posix_exit(1);
+        return;
+    }
+
+    while (1)
+    {
+        IMU_PROF_BEGIN(t_loop);
+
+        IMU_PROF_BEGIN(t_read);
+        ret = imu_replay_drain(samples, ARRAY_SIZE(samples), &count);
+        IMU_PROF_END(IMU_PROF_READ_FIFO, t_read);
+
+        if (ret != 0)
+        {
+            break;
+        }
+
+        IMU_PROF_BEGIN(t_output);
+
+#if defined(CONFIG_L3_PROC_THREAD)
+        for (uint16_t i = 0; i < count; i++)
+        {
+            /* Wait for the processing thread to make room, the recording is never dropped from. */
+            imu_proc_get_stats(&stats);
+            while (stats.count >= stats.capacity)
+            {
+                k_sleep(K_TICKS(1));
+                imu_proc_get_stats(&stats);
+            }
+
+            imu_proc_put(&samples[i]);
+        }
+#else
+        /* No processing thread: the samples leave the chain right here. */
+        imu_replay_put_samples(samples, count);
+
+#if defined(CONFIG_L3_TELEMETRY)
+        for (uint16_t i = 0; i < count; i++)
+        {
+            telemetry_send_sample(&samples[i]);
+        }
+#endif
+#endif
+
+        IMU_PROF_END(IMU_PROF_OUTPUT, t_output);
+
+        IMU_PROF_END(IMU_PROF_LOOP, t_loop);
+    }
+
+#if defined(CONFIG_L3_PROC_THREAD)
+    if (imu_proc_flush(K_SECONDS(10)) != 0)
+    {
+        printk("imu_proc_flush timed out, the output is incomplete\n\r");
+    }
+#endif
+
+#if defined(CONFIG_L3_TELEMETRY)
+    /* The last samples of the recording may still wait in a delta packet. */
+    telemetry_flush();
+#endif
+
+    ret = imu_replay_finish();
+
+    posix_exit((ret == 0) ? 0 : 1);
+}
+#elif defined(CONFIG_L3_ACQ_STREAM)
+/*!
+ * @brief This internal API prints a summary of every FIFO batch streamed by the sensor driver.
+ *
+ * @details
+ *      the driver fills a buffer from 'stream_ctx' with the raw FIFO frames at every watermark and
+ *      completes the request, the application never talks to the bus. the frames stay raw: only the
+ *      last frame of each batch is decoded here, the other ones cost nothing.
+ */
+static void run_stream_loop(const struct device *sensor)
+{
+    const struct sensor_decoder_api *decoder;
+    struct sensor_chan_spec acc_spec = { .chan_type = SENSOR_CHAN_ACCEL_XYZ, .chan_idx = 0 };
+    struct sensor_chan_spec gyr_spec = { .chan_type = SENSOR_CHAN_GYRO_XYZ, .chan_idx = 0 };
+    struct sensor_three_axis_data acc;
+    struct sensor_three_axis_data gyr;
+    struct rtio_sqe *handle;
+    struct rtio_cqe *cqe;
+    uint8_t *buf;
+    uint32_t buf_len;
+    uint16_t frame_count;
+    uint32_t fit;
+    int result;
+
+    // dummy variable for printing current batch
+    uint32_t batch = 0;
+
+    if ((sensor_get_decoder(sensor, &decoder) != 0) ||
+        (sensor_stream(&stream_iodev, &stream_ctx, NULL, &handle) != 0))
+    {
+        printk("sensor_stream failed\n\r");
+        return;
+    }
+
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("Batch, Frames, Time_ns, Acc_X, Acc_Y, Acc_Z (m/s^2), Gyr_X, Gyr_Y, Gyr_Z (rad/s)\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+
+    // infinite loop
+    while (1)
+    {
+        /* Sleep until the driver completes the next batch. */
+        cqe = rtio_cqe_consume_block(&stream_ctx);
+        result = cqe->result;
+
+        if (rtio_cqe_get_mempool_buffer(&stream_ctx, cqe, &buf, &buf_len) != 0)
+        {
+            buf = NULL;
+        }
+
+        rtio_cqe_release(&stream_ctx, cqe);
+
+        if ((result == 0) && (buf != NULL) &&
+            (decoder->get_frame_count(buf, acc_spec, &frame_count) == 0) && (frame_count > 0))
+        {
+            /* Decode only the last frame of the batch. */
+            fit = frame_count - 1U;
+            decoder->decode(buf, acc_spec, &fit, 1, &acc);
+
+            fit = frame_count - 1U;
+            decoder->decode(buf, gyr_spec, &fit, 1, &gyr);
+
+            printk("%u, %u, %llu, %4.2f, %4.2f, %4.2f, %4.2f, %4.2f, %4.2f\n\r",
+                   batch,
+                   frame_count,
+                   (unsigned long long)acc.header.base_timestamp_ns,
+                   q31_to_float(acc.readings[0].x, acc.shift),
+                   q31_to_float(acc.readings[0].y, acc.shift),
+                   q31_to_float(acc.readings[0].z, acc.shift),
+                   q31_to_float(gyr.readings[0].x, gyr.shift),
+                   q31_to_float(gyr.readings[0].y, gyr.shift),
+                   q31_to_float(gyr.readings[0].z, gyr.shift));
+
+            batch++;
+        }
+        else if (result != 0)
+        {
+            printk("stream error %d\n\r", result);
+        }
+
+        if (buf != NULL)
+        {
+            rtio_release_buffer(&stream_ctx, buf, buf_len);
+        }
+    }
+}
+
+/*!
+ * @brief This internal API converts a q31_t value of the sensor decoder to float, value = q31 * 2^shift / 2^31.
+ */
+static float q31_to_float(q31_t value, int8_t shift)
+{
+    return ((float)value / 2147483648.0f) * (float)(1UL << shift);
+}
+#else
+/*!
+ * @brief This internal API polls the data-ready status and reads one sample at a time.
+ */
+static void run_poll_loop(struct bmi3_dev *dev)
+{
+    /* Status of API are returned to this variable. */
+    int8_t rslt;
+
+    /* Create an instance of sensor data structure. */
+    struct bmi3_sensor_data acc_sensor_data = { 0 };
+    struct bmi3_sensor_data gyr_sensor_data = { 0 };
 
-        /* Set the accel configurations. */
-        rslt = bmi323_set_sensor_config(&config, 1, dev);
-        bmi3_error_codes_print_result("bmi323_set_sensor_config", rslt);
+    /* Initialize the interrupt status of accel. */
+    uint16_t sens_status = 0;
+
+    /* Data-ready flags seen since the last read, reading STATUS clears them in the sensor. */
+    uint16_t drdy_pending = 0;
+
+    // dummy variable for printing current line
+    uint32_t indx = 0;
+
+    /* Raw sample with its timestamps, handed to the telemetry channel or to the processing thread. */
+    imu_sample_t sample;
+
+#if !defined(CONFIG_L3_TELEMETRY) && !defined(CONFIG_L3_PROC_THREAD)
+    /** acceleration values in m/s^2 */
+    float acc_x = 0, acc_y = 0, acc_z = 0;
+
+    /** gyroscope values in degree/s */
+    float gyr_x = 0, gyr_y = 0, gyr_z = 0;
+#endif
+
+    /* Select both accel and gyro sensor. */
+    acc_sensor_data.type = BMI323_ACCEL;
+    gyr_sensor_data.type = BMI323_GYRO;
+
+#if !defined(CONFIG_L3_TELEMETRY) && !defined(CONFIG_L3_PROC_THREAD)
+    printk("\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+    printk("Data set, Sensor_Time, Acc_Raw_X, Acc_Raw_Y, Acc_Raw_Z, Acc_g_X, Acc_g_Y, Acc_g_Z\n\r");
+    printk("Data set, Gyr_Raw_X, Gyr_Raw_Y, Gyr_Raw_Z, Gyr_dps_X, Gyr_dps_Y, Gyr_dps_Z\n\r");
+    printk("----------------------------------------------------------------------------------\n\r");
+#endif
+
+    // infinite loop
+    while (1)
+    {
+        IMU_PROF_BEGIN(t_loop);
+
+        /* To get the status of accel data ready interrupt. */
+        IMU_PROF_BEGIN(t_status);
+        rslt = bmi323_get_sensor_status(&sens_status, dev);
+        IMU_PROF_END(IMU_PROF_STATUS, t_status);
+        bmi3_error_codes_print_result("bmi323_get_int1_status", rslt);
+
+        /* A sensor that became ready before the other one would lose its flag on the next STATUS read,
+         * so the flags are collected until both are set. Use CONFIG_L3_ACQ_SPLIT to read them independently. */
+        drdy_pending |= sens_status & (BMI3_STATUS_DRDY_ACC | BMI3_STATUS_DRDY_GYR);
+
+        if (drdy_pending == (BMI3_STATUS_DRDY_ACC | BMI3_STATUS_DRDY_GYR))
+        {
+            drdy_pending = 0;
+
+            /* Get accelerometer data for x, y and z axis. 1 is the number of readings to get*/
+            IMU_PROF_BEGIN(t_acc);
+            rslt = bmi323_get_sensor_data(&acc_sensor_data, 1, dev);
+            IMU_PROF_END(IMU_PROF_READ_ACC, t_acc);
+            bmi3_error_codes_print_result("Get sensor data", rslt);
+
+            /* Get gyro data for x, y and z axis */
+            IMU_PROF_BEGIN(t_gyr);
+            rslt = bmi323_get_sensor_data(&gyr_sensor_data, 1, dev);
+            IMU_PROF_END(IMU_PROF_READ_GYR, t_gyr);
+            bmi3_error_codes_print_result("Get sensor data", rslt);
+
+            /* Keep the raw values as they are, the conversion is done later (or on the host). */
+            sample.acc_x = acc_sensor_data.sens_data.acc.x;
+            sample.acc_y = acc_sensor_data.sens_data.acc.y;
+            sample.acc_z = acc_sensor_data.sens_data.acc.z;
+            sample.gyr_x = gyr_sensor_data.sens_data.gyr.x;
+            sample.gyr_y = gyr_sensor_data.sens_data.gyr.y;
+            sample.gyr_z = gyr_sensor_data.sens_data.gyr.z;
+            sample.sensor_time = acc_sensor_data.sens_data.acc.sens_time;
+            sample.read_cycles = k_cycle_get_32();
+
+#if defined(CONFIG_L3_WARM_BOOT)
+            bmi323_warm_first_sample();
+#endif
+
+#if defined(CONFIG_L3_TIMING)
+            imu_timing_update(&sample);
+#endif
+
+#if defined(CONFIG_L3_CALIB)
+            imu_calib_update(&sample, 1);
+#endif
+
+#if defined(CONFIG_L3_LOG)
+            imu_log_put(&sample, 1);
+#endif
+
+#if defined(CONFIG_L3_PROC_THREAD)
+            IMU_PROF_BEGIN(t_output);
+            imu_proc_put(&sample);
+            IMU_PROF_END(IMU_PROF_OUTPUT, t_output);
+#elif defined(CONFIG_L3_TELEMETRY)
+            IMU_PROF_BEGIN(t_output);
+            telemetry_send_sample(&sample);
+            IMU_PROF_END(IMU_PROF_OUTPUT, t_output);
+#else
+            /* Converting lsb to g, the scale of the configured range was computed once in set_accel_config(). */
+            IMU_PROF_BEGIN(t_convert);
+            acc_x = imu_convert_acc_g(sample.acc_x);
+            acc_y = imu_convert_acc_g(sample.acc_y);
+            acc_z = imu_convert_acc_g(sample.acc_z);
+            
+            /* Converting lsb to degree per second, the scale was computed once in set_gyro_config(). */
+            gyr_x = imu_convert_gyr_dps(sample.gyr_x);
+            gyr_y = imu_convert_gyr_dps(sample.gyr_y);
+            gyr_z = imu_convert_gyr_dps(sample.gyr_z);
+            IMU_PROF_END(IMU_PROF_CONVERT, t_convert);
+
+            /* Print the data in g units for serial monitor. */
+            /* %4.2d means to use at least 4 places for the decimal part and exactly 2 places for the fracitonal part*/
+            IMU_PROF_BEGIN(t_output);
+            printk("------------------------------------\n\r");
+            printk("%u, %u, %d, %d, %d, %4.2f g, %4.2f g, %4.2f g\n\r",
+                   indx,
+                   sample.sensor_time,
+                   sample.acc_x,
+                   sample.acc_y,
+                   sample.acc_z,
+                   acc_x,
+                   acc_y,
+                   acc_z);
+            printk("%u, %d, %d, %d, %4.2f dsp, %4.2f dsp, %4.2f dsp\n\r",
+                   indx,
+                   sample.gyr_x,
+                   sample.gyr_y,
+                   sample.gyr_z,
+                   gyr_x,
+                   gyr_y,
+                   gyr_z);
+            IMU_PROF_END(IMU_PROF_OUTPUT, t_output);
+            // printk("------------------------------------\n\r");
+            
+
+           /* Print the data in g units for serial plotter. */
+           /* Note: no special characters are allowed as labels like '_' or '-', etc... */
+            // printk("ACCx%4.2f", acc_x);
+            // printk("ACCy%4.2f", acc_y);
+            // printk("ACCz%4.2f", acc_z);
+            // printk("GYROx%4.2f", gyr_x);
+            // printk("GYROy%4.2f", gyr_y);
+            // printk("GYROz%4.2f", gyr_z); 
+
+            // printk("\n\r");
+#endif
         
+            indx++;
+        }
+
+        IMU_PROF_END(IMU_PROF_LOOP, t_loop);
+
+        // sample a new reading every 20 mS (running at ~50HZ)
+        k_msleep(20);
     }
+}
+#endif
 
-    return rslt;
+#if defined(CONFIG_L3_PROC_THREAD)
+/*!
+ * @brief This internal API converts and prints (or sends) a batch of samples.
+ *
+ * @details
+ *      runs in the processing thread at a lower priority than the acquisition, the time spent in printk
+ *      here only shows up as a higher fill level of the ring. the high-water mark and the overruns of the
+ *      ring are printed with every sample to size CONFIG_L3_PROC_RING_CAPACITY from a real run. with the
+ *      orientation filter only one line (the orientation after the last sample) is printed per batch.
+ */
+static void process_samples(const imu_sample_t *samples, uint16_t count)
+{
+#if defined(CONFIG_L3_ACQ_REPLAY) && defined(CONFIG_L3_AHRS)
+    /*
+     * The batches of a replay depend on the pacing and on the fill level of the ring, the orientation is
+     * recorded at fixed positions of the recording instead: the batch is cut every
+     * CONFIG_L3_REPLAY_ORIENTATION_SAMPLES samples, so both paces write the same records.
+     */
+    static uint32_t since_orientation = 0;
+
+    imu_ahrs_quat_t orientation;
+    uint16_t done = 0;
+    uint16_t len;
+
+    while (done < count)
+    {
+        len = (uint16_t)MIN((uint32_t)(count - done), CONFIG_L3_REPLAY_ORIENTATION_SAMPLES - since_orientation);
+
+        imu_ahrs_update(&samples[done], len);
+        imu_replay_put_samples(&samples[done], len);
+
+        since_orientation += len;
+        done += len;
+
+        if (since_orientation == CONFIG_L3_REPLAY_ORIENTATION_SAMPLES)
+        {
+            imu_ahrs_get_quat(&orientation);
+            imu_replay_put(IMU_REPLAY_REC_ORIENTATION, &orientation, sizeof(orientation));
+            since_orientation = 0;
+        }
+    }
+#else
+#if defined(CONFIG_L3_AHRS)
+    /* One filter step per sample, the orientation is only read out once per batch. */
+    imu_ahrs_update(samples, count);
+#endif
+
+#if defined(CONFIG_L3_ACQ_REPLAY)
+    /* The records of a replay are taken where the samples leave the filter, ahead of any formatting. */
+    imu_replay_put_samples(samples, count);
+#endif
+#endif
+
+#if defined(CONFIG_L3_STATS)
+    imu_stats_summary_t summary;
+
+    // dummy variable for printing current window
+    static uint32_t window = 0;
+
+    /* Nothing leaves the stage until a window is closed, one summary then replaces all of its samples. */
+    if (imu_stats_update(samples, count) == 0)
+    {
+        return;
+    }
+
+    imu_stats_get_summary(&summary);
+
+#if defined(CONFIG_L3_TELEMETRY)
+    {
+        uint8_t payload[IMU_STATS_PACKED_SIZE];
+
+        telemetry_send(TELEMETRY_TYPE_STATS, payload, imu_stats_pack(&summary, payload));
+    }
+#else
+    static const char *const axis_names[IMU_STATS_AXES] = { "acc_x", "acc_y", "acc_z", "gyr_x", "gyr_y", "gyr_z" };
+
+    printk("%u, %u, %u, %u, %u, %u\n\r", window, summary.start_time, summary.end_time, summary.count,
+           summary.cycles_per_sample, summary.max_block_cycles);
+
+    for (uint8_t axis = 0; axis < IMU_STATS_AXES; axis++)
+    {
+        printk("%u, %s, %.2f, %.2f, %.2f, %d, %d\n\r", window, axis_names[axis],
+               summary.axis[axis].mean_q8 / 256.0f, summary.axis[axis].std_q8 / 256.0f,
+               summary.axis[axis].rms_q8 / 256.0f, summary.axis[axis].min, summary.axis[axis].max);
+    }
+#endif
+
+    window++;
+#elif defined(CONFIG_L3_TELEMETRY)
+    for (uint16_t i = 0; i < count; i++)
+    {
+        telemetry_send_sample(&samples[i]);
+    }
+#elif defined(CONFIG_L3_VIB)
+    static const char axis_names[IMU_VIB_AXES] = { 'x', 'y', 'z' };
+    imu_vib_result_t result;
+    uint8_t axis, i;
+
+    // dummy variable for printing current window
+    static uint32_t window = 0;
+
+    /* Nothing is printed until a window is complete, one line per axis then replaces FFT_SIZE raw samples. */
+    if (imu_vib_update(samples, count) == 0)
+    {
+        return;
+    }
+
+    for (axis = 0; axis < IMU_VIB_AXES; axis++)
+    {
+        imu_vib_get_result((imu_vib_axis_t)axis, &result);
+
+        printk("%u, %c, %u, %.1f,", window, axis_names[axis], result.sensor_time, result.rms_mg);
+
+        for (i = 0; i < result.peak_count; i++)
+        {
+            printk(" %.1f:%.1f", result.peaks[i].freq_hz, result.peaks[i].amp_mg);
+        }
+
+        printk(",");
+
+        for (i = 0; i < CONFIG_L3_VIB_BANDS; i++)
+        {
+            printk(" %.1f", result.band_mg[i]);
+        }
+
+        printk("\n\r");
+    }
+
+    window++;
+#elif defined(CONFIG_L3_CLASSIFY)
+    imu_classify_result_t result;
+    int ready;
+
+    // dummy variable for printing current window
+    static uint32_t window = 0;
+
+    /* Nothing is printed until a window is classified, one line then replaces CONFIG_L3_CLASSIFY_HOP raw samples. */
+    ready = imu_classify_update(samples, count);
+    if (ready < 0)
+    {
+        printk("imu_classify_update failed (%d)\n\r", ready);
+        return;
+    }
+
+    if (ready == 0)
+    {
+        return;
+    }
+
+    imu_classify_get_result(&result);
+
+    printk("%u, %u, %s, %u\n\r", window, result.sensor_time, result.name, result.confidence);
+
+    window++;
+#elif defined(CONFIG_L3_AHRS)
+    imu_proc_stats_t stats;
+    imu_ahrs_quat_t quat;
+    imu_ahrs_euler_t euler;
+
+    // dummy variable for printing current batch
+    static uint32_t batch = 0;
+
+    imu_proc_get_stats(&stats);
+    imu_ahrs_get_quat(&quat);
+    imu_ahrs_get_euler(&euler);
+
+    printk("%u, %u, %5.4f, %5.4f, %5.4f, %5.4f, %6.2f, %6.2f, %6.2f, %u, %u\n\r",
+           batch,
+           samples[count - 1U].sensor_time,
+           quat.w, quat.x, quat.y, quat.z,
+           euler.roll, euler.pitch, euler.yaw,
+           stats.high_water,
+           stats.overruns);
+
+    batch++;
+#elif defined(CONFIG_L3_ACQ_REPLAY)
+    /* Two lines per sample would take longer than the chain itself, the records are the output of a replay. */
+#else
+    imu_proc_stats_t stats;
+
+    // dummy variable for printing current line
+    static uint32_t indx = 0;
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        imu_proc_get_stats(&stats);
+
+        printk("%u, %u, %d, %d, %d, %4.2f g, %4.2f g, %4.2f g\n\r",
+               indx,
+               samples[i].sensor_time,
+               samples[i].acc_x,
+               samples[i].acc_y,
+               samples[i].acc_z,
+               imu_convert_acc_g(samples[i].acc_x),
+               imu_convert_acc_g(samples[i].acc_y),
+               imu_convert_acc_g(samples[i].acc_z));
+        printk("%u, %u, %u, %d, %d, %d, %4.2f dsp, %4.2f dsp, %4.2f dsp\n\r",
+               indx,
+               stats.high_water,
+               stats.overruns,
+               samples[i].gyr_x,
+               samples[i].gyr_y,
+               samples[i].gyr_z,
+               imu_convert_gyr_dps(samples[i].gyr_x),
+               imu_convert_gyr_dps(samples[i].gyr_y),
+               imu_convert_gyr_dps(samples[i].gyr_z));
+
+        indx++;
+    }
+#endif
 }
+#endif
 
 /*!
- * @brief This function converts lsb to meter per second squared for 16 bit accelerometer at
- * range 2G, 4G, 8G or 16G.
+ * @brief This internal API fills the accel configuration.
+ *
+ */
+static void fill_accel_config(struct bmi3_sens_config *config)
+{
+    /* NOTE: The user can change the following configuration parameters according to their requirement. */
+    /* Output Data Rate. By default ODR is set as 100Hz for accel, refer to 'CONFIG_L3_IMU_ODR' in 'prj.conf'. */
+    config->cfg.acc.odr = ACC_ODR;
+
+    /* Gravity range of the sensor (+/- 2G, 4G, 8G, 16G). */
+    config->cfg.acc.range = BMI3_ACC_RANGE_4G;
+
+    /* The Accel bandwidth coefficient defines the 3 dB cutoff frequency in relation to the ODR. */
+    /* In other words, it defines the bandwidth limits upon which the low pass filter will act */
+    config->cfg.acc.bwp = BMI3_ACC_BW_ODR_QUARTER;
+
+    /* Set number of average samples for accel. in other words, its output is the average of the most recent 8 samples*/
+    config->cfg.acc.avg_num = BMI3_ACC_AVG8;
+
+    /* Enable the accel mode where averaging of samples
+    * will be done based on above set bandwidth and ODR.
+    * Note : By default accel is disabled. The accel will get enable by selecting the mode.
+    */
+    config->cfg.acc.acc_mode = BMI3_ACC_MODE_NORMAL;
+}
+
+/*!
+ * @brief This internal API is used to set configurations for accel.
  * 
- * @details: 
- *      this function works as follows -:
- *          'val' is the returned number from the accelerometer which is by default a 16-bit value 
- *                 ranging between -32768 and 32767 all-inclusive.
- *          we will first normalize this number to be in the range of '-1 to 1'. we will need to just divide 'val' by 
- *              its maximum value which is stored in the variable 'half_scale' according to the bitwidth of 'val'
- *          then depending on the sensor range whether it's '±2G', '±4G', '±8G' or '±16G'. We will map the values '-1 to 1' to 
- *              the range of 'g_range' by simple multiplication. if 
- */     
-static float lsb_to_g(int16_t val, int8_t g_range, uint8_t bit_width)
+ */
+static int8_t set_accel_config(struct bmi3_dev *dev, bool keep)
 {
-    double power = 2;
+    /* Status of API are returned to this variable. */
+    int8_t rslt = BMI323_OK;
+
+    /* Structure to define accelerometer configuration. */
+    struct bmi3_sens_config config = { 0 };
+
+    /* Configure the type of feature. */
+    config.type = BMI323_ACCEL;
+
+    if (!keep)
+    {
+        /* Get default configurations for the type of feature selected. */
+        rslt = bmi323_get_sensor_config(&config, 1, dev);
+        bmi3_error_codes_print_result("bmi323_get_sensor_config", rslt);
+    }
+
+    if (rslt == BMI323_OK)
+    {
+        fill_accel_config(&config);
+
+        if (!keep)
+        {
+            /* Set the accel configurations. */
+            rslt = bmi323_set_sensor_config(&config, 1, dev);
+            bmi3_error_codes_print_result("bmi323_set_sensor_config", rslt);
+        }
 
-    float half_scale = (float)((pow((double)power, (double)bit_width) / 2.0f));
+        /* Compute the conversion scale of the new range once, instead of on every sample. */
+        if ((rslt == BMI323_OK) && (imu_convert_set_accel_range(config.cfg.acc.range, dev->resolution) != 0))
+        {
+            rslt = BMI3_E_INVALID_INPUT;
+        }
+        
+    }
 
-    return (val * g_range) / half_scale;
+    return rslt;
 }
 
 
+
+/*!
+ *  @brief This internal API fills the gyro configuration.
+ */
+static void fill_gyro_config(struct bmi3_sens_config *config)
+{
+    /* The user can change the following configuration parameters according to their requirement. */
+    /* Output Data Rate. By default ODR is set as 100Hz for gyro, refer to 'CONFIG_L3_IMU_ODR' and 'CONFIG_L3_GYR_ODR' in 'prj.conf'. */
+    config->cfg.gyr.odr = GYR_ODR;
+
+    /* Gyroscope Angular Rate Measurement Range. By default the range is 2000dps. */
+    config->cfg.gyr.range = BMI3_GYR_RANGE_500DPS;
+
+    /*  The Gyroscope bandwidth coefficient defines the 3 dB cutoff frequency in relation to the ODR
+        *  Value   Name      Description
+        *    0   odr_half   BW = gyr_odr/2
+        *    1  odr_quarter BW = gyr_odr/4
+        */
+    config->cfg.gyr.bwp = BMI3_GYR_BW_ODR_HALF;
+
+    /* By default the gyro is disabled. Gyro is enabled by selecting the mode. */
+    config->cfg.gyr.gyr_mode = BMI3_GYR_MODE_NORMAL;
+
+    /* Value    Name    Description
+        *  000     avg_1   No averaging; pass sample without filtering
+        *  001     avg_2   Averaging of 2 samples
+        *  010     avg_4   Averaging of 4 samples
+        *  011     avg_8   Averaging of 8 samples
+        *  100     avg_16  Averaging of 16 samples
+        *  101     avg_32  Averaging of 32 samples
+        *  110     avg_64  Averaging of 64 samples
+        */
+    config->cfg.gyr.avg_num = BMI3_GYR_AVG1;
+}
+
 /*!
  *  @brief This internal API is used to set configurations for gyro.
  */
-static int8_t set_gyro_config(struct bmi3_dev *dev)
+static int8_t set_gyro_config(struct bmi3_dev *dev, bool keep)
 {
 
     /* Status of API are returned to this variable. */
-    int8_t rslt;
+    int8_t rslt = BMI323_OK;
 
     /* Structure to define the type of sensor and its configurations. */
-    struct bmi3_sens_config config;
+    struct bmi3_sens_config config = { 0 };
 
     /* Configure the type of feature. */
     config.type = BMI323_GYRO;
 
-    /* Get default configurations for the type of feature selected. */
-    rslt = bmi323_get_sensor_config(&config, 1, dev);
-    bmi3_error_codes_print_result("Get sensor config", rslt);
+    if (!keep)
+    {
+        /* Get default configurations for the type of feature selected. */
+        rslt = bmi323_get_sensor_config(&config, 1, dev);
+        bmi3_error_codes_print_result("Get sensor config", rslt);
+    }
 
     if (rslt == BMI323_OK)
     {
+        fill_gyro_config(&config);
 
-        /* The user can change the following configuration parameters according to their requirement. */
-        /* Output Data Rate. By default ODR is set as 100Hz for gyro. */
-        config.cfg.gyr.odr = BMI3_GYR_ODR_100HZ;
-
-        /* Gyroscope Angular Rate Measurement Range. By default the range is 2000dps. */
-        config.cfg.gyr.range = BMI3_GYR_RANGE_500DPS;
-
-        /*  The Gyroscope bandwidth coefficient defines the 3 dB cutoff frequency in relation to the ODR
-            *  Value   Name      Description
-            *    0   odr_half   BW = gyr_odr/2
-            *    1  odr_quarter BW = gyr_odr/4
-            */
-        config.cfg.gyr.bwp = BMI3_GYR_BW_ODR_HALF;
-
-        /* By default the gyro is disabled. Gyro is enabled by selecting the mode. */
-        config.cfg.gyr.gyr_mode = BMI3_GYR_MODE_NORMAL;
-
-        /* Value    Name    Description
-            *  000     avg_1   No averaging; pass sample without filtering
-            *  001     avg_2   Averaging of 2 samples
-            *  010     avg_4   Averaging of 4 samples
-            *  011     avg_8   Averaging of 8 samples
-            *  100     avg_16  Averaging of 16 samples
-            *  101     avg_32  Averaging of 32 samples
-            *  110     avg_64  Averaging of 64 samples
-            */
-        config.cfg.gyr.avg_num = BMI3_GYR_AVG1;
-
-        /* Set the gyro configurations. */
-        rslt = bmi323_set_sensor_config(&config, 1, dev);
-        bmi3_error_codes_print_result("Set sensor config", rslt);
+        if (!keep)
+        {
+            /* Set the gyro configurations. */
+            rslt = bmi323_set_sensor_config(&config, 1, dev);
+            bmi3_error_codes_print_result("Set sensor config", rslt);
+        }
+
+        /* Compute the conversion scale of the new range once, instead of on every sample. */
+        if ((rslt == BMI323_OK) && (imu_convert_set_gyro_range(config.cfg.gyr.range, dev->resolution) != 0))
+        {
+            rslt = BMI3_E_INVALID_INPUT;
+        }
         
     }
 
     return rslt;
 }
 
+#if defined(CONFIG_L3_WARM_BOOT)
 /*!
- * @brief This function converts lsb to degree per second for 16 bit gyro at
- * range 125, 250, 500, 1000 or 2000dps.
- * 
+ * @brief This internal API computes the CRC-32 of the configuration of this build.
+ *
  * @details
- *      this function works as follows -:
- *          'val' is the returned number from the gyroscope which is by default a 16-bit value 
- *                 ranging between -32768 and 32767 all-inclusive.
- *          we will first normalize this number to be in the range of '-1 to 1'. we will need to just divide 'val' by 
- *              its maximum value which is stored in the variable 'half_scale' according to the bitwidth of 'val'
- *          then depending on the sensor range whether it's '±125dps', '±250dps', '±500dps', '±1000dps' or '±2000'. We will map the values '-1 to 1' to 
- *              the range of 'dps' by simple multiplication.
- */
-static float lsb_to_dps(int16_t val, float dps, uint8_t bit_width)
+ *      the structures are filled from zero, exactly what set_accel_config() and set_gyro_config() write,
+ *      without a bus access. a build with another ODR or range gets another CRC and configures the
+ *      sensor from a reset, whatever the sensor kept.
+ */
+static uint32_t sensor_config_crc(void)
 {
-    double power = 2;
+    struct bmi3_sens_config acc = { 0 };
+    struct bmi3_sens_config gyr = { 0 };
 
-    float half_scale = (float)((pow((double)power, (double)bit_width) / 2.0f));
+    fill_accel_config(&acc);
+    fill_gyro_config(&gyr);
 
-    return (dps / (half_scale)) * (val);
-}
\ No newline at end of file
+    return crc32_ieee_update(crc32_ieee((const uint8_t *)&acc.cfg.acc, sizeof(acc.cfg.acc)),
+                             (const uint8_t *)&gyr.cfg.gyr, sizeof(gyr.cfg.gyr));
+}
+#endif
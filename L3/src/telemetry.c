@@ -0,0 +1,319 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+#include <zephyr/kernel.h>
+
+#include <string.h>
+
+// include the sys_put_le16() helpers
+#include <zephyr/sys/byteorder.h>
+
+// include the crc16_itu_t() function
+#include <zephyr/sys/crc.h>
+
+#if defined(CONFIG_BOARD_NATIVE_SIM)
+// the file is written by the host side of native_sim, refer to 'telemetry_native.c'
+#include "telemetry_native.h"
+#else
+// include the SEGGER RTT functions, the console already uses channel 0
+#include <SEGGER_RTT.h>
+#endif
+
+#if defined(CONFIG_L3_TELEMETRY_DELTA)
+// include the delta codec of the compressed sample packets
+#include "imu_codec.h"
+
+// include the cycle counter probe of the encoder, it compiles to nothing without CONFIG_L3_PROF
+#include "imu_prof.h"
+#endif
+
+#include "telemetry.h"
+
+/**
+ * Documenation links of the used functions
+ * ----------------------------------------
+ * Function                     |   Documentation Link
+ * =============================|=====================
+ * SEGGER_RTT_ConfigUpBuffer()  |   https://wiki.segger.com/RTT#SEGGER_RTT_ConfigUpBuffer.28.29
+ * SEGGER_RTT_Write()           |   https://wiki.segger.com/RTT#SEGGER_RTT_Write.28.29
+ * crc16_itu_t()                |   https://docs.zephyrproject.org/latest/doxygen/html/group__crc.html
+ */
+
+/******************************************************************************/
+/*!         Macros definition                                                 */
+
+/*! Unframed packet: header + payload + crc. */
+#define PACKET_MAX_SIZE         (TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_PAYLOAD + TELEMETRY_CRC_SIZE)
+
+/*! COBS adds one byte per started block of 254 bytes, plus the 0x00 delimiter. */
+#define FRAME_MAX_SIZE          (PACKET_MAX_SIZE + (PACKET_MAX_SIZE / 254U) + 2U)
+
+/*! Seed of the CRC-16/CCITT-FALSE. */
+#define TELEMETRY_CRC_SEED      (0xFFFFU)
+
+/*! Payload size of a TELEMETRY_TYPE_SAMPLE packet. */
+#define SAMPLE_PAYLOAD_SIZE     (16U)
+
+#if defined(CONFIG_L3_TELEMETRY_DELTA)
+BUILD_ASSERT(IMU_CODEC_MAX_SAMPLE_SIZE <= TELEMETRY_MAX_PAYLOAD, "a coded sample has to fit a packet");
+#endif
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+/*! Serialises the sequence number and the frame buffer when several threads send. */
+K_MUTEX_DEFINE(telemetry_mutex);
+
+static uint8_t packet[PACKET_MAX_SIZE];
+static uint8_t frame[FRAME_MAX_SIZE];
+static uint16_t sequence;
+static atomic_t dropped;
+
+#if defined(CONFIG_L3_TELEMETRY_DELTA)
+/*! The delta packet being filled, its encoder and the number of samples in it. */
+static uint8_t delta_payload[TELEMETRY_MAX_PAYLOAD];
+static size_t delta_len;
+static uint8_t delta_count;
+static imu_codec_t delta_codec;
+#endif
+
+#if !defined(CONFIG_BOARD_NATIVE_SIM)
+/*! Memory of the dedicated RTT up-buffer the host logger reads from. */
+static uint8_t rtt_buffer[CONFIG_L3_TELEMETRY_RTT_BUFFER_SIZE];
+#endif
+
+/******************************************************************************/
+/*!           Static Function Declaration                                     */
+
+/*!
+ *  @brief This internal function COBS encodes 'len' bytes of 'src' into 'dst' and appends the 0x00 delimiter.
+ *
+ *  @param[in]  src      : Unframed packet.
+ *  @param[in]  len      : Length of the packet.
+ *  @param[out] dst      : Framed output, at least len + len / 254 + 2 bytes.
+ *
+ *  @return Length of the frame including the delimiter.
+ */
+static size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst);
+
+/*!
+ *  @brief This internal function writes a complete frame to the channel, or nothing at all.
+ *
+ *  @return true if the frame was written.
+ */
+static bool channel_write(const uint8_t *data, size_t len);
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int telemetry_init(void)
+{
+#if defined(CONFIG_BOARD_NATIVE_SIM)
+    if (telemetry_native_open(CONFIG_L3_TELEMETRY_FILE) != 0)
+    {
+        return -EIO;
+    }
+#else
+    /* NO_BLOCK_SKIP: a frame that does not fit is skipped as a whole, the acquisition never waits for the host. */
+    if (SEGGER_RTT_ConfigUpBuffer(CONFIG_L3_TELEMETRY_RTT_CHANNEL, "L3 telemetry", rtt_buffer,
+                                  sizeof(rtt_buffer), SEGGER_RTT_MODE_NO_BLOCK_SKIP) < 0)
+    {
+        return -EIO;
+    }
+#endif
+
+    sequence = 0;
+    atomic_set(&dropped, 0);
+
+#if defined(CONFIG_L3_TELEMETRY_DELTA)
+    delta_len = 0;
+    delta_count = 0;
+#endif
+
+    return 0;
+}
+
+int telemetry_send(uint8_t type, const uint8_t *payload, size_t len)
+{
+    size_t frame_len;
+    uint16_t crc;
+    int ret = 0;
+
+    if (len > TELEMETRY_MAX_PAYLOAD)
+    {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&telemetry_mutex, K_FOREVER);
+
+    packet[0] = type;
+    sys_put_le16(sequence, &packet[1]);
+    memcpy(&packet[TELEMETRY_HEADER_SIZE], payload, len);
+
+    crc = crc16_itu_t(TELEMETRY_CRC_SEED, packet, TELEMETRY_HEADER_SIZE + len);
+    sys_put_le16(crc, &packet[TELEMETRY_HEADER_SIZE + len]);
+
+    frame_len = cobs_encode(packet, TELEMETRY_HEADER_SIZE + len + TELEMETRY_CRC_SIZE, frame);
+
+    /* The sequence advances even for a dropped frame, the host decoder reports it as a gap. */
+    sequence++;
+
+    if (!channel_write(frame, frame_len))
+    {
+        atomic_inc(&dropped);
+        ret = -ENOSPC;
+    }
+
+    k_mutex_unlock(&telemetry_mutex);
+
+    return ret;
+}
+
+#if defined(CONFIG_L3_TELEMETRY_DELTA)
+/*!
+ * @brief add one sample to the pending delta packet.
+ *
+ * @details
+ *      the packet is sent before a sample that might overflow it, so a packet never has to be cut. the
+ *      mutex is recursive, telemetry_send() takes it again from here.
+ */
+int telemetry_send_sample(const imu_sample_t *sample)
+{
+    int ret = 0;
+
+    k_mutex_lock(&telemetry_mutex, K_FOREVER);
+
+    if ((delta_len + IMU_CODEC_MAX_SAMPLE_SIZE) > TELEMETRY_MAX_PAYLOAD)
+    {
+        ret = telemetry_send(TELEMETRY_TYPE_SAMPLE_DELTA, delta_payload, delta_len);
+        delta_len = 0;
+        delta_count = 0;
+    }
+
+    /* Every packet starts a new stream, the host decodes it on its own. */
+    if (delta_count == 0)
+    {
+        imu_codec_reset(&delta_codec);
+    }
+
+    IMU_PROF_BEGIN(t_encode);
+    delta_len += imu_codec_encode(&delta_codec, sample, &delta_payload[delta_len]);
+    IMU_PROF_END(IMU_PROF_ENCODE, t_encode);
+
+    delta_count++;
+
+    if (delta_count >= CONFIG_L3_TELEMETRY_DELTA_SAMPLES)
+    {
+        ret = telemetry_send(TELEMETRY_TYPE_SAMPLE_DELTA, delta_payload, delta_len);
+        delta_len = 0;
+        delta_count = 0;
+    }
+
+    k_mutex_unlock(&telemetry_mutex);
+
+    return ret;
+}
+
+/*!
+ * @brief send the pending delta packet, if it holds any sample.
+ */
+int telemetry_flush(void)
+{
+    int ret = 0;
+
+    k_mutex_lock(&telemetry_mutex, K_FOREVER);
+
+    if (delta_count > 0)
+    {
+        ret = telemetry_send(TELEMETRY_TYPE_SAMPLE_DELTA, delta_payload, delta_len);
+        delta_len = 0;
+        delta_count = 0;
+    }
+
+    k_mutex_unlock(&telemetry_mutex);
+
+    return ret;
+}
+#else
+int telemetry_send_sample(const imu_sample_t *sample)
+{
+    uint8_t payload[SAMPLE_PAYLOAD_SIZE];
+
+    sys_put_le32(sample->sensor_time, &payload[0]);
+    sys_put_le16((uint16_t)sample->acc_x, &payload[4]);
+    sys_put_le16((uint16_t)sample->acc_y, &payload[6]);
+    sys_put_le16((uint16_t)sample->acc_z, &payload[8]);
+    sys_put_le16((uint16_t)sample->gyr_x, &payload[10]);
+    sys_put_le16((uint16_t)sample->gyr_y, &payload[12]);
+    sys_put_le16((uint16_t)sample->gyr_z, &payload[14]);
+
+    return telemetry_send(TELEMETRY_TYPE_SAMPLE, payload, sizeof(payload));
+}
+
+int telemetry_flush(void)
+{
+    /* Every sample went out as a packet of its own, nothing is pending. */
+    return 0;
+}
+#endif
+
+uint32_t telemetry_dropped(void)
+{
+    return (uint32_t)atomic_get(&dropped);
+}
+
+/*!
+ * @brief This internal function COBS encodes a packet.
+ *
+ * @details
+ *      Consistent Overhead Byte Stuffing replaces every 0x00 of the packet by the distance to the next
+ *      0x00, so the only 0x00 on the wire is the frame delimiter.
+ */
+static size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t read_idx = 0;
+    size_t write_idx = 1;
+    size_t code_idx = 0;
+    uint8_t code = 1;
+
+    while (read_idx < len)
+    {
+        if (src[read_idx] == 0)
+        {
+            dst[code_idx] = code;
+            code_idx = write_idx++;
+            code = 1;
+        }
+        else
+        {
+            dst[write_idx++] = src[read_idx];
+            code++;
+
+            if (code == 0xFF)
+            {
+                dst[code_idx] = code;
+                code_idx = write_idx++;
+                code = 1;
+            }
+        }
+
+        read_idx++;
+    }
+
+    dst[code_idx] = code;
+    dst[write_idx++] = 0x00;
+
+    return write_idx;
+}
+
+/*!
+ * @brief This internal function writes a complete frame to the channel.
+ */
+static bool channel_write(const uint8_t *data, size_t len)
+{
+#if defined(CONFIG_BOARD_NATIVE_SIM)
+    return telemetry_native_write(data, len) == (int)len;
+#else
+    return SEGGER_RTT_Write(CONFIG_L3_TELEMETRY_RTT_CHANNEL, data, len) == len;
+#endif
+}
@@ -0,0 +1,196 @@
+
+/**
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @title          :   binary framed telemetry channel                                                                             |
+ * |    @file           :   telemetry.h                                                                                                 |
+ * |    @author         :   Abdelrahman Mohamed Salem                                                                                   |
+ * |    @origin_date    :   17/10/2026                                                                                                  |
+ * |    @version        :   1.0.0                                                                                                       |
+ * |    @tool_chain     :   nRF Connect SDK                                                                                             |
+ * |    @compiler       :   zephyr SDK toolchain                                                                                        |
+ * |    @C_standard     :   ISO C99 (-std=c99)                                                                                          |
+ * |    @target         :   nRF52832                                                                                                    |
+ * |    @notes          :   None                                                                                                        |
+ * |    @license        :   MIT License                                                                                                 |
+ * |    @brief          :   this file provides COBS framed binary packets over a dedicated RTT channel (or a file on native_sim)        |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    MIT License                                                                                                                     |
+ * |                                                                                                                                    |
+ * |    Copyright (c) - 2024 - Abdelrahman Mohamed Salem - All Rights Reserved                                                          |
+ * |                                                                                                                                    |
+ * |    Permission is hereby granted, free of charge, to any person obtaining a copy                                                    |
+ * |    of this software and associated documentation files (the "Software"), to deal                                                   |
+ * |    in the Software without restriction, including without limitation the rights                                                    |
+ * |    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell                                                       |
+ * |    copies of the Software, and to permit persons to whom the Software is                                                           |
+ * |    furnished to do so, subject to the following conditions:                                                                        |
+ * |                                                                                                                                    |
+ * |    The above copyright notice and this permission notice shall be included in all                                                  |
+ * |    copies or substantial portions of the Software.                                                                                 |
+ * |                                                                                                                                    |
+ * |    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR                                                      |
+ * |    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,                                                        |
+ * |    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE                                                     |
+ * |    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER                                                          |
+ * |    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,                                                   |
+ * |    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE                                                   |
+ * |    SOFTWARE.                                                                                                                       |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ * |    @history_change_list                                                                                                            |
+ * |    ====================                                                                                                            |
+ * |    Date            Version         Author                          Description                                                     |
+ * |    17/10/2026      1.0.0           Abdelrahman Mohamed Salem       file Created.                                                   |
+ * --------------------------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+/******************************************************************************
+ * Includes
+ *******************************************************************************/
+
+/**
+ * @reason: provide the'uint8_t' type-defined data-types
+ */
+#include <stdint.h>
+
+/**
+ * @reason: provide the 'size_t' data-type
+ */
+#include <stddef.h>
+
+/**
+ * @reason: provide the 'imu_sample_t' type
+ */
+#include "imu_sample.h"
+
+/******************************************************************************
+ * Preprocessor Constants
+ *******************************************************************************/
+
+/**
+ * packet layout before framing (all fields little-endian):
+ *
+ *      | type (1) | sequence (2) | payload (n) | crc16 (2) |
+ *
+ * the crc is CRC-16/CCITT-FALSE (poly 0x1021, seed 0xFFFF) over type, sequence and payload.
+ * the packet is then COBS encoded and terminated by a 0x00 byte, so a decoder can resynchronise
+ * at the next 0x00 after any lost or corrupted byte. refer to 'tools/telemetry_decode.py'.
+ */
+#define TELEMETRY_HEADER_SIZE           (3U)
+#define TELEMETRY_CRC_SIZE              (2U)
+
+/**
+ * the biggest payload a single packet can carry, below 254 so that COBS adds a single byte
+ */
+#define TELEMETRY_MAX_PAYLOAD           (240U)
+
+/**
+ * packet types, the host decoder dispatches on them
+ */
+#define TELEMETRY_TYPE_SAMPLE           (0x01U)     /**< sensor time (4) + acc x/y/z (6) + gyr x/y/z (6) */
+#define TELEMETRY_TYPE_SAMPLE_DELTA     (0x02U)     /**< up to CONFIG_L3_TELEMETRY_DELTA_SAMPLES samples, refer to 'imu_codec.h' */
+#define TELEMETRY_TYPE_STATS            (0x03U)     /**< summary of one window of CONFIG_L3_STATS, refer to 'imu_stats.h' */
+
+/******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/**
+ *  \b function                                 :       int telemetry_init(void);
+ *  \b Description                              :       open the telemetry channel: a dedicated RTT up-buffer on the target, or the file
+ *                                                      'CONFIG_L3_TELEMETRY_FILE' when running on native_sim.
+ *  @note                                       :       the console keeps its own RTT channel 0, the telemetry never mixes with printk.
+ *  \b PRE-CONDITION                            :       None.
+ *  \b POST-CONDITION                           :       telemetry_send() can be used.
+ *  @return                                     :       0 on success, -EIO if the channel could not be opened.
+ *  @see                                        :       int telemetry_send(uint8_t type, const uint8_t *payload, size_t len);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int telemetry_init(void);
+
+
+/**
+ *  \b function                                 :       int telemetry_send(uint8_t type, const uint8_t *payload, size_t len);
+ *  \b Description                              :       frame one packet and write it to the telemetry channel without blocking.
+ *  @param  type [IN]                           :       packet type, refer to @TELEMETRY_TYPE_SAMPLE.
+ *  @param  payload [IN]                        :       packet payload.
+ *  @param  len [IN]                            :       payload length, at most @TELEMETRY_MAX_PAYLOAD.
+ *  @note                                       :       a packet that does not fit in the channel is dropped as a whole (never truncated)
+ *                                                      and counted, the sequence number still advances so the host sees the gap.
+ *  \b PRE-CONDITION                            :       telemetry_init() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       0 on success, -EINVAL if the payload is too big, -ENOSPC if the packet was dropped.
+ *  @see                                        :       int telemetry_send_sample(const imu_sample_t *sample);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int telemetry_send(uint8_t type, const uint8_t *payload, size_t len);
+
+
+/**
+ *  \b function                                 :       int telemetry_send_sample(const imu_sample_t *sample);
+ *  \b Description                              :       send one raw sample as a @TELEMETRY_TYPE_SAMPLE packet (23 bytes on the wire), or with
+ *                                                      CONFIG_L3_TELEMETRY_DELTA add it to the pending @TELEMETRY_TYPE_SAMPLE_DELTA packet.
+ *  @param  sample [IN]                         :       the sample to send.
+ *  @note                                       :       a delta packet is sent once it holds CONFIG_L3_TELEMETRY_DELTA_SAMPLES samples, the
+ *                                                      next sample might not fit or telemetry_flush() is called. its first sample is coded in full, a lost packet only loses
+ *                                                      its own samples.
+ *  \b PRE-CONDITION                            :       telemetry_init() succeeded.
+ *  \b POST-CONDITION                           :       None.
+ *  @return                                     :       refer to telemetry_send(), 0 if the sample was only buffered.
+ *  @see                                        :       int telemetry_send(uint8_t type, const uint8_t *payload, size_t len);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int telemetry_send_sample(const imu_sample_t *sample);
+
+
+/**
+ *  \b function                                 :       int telemetry_flush(void);
+ *  \b Description                              :       send the pending @TELEMETRY_TYPE_SAMPLE_DELTA packet even if it is not full.
+ *  @note                                       :       call it when the acquisition stops or the replay ends, the last samples of a run wait in
+ *                                                      the pending packet otherwise. nothing to do without CONFIG_L3_TELEMETRY_DELTA.
+ *  \b PRE-CONDITION                            :       telemetry_init() succeeded.
+ *  \b POST-CONDITION                           :       no sample is pending.
+ *  @return                                     :       refer to telemetry_send(), 0 if no sample was pending.
+ *  @see                                        :       int telemetry_send_sample(const imu_sample_t *sample);
+ *
+ * <br><b> - HISTORY OF CHANGES - </b>
+ * <table align="left" style="width:800px">
+ * <tr><td> Date       </td><td> Software Version </td><td> Initials </td><td> Description </td></tr>
+ * <tr><td> 17/10/2026 </td><td> 1.0.0            </td><td> AMS      </td><td> Interface Created </td></tr>
+ * </table><br><br>
+ * <hr>
+ */
+int telemetry_flush(void);
+
+
+/**
+ *  \b function                                 :       uint32_t telemetry_dropped(void);
+ *  \b Description                              :       number of packets dropped because the channel was full.
+ *  @return                                     :       the drop counter.
+ */
+uint32_t telemetry_dropped(void);
+
+
+/*** End of File **************************************************************/
+
+#endif /*TELEMETRY_H_*/
@@ -0,0 +1,43 @@
+/******************************************************************************/
+/*!                 Header Files                                              */
+
+/*
+ * NOTE: this file is compiled in the native_sim runner (host) context and linked with the host C library,
+ * that is why it can use fopen()/fwrite(). it must not include any zephyr header.
+ * documentation can be found at: https://docs.zephyrproject.org/latest/boards/native/native_sim/doc/index.html
+ */
+#include <stdio.h>
+
+#include "telemetry_native.h"
+
+/******************************************************************************/
+/*!         Static Variables                                                  */
+
+static FILE *telemetry_file;
+
+/******************************************************************************/
+/*!            Functions                                                      */
+
+int telemetry_native_open(const char *path)
+{
+    telemetry_file = fopen(path, "wb");
+
+    return (telemetry_file != NULL) ? 0 : -1;
+}
+
+int telemetry_native_write(const void *data, size_t len)
+{
+    size_t written;
+
+    if (telemetry_file == NULL)
+    {
+        return 0;
+    }
+
+    written = fwrite(data, 1, len, telemetry_file);
+
+    /* Flush every frame, the simulation is usually ended with Ctrl+C. */
+    fflush(telemetry_file);
+
+    return (int)written;
+}
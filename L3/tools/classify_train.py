@@ -0,0 +1,505 @@
+#!/usr/bin/env python3
+"""
+train the activity classifier of L3 (CONFIG_L3_CLASSIFY) and export it as 'src/imu_classify_model.h'.
+
+the features are computed exactly like 'src/imu_classify.c' does on the device, over windows of WINDOW
+samples at RATE Hz:
+
+    - per axis (acc x, y, z in g, gyr x, y, z in dps): mean, log(variance), zero crossings of the mean
+    - per magnitude (|acc| and |gyr|, mean removed, Hann window, FFT): log(power) of BANDS equal bands
+
+the network is a small MLP (features -> HIDDEN ReLU -> classes) trained in float, then quantized to int8
+the way CMSIS-NN expects it (int8 weights, int32 biases, per-tensor requantization multiplier / shift).
+the accuracy of the int8 network is checked with the integer arithmetic of arm_fully_connected_s8().
+
+recordings are CSV files of 'telemetry_decode.py' or 'imu_log_decode.py', one file (or more) per class:
+
+    python3 classify_train.py still=still.csv walk=walk.csv run=run.csv shake=shake.csv -o ../src/imu_classify_model.h
+
+without recordings, '--synthetic' trains on generated windows of the same classes, only good to try the
+stage out:
+
+    python3 classify_train.py --synthetic -o ../src/imu_classify_model.h
+
+the raw values are scaled with the ranges 'src/main.c' configures (4 g, 500 dps), refer to '--acc-lsb'
+and '--gyr-lsb' for other ranges. only the standard library is used, training takes seconds.
+"""
+
+import argparse
+import cmath
+import csv
+import math
+import random
+import sys
+
+# keep in sync with 'src/imu_classify.c'
+VAR_EPS = 1e-6
+BAND_EPS = 1e-6
+INPUT_SCALE = 32.0          # int8 input = standardised feature * INPUT_SCALE
+SOFTMAX_INT_BITS = 5        # kScaledDiffIntegerBits of the TFLite / CMSIS-NN softmax
+
+AXES = ("acc_x", "acc_y", "acc_z", "gyr_x", "gyr_y", "gyr_z")
+
+
+# --------------------------------------------------------------------------------------------------
+# features
+# --------------------------------------------------------------------------------------------------
+
+def fft(values):
+    """iterative radix-2 FFT, len(values) is a power of 2."""
+    n = len(values)
+    out = [complex(v) for v in values]
+    j = 0
+    for i in range(1, n):
+        bit = n >> 1
+        while j & bit:
+            j ^= bit
+            bit >>= 1
+        j |= bit
+        if i < j:
+            out[i], out[j] = out[j], out[i]
+    size = 2
+    while size <= n:
+        step = cmath.exp(-2j * math.pi / size)
+        for start in range(0, n, size):
+            w = 1.0
+            for k in range(size // 2):
+                a = out[start + k]
+                b = out[start + k + size // 2] * w
+                out[start + k] = a + b
+                out[start + k + size // 2] = a - b
+                w *= step
+        size *= 2
+    return out
+
+
+def band_features(signal, bands, hann):
+    """log power of 'bands' equal bands of the one sided spectrum, like analyse_magnitude() of the device."""
+    n = len(signal)
+    mean = sum(signal) / n
+    spectrum = fft([(v - mean) * w for v, w in zip(signal, hann)])
+    bins = n // 2
+    power = [0.0] * bands
+    for k in range(1, bins):
+        power[(k * bands) // bins] += abs(spectrum[k]) ** 2
+    scale = 2.0 / (0.375 * n * n)
+    return [math.log(p * scale + BAND_EPS) for p in power]
+
+
+def window_features(rows, bands, acc_lsb, gyr_lsb, hann):
+    """features of one window, 'rows' are (acc_x .. gyr_z) raw values."""
+    n = len(rows)
+    features = []
+    units = []
+    for axis in range(6):
+        scale = 1.0 / (acc_lsb if axis < 3 else gyr_lsb)
+        values = [row[axis] * scale for row in rows]
+        units.append(values)
+        mean = sum(values) / n
+        var = sum((v - mean) ** 2 for v in values) / n
+        crossings = sum(1 for i in range(1, n) if ((values[i - 1] - mean) < 0) != ((values[i] - mean) < 0))
+        features += [mean, math.log(var + VAR_EPS), float(crossings)]
+    for first in (0, 3):
+        magnitude = [math.sqrt(units[first][i] ** 2 + units[first + 1][i] ** 2 + units[first + 2][i] ** 2)
+                     for i in range(n)]
+        features += band_features(magnitude, bands, hann)
+    return features
+
+
+def hann_window(n):
+    return [0.5 * (1.0 - math.cos(2.0 * math.pi * i / n)) for i in range(n)]
+
+
+# --------------------------------------------------------------------------------------------------
+# data
+# --------------------------------------------------------------------------------------------------
+
+def load_csv(path, window, hop, rate):
+    """sliding windows over a recording, a gap in the sensor time starts over."""
+    nominal = 25600.0 / rate
+    windows = []
+    run = []
+    last = None
+    with open(path, newline="") as handle:
+        for record in csv.DictReader(handle):
+            time = int(record["sensor_time"])
+            if last is not None and ((time - last) & 0xFFFFFFFF) > 1.5 * nominal:
+                run = []
+            last = time
+            run.append(tuple(int(record[axis]) for axis in AXES))
+            if len(run) == window:
+                windows.append(list(run))
+                run = run[hop:]
+    return windows
+
+
+def synthetic_window(label, window, rate, acc_lsb, gyr_lsb, rng):
+    """one window of a made-up recording: a random orientation, a periodic motion and sensor noise."""
+    def unit():
+        while True:
+            v = [rng.gauss(0, 1) for _ in range(3)]
+            norm = math.sqrt(sum(x * x for x in v))
+            if norm > 1e-3:
+                return [x / norm for x in v]
+
+    gravity = unit()
+    side = unit()
+    turn = unit()
+    phase = rng.uniform(0, 2 * math.pi)
+    if label == "still":
+        freq, vertical, lateral, rate_dps = 0.0, 0.0, 0.0, 0.0
+    elif label == "walk":
+        freq, vertical, lateral, rate_dps = rng.uniform(1.6, 2.2), rng.uniform(0.2, 0.4), 0.1, rng.uniform(20, 40)
+    elif label == "run":
+        freq, vertical, lateral, rate_dps = rng.uniform(2.5, 3.2), rng.uniform(0.8, 1.4), 0.3, rng.uniform(80, 150)
+    else:
+        freq, vertical, lateral, rate_dps = rng.uniform(5.0, 10.0), rng.uniform(1.0, 1.8), 0.2, rng.uniform(100, 300)
+    bias = [rng.uniform(-0.5, 0.5) for _ in range(3)]
+
+    rows = []
+    for i in range(window):
+        t = i / rate
+        step = math.sin(2 * math.pi * freq * t + phase)
+        sway = math.sin(math.pi * freq * t + phase)
+        acc = [gravity[a] * (1.0 + vertical * step + 0.3 * vertical * step * step)
+               + side[a] * lateral * sway + rng.gauss(0, 0.002) for a in range(3)]
+        gyr = [turn[a] * rate_dps * sway + bias[a] + rng.gauss(0, 0.1) for a in range(3)]
+        raw = [round(v * acc_lsb) for v in acc] + [round(v * gyr_lsb) for v in gyr]
+        rows.append(tuple(max(-32768, min(32767, v)) for v in raw))
+    return rows
+
+
+# --------------------------------------------------------------------------------------------------
+# float network
+# --------------------------------------------------------------------------------------------------
+
+def forward(net, x):
+    w1, b1, w2, b2 = net
+    hidden = [max(0.0, b + sum(w * v for w, v in zip(row, x))) for row, b in zip(w1, b1)]
+    logits = [b + sum(w * h for w, h in zip(row, hidden)) for row, b in zip(w2, b2)]
+    return hidden, logits
+
+
+def softmax(logits):
+    top = max(logits)
+    e = [math.exp(v - top) for v in logits]
+    total = sum(e)
+    return [v / total for v in e]
+
+
+def train(data, features, hidden, classes, epochs, rng):
+    """mini-batch Adam on the cross entropy, small enough for pure Python."""
+    def init(rows, cols):
+        bound = math.sqrt(6.0 / (rows + cols))
+        return [[rng.uniform(-bound, bound) for _ in range(cols)] for _ in range(rows)]
+
+    net = [init(hidden, features), [0.0] * hidden, init(classes, hidden), [0.0] * classes]
+    shapes = [(hidden, features), (hidden, 1), (classes, hidden), (classes, 1)]
+    m = [[[0.0] * c for _ in range(r)] for r, c in shapes]
+    v = [[[0.0] * c for _ in range(r)] for r, c in shapes]
+    rate, beta1, beta2, t = 0.01, 0.9, 0.999, 0
+
+    for epoch in range(epochs):
+        rng.shuffle(data)
+        loss = 0.0
+        for start in range(0, len(data), 16):
+            batch = data[start:start + 16]
+            grads = [[[0.0] * c for _ in range(r)] for r, c in shapes]
+            for x, label in batch:
+                h, logits = forward(net, x)
+                p = softmax(logits)
+                loss -= math.log(max(p[label], 1e-12))
+                d_logits = [p[c] - (1.0 if c == label else 0.0) for c in range(classes)]
+                d_hidden = [0.0] * hidden
+                for c in range(classes):
+                    grads[3][c][0] += d_logits[c]
+                    for j in range(hidden):
+                        grads[2][c][j] += d_logits[c] * h[j]
+                        d_hidden[j] += d_logits[c] * net[2][c][j]
+                for j in range(hidden):
+                    if h[j] <= 0.0:
+                        continue
+                    grads[1][j][0] += d_hidden[j]
+                    for i in range(features):
+                        grads[0][j][i] += d_hidden[j] * x[i]
+            t += 1
+            for p_idx, (r, c) in enumerate(shapes):
+                for i in range(r):
+                    for j in range(c):
+                        g = grads[p_idx][i][j] / len(batch)
+                        m[p_idx][i][j] = beta1 * m[p_idx][i][j] + (1 - beta1) * g
+                        v[p_idx][i][j] = beta2 * v[p_idx][i][j] + (1 - beta2) * g * g
+                        step = rate * (m[p_idx][i][j] / (1 - beta1 ** t)) / (math.sqrt(v[p_idx][i][j] / (1 - beta2 ** t)) + 1e-8)
+                        if c == 1:
+                            net[p_idx][i] -= step
+                        else:
+                            net[p_idx][i][j] -= step
+        if epoch % 20 == 0 or epoch == epochs - 1:
+            print("epoch %3d, loss %.4f" % (epoch, loss / len(data)), file=sys.stderr)
+    return net
+
+
+# --------------------------------------------------------------------------------------------------
+# int8 network, the arithmetic of CMSIS-NN
+# --------------------------------------------------------------------------------------------------
+
+def quantize_multiplier(real):
+    """QuantizeMultiplier() of TFLite: real = multiplier / 2^31 * 2^shift."""
+    if real == 0.0:
+        return 0, 0
+    q, shift = math.frexp(real)
+    fixed = int(round(q * (1 << 31)))
+    if fixed == (1 << 31):
+        fixed //= 2
+        shift += 1
+    return fixed, shift
+
+
+def requantize(value, multiplier, shift):
+    """arm_nn_requantize(): doubling high multiply, then a rounding right shift."""
+    value = value << max(shift, 0)
+    product = (1 << 30) if (value < 0) == (multiplier < 0) else (1 - (1 << 30))
+    product += value * multiplier
+    high = int(product / (1 << 31))
+    exponent = max(-shift, 0)
+    mask = (1 << exponent) - 1
+    result = high >> exponent
+    threshold = (mask >> 1) + (1 if result < 0 else 0)
+    if (high & mask) > threshold:
+        result += 1
+    return result
+
+
+def fully_connected(x, weights, biases, input_offset, multiplier, shift, output_offset, act_min, act_max):
+    """arm_fully_connected_s8() for one batch, the filter offset is 0 (symmetric weights)."""
+    out = []
+    for row, bias in zip(weights, biases):
+        acc = bias + sum((v + input_offset) * w for v, w in zip(x, row))
+        out.append(max(act_min, min(act_max, requantize(acc, multiplier, shift) + output_offset)))
+    return out
+
+
+def quantize_input(features, mean, scale):
+    return [max(-128, min(127, int(round((f - m) * s)))) for f, m, s in zip(features, mean, scale)]
+
+
+def quantize_net(net, calibration):
+    """int8 weights and activations, the ranges of the activations come from the training windows."""
+    w1, b1, w2, b2 = net
+    in_scale = 1.0 / INPUT_SCALE
+
+    hidden_max = 1e-6
+    logit_min, logit_max = 0.0, 0.0
+    for x in calibration:
+        h, logits = forward(net, x)
+        hidden_max = max(hidden_max, max(h))
+        logit_min = min(logit_min, min(logits))
+        logit_max = max(logit_max, max(logits))
+
+    w1_scale = max(abs(w) for row in w1 for w in row) / 127.0
+    hidden_scale = hidden_max / 255.0
+    q = {
+        "w1": [[int(round(w / w1_scale)) for w in row] for row in w1],
+        "b1": [int(round(b / (in_scale * w1_scale))) for b in b1],
+        "hidden_offset": -128,
+    }
+    q["m1"], q["s1"] = quantize_multiplier(in_scale * w1_scale / hidden_scale)
+
+    w2_scale = max(abs(w) for row in w2 for w in row) / 127.0
+    logit_scale = (logit_max - logit_min) / 255.0
+    q["w2"] = [[int(round(w / w2_scale)) for w in row] for row in w2]
+    q["b2"] = [int(round(b / (hidden_scale * w2_scale))) for b in b2]
+    q["logit_offset"] = max(-128, min(127, int(round(-128 - logit_min / logit_scale))))
+    q["m2"], q["s2"] = quantize_multiplier(hidden_scale * w2_scale / logit_scale)
+
+    # PreprocessSoftmaxScaling() and CalculateInputRadius() of TFLite, beta = 1
+    real = min(logit_scale * (1 << (31 - SOFTMAX_INT_BITS)), (1 << 31) - 1.0)
+    q["sm_mult"], q["sm_shift"] = quantize_multiplier(real)
+    radius = ((1 << SOFTMAX_INT_BITS) - 1) * (1 << (31 - SOFTMAX_INT_BITS)) / (1 << q["sm_shift"])
+    q["sm_diff_min"] = -int(math.floor(radius))
+    q["logit_scale"] = logit_scale
+    return q
+
+
+def run_int8(q, x):
+    hidden = fully_connected(x, q["w1"], q["b1"], 0, q["m1"], q["s1"], q["hidden_offset"], -128, 127)
+    return fully_connected(hidden, q["w2"], q["b2"], -q["hidden_offset"], q["m2"], q["s2"], q["logit_offset"], -128, 127)
+
+
+# --------------------------------------------------------------------------------------------------
+# export
+# --------------------------------------------------------------------------------------------------
+
+def c_array(values, per_line=16):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(str(v) for v in values[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def c_floats(values, per_line=6):
+    return c_array(["%.8ef" % v for v in values], per_line)
+
+
+def write_header(path, args, labels, mean, scale, q, features, source):
+    hidden = len(q["b1"])
+    flat_w1 = [w for row in q["w1"] for w in row]
+    flat_w2 = [w for row in q["w2"] for w in row]
+    text = """/*
+ * activity classifier of L3, generated by 'tools/classify_train.py', do not edit.
+ *
+ * trained on: {source}
+ * features: {features} per window of {window} samples at {rate} Hz ({bands} bands per magnitude)
+ * network: {features} -> {hidden} (ReLU) -> {classes}, int8 weights, {weight_bytes} bytes of weights and biases
+ */
+
+#ifndef IMU_CLASSIFY_MODEL_H_
+#define IMU_CLASSIFY_MODEL_H_
+
+#include <stdint.h>
+
+#define IMU_CLASSIFY_MODEL_RATE_HZ          ({rate}U)
+#define IMU_CLASSIFY_MODEL_WINDOW           ({window}U)
+#define IMU_CLASSIFY_MODEL_BANDS            ({bands}U)
+#define IMU_CLASSIFY_MODEL_FEATURES         ({features}U)
+#define IMU_CLASSIFY_MODEL_HIDDEN           ({hidden}U)
+#define IMU_CLASSIFY_MODEL_CLASSES          ({classes}U)
+
+/* requantization of the layers (multiplier, shift) and the zero points of their outputs */
+#define IMU_CLASSIFY_MODEL_L1_MULT          ({m1})
+#define IMU_CLASSIFY_MODEL_L1_SHIFT         ({s1})
+#define IMU_CLASSIFY_MODEL_L1_OUT_OFFSET    ({hidden_offset})
+#define IMU_CLASSIFY_MODEL_L2_MULT          ({m2})
+#define IMU_CLASSIFY_MODEL_L2_SHIFT         ({s2})
+#define IMU_CLASSIFY_MODEL_L2_OUT_OFFSET    ({logit_offset})
+
+/* arm_softmax_s8() of the logits */
+#define IMU_CLASSIFY_MODEL_SM_MULT          ({sm_mult})
+#define IMU_CLASSIFY_MODEL_SM_SHIFT         ({sm_shift})
+#define IMU_CLASSIFY_MODEL_SM_DIFF_MIN      ({sm_diff_min})
+
+static const char *const imu_classify_model_labels[IMU_CLASSIFY_MODEL_CLASSES] = {{
+    {labels}
+}};
+
+/* int8 input = (feature - mean) * scale */
+static const float imu_classify_model_feature_mean[IMU_CLASSIFY_MODEL_FEATURES] = {{
+{mean}
+}};
+
+static const float imu_classify_model_feature_scale[IMU_CLASSIFY_MODEL_FEATURES] = {{
+{scale}
+}};
+
+/* [IMU_CLASSIFY_MODEL_HIDDEN][IMU_CLASSIFY_MODEL_FEATURES] */
+static const int8_t imu_classify_model_w1[IMU_CLASSIFY_MODEL_HIDDEN * IMU_CLASSIFY_MODEL_FEATURES] = {{
+{w1}
+}};
+
+static const int32_t imu_classify_model_b1[IMU_CLASSIFY_MODEL_HIDDEN] = {{
+{b1}
+}};
+
+/* [IMU_CLASSIFY_MODEL_CLASSES][IMU_CLASSIFY_MODEL_HIDDEN] */
+static const int8_t imu_classify_model_w2[IMU_CLASSIFY_MODEL_CLASSES * IMU_CLASSIFY_MODEL_HIDDEN] = {{
+{w2}
+}};
+
+static const int32_t imu_classify_model_b2[IMU_CLASSIFY_MODEL_CLASSES] = {{
+{b2}
+}};
+
+#endif /*IMU_CLASSIFY_MODEL_H_*/
+""".format(source=source, features=features, window=args.window, rate=args.rate, bands=args.bands,
+           hidden=hidden, classes=len(labels),
+           weight_bytes=len(flat_w1) + len(flat_w2) + 4 * (len(q["b1"]) + len(q["b2"])),
+           m1=q["m1"], s1=q["s1"], hidden_offset=q["hidden_offset"],
+           m2=q["m2"], s2=q["s2"], logit_offset=q["logit_offset"],
+           sm_mult=q["sm_mult"], sm_shift=q["sm_shift"], sm_diff_min=q["sm_diff_min"],
+           labels=", ".join('"%s"' % label for label in labels),
+           mean=c_floats(mean), scale=c_floats(scale),
+           w1=c_array(flat_w1, features), b1=c_array(q["b1"], 8),
+           w2=c_array(flat_w2, hidden), b2=c_array(q["b2"], 8))
+    with open(path, "w") as handle:
+        handle.write(text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("recordings", nargs="*", help="label=file.csv, a label may be given more than once")
+    parser.add_argument("--synthetic", action="store_true", help="train on generated windows (still, walk, run, shake)")
+    parser.add_argument("-o", "--output", default="imu_classify_model.h", help="header to write")
+    parser.add_argument("--rate", type=int, default=100, help="sample rate of the classified samples (ODR / decimation)")
+    parser.add_argument("--window", type=int, default=128, help="samples per window, a power of 2")
+    parser.add_argument("--hop", type=int, default=32, help="hop between the training windows of a recording")
+    parser.add_argument("--bands", type=int, default=4, help="bands per magnitude spectrum")
+    parser.add_argument("--hidden", type=int, default=16, help="neurons of the hidden layer")
+    parser.add_argument("--epochs", type=int, default=60)
+    parser.add_argument("--acc-lsb", type=float, default=8192.0, help="LSB per g (4 g range)")
+    parser.add_argument("--gyr-lsb", type=float, default=65.536, help="LSB per dps (500 dps range)")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    if args.window & (args.window - 1) or args.window < 32:
+        parser.error("the window has to be a power of 2 of at least 32 (arm_rfft_fast_f32)")
+
+    rng = random.Random(args.seed)
+    hann = hann_window(args.window)
+
+    windows = {}
+    if args.synthetic:
+        for label in ("still", "walk", "run", "shake"):
+            windows[label] = [synthetic_window(label, args.window, args.rate, args.acc_lsb, args.gyr_lsb, rng)
+                              for _ in range(80)]
+        source = "synthetic windows (--synthetic), replace with recordings"
+    else:
+        if not args.recordings:
+            parser.error("give label=file.csv recordings or --synthetic")
+        for item in args.recordings:
+            label, _, path = item.partition("=")
+            if not path:
+                parser.error("'%s' is not label=file.csv" % item)
+            windows.setdefault(label, []).extend(load_csv(path, args.window, args.hop, args.rate))
+        source = ", ".join(args.recordings)
+
+    labels = list(windows)
+    samples = []
+    for index, label in enumerate(labels):
+        print("%s: %d windows" % (label, len(windows[label])), file=sys.stderr)
+        for rows in windows[label]:
+            samples.append((window_features(rows, args.bands, args.acc_lsb, args.gyr_lsb, hann), index))
+
+    features = len(samples[0][0])
+    mean = [sum(x[i] for x, _ in samples) / len(samples) for i in range(features)]
+    std = [math.sqrt(sum((x[i] - mean[i]) ** 2 for x, _ in samples) / len(samples)) for i in range(features)]
+    scale = [INPUT_SCALE / max(s, 1e-6) for s in std]
+    standard = [([(v - m) / max(s, 1e-6) for v, m, s in zip(x, mean, std)], label) for x, label in samples]
+
+    rng.shuffle(standard)
+    split = max(1, len(standard) // 5)
+    test, training = standard[:split], standard[split:]
+
+    net = train(training, features, args.hidden, len(labels), args.epochs, rng)
+    q = quantize_net(net, [x for x, _ in training])
+
+    float_ok = sum(1 for x, label in test if max(range(len(labels)), key=lambda c: forward(net, x)[1][c]) == label)
+    int8_ok = 0
+    confusion = [[0] * len(labels) for _ in labels]
+    for x, label in test:
+        logits = run_int8(q, [max(-128, min(127, int(round(v * INPUT_SCALE)))) for v in x])
+        guess = max(range(len(labels)), key=lambda c: logits[c])
+        confusion[label][guess] += 1
+        int8_ok += guess == label
+
+    print("held out %d windows: float %.1f %%, int8 %.1f %%"
+          % (len(test), 100.0 * float_ok / len(test), 100.0 * int8_ok / len(test)), file=sys.stderr)
+    print("confusion (rows: truth, columns: int8 guess, %s)" % ", ".join(labels), file=sys.stderr)
+    for label, row in zip(labels, confusion):
+        print("  %-8s %s" % (label, " ".join("%4d" % v for v in row)), file=sys.stderr)
+
+    write_header(args.output, args, labels, mean, scale, q, features, source)
+    print("wrote %s" % args.output, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
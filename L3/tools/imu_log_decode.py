@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""
+decode the flash log of L3 (CONFIG_L3_LOG) from a captured console into CSV.
+
+at startup the application prints every block of the log as one line (CONFIG_L3_LOG_DUMP_AT_BOOT):
+
+    imu_log: dump begin
+    imu_log: 01020040000000...
+    imu_log: dump end, 312 blocks
+
+a block is (all fields little-endian, refer to 'src/imu_log.h'):
+
+    | version (1) | session (2) | samples (2) | dropped (2) | samples coded by 'imu_codec' (n) | 0xFF padding |
+
+the samples of a block are delta coded from zero like one delta telemetry packet, the decoder of
+'telemetry_decode.py' is reused.
+
+capturing the console:
+    - on the board, log the RTT console (channel 0), e.g.:
+          JLinkRTTLogger -Device NRF52832_XXAA -If SWD -Speed 4000 -RTTChannel 0 console.txt
+    - on native_sim, redirect the output of zephyr.exe to a file.
+
+usage:
+    python3 imu_log_decode.py console.txt > samples.csv
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+from telemetry_decode import SAMPLE_COLUMNS, delta_decode
+
+# keep in sync with IMU_LOG_BLOCK_VERSION and IMU_LOG_BLOCK_HEADER_SIZE
+BLOCK_VERSION = 1
+BLOCK_HEADER = struct.Struct("<BHHH")
+
+LINE = re.compile(r"imu_log: ([0-9a-f]+)\s*$")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="captured console ('-' for stdin)")
+    parser.add_argument("--session", type=int, help="only export this session")
+    args = parser.parse_args()
+
+    text = sys.stdin.read() if args.input == "-" else open(args.input, errors="replace").read()
+
+    print("session,block," + SAMPLE_COLUMNS)
+
+    blocks = 0
+    bad = 0
+    samples = 0
+    dropped = 0
+    stored = 0
+    sessions = set()
+    for line in text.splitlines():
+        match = LINE.search(line)
+        if not match:
+            continue
+        try:
+            block = bytes.fromhex(match.group(1))
+            version, session, count, lost = BLOCK_HEADER.unpack_from(block)
+            if version != BLOCK_VERSION:
+                raise ValueError("version %d" % version)
+            rows = delta_decode(block[BLOCK_HEADER.size:], count)
+            if len(rows) != count:
+                raise ValueError("truncated block")
+        except (struct.error, ValueError):
+            bad += 1
+            continue
+        if args.session is not None and session != args.session:
+            continue
+        sessions.add(session)
+        blocks += 1
+        samples += count
+        dropped += lost
+        stored += len(block)
+        for row in rows:
+            print("%d,%d,%s" % (session, blocks - 1, ",".join(str(v) for v in row)))
+
+    print("decoded %d blocks (sessions %s), %d corrupted" % (blocks, sorted(sessions), bad), file=sys.stderr)
+    if samples:
+        print("%d samples, %d dropped while recording, %.2f bytes/sample in flash"
+              % (samples, dropped, stored / samples), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+"""
+decode the binary telemetry stream of L3 into CSV.
+
+the stream is a sequence of COBS encoded packets, each terminated by a 0x00 byte.
+a decoded packet is (all fields little-endian):
+
+    | type (1) | sequence (2) | payload (n) | crc16 (2) |
+
+with a CRC-16/CCITT-FALSE over type, sequence and payload. refer to 'src/telemetry.h'.
+
+capturing the stream:
+    - on the board, log RTT channel 1 to a file, e.g.:
+          JLinkRTTLogger -Device NRF52832_XXAA -If SWD -Speed 4000 -RTTChannel 1 telemetry.bin
+    - on native_sim, the application writes 'telemetry.bin' (CONFIG_L3_TELEMETRY_FILE) next to zephyr.exe.
+
+usage:
+    python3 telemetry_decode.py telemetry.bin > samples.csv
+
+raw (0x01) and delta compressed (0x02, CONFIG_L3_TELEMETRY_DELTA) sample packets are exported alike. the
+summary on stderr reports the bytes per sample on the wire and the ratio to raw packets. '--estimate N'
+codes the samples of a capture again N per packet, to size the compression on recorded data without
+flashing a new build.
+
+window summaries (0x03, CONFIG_L3_STATS) are exported with '--type 0x03', one row per window.
+"""
+
+import argparse
+import struct
+import sys
+
+# packet types, keep in sync with 'src/telemetry.h'
+TYPE_SAMPLE = 0x01
+TYPE_SAMPLE_DELTA = 0x02
+TYPE_STATS = 0x03
+
+HEADER = struct.Struct("<BH")
+CRC_SIZE = 2
+
+SAMPLE = struct.Struct("<I6h")
+SAMPLE_COLUMNS = "sensor_time,acc_x,acc_y,acc_z,gyr_x,gyr_y,gyr_z"
+
+# window summary of CONFIG_L3_STATS, keep in sync with imu_stats_pack(): mean, std and rms are Q8 raw LSB
+STATS_HEADER = struct.Struct("<IIIHH")
+STATS_AXIS = struct.Struct("<iIIhh")
+STATS_AXES = ("acc_x", "acc_y", "acc_z", "gyr_x", "gyr_y", "gyr_z")
+STATS_COLUMNS = "start_time,end_time,count,cycles_per_sample,max_block_cycles," + ",".join(
+    "%s_%s" % (axis, field) for axis in STATS_AXES for field in ("mean", "std", "rms", "min", "max"))
+
+# bytes of a raw sample packet on the wire: COBS code byte + header + payload + crc + delimiter
+RAW_FRAME_SIZE = 1 + HEADER.size + SAMPLE.size + CRC_SIZE + 1
+
+# keep in sync with TELEMETRY_MAX_PAYLOAD and IMU_CODEC_MAX_SAMPLE_SIZE
+MAX_PAYLOAD = 240
+CODEC_MAX_SAMPLE_SIZE = 5 + 6 * 3
+
+
+def crc16_ccitt_false(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, the same as zephyr's crc16_itu_t(0xFFFF, ...)."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(frame):
+    """decode one COBS frame (without the 0x00 delimiter), returns None if the frame is malformed."""
+    out = bytearray()
+    idx = 0
+    while idx < len(frame):
+        code = frame[idx]
+        if code == 0 or idx + code > len(frame):
+            return None
+        out += frame[idx + 1: idx + code]
+        idx += code
+        # a block shorter than 254 bytes stands for a 0x00, except the last one of the frame
+        if code != 0xFF and idx < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def packets(stream):
+    """split the raw stream at every 0x00 and yield the valid decoded packets with a count of the bad ones."""
+    for frame in stream.split(b"\x00"):
+        if not frame:
+            continue
+        packet = cobs_decode(frame)
+        if packet is None or len(packet) < HEADER.size + CRC_SIZE:
+            yield None
+            continue
+        body, crc = packet[:-CRC_SIZE], struct.unpack("<H", packet[-CRC_SIZE:])[0]
+        if crc16_ccitt_false(body) != crc:
+            yield None
+            continue
+        yield body
+
+
+def zigzag(value):
+    return (value << 1) ^ (-1 if value < 0 else 0)
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def put_varint(value, out):
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+
+
+def get_varint(data, idx, max_len):
+    """read one varint at 'idx', returns (value, next index), raises ValueError if it is truncated or too long."""
+    value = 0
+    for n in range(max_len):
+        if idx + n >= len(data):
+            break
+        value |= (data[idx + n] & 0x7F) << (7 * n)
+        if not data[idx + n] & 0x80:
+            return value, idx + n + 1
+    raise ValueError("bad varint")
+
+
+def wrap16(value):
+    return ((value + 0x8000) & 0xFFFF) - 0x8000
+
+
+def delta_encode(samples):
+    """the host side of imu_codec_encode(), 'samples' is a list of (sensor_time, 6 axes) starting a new stream."""
+    out = bytearray()
+    prev = (0,) * 7
+    prev_delta = 0
+    for sample in samples:
+        delta = (sample[0] - prev[0]) & 0xFFFFFFFF
+        step = ((delta - prev_delta + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+        put_varint(zigzag(step) & 0xFFFFFFFF, out)
+        for axis in range(1, 7):
+            put_varint(zigzag(wrap16(sample[axis] - prev[axis])) & 0xFFFF, out)
+        prev = sample
+        prev_delta = delta
+    return bytes(out)
+
+
+def delta_decode(payload, count=None):
+    """the host side of imu_codec_decode(), one packet is one stream. 'count' stops before trailing padding."""
+    rows = []
+    prev = [0] * 7
+    prev_delta = 0
+    idx = 0
+    while idx < len(payload) and (count is None or len(rows) < count):
+        step, idx = get_varint(payload, idx, 5)
+        prev_delta = (prev_delta + unzigzag(step)) & 0xFFFFFFFF
+        prev[0] = (prev[0] + prev_delta) & 0xFFFFFFFF
+        for axis in range(1, 7):
+            value, idx = get_varint(payload, idx, 3)
+            prev[axis] = wrap16(prev[axis] + unzigzag(value))
+        rows.append(tuple(prev))
+    return rows
+
+
+def stats_decode(payload):
+    if len(payload) != STATS_HEADER.size + len(STATS_AXES) * STATS_AXIS.size:
+        raise ValueError("stats payload of %d bytes" % len(payload))
+    row = list(STATS_HEADER.unpack_from(payload))
+    for i in range(len(STATS_AXES)):
+        mean, std, rms, low, high = STATS_AXIS.unpack_from(payload, STATS_HEADER.size + i * STATS_AXIS.size)
+        row += ["%.3f" % (mean / 256.0), "%.3f" % (std / 256.0), "%.3f" % (rms / 256.0), low, high]
+    return [row]
+
+
+def frame_size(payload_len):
+    """bytes of a packet with this payload on the wire, the payloads stay below 254 so COBS adds one byte."""
+    return 1 + HEADER.size + payload_len + CRC_SIZE + 1
+
+
+def estimate(rows, per_packet):
+    """wire bytes of 'rows' sent as delta packets of 'per_packet' samples, cut like telemetry_send_sample()."""
+    total = 0
+    packet = []
+    length = 0
+    for row in rows:
+        if length + CODEC_MAX_SAMPLE_SIZE > MAX_PAYLOAD:
+            total += frame_size(length)
+            packet, length = [], 0
+        packet.append(row)
+        length = len(delta_encode(packet))
+        if len(packet) >= per_packet:
+            total += frame_size(length)
+            packet, length = [], 0
+    if packet:
+        total += frame_size(length)
+    return total
+
+
+# payload parsers by packet type: (csv header, function returning the rows of one payload)
+PARSERS = {
+    TYPE_SAMPLE: (SAMPLE_COLUMNS, lambda payload: [SAMPLE.unpack(payload)]),
+    TYPE_SAMPLE_DELTA: (SAMPLE_COLUMNS, delta_decode),
+    TYPE_STATS: (STATS_COLUMNS, stats_decode),
+}
+
+# the compressed samples are exported with the raw ones
+ALIASES = {
+    TYPE_SAMPLE_DELTA: TYPE_SAMPLE,
+}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="captured binary stream ('-' for stdin)")
+    parser.add_argument("--type", type=lambda v: int(v, 0), default=TYPE_SAMPLE,
+                        help="packet type to export (default: 0x01, raw and compressed samples)")
+    parser.add_argument("--estimate", type=int, metavar="N",
+                        help="also print the size of the exported samples as delta packets of N samples")
+    args = parser.parse_args()
+
+    stream = sys.stdin.buffer.read() if args.input == "-" else open(args.input, "rb").read()
+
+    if args.type not in PARSERS:
+        sys.exit("unknown packet type 0x%02x" % args.type)
+
+    print("seq," + PARSERS[args.type][0])
+
+    bad = 0
+    lost = 0
+    total = 0
+    expected = None
+    wire = 0
+    exported = []
+    for body in packets(stream):
+        if body is None:
+            bad += 1
+            continue
+        ptype, seq = HEADER.unpack_from(body)
+        # the sequence is shared by all packet types, gaps are counted over the whole stream
+        if expected is not None and seq != expected:
+            lost += (seq - expected) & 0xFFFF
+        expected = (seq + 1) & 0xFFFF
+        total += 1
+        if ptype not in PARSERS or ALIASES.get(ptype, ptype) != args.type:
+            continue
+        payload = body[HEADER.size:]
+        try:
+            rows = PARSERS[ptype][1](payload)
+        except (struct.error, ValueError):
+            bad += 1
+            continue
+        wire += frame_size(len(payload))
+        exported += rows
+        for row in rows:
+            print("%d,%s" % (seq, ",".join(str(v) for v in row)))
+
+    print("decoded %d packets, %d lost (sequence gaps), %d corrupted" % (total, lost, bad), file=sys.stderr)
+
+    if exported and args.type == TYPE_SAMPLE:
+        print("%d samples in %d bytes, %.2f bytes/sample, ratio %.2f to raw packets"
+              % (len(exported), wire, wire / len(exported), len(exported) * RAW_FRAME_SIZE / wire), file=sys.stderr)
+        if args.estimate:
+            size = estimate([tuple(row) for row in exported], args.estimate)
+            print("as delta packets of %d: %d bytes, %.2f bytes/sample, ratio %.2f to raw packets"
+                  % (args.estimate, size, size / len(exported), len(exported) * RAW_FRAME_SIZE / size), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()